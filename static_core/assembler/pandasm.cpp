@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -26,6 +26,7 @@
 #include "assembly-emitter.h"
 #include "assembly-parser.h"
 #ifdef PANDA_WITH_BYTECODE_OPTIMIZER
+#include "bytecode_optimizer/bytecodeopt_options.h"
 #include "bytecode_optimizer/optimize_bytecode.h"
 #endif
 #include "file_format_version.h"
@@ -229,6 +230,10 @@ int main(int argc, const char *argv[])
     ark::PandArg<bool> help("help", false, "Print this message and exit");
     ark::PandArg<bool> sizeStat("size-stat", false, "Print panda file size statistic");
     ark::PandArg<bool> optimize("optimize", false, "Run the bytecode optimization");
+#ifdef PANDA_WITH_BYTECODE_OPTIMIZER
+    ark::PandArg<uint32_t> optThreads("opt-threads", 1U,
+                                      "Number of threads of the bytecode optimization, 0 means the hardware threads");
+#endif
     ark::PandArg<bool> version {"version", false,
                                 "Ark version, file format version and minimum supported file format version"};
     // tail arguments
@@ -241,6 +246,9 @@ int main(int argc, const char *argv[])
     paParser.Add(&scopesFile);
     paParser.Add(&sizeStat);
     paParser.Add(&optimize);
+#ifdef PANDA_WITH_BYTECODE_OPTIMIZER
+    paParser.Add(&optThreads);
+#endif
     paParser.Add(&version);
     paParser.PushBackTail(&inputFile);
     paParser.PushBackTail(&outputFile);
@@ -273,6 +281,9 @@ int main(int argc, const char *argv[])
     }
 
     auto &program = res.Value();
+#ifdef PANDA_WITH_BYTECODE_OPTIMIZER
+    ark::bytecodeopt::g_options.SetOptThreads(optThreads.GetValue());
+#endif
 
     auto w = parser.ShowWarnings();
     if (!w.empty()) {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,7 @@
 #define PANDA_IR_INTERFACE_H
 
 #include <string>
+#include <vector>
 
 #include "assembler/assembly-emitter.h"
 #include "libpandafile/method_data_accessor-inl.h"
@@ -25,6 +26,9 @@
 namespace ark::bytecodeopt {
 class BytecodeOptIrInterface {
 public:
+    // Placeholder ids of the deferred literal arrays are above the offsets of any panda file
+    static constexpr uint32_t DEFERRED_LITERAL_ARRAY_ID_BASE = 1U << 31U;
+
     explicit BytecodeOptIrInterface(const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
                                     pandasm::Program *prog = nullptr)
         : prog_(prog), maps_(maps)
@@ -58,6 +62,10 @@ public:
             return std::nullopt;
         }
         auto id = std::to_string(offset);
+        if (deferLiteralArrays_ && offset >= DEFERRED_LITERAL_ARRAY_ID_BASE &&
+            offset - DEFERRED_LITERAL_ARRAY_ID_BASE < deferredLiteralArrays_.size()) {
+            return id;
+        }
         auto it = prog_->literalarrayTable.find(id);
         ASSERT(it != prog_->literalarrayTable.end());
         return it != prog_->literalarrayTable.end() ? std::optional<std::string>(id) : std::nullopt;
@@ -120,6 +128,11 @@ public:
         if (prog_ == nullptr) {
             return;
         }
+        if (deferLiteralArrays_) {
+            ASSERT(id == std::to_string(GetLiteralArrayTableSize()));
+            deferredLiteralArrays_.push_back(std::move(literalarray));
+            return;
+        }
         prog_->literalarrayTable.emplace(id, std::move(literalarray));
     }
 
@@ -129,9 +142,27 @@ public:
         if (prog_ == nullptr) {
             return 0;
         }
+        if (deferLiteralArrays_) {
+            return DEFERRED_LITERAL_ARRAY_ID_BASE + deferredLiteralArrays_.size();
+        }
         return prog_->literalarrayTable.size();
     }
 
+    /**
+     * In the deferred mode the new literal arrays are kept here instead of the program, so the program is only read.
+     * They get the ids DEFERRED_LITERAL_ARRAY_ID_BASE + i, which are replaced with the real ones by the caller.
+     * It lets several methods be optimized concurrently while the ids are still assigned in the method order.
+     */
+    void SetDeferLiteralArrays(bool defer)
+    {
+        deferLiteralArrays_ = defer;
+    }
+
+    std::vector<pandasm::LiteralArray> &GetDeferredLiteralArrays()
+    {
+        return deferredLiteralArrays_;
+    }
+
     bool IsMapsSet() const
     {
         return maps_ != nullptr;
@@ -146,6 +177,8 @@ private:
     pandasm::Program *prog_ {nullptr};
     const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps_ {nullptr};
     std::unordered_map<size_t, pandasm::Ins *> pcInsMap_;
+    bool deferLiteralArrays_ {false};
+    std::vector<pandasm::LiteralArray> deferredLiteralArrays_;
 };
 }  // namespace ark::bytecodeopt
 
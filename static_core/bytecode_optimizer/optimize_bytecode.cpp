@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -49,7 +49,13 @@
 #include "reg_encoder.h"
 #include "runtime_adapter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
 #include <regex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace ark::bytecodeopt {
 // NOLINTNEXTLINE(fuchsia-statically-constructed-objects)
@@ -250,16 +256,12 @@ static void SetCompilerOptions(bool isDynamic)
     }
 }
 
-bool OptimizeFunction(pandasm::Program *prog, const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
-                      const panda_file::MethodDataAccessor &mda, bool isDynamic, SourceLanguage lang)
+static bool OptimizeFunction(pandasm::Program *prog, const panda_file::MethodDataAccessor &mda, bool isDynamic,
+                             SourceLanguage lang, BytecodeOptIrInterface &irInterface)
 {
     ArenaAllocator allocator {SpaceType::SPACE_TYPE_COMPILER};
     ArenaAllocator localAllocator {SpaceType::SPACE_TYPE_COMPILER, nullptr, true};
 
-    SetCompilerOptions(isDynamic);
-
-    auto irInterface = BytecodeOptIrInterface(maps, prog);
-
     auto funcName = irInterface.GetMethodIdByOffset(mda.GetMethodId().GetOffset());
     LOG(INFO, BYTECODE_OPTIMIZER) << "Optimizing function: " << funcName;
 
@@ -321,6 +323,166 @@ bool OptimizeFunction(pandasm::Program *prog, const pandasm::AsmEmitter::PandaFi
     return true;
 }
 
+static bool OptimizeFunction(pandasm::Program *prog, const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
+                             const panda_file::MethodDataAccessor &mda, bool isDynamic, SourceLanguage lang)
+{
+    auto irInterface = BytecodeOptIrInterface(maps, prog);
+    return OptimizeFunction(prog, mda, isDynamic, lang, irInterface);
+}
+
+struct MethodToOptimize {
+    panda_file::File::EntityId id;
+    SourceLanguage lang;
+};
+
+/// The fields of pandasm::Function which are changed by the optimization
+struct FunctionBody {
+    explicit FunctionBody(const pandasm::Function &function)
+        : ins(function.ins),
+          catchBlocks(function.catchBlocks),
+          localVariableDebug(function.localVariableDebug),
+          valueOfFirstParam(function.valueOfFirstParam),
+          regsNum(function.regsNum)
+    {
+    }
+
+    void Restore(pandasm::Function *function)
+    {
+        function->ins = std::move(ins);
+        function->catchBlocks = std::move(catchBlocks);
+        function->localVariableDebug = std::move(localVariableDebug);
+        function->valueOfFirstParam = valueOfFirstParam;
+        function->regsNum = regsNum;
+    }
+
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    std::vector<pandasm::Ins> ins;
+    std::vector<pandasm::Function::CatchBlock> catchBlocks;
+    std::vector<pandasm::debuginfo::LocalVariable> localVariableDebug;
+    int64_t valueOfFirstParam;
+    size_t regsNum;
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+};
+
+/// The result of the optimization of a method by a worker thread, it is committed to the program in the method order
+struct OptimizedMethod {
+    bool result {false};
+    pandasm::Function *function {nullptr};
+    // Literal arrays created by ConstArrayResolver, the code refers to them by the placeholder ids
+    std::vector<pandasm::LiteralArray> literalArrays;
+    // The function before the optimization, it is kept only if the optimization may create literal arrays
+    std::optional<FunctionBody> original;
+};
+
+static bool MayCreateLiteralArrays(const pandasm::Function &function)
+{
+    return std::any_of(function.ins.begin(), function.ins.end(),
+                       [](const pandasm::Ins &ins) { return ins.opcode == pandasm::Opcode::NEWARR; });
+}
+
+// The worker doesn't change anything in the program except the optimized function
+static void OptimizeMethodConcurrently(pandasm::Program *prog, const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
+                                       const panda_file::File &pfile, const MethodToOptimize &method, bool isDynamic,
+                                       OptimizedMethod *out)
+{
+    panda_file::MethodDataAccessor mda(pfile, method.id);
+    auto irInterface = BytecodeOptIrInterface(maps, prog);
+    irInterface.SetDeferLiteralArrays(true);
+
+    auto it = prog->functionTable.find(irInterface.GetMethodIdByOffset(method.id.GetOffset()));
+    if (it != prog->functionTable.end()) {
+        out->function = &it->second;
+        if (MayCreateLiteralArrays(it->second)) {
+            out->original.emplace(it->second);
+        }
+    }
+    out->result = OptimizeFunction(prog, mda, isDynamic, method.lang, irInterface);
+    out->literalArrays = std::move(irInterface.GetDeferredLiteralArrays());
+}
+
+/**
+ * Adds the literal arrays of the method to the program with the same ids as the serial optimization gives them.
+ * Returns false if one of the ids is already taken, the program is not changed in this case.
+ */
+static bool CommitLiteralArrays(pandasm::Program *prog, OptimizedMethod *method)
+{
+    auto &arrays = method->literalArrays;
+    size_t base = prog->literalarrayTable.size();
+    for (size_t i = 0; i < arrays.size(); ++i) {
+        if (prog->literalarrayTable.find(std::to_string(base + i)) != prog->literalarrayTable.end()) {
+            return false;
+        }
+    }
+    std::unordered_map<std::string, std::string> ids;
+    for (size_t i = 0; i < arrays.size(); ++i) {
+        auto id = std::to_string(base + i);
+        ids.emplace(std::to_string(BytecodeOptIrInterface::DEFERRED_LITERAL_ARRAY_ID_BASE + i), id);
+        prog->literalarrayTable.emplace(id, std::move(arrays[i]));
+    }
+    ASSERT(method->function != nullptr);
+    for (auto &ins : method->function->ins) {
+        if (ins.opcode != pandasm::Opcode::LDA_CONST || ins.ids.empty()) {
+            continue;
+        }
+        auto it = ids.find(ins.ids[0]);
+        if (it != ids.end()) {
+            ins.ids[0] = it->second;
+        }
+    }
+    return true;
+}
+
+static bool OptimizeMethodsConcurrently(pandasm::Program *prog,
+                                        const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
+                                        const panda_file::File &pfile, const std::vector<MethodToOptimize> &methods,
+                                        bool isDynamic, size_t threadsCount)
+{
+    std::vector<OptimizedMethod> optimized(methods.size());
+    std::atomic<size_t> next {0};
+    auto worker = [&]() {
+        while (true) {
+            // Atomic with relaxed order reason: the index only distributes the methods, the results are read after join
+            size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= methods.size()) {
+                return;
+            }
+            OptimizeMethodConcurrently(prog, maps, pfile, methods[index], isDynamic, &optimized[index]);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(threadsCount - 1U);
+    for (size_t i = 1; i < threadsCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    bool result = true;
+    for (size_t i = 0; i < methods.size(); ++i) {
+        auto &method = optimized[i];
+        if (!method.literalArrays.empty() && !CommitLiteralArrays(prog, &method)) {
+            // The ids of the serial optimization are taken by the arrays of the input, so optimize the method again
+            ASSERT(method.original.has_value());
+            method.original->Restore(method.function);
+            panda_file::MethodDataAccessor mda(pfile, methods[i].id);
+            method.result = OptimizeFunction(prog, maps, mda, isDynamic, methods[i].lang);
+        }
+        result = method.result && result;
+    }
+    return result;
+}
+
+static size_t GetOptThreadsCount()
+{
+    size_t count = g_options.GetOptThreads();
+    if (count == 0) {
+        count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    return count;
+}
+
 bool OptimizePandaFile(pandasm::Program *prog, const pandasm::AsmEmitter::PandaFileToPandaAsmMaps *maps,
                        const std::string &pfileName, bool isDynamic)
 {
@@ -329,8 +491,9 @@ bool OptimizePandaFile(pandasm::Program *prog, const pandasm::AsmEmitter::PandaF
         LOG(FATAL, BYTECODE_OPTIMIZER) << "Can not open binary file: " << pfileName;
     }
 
-    bool result = true;
+    SetCompilerOptions(isDynamic);
 
+    std::vector<MethodToOptimize> methods;
     for (uint32_t id : pfile->GetClasses()) {
         panda_file::File::EntityId recordId {id};
 
@@ -341,13 +504,24 @@ bool OptimizePandaFile(pandasm::Program *prog, const pandasm::AsmEmitter::PandaF
         panda_file::ClassDataAccessor cda {*pfile, recordId};
         auto lang = cda.GetSourceLang().value_or(SourceLanguage::PANDA_ASSEMBLY);
 
-        cda.EnumerateMethods([prog, maps, isDynamic, lang, &result](panda_file::MethodDataAccessor &mda) {
+        cda.EnumerateMethods([lang, &methods](panda_file::MethodDataAccessor &mda) {
             if (!mda.IsExternal() && !mda.IsAbstract() && !mda.IsNative()) {
-                result = OptimizeFunction(prog, maps, mda, isDynamic, lang) && result;
+                methods.push_back({mda.GetMethodId(), lang});
             }
         });
     }
 
+    auto threadsCount = std::min(GetOptThreadsCount(), methods.size());
+    // The placeholder ids of the literal arrays must not clash with the offsets of the file
+    if (threadsCount > 1U && pfile->GetHeader()->fileSize < BytecodeOptIrInterface::DEFERRED_LITERAL_ARRAY_ID_BASE) {
+        return OptimizeMethodsConcurrently(prog, maps, *pfile, methods, isDynamic, threadsCount);
+    }
+
+    bool result = true;
+    for (const auto &method : methods) {
+        panda_file::MethodDataAccessor mda(*pfile, method.id);
+        result = OptimizeFunction(prog, maps, mda, isDynamic, method.lang) && result;
+    }
     return result;
 }
 
@@ -18,6 +18,7 @@ import os
 import json
 import subprocess
 import tempfile
+import time
 
 SRC_PATH = os.path.realpath(os.path.dirname(__file__))
 testdir = os.path.join(SRC_PATH, "suite")
@@ -31,11 +32,13 @@ parser.add_argument("--bindir", default=bindir,
 parser.add_argument("--input-type", choices=["class", "pa"], default="class",
                     help="Type of the test input. Default: '%(default)s'"),
 parser.add_argument("--compiler-options", metavar="LIST",
-                    help="Comma separated list of compiler options for C2P (see '%s --help' for details"
+                    help="Comma separated list of compiler options for C2P or ark_asm (see '%s --help' for details"
                     % (os.path.relpath(os.path.join(bindir, "c2p")))),
 parser.add_argument("--compiler-options-file", metavar="FILE",
-                    help="Input file containing compiler options for C2P (see '%s --help' for details"
+                    help="Input file containing compiler options for C2P or ark_asm (see '%s --help' for details"
                     % (os.path.relpath(os.path.join(bindir, "c2p")))),
+parser.add_argument("--repeats", type=int, default=1,
+                    help="Number of runs of ark_asm per test, the minimum time is reported. Default: %(default)s"),
 parser.add_argument("--json", metavar="FILE",
                     help="JSON dump file name"),
 parser.add_argument("--verbose", "-v", action='store_true',
@@ -105,6 +108,17 @@ def calc_statistics(sizes):
             "Maximum sizes (in bytes)": maxs}
 
 
+def calc_time_statistics(times):
+    if len(times) == 0:
+        return None
+    stats = {"Total": round(sum(times), 1), "Average": round(sum(times) / len(times), 1),
+             "Minimum": round(min(times), 1), "Maximum": round(max(times), 1)}
+    print("\nTime (in ms):")
+    for d in sorted(stats):
+        print("%28s: %.1f" % (d, stats[d]))
+    return {"Time (in ms)": stats}
+
+
 def run_c2p(test_dir, bin_dir, c2p_opts):
     sizes = []
     result = {}
@@ -135,6 +149,61 @@ def run_c2p(test_dir, bin_dir, c2p_opts):
     return sizes, tests_passed, tests_failed, result
 
 
+def run_asm(test_dir, bin_dir, asm_opts, repeats):
+    sizes = []
+    times = []
+    result = {}
+    tests_passed = 0
+    tests_failed = 0
+
+    asm = os.path.join(bin_dir, "ark_asm")
+    if not os.path.exists(asm):
+        print("ark_asm executable does not exists (%s)." % os.path.relpath(asm))
+        exit(2)
+    fp = tempfile.NamedTemporaryFile()
+    for dirpath, dirnames, filenames in os.walk(test_dir):
+        for name in filenames:
+            if not name.endswith(".pa"):
+                continue
+            test_path = os.path.join(dirpath, name)
+            # The time includes the parsing, the optimization (if enabled) and the emission of the file
+            best_time = None
+            for _ in range(max(repeats, 1)):
+                start = time.perf_counter()
+                proc = subprocess.Popen([asm, "--size-stat"] + asm_opts + [
+                                        test_path, fp.name], stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+                stdout, stderr = proc.communicate(timeout=3600)
+                elapsed = (time.perf_counter() - start) * 1000
+                if proc.returncode != 0:
+                    break
+                best_time = elapsed if best_time is None else min(best_time, elapsed)
+            sizes.append(parse_c2p_output(test_path, stdout,
+                         stderr, proc.returncode, result))
+            if proc.returncode == 0:
+                tests_passed += 1
+                times.append(best_time)
+                result[test_path]["time (ms)"] = round(best_time, 1)
+                log("%s: %.1f ms" % (test_path, best_time))
+            else:
+                tests_failed += 1
+                log("Could not process the assembly file (%s)." % test_path)
+    fp.close()
+    return sizes, times, tests_passed, tests_failed, result
+
+
+def read_compiler_options():
+    options = []
+    if args.compiler_options_file:
+        with open(args.compiler_options_file) as conf_fp:
+            lines = conf_fp.readlines()
+            for line in lines:
+                options.append(line.strip())
+
+    if args.compiler_options:
+        options += args.compiler_options.split(",")
+    return options
+
+
 ############################################
 
 if __name__ == '__main__':
@@ -147,16 +216,7 @@ if __name__ == '__main__':
     failed_tests = 0
 
     if args.input_type == "class":
-        c2p_options = []
-        if args.compiler_options_file:
-            with open(args.compiler_options_file) as conf_fp:
-                lines = conf_fp.readlines()
-                for line in lines:
-                    c2p_options.append(line.strip())
-
-        if args.compiler_options:
-            c2p_options += args.compiler_options.split(",")
-
+        c2p_options = read_compiler_options()
         c2p_sizes, passed_tests, failed_tests, c2p_res = run_c2p(
             args.testdir, args.bindir, c2p_options)
         num_of_tests = passed_tests + failed_tests
@@ -167,8 +227,16 @@ if __name__ == '__main__':
                 json_file.write("\n")
 
     else:
-        print("Non class input types have not been implemented.")
-        exit(2)
+        asm_sizes, asm_times, passed_tests, failed_tests, asm_res = run_asm(
+            args.testdir, args.bindir, read_compiler_options(), args.repeats)
+        num_of_tests = passed_tests + failed_tests
+        # The successful runs have the same keys, the failed ones are reported in the summary
+        calc_statistics([sizes for sizes in asm_sizes if sizes])
+        calc_time_statistics(asm_times)
+        if args.json:
+            with open(args.json, 'w') as json_file:
+                json.dump(asm_res, json_file, indent=4, sort_keys=True)
+                json_file.write("\n")
 
     print("Summary:\n========\n  Tests : %d\n  Passed: %d\n  Failed: %d\n"
           % (num_of_tests, passed_tests, failed_tests))
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "assembler/assembly-emitter.h"
+#include "assembler/assembly-parser.h"
+#include "bytecodeopt_options.h"
+#include "optimize_bytecode.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ark::bytecodeopt::test {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+/// Every function has a loop, a call and (for the most of them) an array of constants for ConstArrayResolver
+static std::string GenerateSource(size_t functionsCount)
+{
+    std::stringstream ss;
+    for (size_t i = 0; i < functionsCount; ++i) {
+        ss << ".function i32 f" << i << "(i32 a0) {\n";
+        ss << "    movi v0, 0x0\n";
+        ss << "    movi v1, 0x0\n";
+        ss << "loop:\n";
+        ss << "    lda v0\n";
+        ss << "    jge a0, exit\n";
+        ss << "    lda v1\n";
+        ss << "    addi " << (i % 7U + 1U) << "\n";
+        ss << "    muli 3\n";
+        ss << "    sta v1\n";
+        ss << "    inci v0, 0x1\n";
+        ss << "    jmp loop\n";
+        ss << "exit:\n";
+        if (i % 4U != 3U) {
+            ss << "    movi v2, 0x" << (i % 3U + 2U) << "\n";
+            ss << "    newarr v3, v2, i32[]\n";
+            for (size_t j = 0; j < i % 3U + 2U; ++j) {
+                ss << "    movi v4, 0x" << j << "\n";
+                ss << "    ldai " << i * 10U + j << "\n";
+                ss << "    starr v3, v4\n";
+            }
+        }
+        if (i > 0) {
+            ss << "    call.short f" << (i - 1U) << ", v1\n";
+            ss << "    add2 v1\n";
+        } else {
+            ss << "    lda v1\n";
+        }
+        ss << "    return\n";
+        ss << "}\n\n";
+    }
+    ss << ".function i32 main() {\n";
+    ss << "    movi v0, 0x10\n";
+    ss << "    call.short f" << (functionsCount - 1U) << ", v0\n";
+    ss << "    return\n";
+    ss << "}\n";
+    return ss.str();
+}
+
+static std::vector<uint8_t> ReadFile(const std::string &fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+/// Optimizes the generated program with the given number of threads and returns the emitted file
+static std::vector<uint8_t> Optimize(const std::string &source, uint32_t threadsCount)
+{
+    const std::string fileName = "parallel_opt_bc.bin";
+    const std::string outName = "parallel_opt_bc_out.bin";
+    pandasm::Parser parser;
+    auto res = parser.Parse(source, fileName);
+    EXPECT_EQ(parser.ShowError().err, pandasm::Error::ErrorType::ERR_NONE);
+    auto &prog = res.Value();
+    pandasm::AsmEmitter::PandaFileToPandaAsmMaps maps;
+    EXPECT_TRUE(pandasm::AsmEmitter::Emit(fileName, prog, nullptr, &maps));
+
+    g_options.SetOptThreads(threadsCount);
+    EXPECT_TRUE(OptimizeBytecode(&prog, &maps, fileName));
+    g_options.SetOptThreads(1U);
+
+    EXPECT_FALSE(prog.literalarrayTable.empty());
+    EXPECT_TRUE(pandasm::AsmEmitter::Emit(outName, prog));
+    return ReadFile(outName);
+}
+
+TEST(ParallelOptimizeTest, SameAsSerial)
+{
+    auto source = GenerateSource(40U);
+    auto expected = Optimize(source, 1U);
+    ASSERT_FALSE(expected.empty());
+    for (uint32_t threadsCount : {2U, 3U, 8U, 0U}) {
+        ASSERT_EQ(Optimize(source, threadsCount), expected) << "threads count " << threadsCount;
+    }
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+}  // namespace ark::bytecodeopt::test
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -126,6 +126,7 @@ void AotBuilder::FillHeader(const std::string &cmdline, const std::string &fileN
     aotHeader_.environmentChecksum = GetRuntime()->GetEnvironmentChecksum(arch_);
     aotHeader_.arch = static_cast<uint32_t>(arch_);
     aotHeader_.gcType = gcType_;
+    aotHeader_.cpuFeatures = cpuFeatures_;
     aotHeader_.filesOffset = sizeof(aotHeader_);
     aotHeader_.filesCount = fileHeaders_.size();
     aotHeader_.classHashTablesOffset =
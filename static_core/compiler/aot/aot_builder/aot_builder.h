@@ -53,6 +53,12 @@ public:
         return gcType_;
     }
 
+    /// Mask of the CPU features the code may use, see `CompilerOptions::GetCpuFeaturesMask`
+    void SetCpuFeatures(uint32_t cpuFeatures)
+    {
+        cpuFeatures_ = cpuFeatures;
+    }
+
     uint64_t *GetIntfInlineCacheIndex()
     {
         return &intfInlineCacheIndex_;
@@ -161,6 +167,7 @@ private:
     std::string fileName_;
     compiler::AotHeader aotHeader_ {};
     uint32_t gcType_ {static_cast<uint32_t>(mem::GCType::INVALID_GC)};
+    uint32_t cpuFeatures_ {0};
     uint64_t intfInlineCacheIndex_ {0};
     std::vector<compiler::RoData> roDatas_;
     std::map<std::pair<const panda_file::File *, uint32_t>, int32_t> gotPlt_;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,7 @@
  */
 
 #include "aot_file.h"
+#include "compiler/compiler_options.h"
 #include "compiler/optimizer/ir/inst.h"
 #include "optimizer/ir/runtime_interface.h"
 #include "utils/logger.h"
@@ -83,6 +84,14 @@ Expected<std::unique_ptr<AotFile>, std::string> AotFile::Open(const std::string
                           std::string(mem::GCStringFromType(static_cast<mem::GCType>(aotHeader->gcType))) + " vs " +
                           std::string(mem::GCStringFromType(static_cast<mem::GCType>(gcType))));
     }
+
+    // The code may use the instructions which are not supported by the CPU
+    uint32_t missingFeatures =
+        aotHeader->cpuFeatures & ~static_cast<uint32_t>(CompilerOptions::GetHostCpuFeatures().to_ulong());
+    if (!forDump && missingFeatures != 0) {
+        return Unexpected(std::string("AOT file requires CPU features: ") +
+                          CompilerOptions::CpuFeaturesMaskToString(missingFeatures));
+    }
     return std::make_unique<AotFile>(std::move(handle), Span(aot.Value(), aot_end.Value() - aot.Value()),
                                      Span(code.Value(), code_end.Value() - code.Value()));
 }
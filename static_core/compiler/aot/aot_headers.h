@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -32,6 +32,7 @@ struct AotHeader {
     uint32_t environmentChecksum;
     uint32_t arch;
     uint32_t gcType;
+    uint32_t cpuFeatures;
     uint32_t filesCount;
     uint32_t filesOffset;
     uint32_t classHashTablesOffset;
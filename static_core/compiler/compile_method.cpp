@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -38,27 +38,40 @@ static Span<uint8_t> EmitElf(Graph *graph, CodeAllocator *codeAllocator, ArenaAl
                              const std::string &methodName);
 #endif
 
-void JITStats::SetCompilationStart()
+// JIT threads compile different methods in parallel, only the installation of the code is serialized
+// NOLINTNEXTLINE(fuchsia-statically-constructed-objects)
+static os::memory::Mutex g_codeInstallLock;
+
+void JITStats::SetCompilationStart(const Method *method, bool isOsr)
 {
-    ASSERT(startTime_ == 0);
-    startTime_ = time::GetCurrentTimeInNanos();
+    os::memory::LockHolder lock(lock_);
+    [[maybe_unused]] auto inserted = startTimes_.emplace(std::make_pair(method, isOsr), time::GetCurrentTimeInNanos());
+    ASSERT(inserted.second);
 }
-void JITStats::EndCompilationWithStats(const std::string &methodName, bool isOsr, size_t bcSize, size_t codeSize)
+
+void JITStats::EndCompilationWithStats(const Method *method, const std::string &methodName, bool isOsr,
+                                       size_t codeSize)
 {
-    ASSERT(startTime_ != 0);
-    auto time = time::GetCurrentTimeInNanos() - startTime_;
-    statsList_.push_back(Entry {PandaString(methodName, internalAllocator_->Adapter()), isOsr, bcSize, codeSize, time});
-    startTime_ = 0;
+    auto endTime = time::GetCurrentTimeInNanos();
+    os::memory::LockHolder lock(lock_);
+    auto it = startTimes_.find(std::make_pair(method, isOsr));
+    ASSERT(it != startTimes_.end());
+    auto time = endTime - it->second;
+    startTimes_.erase(it);
+    statsList_.push_back(Entry {PandaString(methodName, internalAllocator_->Adapter()), isOsr,
+                                method->GetCodeSize(), codeSize, time});
 }
 
-void JITStats::ResetCompilationStart()
+void JITStats::ResetCompilationStart(const Method *method, bool isOsr)
 {
-    startTime_ = 0;
+    os::memory::LockHolder lock(lock_);
+    startTimes_.erase(std::make_pair(method, isOsr));
 }
 
 void JITStats::DumpCsv(char sep)
 {
     ASSERT(g_options.WasSetCompilerDumpJitStatsCsv());
+    os::memory::LockHolder lock(lock_);
     std::ofstream csv(g_options.GetCompilerDumpJitStatsCsv(), std::ofstream::trunc);
     for (const auto &i : statsList_) {
         csv << "\"" << i.methodName << "\"" << sep;
@@ -70,14 +83,14 @@ void JITStats::DumpCsv(char sep)
     }
 }
 
-static void EndCompilation(const std::string &methodName, bool isOsr, size_t bcSize, [[maybe_unused]] uintptr_t address,
-                           size_t codeSize, [[maybe_unused]] size_t infoSize,
+static void EndCompilation(const Method *method, const std::string &methodName, bool isOsr,
+                           [[maybe_unused]] uintptr_t address, size_t codeSize, [[maybe_unused]] size_t infoSize,
                            [[maybe_unused]] events::CompilationStatus status, JITStats *jitStats)
 {
-    EVENT_COMPILATION(methodName, isOsr, bcSize, address, codeSize, infoSize, status);
+    EVENT_COMPILATION(methodName, isOsr, method->GetCodeSize(), address, codeSize, infoSize, status);
     if (jitStats != nullptr) {
         ASSERT((codeSize != 0) == (status == events::CompilationStatus::COMPILED));
-        jitStats->EndCompilationWithStats(methodName, isOsr, bcSize, codeSize);
+        jitStats->EndCompilationWithStats(method, methodName, isOsr, codeSize);
     }
 }
 
@@ -121,12 +134,10 @@ static Span<uint8_t> EmitCode(const Graph *graph, CodeAllocator *allocator)
     prefix.codeInfoOffset = codeOffset + RoundUp(graph->GetCode().size(), sizeof(uint32_t));
     prefix.codeInfoSize = graph->GetCodeInfoData().size();
     size_t codeSize = prefix.codeInfoOffset + prefix.codeInfoSize;
-    auto memRange = allocator->AllocateCodeUnprotected(codeSize);
-    if (memRange.GetSize() == 0) {
-        return Span<uint8_t> {};
-    }
 
-    auto data = reinterpret_cast<uint8_t *>(memRange.GetData());
+    // The code is assembled in the compiler's memory, so the code allocator can pack it into a shared code page
+    ArenaVector<uint8_t> buffer(codeSize, 0, graph->GetAllocator()->Adapter());
+    auto data = buffer.data();
     memcpy_s(data, sizeof(CodePrefix), &prefix, sizeof(CodePrefix));
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     memcpy_s(&data[codeOffset], graph->GetCode().size(), graph->GetCode().data(), graph->GetCode().size());
@@ -134,14 +145,16 @@ static Span<uint8_t> EmitCode(const Graph *graph, CodeAllocator *allocator)
     memcpy_s(&data[prefix.codeInfoOffset], graph->GetCodeInfoData().size(), graph->GetCodeInfoData().data(),
              graph->GetCodeInfoData().size());
 
-    allocator->ProtectCode(memRange);
-
-    return Span<uint8_t>(reinterpret_cast<uint8_t *>(memRange.GetData()), codeSize);
+    auto code = allocator->AllocateCode(codeSize, data);
+    if (code == nullptr) {
+        return Span<uint8_t> {};
+    }
+    return Span<uint8_t>(static_cast<uint8_t *>(code), codeSize);
 }
 
-static uint8_t *GetEntryPoint(Graph *graph, [[maybe_unused]] Method *method, const std::string &methodName,
-                              [[maybe_unused]] bool isOsr, CodeAllocator *codeAllocator,
-                              [[maybe_unused]] ArenaAllocator *gdbDebugInfoAllocator, JITStats *jitStats)
+static uint8_t *GetEntryPoint(Graph *graph, Method *method, const std::string &methodName, bool isOsr,
+                              CodeAllocator *codeAllocator, [[maybe_unused]] ArenaAllocator *gdbDebugInfoAllocator,
+                              JITStats *jitStats)
 {
 #ifdef PANDA_COMPILER_DEBUG_INFO
     auto generatedData = g_options.IsCompilerEmitDebugInfo()
@@ -159,8 +172,8 @@ static uint8_t *GetEntryPoint(Graph *graph, [[maybe_unused]] Method *method, con
                         << bit_cast<void *>(codeInfo.GetCode()) << ", code size " << codeInfo.GetCodeSize();
 
     auto entryPoint = const_cast<uint8_t *>(codeInfo.GetCode());
-    EndCompilation(methodName, isOsr, method->GetCodeSize(), reinterpret_cast<uintptr_t>(entryPoint),
-                   codeInfo.GetCodeSize(), codeInfo.GetInfoSize(), events::CompilationStatus::COMPILED, jitStats);
+    EndCompilation(method, methodName, isOsr, reinterpret_cast<uintptr_t>(entryPoint), codeInfo.GetCodeSize(),
+                   codeInfo.GetInfoSize(), events::CompilationStatus::COMPILED, jitStats);
     return entryPoint;
 }
 
@@ -178,8 +191,8 @@ static void RunOptimizations(CompilerTaskRunner<RUNNER_MODE> taskRunner, JITStat
             LOG(FATAL, COMPILER) << "RunOptimizations failed!";
         }
         LOG(WARNING, COMPILER) << "RunOptimizations failed!";
-        EndCompilation(compilerCtx.GetMethodName(), compilerCtx.IsOsr(), compilerCtx.GetMethod()->GetCodeSize(), 0, 0,
-                       0, events::CompilationStatus::FAILED, jitStats);
+        EndCompilation(compilerCtx.GetMethod(), compilerCtx.GetMethodName(), compilerCtx.IsOsr(), 0, 0, 0,
+                       events::CompilationStatus::FAILED, jitStats);
     });
 
     // Run compiler optimizations over created graph
@@ -199,15 +212,15 @@ static bool CheckCompilation(RuntimeInterface *runtime, CodeAllocator *codeAlloc
     auto isOsr = compilerCtx.IsOsr();
     auto *method = compilerCtx.GetMethod();
 
+    os::memory::LockHolder lock(g_codeInstallLock);
     if (!isDynamic && !CheckSingleImplementation(graph)) {
-        EndCompilation(name, isOsr, method->GetCodeSize(), 0, 0, 0, events::CompilationStatus::FAILED_SINGLE_IMPL,
-                       jitStats);
+        EndCompilation(method, name, isOsr, 0, 0, 0, events::CompilationStatus::FAILED_SINGLE_IMPL, jitStats);
         return false;
     }
 
     // Drop non-native code in any case
     if (arch != RUNTIME_ARCH) {
-        EndCompilation(name, isOsr, method->GetCodeSize(), 0, 0, 0, events::CompilationStatus::DROPPED, jitStats);
+        EndCompilation(method, name, isOsr, 0, 0, 0, events::CompilationStatus::DROPPED, jitStats);
         return false;
     }
 
@@ -218,7 +231,8 @@ static bool CheckCompilation(RuntimeInterface *runtime, CodeAllocator *codeAlloc
     if (isOsr) {
         if (!runtime->TrySetOsrCode(method, entryPoint)) {
             // Compiled code has been deoptimized, so we shouldn't install osr code.
-            // NOTE(compiler): release compiled code memory, when CodeAllocator supports freeing the memory.
+            // Nobody has seen the code yet, so it can be released immediately.
+            codeAllocator->FreeCode(entryPoint);
             return false;
         }
     } else {
@@ -246,13 +260,13 @@ void JITCompileMethod(RuntimeInterface *runtime, CodeAllocator *codeAllocator, A
     }
 
     if (jitStats != nullptr) {
-        jitStats->SetCompilationStart();
+        jitStats->SetCompilationStart(taskMethod, taskCtx.IsOsr());
     }
 
     taskRunner.AddFinalize([jitStats](CompilerContext<RUNNER_MODE> &compilerCtx) {
         if (jitStats != nullptr) {
             // Reset compilation start time in all cases for consistency
-            jitStats->ResetCompilationStart();
+            jitStats->ResetCompilationStart(compilerCtx.GetMethod(), compilerCtx.IsOsr());
         }
         auto *graph = compilerCtx.GetGraph();
         if (graph != nullptr) {
@@ -300,7 +314,7 @@ void CompileInGraph(RuntimeInterface *runtime, bool isDynamic, Arch arch, Compil
     taskCtx.SetGraph(graph);
     if (graph == nullptr) {
         LOG(ERROR, COMPILER) << "Creating graph failed!";
-        EndCompilation(methodName, isOsr, method->GetCodeSize(), 0, 0, 0, events::CompilationStatus::FAILED, jitStats);
+        EndCompilation(method, methodName, isOsr, 0, 0, 0, events::CompilationStatus::FAILED, jitStats);
         CompilerTaskRunner<RUNNER_MODE>::EndTask(std::move(taskRunner), false);
         return;
     }
@@ -315,7 +329,7 @@ void CompileInGraph(RuntimeInterface *runtime, bool isDynamic, Arch arch, Compil
             LOG(FATAL, COMPILER) << "IrBuilder failed!";
         }
         LOG(WARNING, COMPILER) << "IrBuilder failed!";
-        EndCompilation(methodName, isOsr, method->GetCodeSize(), 0, 0, 0, events::CompilationStatus::FAILED, jitStats);
+        EndCompilation(method, methodName, isOsr, 0, 0, 0, events::CompilationStatus::FAILED, jitStats);
     };
     CompilerTaskRunner<RUNNER_MODE>::EndTask(std::move(taskRunner), success);
 }
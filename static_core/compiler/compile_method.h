@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -20,6 +20,7 @@
 #include "mem/arena_allocator.h"
 #include "mem/code_allocator.h"
 #include "include/method.h"
+#include "os/mutex.h"
 #include "utils/arch.h"
 #include "compiler_task_runner.h"
 
@@ -30,7 +31,9 @@ class RuntimeInterface;
 class JITStats {
 public:
     explicit JITStats(mem::InternalAllocatorPtr internalAllocator)
-        : internalAllocator_(internalAllocator), statsList_(internalAllocator->Adapter())
+        : internalAllocator_(internalAllocator),
+          startTimes_(internalAllocator->Adapter()),
+          statsList_(internalAllocator->Adapter())
     {
     }
     NO_MOVE_SEMANTIC(JITStats);
@@ -39,9 +42,10 @@ public:
     {
         DumpCsv();
     }
-    void SetCompilationStart();
-    void EndCompilationWithStats(const std::string &methodName, bool isOsr, size_t bcSize, size_t codeSize);
-    void ResetCompilationStart();
+    // Compilations of different methods may run in parallel, so the start time is kept per compiled method
+    void SetCompilationStart(const Method *method, bool isOsr);
+    void EndCompilationWithStats(const Method *method, const std::string &methodName, bool isOsr, size_t codeSize);
+    void ResetCompilationStart(const Method *method, bool isOsr);
 
 private:
     void DumpCsv(char sep = ',');
@@ -55,8 +59,9 @@ private:
 
 private:
     mem::InternalAllocatorPtr internalAllocator_;
-    uint64_t startTime_ {};
-    std::vector<Entry, typename mem::AllocatorAdapter<Entry>> statsList_;
+    os::memory::Mutex lock_;
+    PandaMap<std::pair<const Method *, bool>, uint64_t> startTimes_ GUARDED_BY(lock_);
+    std::vector<Entry, typename mem::AllocatorAdapter<Entry>> statsList_ GUARDED_BY(lock_);
 };
 
 Arch ChooseArch(Arch arch);
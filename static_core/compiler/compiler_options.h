@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -21,7 +21,9 @@
 #include "cpu_features.h"
 #include "compiler_options_gen.h"
 
+#include <bitset>
 #include <regex>
+#include <string>
 
 namespace ark::compiler {
 
@@ -81,31 +83,82 @@ public:
         if (crossCompilation || WasSetCompilerCpuFeatures()) {
             return;
         }
+        features_ |= GetHostCpuFeatures();
+    }
+
+    bool IsCpuFeatureEnabled(CpuFeature feature) const
+    {
+        return features_.test(feature);
+    }
+
+    /// Enabled features which the backend may emit for `arch`, bit `i` stands for the `CpuFeature` `i`
+    uint32_t GetCpuFeaturesMask(Arch arch, bool llvmBackend) const
+    {
+        static_assert(CPU_FEATURES_NUM <= BITS_PER_UINT32);
+        return static_cast<uint32_t>((features_ & GetArchCpuFeatures(arch, llvmBackend)).to_ulong());
+    }
+
+    /// Comma-separated names of the features in the `mask` returned by `GetCpuFeaturesMask`
+    static std::string CpuFeaturesMaskToString(uint32_t mask)
+    {
+        std::string names;
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define DEF(FEATURE, NAME)                                       \
+    if ((mask & (1U << (FEATURE))) != 0) {                       \
+        names += std::string(names.empty() ? "" : ",") + (NAME); \
+    }
+        CPU_FEATURE(DEF)
+#undef DEF
+        return names;
+    }
+
+    static std::bitset<CPU_FEATURES_NUM> GetHostCpuFeatures()
+    {
+        std::bitset<CPU_FEATURES_NUM> features;
         switch (RUNTIME_ARCH) {
             case Arch::AARCH64: {
-                if (CpuFeaturesHasCrc32()) {
-                    EnableCpuFeature(CRC32);
-                }
-                if (CpuFeaturesHasJscvt()) {
-                    EnableCpuFeature(JSCVT);
-                }
+                features.set(CRC32, CpuFeaturesHasCrc32());
+                features.set(JSCVT, CpuFeaturesHasJscvt());
                 break;
             }
-            case Arch::AARCH32:
+            case Arch::X86_64: {
+                features.set(SSE42, CpuFeaturesHasSse42());
+                features.set(POPCNT, CpuFeaturesHasPopcnt());
+                features.set(LZCNT, CpuFeaturesHasLzcnt());
+                features.set(BMI1, CpuFeaturesHasBmi1());
+                features.set(BMI2, CpuFeaturesHasBmi2());
+                features.set(AVX2, CpuFeaturesHasAvx2());
                 break;
+            }
+            case Arch::AARCH32:
             case Arch::X86:
-                break;
-            case Arch::X86_64:
-                break;
             case Arch::NONE:
             default:
                 break;
         }
+        return features;
     }
 
-    bool IsCpuFeatureEnabled(CpuFeature feature) const
+    /// The features used by the code generator, LLVM may emit all the features of the arch
+    static std::bitset<CPU_FEATURES_NUM> GetArchCpuFeatures(Arch arch, bool llvmBackend)
     {
-        return features_.test(feature);
+        std::bitset<CPU_FEATURES_NUM> features;
+        switch (arch) {
+            case Arch::AARCH64: {
+                features.set(JSCVT).set(CRC32, llvmBackend);
+                break;
+            }
+            case Arch::X86_64: {
+                features.set(POPCNT).set(LZCNT).set(BMI1).set(BMI2).set(SSE42, llvmBackend).set(AVX2, llvmBackend);
+                break;
+            }
+            case Arch::AARCH32:
+            case Arch::X86:
+            case Arch::NONE:
+            default:
+                break;
+        }
+        return features;
     }
 
 private:
@@ -116,6 +169,7 @@ private:
 
     void ParseEnabledCpuFeatures()
     {
+        features_.reset();
         for (const auto &arg : GetCompilerCpuFeatures()) {
             if (arg == "none") {
                 features_.reset();
@@ -19,6 +19,7 @@ Encoder (implementation of math and mem Low-level emitters)
 #include <iomanip>
 
 #include "libpandabase/utils/utils.h"
+#include "compiler/compiler_options.h"
 #include "compiler/optimizer/code_generator/relocations.h"
 #include "operands.h"
 #include "scoped_tmp_reg.h"
@@ -1652,9 +1653,19 @@ void Amd64Encoder::EncodeMinMaxFp(Reg dst, Reg src0, Reg src1)
     }
 }
 
+// BMI2 shifts take the count in any register and don't change the flags, they have no 8 and 16-bit forms
+static bool CanEncodeBmi2Shift(Reg dst)
+{
+    return g_options.IsCpuFeatureEnabled(CpuFeature::BMI2) && dst.GetSize() >= WORD_SIZE;
+}
+
 void Amd64Encoder::EncodeShl(Reg dst, Reg src0, Reg src1)
 {
     ASSERT(dst.IsScalar());
+    if (CanEncodeBmi2Shift(dst)) {
+        GetMasm()->shlx(ArchReg(dst), ArchReg(src0, dst.GetSize()), ArchReg(src1, dst.GetSize()));
+        return;
+    }
     ScopedTmpReg tmpReg(this, dst.GetType());
     Reg rcx(ConvertRegNumber(asmjit::x86::rcx.id()), dst.GetType());
     GetMasm()->mov(ArchReg(tmpReg), ArchReg(src0));
@@ -1672,6 +1683,10 @@ void Amd64Encoder::EncodeShl(Reg dst, Reg src0, Reg src1)
 void Amd64Encoder::EncodeShr(Reg dst, Reg src0, Reg src1)
 {
     ASSERT(dst.IsScalar());
+    if (CanEncodeBmi2Shift(dst)) {
+        GetMasm()->shrx(ArchReg(dst), ArchReg(src0, dst.GetSize()), ArchReg(src1, dst.GetSize()));
+        return;
+    }
     ScopedTmpReg tmpReg(this, dst.GetType());
     Reg rcx(ConvertRegNumber(asmjit::x86::rcx.id()), dst.GetType());
     GetMasm()->mov(ArchReg(tmpReg), ArchReg(src0));
@@ -1689,6 +1704,10 @@ void Amd64Encoder::EncodeShr(Reg dst, Reg src0, Reg src1)
 void Amd64Encoder::EncodeAShr(Reg dst, Reg src0, Reg src1)
 {
     ASSERT(dst.IsScalar());
+    if (CanEncodeBmi2Shift(dst)) {
+        GetMasm()->sarx(ArchReg(dst), ArchReg(src0, dst.GetSize()), ArchReg(src1, dst.GetSize()));
+        return;
+    }
     ScopedTmpReg tmpReg(this, dst.GetType());
     Reg rcx(ConvertRegNumber(asmjit::x86::rcx.id()), dst.GetType());
     GetMasm()->mov(ArchReg(tmpReg), ArchReg(src0));
@@ -2320,6 +2339,10 @@ void Amd64Encoder::EncodeBitCount(Reg dst0, Reg src0)
 
 void Amd64Encoder::EncodeCountLeadingZeroBits(Reg dst, Reg src)
 {
+    if (g_options.IsCpuFeatureEnabled(CpuFeature::LZCNT)) {
+        GetMasm()->lzcnt(ArchReg(dst, src.GetSize()), ArchReg(src));
+        return;
+    }
     auto end = CreateLabel();
     auto zero = CreateLabel();
     EncodeJump(zero, src, Condition::EQ);
@@ -2335,6 +2358,10 @@ void Amd64Encoder::EncodeCountLeadingZeroBits(Reg dst, Reg src)
 
 void Amd64Encoder::EncodeCountTrailingZeroBits(Reg dst, Reg src)
 {
+    if (g_options.IsCpuFeatureEnabled(CpuFeature::BMI1)) {
+        GetMasm()->tzcnt(ArchReg(dst, src.GetSize()), ArchReg(src));
+        return;
+    }
     ScopedTmpReg tmp(this, src.GetType());
     GetMasm()->bsf(ArchReg(tmp), ArchReg(src));
     GetMasm()->mov(ArchReg(dst), asmjit::imm(dst.GetSize()));
@@ -2557,7 +2584,7 @@ bool Amd64Encoder::CanEncodeImmLogical(uint64_t imm, uint32_t size)
 
 bool Amd64Encoder::CanEncodeBitCount()
 {
-    return asmjit::CpuInfo::host().hasFeature(asmjit::x86::Features::kPOPCNT);
+    return g_options.IsCpuFeatureEnabled(CpuFeature::POPCNT);
 }
 
 void Amd64Encoder::EncodeIsInf(Reg dst, Reg src)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -1126,13 +1126,8 @@ void Inst::Dump(std::ostream *out, bool newLine) const
     static constexpr auto ALIGN_BUF_SIZE = 64;
     if (auto posDiff = out->tellp() - operandsPos; posDiff < ALIGN_BUF_SIZE) {
         posDiff = ALIGN_BUF_SIZE - posDiff;
-        static std::array<char, ALIGN_BUF_SIZE + 1> spaceBuf;
-        if (spaceBuf[0] != ' ') {
-            std::fill(spaceBuf.begin(), spaceBuf.end(), ' ');
-        }
-        spaceBuf[posDiff] = 0;
-        (*out) << spaceBuf.data();
-        spaceBuf[posDiff] = ' ';
+        // Graphs are dumped by several compiler threads at once, so no shared buffer here
+        (*out) << std::string(posDiff, ' ');
     }
     // bytecode pointer
     if (pc_ != INVALID_PC && !g_options.IsCompilerDumpCompact()) {
@@ -269,18 +269,18 @@ bool Inlining::TryInline(CallInst *callInst)
 
 bool Inlining::TryInlineWithInlineCaches(CallInst *callInst)
 {
-    if (GetGraph()->IsAotMode()) {
-        // We don't support offline inline caches yet.
-        return false;
-    }
     auto runtime = GetGraph()->GetRuntime();
     auto pic = runtime->GetInlineCaches();
     if (pic == nullptr) {
         return false;
     }
 
+    // In AOT mode the inline caches come from the profile of the previous runs of the application
     ArenaVector<RuntimeInterface::ClassPtr> receivers(GetGraph()->GetLocalAllocator()->Adapter());
     auto callKind = pic->GetClasses(GetGraph()->GetMethod(), callInst->GetPc(), &receivers);
+    if (GetGraph()->IsAotMode() && !CanLoadReceiverClasses(receivers)) {
+        return false;
+    }
     switch (callKind) {
         case InlineCachesInterface::CallKind::MEGAMORPHIC:
             EVENT_INLINE(runtime->GetMethodFullName(GetGraph()->GetMethod()), "-", callInst->GetId(),
@@ -299,6 +299,26 @@ bool Inlining::TryInlineWithInlineCaches(CallInst *callInst)
     return false;
 }
 
+bool Inlining::CanLoadReceiverClasses(const ArenaVector<RuntimeInterface::ClassPtr> &receivers) const
+{
+    auto runtime = GetGraph()->GetRuntime();
+    return std::all_of(receivers.begin(), receivers.end(), [this, runtime](auto receiver) {
+        return runtime->GetClassIdWithinFile(GetGraph()->GetMethod(), receiver) != 0;
+    });
+}
+
+Inst *Inlining::CreateLoadReceiverClass(CallInst *callInst, RuntimeInterface::ClassPtr receiver)
+{
+    if (!GetGraph()->IsAotMode()) {
+        return GetGraph()->CreateInstLoadImmediate(DataType::REFERENCE, callInst->GetPc(), receiver);
+    }
+    // AOT code can't refer to the class by its address, so the class is loaded by its id in the panda file
+    auto typeId = GetGraph()->GetRuntime()->GetClassIdWithinFile(GetGraph()->GetMethod(), receiver);
+    ASSERT(typeId != 0);
+    return GetGraph()->CreateInstLoadClass(DataType::REFERENCE, callInst->GetPc(), callInst->GetSaveState(), typeId,
+                                           GetGraph()->GetMethod(), receiver);
+}
+
 bool Inlining::DoInlineMonomorphic(CallInst *callInst, RuntimeInterface::ClassPtr receiver)
 {
     auto runtime = GetGraph()->GetRuntime();
@@ -318,7 +338,7 @@ bool Inlining::DoInlineMonomorphic(CallInst *callInst, RuntimeInterface::ClassPt
 
     // Add type guard
     auto getClsInst = GetGraph()->CreateInstGetInstanceClass(DataType::REFERENCE, callInst->GetPc(), objInst);
-    auto loadClsInst = GetGraph()->CreateInstLoadImmediate(DataType::REFERENCE, callInst->GetPc(), receiver);
+    auto loadClsInst = CreateLoadReceiverClass(callInst, receiver);
     auto cmpInst = GetGraph()->CreateInstCompare(DataType::BOOL, callInst->GetPc(), getClsInst, loadClsInst,
                                                  DataType::REFERENCE, ConditionCode::CC_NE);
     auto deoptInst = GetGraph()->CreateInstDeoptimizeIf(DataType::NO_TYPE, callInst->GetPc(), cmpInst, saveState,
@@ -344,7 +364,7 @@ bool Inlining::DoInlineMonomorphic(CallInst *callInst, RuntimeInterface::ClassPt
 void Inlining::CreateCompareClass(CallInst *callInst, Inst *getClsInst, RuntimeInterface::ClassPtr receiver,
                                   BasicBlock *callBb)
 {
-    auto loadClsInst = GetGraph()->CreateInstLoadImmediate(DataType::REFERENCE, callInst->GetPc(), receiver);
+    auto loadClsInst = CreateLoadReceiverClass(callInst, receiver);
     auto cmpInst = GetGraph()->CreateInstCompare(DataType::BOOL, callInst->GetPc(), loadClsInst, getClsInst,
                                                  DataType::REFERENCE, ConditionCode::CC_EQ);
     auto ifInst = GetGraph()->CreateInstIfImm(DataType::BOOL, callInst->GetPc(), cmpInst, 0, DataType::BOOL,
@@ -89,6 +89,8 @@ protected:
     bool DoInline(CallInst *callInst, InlineContext *ctx);
     bool DoInlineMethod(CallInst *callInst, InlineContext *ctx);
     bool DoInlineIntrinsic(CallInst *callInst, InlineContext *ctx);
+    bool CanLoadReceiverClasses(const ArenaVector<RuntimeInterface::ClassPtr> &receivers) const;
+    Inst *CreateLoadReceiverClass(CallInst *callInst, RuntimeInterface::ClassPtr receiver);
     bool DoInlineMonomorphic(CallInst *callInst, RuntimeInterface::ClassPtr receiver);
     bool DoInlinePolymorphic(CallInst *callInst, ArenaVector<RuntimeInterface::ClassPtr> *receivers);
     void CreateCompareClass(CallInst *callInst, Inst *getClsInst, RuntimeInterface::ClassPtr receiver,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -22,8 +22,8 @@ namespace ark::compiler {
 bool LoopIdioms::RunImpl()
 {
     if (GetGraph()->GetArch() == Arch::AARCH32) {
-        // There is only one supported idiom and intrinsic
-        // emitted for it could not be encoded on Arm32.
+        // Intrinsics emitted for the idioms take 64-bit arguments
+        // and could not be encoded on Arm32.
         return false;
     }
     GetGraph()->RunPass<LoopAnalyzer>();
@@ -39,7 +39,7 @@ void LoopIdioms::InvalidateAnalyses()
 
 bool LoopIdioms::TransformLoop(Loop *loop)
 {
-    if (TryTransformArrayInitIdiom(loop)) {
+    if (TryTransformArrayInitIdiom(loop) || TryTransformReductionIdiom(loop) || TryTransformArrayMapIdiom(loop)) {
         isApplied_ = true;
         return true;
     }
@@ -101,13 +101,78 @@ bool CanReplaceLoop(Loop *loop, Marker marker)
     return true;
 }
 
+bool IsSimpleCountableLoop(Loop *loop, CountableLoopInfo &loopInfo)
+{
+    return loopInfo.constStep == 1UL && loopInfo.normalizedCc == ConditionCode::CC_LT &&
+           AllUsesWithinLoop(loopInfo.index, loop) && AllUsesWithinLoop(loopInfo.update, loop) &&
+           AllUsesWithinLoop(loopInfo.ifImm->GetInput(0).GetInst(), loop);
+}
+
 bool IsLoopContainsArrayInitIdiom(StoreInst *store, Loop *loop, CountableLoopInfo &loopInfo)
 {
-    auto storeIdx = store->GetIndex();
+    return loopInfo.index == store->GetIndex() && IsSimpleCountableLoop(loop, loopInfo);
+}
 
-    return loopInfo.constStep == 1UL && loopInfo.index == storeIdx && loopInfo.normalizedCc == ConditionCode::CC_LT &&
-           AllUsesWithinLoop(storeIdx, loop) && AllUsesWithinLoop(loopInfo.update, loop) &&
-           AllUsesWithinLoop(loopInfo.ifImm->GetInput(0).GetInst(), loop);
+void MarkLoopControl(CountableLoopInfo &loopInfo, Marker marker)
+{
+    loopInfo.update->SetMarker(marker);
+    loopInfo.index->SetMarker(marker);
+    loopInfo.ifImm->SetMarker(marker);
+    loopInfo.ifImm->GetInput(0).GetInst()->SetMarker(marker);
+}
+
+// Load of a primitive array element by the loop index, the array is a loop invariant
+bool IsElementLoad(Inst *inst, Loop *loop, CountableLoopInfo &loopInfo)
+{
+    if (inst->GetOpcode() != Opcode::LoadArray || inst->GetBasicBlock()->GetLoop() != loop) {
+        return false;
+    }
+    auto load = inst->CastToLoadArray();
+    return load->IsArray() && !load->IsString() && !load->GetNeedBarrier() && load->GetIndex() == loopInfo.index &&
+           load->GetArray()->GetBasicBlock()->GetLoop() != loop && !DataType::IsReference(load->GetType());
+}
+
+// All the users of the value, except for the ones outside of the loop, are `users`
+bool HasOnlyUsersInLoop(Inst *inst, Loop *loop, std::initializer_list<Inst *> users)
+{
+    for (auto &user : inst->GetUsers()) {
+        auto userInst = user.GetInst();
+        if (userInst->GetBasicBlock()->GetLoop() == loop &&
+            std::find(users.begin(), users.end(), userInst) == users.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::optional<CountableLoopInfo> ParseIdiomLoop(Loop *loop)
+{
+    ASSERT(loop->GetInnerLoops().empty());
+    if (loop->GetBlocks().size() != 1) {
+        return std::nullopt;
+    }
+    auto loopInfo = CountableLoopParser {*loop}.Parse();
+    if (!loopInfo.has_value() || !IsSimpleCountableLoop(loop, *loopInfo)) {
+        return std::nullopt;
+    }
+    ASSERT(loopInfo->isInc);
+    return loopInfo;
+}
+
+bool LoopIdioms::CheckIterationsCount(CountableLoopInfo *loopInfo, bool *alwaysJump) const
+{
+    *alwaysJump = false;
+    if (loopInfo->init->IsConst() && loopInfo->test->IsConst()) {
+        auto iterations =
+            loopInfo->test->CastToConstant()->GetIntValue() - loopInfo->init->CastToConstant()->GetIntValue();
+        if (iterations <= ITERATIONS_THRESHOLD) {
+            COMPILER_LOG(DEBUG, LOOP_TRANSFORM)
+                << "Loop will have " << iterations << " iterations, so intrinsics will not be generated";
+            return false;
+        }
+        *alwaysJump = true;
+    }
+    return true;
 }
 
 bool LoopIdioms::TryTransformArrayInitIdiom(Loop *loop)
@@ -135,10 +200,7 @@ bool LoopIdioms::TryTransformArrayInitIdiom(Loop *loop)
     MarkerHolder holder {GetGraph()};
     Marker marker = holder.GetMarker();
     store->SetMarker(marker);
-    loopInfo.update->SetMarker(marker);
-    loopInfo.index->SetMarker(marker);
-    loopInfo.ifImm->SetMarker(marker);
-    loopInfo.ifImm->GetInput(0).GetInst()->SetMarker(marker);
+    MarkLoopControl(loopInfo, marker);
 
     if (!CanReplaceLoop(loop, marker)) {
         return false;
@@ -152,18 +214,16 @@ bool LoopIdioms::TryTransformArrayInitIdiom(Loop *loop)
                                         << "\n\tindex: " << *loopInfo.index;
 
     bool alwaysJump = false;
-    if (loopInfo.init->IsConst() && loopInfo.test->IsConst()) {
-        auto iterations =
-            loopInfo.test->CastToConstant()->GetIntValue() - loopInfo.init->CastToConstant()->GetIntValue();
-        if (iterations <= ITERATIONS_THRESHOLD) {
-            COMPILER_LOG(DEBUG, LOOP_TRANSFORM)
-                << "Loop will have " << iterations << " iterations, so intrinsics will not be generated";
-            return false;
-        }
-        alwaysJump = true;
+    if (!CheckIterationsCount(&loopInfo, &alwaysJump)) {
+        return false;
     }
 
-    return ReplaceArrayInitLoop(loop, &loopInfo, store, alwaysJump);
+    auto inst = CreateArrayInitIntrinsic(store, &loopInfo);
+    if (inst == nullptr) {
+        return false;
+    }
+    ReplaceLoop(loop, &loopInfo, inst, nullptr, alwaysJump);
+    return true;
 }
 
 Inst *LoopIdioms::CreateArrayInitIntrinsic(StoreInst *store, CountableLoopInfo *info)
@@ -208,21 +268,240 @@ Inst *LoopIdioms::CreateArrayInitIntrinsic(StoreInst *store, CountableLoopInfo *
     return fillArray;
 }
 
-bool LoopIdioms::ReplaceArrayInitLoop(Loop *loop, CountableLoopInfo *loopInfo, StoreInst *store, bool alwaysJump)
+/*
+ * Reduction of an integer array: `acc = acc op a[i]`, where op is Add or Xor.
+ * Both operations are associative for the integers wrapping on overflow, so the
+ * intrinsic may sum the elements in any order.
+ */
+bool LoopIdioms::TryTransformReductionIdiom(Loop *loop)
+{
+    auto loopInfoOpt = ParseIdiomLoop(loop);
+    if (!loopInfoOpt.has_value()) {
+        return false;
+    }
+    auto loopInfo = *loopInfoOpt;
+    auto header = loop->GetHeader();
+
+    PhiInst *acc = nullptr;
+    for (auto phi : header->PhiInsts()) {
+        if (phi == loopInfo.index) {
+            continue;
+        }
+        if (acc != nullptr) {
+            return false;
+        }
+        acc = phi->CastToPhi();
+    }
+    if (acc == nullptr || !AllUsesWithinLoop(acc, loop)) {
+        return false;
+    }
+    auto reduction = acc->GetPhiInput(header);
+    auto opcode = reduction->GetOpcode();
+    if ((opcode != Opcode::Add && opcode != Opcode::Xor) || reduction->GetBasicBlock() != header) {
+        return false;
+    }
+    auto input = reduction->GetInput(0).GetInst() == acc ? reduction->GetInput(1).GetInst()
+                                                          : reduction->GetInput(0).GetInst();
+    if (input == acc || (reduction->GetInput(0).GetInst() != acc && reduction->GetInput(1).GetInst() != acc) ||
+        !IsElementLoad(input, loop, loopInfo) || !HasOnlyUsersInLoop(input, loop, {reduction}) ||
+        !HasOnlyUsersInLoop(reduction, loop, {acc})) {
+        return false;
+    }
+    auto load = input->CastToLoadArray();
+
+    MarkerHolder holder {GetGraph()};
+    Marker marker = holder.GetMarker();
+    acc->SetMarker(marker);
+    reduction->SetMarker(marker);
+    load->SetMarker(marker);
+    MarkLoopControl(loopInfo, marker);
+
+    if (!CanReplaceLoop(loop, marker)) {
+        return false;
+    }
+
+    COMPILER_LOG(DEBUG, LOOP_TRANSFORM) << "Reduction idiom found in loop: " << loop->GetId()
+                                        << "\n\tarray: " << *load->GetArray() << "\n\treduction: " << *reduction
+                                        << "\n\tinitial index: " << *loopInfo.init << "\n\ttest: " << *loopInfo.test;
+
+    bool alwaysJump = false;
+    if (!CheckIterationsCount(&loopInfo, &alwaysJump)) {
+        return false;
+    }
+
+    auto inst = CreateReductionIntrinsic(reduction, load, acc->GetPhiInput(loop->GetPreHeader()), &loopInfo);
+    if (inst == nullptr) {
+        return false;
+    }
+    ReplaceLoop(loop, &loopInfo, inst, reduction, alwaysJump);
+    return true;
+}
+
+Inst *LoopIdioms::CreateReductionIntrinsic(Inst *reduction, LoadInst *load, Inst *initialValue,
+                                           CountableLoopInfo *info)
 {
-    auto inst = CreateArrayInitIntrinsic(store, loopInfo);
+    auto type = reduction->GetType();
+    auto arch = GetGraph()->GetArch();
+    if (DataType::IsFloatType(type) || DataType::IsFloatType(load->GetType()) ||
+        DataType::GetTypeSize(type, arch) != DataType::GetTypeSize(load->GetType(), arch)) {
+        return nullptr;
+    }
+    bool isAdd = reduction->GetOpcode() == Opcode::Add;
+    RuntimeInterface::IntrinsicId intrinsicId;
+    switch (type) {
+        case DataType::INT32:
+        case DataType::UINT32:
+            intrinsicId = isAdd ? RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_32
+                                : RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_XOR_32;
+            break;
+        case DataType::INT64:
+        case DataType::UINT64:
+            intrinsicId = isAdd ? RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_64
+                                : RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_XOR_64;
+            break;
+        default:
+            return nullptr;
+    }
+
+    auto reduce = GetGraph()->CreateInstIntrinsic(type, reduction->GetPc(), intrinsicId);
+    reduce->ClearFlag(inst_flags::Flags::REQUIRE_STATE);
+    reduce->ClearFlag(inst_flags::Flags::RUNTIME_CALL);
+    reduce->SetInputs(GetGraph()->GetAllocator(), {{load->GetArray(), DataType::REFERENCE},
+                                                   {initialValue, type},
+                                                   {info->init, DataType::INT32},
+                                                   {info->test, DataType::INT32}});
+    return reduce;
+}
+
+/*
+ * Element-wise operation with a loop invariant: `b[i] = a[i] op k`, where op is Add or Mul.
+ * Every element depends only on the element with the same index, so the arrays may be the same.
+ */
+bool LoopIdioms::TryTransformArrayMapIdiom(Loop *loop)
+{
+    auto loopInfoOpt = ParseIdiomLoop(loop);
+    if (!loopInfoOpt.has_value()) {
+        return false;
+    }
+    auto loopInfo = *loopInfoOpt;
+    auto header = loop->GetHeader();
+
+    StoreInst *store = nullptr;
+    for (auto inst : header->Insts()) {
+        if (inst->GetOpcode() == Opcode::StoreArray) {
+            if (store != nullptr) {
+                return false;
+            }
+            store = inst->CastToStoreArray();
+        }
+    }
+    if (store == nullptr || store->GetNeedBarrier() || store->GetIndex() != loopInfo.index ||
+        store->GetArray()->GetBasicBlock()->GetLoop() == loop) {
+        return false;
+    }
+    auto op = store->GetStoredValue();
+    if ((op->GetOpcode() != Opcode::Add && op->GetOpcode() != Opcode::Mul) || op->GetBasicBlock() != header ||
+        !HasOnlyUsersInLoop(op, loop, {store}) || !AllUsesWithinLoop(op, loop)) {
+        return false;
+    }
+    auto input0 = op->GetInput(0).GetInst();
+    auto input1 = op->GetInput(1).GetInst();
+    // Both operations are commutative
+    auto loadInput = IsElementLoad(input0, loop, loopInfo) ? input0 : input1;
+    auto scalar = loadInput == input0 ? input1 : input0;
+    if (!IsElementLoad(loadInput, loop, loopInfo) || scalar->GetBasicBlock()->GetLoop() == loop ||
+        !HasOnlyUsersInLoop(loadInput, loop, {op}) || !AllUsesWithinLoop(loadInput, loop)) {
+        return false;
+    }
+    auto load = loadInput->CastToLoadArray();
+
+    MarkerHolder holder {GetGraph()};
+    Marker marker = holder.GetMarker();
+    store->SetMarker(marker);
+    op->SetMarker(marker);
+    load->SetMarker(marker);
+    MarkLoopControl(loopInfo, marker);
+
+    if (!CanReplaceLoop(loop, marker)) {
+        return false;
+    }
+
+    COMPILER_LOG(DEBUG, LOOP_TRANSFORM) << "Array map idiom found in loop: " << loop->GetId()
+                                        << "\n\tdestination: " << *store->GetArray()
+                                        << "\n\tsource: " << *load->GetArray() << "\n\toperation: " << *op
+                                        << "\n\tinitial index: " << *loopInfo.init << "\n\ttest: " << *loopInfo.test;
+
+    bool alwaysJump = false;
+    if (!CheckIterationsCount(&loopInfo, &alwaysJump)) {
+        return false;
+    }
+
+    auto inst = CreateArrayMapIntrinsic(store, load, scalar, &loopInfo);
     if (inst == nullptr) {
         return false;
     }
+    ReplaceLoop(loop, &loopInfo, inst, nullptr, alwaysJump);
+    return true;
+}
+
+Inst *LoopIdioms::CreateArrayMapIntrinsic(StoreInst *store, LoadInst *load, Inst *scalar, CountableLoopInfo *info)
+{
+    auto op = store->GetStoredValue();
+    auto type = op->GetType();
+    if (store->GetType() != type || load->GetType() != type) {
+        return nullptr;
+    }
+    bool isAdd = op->GetOpcode() == Opcode::Add;
+    RuntimeInterface::IntrinsicId intrinsicId;
+    switch (type) {
+        case DataType::INT32:
+        case DataType::UINT32:
+            intrinsicId = isAdd ? RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_ADD_SCALAR_32
+                                : RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_MUL_SCALAR_32;
+            break;
+        case DataType::FLOAT64:
+            intrinsicId = isAdd ? RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_ADD_SCALAR_F64
+                                : RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_MUL_SCALAR_F64;
+            break;
+        default:
+            return nullptr;
+    }
+
+    auto map = GetGraph()->CreateInstIntrinsic(DataType::VOID, store->GetPc(), intrinsicId);
+    map->ClearFlag(inst_flags::Flags::REQUIRE_STATE);
+    map->ClearFlag(inst_flags::Flags::RUNTIME_CALL);
+    map->SetInputs(GetGraph()->GetAllocator(), {{store->GetArray(), DataType::REFERENCE},
+                                                {load->GetArray(), DataType::REFERENCE},
+                                                {scalar, type},
+                                                {info->init, DataType::INT32},
+                                                {info->test, DataType::INT32}});
+    return map;
+}
+
+void LoopIdioms::ReplaceLoop(Loop *loop, CountableLoopInfo *loopInfo, Inst *inst, Inst *liveOut, bool alwaysJump)
+{
     auto header = loop->GetHeader();
     auto preHeader = loop->GetPreHeader();
 
+    // Users of the value computed by the loop, they take the result of the intrinsic
+    ArenaVector<std::pair<Inst *, unsigned>> outsideUsers(GetGraph()->GetLocalAllocator()->Adapter());
+    if (liveOut != nullptr) {
+        for (auto &user : liveOut->GetUsers()) {
+            if (user.GetInst()->GetBasicBlock()->GetLoop() != loop) {
+                outsideUsers.emplace_back(user.GetInst(), user.GetIndex());
+            }
+        }
+    }
+
     auto loopSucc = header->GetSuccessor(0) == header ? header->GetSuccessor(1) : header->GetSuccessor(0);
     if (alwaysJump) {
         ASSERT(loop->GetBlocks().size() == 1);
         // insert block before disconnecting header to properly handle Phi in loop_succ
         auto block = header->InsertNewBlockToSuccEdge(loopSucc);
         preHeader->ReplaceSucc(header, block, true);
+        for (auto [user, index] : outsideUsers) {
+            user->SetInput(index, inst);
+        }
         GetGraph()->DisconnectBlock(header, false, false);
         block->AppendInst(inst);
 
@@ -247,11 +526,21 @@ bool LoopIdioms::ReplaceArrayInitLoop(Loop *loop, CountableLoopInfo *loopInfo, S
         intrinsicBlock->AddSucc(mergeBlock);
         intrinsicBlock->AppendInst(inst);
 
+        if (liveOut != nullptr) {
+            ASSERT(mergeBlock->GetPredsBlocks().front() == header);
+            auto phi = GetGraph()->CreateInstPhi(liveOut->GetType(), inst->GetPc());
+            mergeBlock->AppendPhi(phi);
+            phi->AppendInput(liveOut);
+            phi->AppendInput(inst);
+            for (auto [user, index] : outsideUsers) {
+                user->SetInput(index, phi);
+            }
+        }
+
         COMPILER_LOG(INFO, LOOP_TRANSFORM) << "Inserted conditional jump into intinsic " << *inst << " before  loop "
                                            << loop->GetId() << ", inserted blocks: " << intrinsicBlock->GetId() << ", "
                                            << guardBlock->GetId() << ", " << mergeBlock->GetId();
     }
-    return true;
 }
 
 }  // namespace ark::compiler
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -20,7 +20,9 @@
 #include "compiler_options.h"
 
 // Find loops representing some idiom (like memcpy or memset) and replace
-// it with an intrinsics.
+// it with an intrinsics. The intrinsics are native loops over primitive arrays,
+// which the compiler of the runtime may vectorize for the baseline ISA of the build only
+// (SSE2 on amd64, NEON on arm64): the runtime is not built with -mavx2 and has no dispatch by CPU features.
 namespace ark::compiler {
 
 struct CountableLoopInfo;
@@ -53,7 +55,12 @@ private:
     bool TransformLoop(Loop *loop) override;
     bool TryTransformArrayInitIdiom(Loop *loop);
     Inst *CreateArrayInitIntrinsic(StoreInst *store, CountableLoopInfo *info);
-    bool ReplaceArrayInitLoop(Loop *loop, CountableLoopInfo *loopInfo, StoreInst *store, bool alwaysJump);
+    bool TryTransformReductionIdiom(Loop *loop);
+    Inst *CreateReductionIntrinsic(Inst *reduction, LoadInst *load, Inst *initialValue, CountableLoopInfo *info);
+    bool TryTransformArrayMapIdiom(Loop *loop);
+    Inst *CreateArrayMapIntrinsic(StoreInst *store, LoadInst *load, Inst *scalar, CountableLoopInfo *info);
+    bool CheckIterationsCount(CountableLoopInfo *loopInfo, bool *alwaysJump) const;
+    void ReplaceLoop(Loop *loop, CountableLoopInfo *loopInfo, Inst *inst, Inst *liveOut, bool alwaysJump);
 
     bool isApplied_ {false};
 };
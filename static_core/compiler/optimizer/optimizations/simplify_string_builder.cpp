@@ -63,8 +63,10 @@ bool SimplifyStringBuilder::RunImpl()
 
     ASSERT(GetGraph()->GetRootLoop() != nullptr);
 
-    // Loops with try-catch block and OSR mode are not supported in current implementation
-    if (!HasTryCatchBlocks(GetGraph()) && !GetGraph()->IsOsrMode()) {
+    // Loops and chains with try-catch block and OSR mode are not supported in current implementation:
+    // the intermediate string values are removed from save states
+    bool removeIntermediateValues = !HasTryCatchBlocks(GetGraph()) && !GetGraph()->IsOsrMode();
+    if (removeIntermediateValues) {
         for (auto loop : GetGraph()->GetRootLoop()->GetInnerLoops()) {
             OptimizeStringConcatenation(loop);
         }
@@ -75,6 +77,9 @@ bool SimplifyStringBuilder::RunImpl()
             continue;
         }
         OptimizeStringBuilderToString(block);
+        if (removeIntermediateValues) {
+            OptimizeConcatenationChains(block);
+        }
         OptimizeStringConcatenation(block);
     }
 
@@ -435,6 +440,169 @@ void SimplifyStringBuilder::OptimizeStringConcatenation(BasicBlock *block)
     } while (isAppliedLocal);
 }
 
+bool SimplifyStringBuilder::MatchConcatenationChain(Inst *ctorCall, ConcatenationChainMatch &match)
+{
+    // Match the instance created by the default constructor against ConcatenationChainMatch pattern
+
+    auto block = ctorCall->GetBasicBlock();
+    auto instance = ctorCall->GetInput(0).GetInst();
+    if (instance->GetBasicBlock() != block || IsUsedOutsideBasicBlock(instance, block)) {
+        return false;
+    }
+    match.instance = instance;
+    match.ctorCall = ctorCall;
+
+    for (auto inst = ctorCall->GetNext(); inst != nullptr; inst = inst->GetNext()) {
+        if (inst->IsSaveState() || inst->IsCheck() || !IsDataFlowInput(inst, instance)) {
+            continue;
+        }
+        if (match.appendIntermediateValue == nullptr) {
+            // The first append-call should take the result of another StringBuilder instance
+            if (!IsIntrinsicStringBuilderAppendString(inst)) {
+                return false;
+            }
+            match.appendIntermediateValue = inst;
+        } else if (IsStringBuilderToString(inst)) {
+            match.toStringCall = inst;
+            break;
+        } else if (!IsStringBuilderAppend(inst)) {
+            return false;
+        }
+    }
+    if (match.toStringCall == nullptr) {
+        return false;
+    }
+
+    auto intermediateValue = match.appendIntermediateValue->GetDataFlowInput(1);
+    if (intermediateValue->GetBasicBlock() != block || !IsStringBuilderToString(intermediateValue)) {
+        return false;
+    }
+    auto prevInstance = intermediateValue->GetDataFlowInput(0);
+    if (prevInstance == instance || prevInstance->GetBasicBlock() != block ||
+        IsUsedOutsideBasicBlock(prevInstance, block)) {
+        return false;
+    }
+    match.intermediateValue = intermediateValue;
+    match.prevInstance = prevInstance;
+
+    return IsConcatenationChainMergeable(match);
+}
+
+bool SimplifyStringBuilder::IsConcatenationChainMergeable(const ConcatenationChainMatch &match)
+{
+    MarkerHolder beforeMarker {GetGraph()};
+    Marker before = beforeMarker.GetMarker();
+    for (auto inst : match.intermediateValue->GetBasicBlock()->Insts()) {
+        if (inst == match.intermediateValue) {
+            break;
+        }
+        inst->SetMarker(before);
+    }
+
+    // The previous instance should not be used after its toString-call
+    bool usedAfterToString = HasUser(match.prevInstance, [&match, before](auto &user) {
+        auto userInst = SkipSingleUserCheckInstruction(user.GetInst());
+        return !userInst->IsSaveState() && userInst != match.intermediateValue && !userInst->IsMarked(before);
+    });
+    if (usedAfterToString) {
+        return false;
+    }
+
+    // The intermediate value is removed from save states, so nothing in between can deoptimize or call the code which
+    // may observe the frame
+    MarkerHolder rangeMarker {GetGraph()};
+    Marker inRange = rangeMarker.GetMarker();
+    for (auto inst = match.intermediateValue->GetNext(); inst != nullptr; inst = inst->GetNext()) {
+        inst->SetMarker(inRange);
+        if (inst == match.toStringCall) {
+            break;
+        }
+        if (inst->IsSaveState() || inst == match.instance || IsDataFlowInput(inst, match.instance)) {
+            continue;
+        }
+        if (inst->IsCall() || inst->CanDeoptimize()) {
+            return false;
+        }
+    }
+
+    // The instance is not used after its toString-call
+    bool instanceUsedOutside = HasUser(match.instance, [inRange](auto &user) {
+        auto userInst = SkipSingleUserCheckInstruction(user.GetInst());
+        return !userInst->IsSaveState() && !userInst->IsMarked(inRange);
+    });
+    if (instanceUsedOutside) {
+        return false;
+    }
+
+    // The intermediate value is used only by the append-call and the save states in between
+    return !HasUser(match.intermediateValue, [&match, inRange](auto &user) {
+        auto userInst = SkipSingleUserCheckInstruction(user.GetInst());
+        return userInst != match.appendIntermediateValue && !(userInst->IsSaveState() && userInst->IsMarked(inRange));
+    });
+}
+
+void SimplifyStringBuilder::MergeConcatenationChain(const ConcatenationChainMatch &match)
+{
+    COMPILER_LOG(DEBUG, SIMPLIFY_SB) << "Merge StringBuilder instance (id=" << match.instance->GetId()
+                                     << ") into StringBuilder instance (id=" << match.prevInstance->GetId() << ")";
+
+    // StringBuilder append-call returns 'this' (instance)
+    auto appendIntermediateValue = match.appendIntermediateValue;
+    appendIntermediateValue->ReplaceUsers(match.instance);
+    auto appendedValue = appendIntermediateValue->GetInput(1).GetInst();
+    appendIntermediateValue->GetBasicBlock()->RemoveInst(appendIntermediateValue);
+    if (appendedValue->IsCheck() && !appendedValue->HasUsers()) {
+        appendedValue->GetBasicBlock()->RemoveInst(appendedValue);
+    }
+
+    RemoveFromSaveStateInputs(match.intermediateValue);
+    ASSERT(!match.intermediateValue->HasUsers());
+    match.intermediateValue->GetBasicBlock()->RemoveInst(match.intermediateValue);
+
+    match.ctorCall->GetBasicBlock()->RemoveInst(match.ctorCall);
+    ArenaVector<Inst *> unusedChecks {GetGraph()->GetLocalAllocator()->Adapter()};
+    for (auto &user : match.instance->GetUsers()) {
+        if (user.GetInst()->IsCheck() && !user.GetInst()->HasUsers()) {
+            unusedChecks.push_back(user.GetInst());
+        }
+    }
+    for (auto check : unusedChecks) {
+        check->GetBasicBlock()->RemoveInst(check);
+    }
+
+    // The appends and the toString-call of the instance go to the previous instance
+    match.instance->ReplaceUsers(match.prevInstance);
+    match.instance->GetBasicBlock()->RemoveInst(match.instance);
+    FixBrokenSaveStates(match.prevInstance, match.toStringCall);
+}
+
+void SimplifyStringBuilder::OptimizeConcatenationChains(BasicBlock *block)
+{
+    // Merges String Builder chains created for the repeated concatenation with a local variable, e.g.
+    //     str += a; str += b;
+    // The concatenation of the whole chain is done once, instead of copying the accumulated string at every step
+
+    ASSERT(block != nullptr);
+    ASSERT(block->GetGraph() == GetGraph());
+
+    // The merged instructions are removed from the block, so collect the constructors first
+    instructionsVector_.clear();
+    InstIter inst = block->Insts().begin();
+    while ((inst = SkipToStringBuilderDefaultConstructor(inst, block->Insts().end())) != block->Insts().end()) {
+        instructionsVector_.push_back(*inst);
+        ++inst;
+    }
+
+    for (auto ctorCall : instructionsVector_) {
+        ASSERT(ctorCall->IsStaticCall());
+        ConcatenationChainMatch match;
+        if (MatchConcatenationChain(ctorCall, match)) {
+            MergeConcatenationChain(match);
+            isApplied_ = true;
+        }
+    }
+}
+
 void SimplifyStringBuilder::ConcatenationLoopMatch::TemporaryInstructions::Clear()
 {
     intermediateValue = nullptr;
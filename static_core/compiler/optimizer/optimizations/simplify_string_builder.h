@@ -29,6 +29,7 @@ namespace ark::compiler {
  * 1. Removes unnecessary String Builder instances
  * 2. Replaces String Builder usage with string concatenation whenever optimal
  * 3. Optimizes String Builder concatenation loops
+ * 4. Merges String Builder chains created for the repeated concatenation with a local variable
  *
  * See compiler/docs/simplify_sb_doc.md for complete documentation
  */
@@ -243,6 +244,36 @@ private:
 
     void OptimizeStringConcatenation(Loop *loop);
 
+    // 4. Merges String Builder chains created for the repeated concatenation with a local variable
+    struct ConcatenationChainMatch {
+        /*
+            This structure reflects the following pattern within a basic block:
+
+                let prevInstance = new StringBuilder();
+                prevInstance.append(str);
+                prevInstance.append(a);
+                let intermediateValue = prevInstance.toString();
+                let instance = new StringBuilder();                 // ctorCall
+                instance.append(intermediateValue);                 // appendIntermediateValue
+                instance.append(b);
+                    ... Zero or more append calls
+                str = instance.toString();                          // toStringCall
+
+            The appends of the instance are moved to the previous instance, so the intermediate value is not built.
+        */
+        Inst *prevInstance {nullptr};             // NOLINT(misc-non-private-member-variables-in-classes)
+        Inst *intermediateValue {nullptr};        // NOLINT(misc-non-private-member-variables-in-classes)
+        Inst *instance {nullptr};                 // NOLINT(misc-non-private-member-variables-in-classes)
+        Inst *ctorCall {nullptr};                 // NOLINT(misc-non-private-member-variables-in-classes)
+        Inst *appendIntermediateValue {nullptr};  // NOLINT(misc-non-private-member-variables-in-classes)
+        Inst *toStringCall {nullptr};             // NOLINT(misc-non-private-member-variables-in-classes)
+    };
+
+    bool MatchConcatenationChain(Inst *ctorCall, ConcatenationChainMatch &match);
+    bool IsConcatenationChainMergeable(const ConcatenationChainMatch &match);
+    void MergeConcatenationChain(const ConcatenationChainMatch &match);
+    void OptimizeConcatenationChains(BasicBlock *block);
+
 private:
     bool isApplied_ {false};
     SaveStateBridgesBuilder ssb_ {};
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -57,6 +57,11 @@ PassManager::PassManager(Graph *graph, PassManager *parentPm)
 {
 }
 
+size_t PassManager::GetExecutionCounter() const
+{
+    return graph_->GetOutermostParentGraph()->GetPassManager()->executionNumber_;
+}
+
 #ifdef ENABLE_IR_DUMP
 static std::string ClearFileName(std::string str, std::string_view suffix)
 {
@@ -80,7 +85,7 @@ std::string PassManager::GetFileName([[maybe_unused]] const char *passName, [[ma
     os::CreateDirectories(folderName);
     constexpr auto IMM_3 = 3;
     constexpr auto IMM_4 = 4;
-    ssFilename << std::setw(IMM_3) << std::setfill('0') << executionCounter_ << "_";
+    ssFilename << std::setw(IMM_3) << std::setfill('0') << GetExecutionCounter() << "_";
     if (passName != nullptr) {
         ssFilename << "pass_" << std::setw(IMM_4) << std::setfill('0') << stats_->GetCurrentPassIndex() << "_";
     }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,7 @@
 #ifndef COMPILER_OPTIMIZER_PASS_MANAGER_H
 #define COMPILER_OPTIMIZER_PASS_MANAGER_H
 
+#include <atomic>
 #include <tuple>
 #include "compiler_options.h"
 #include "pass.h"
@@ -149,16 +150,13 @@ public:
         return checkMode_;
     }
 
-    // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-    size_t GetExecutionCounter() const
-    {
-        return executionCounter_;
-    }
+    /// Number of the compilation the graph belongs to, inlined graphs share it with the outermost one
+    size_t GetExecutionCounter() const;
 
-    // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
     void StartExecution()
     {
-        executionCounter_++;
+        // Atomic with relaxed order reason: only the uniqueness of the numbers matters
+        executionNumber_ = executionCounter_.fetch_add(1, std::memory_order_relaxed) + 1;
     }
 
 private:
@@ -167,7 +165,9 @@ private:
     const ArenaVector<Analysis *> analyses_;
 
     PassManagerStatistics *stats_ {nullptr};
-    inline static size_t executionCounter_ {0};
+    // Compilations run in several threads at once
+    inline static std::atomic<size_t> executionCounter_ {0};
+    size_t executionNumber_ {0};
 
     // Whether passes are run by checker.
     bool checkMode_ {false};
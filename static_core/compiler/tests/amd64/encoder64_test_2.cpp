@@ -14,6 +14,8 @@
  */
 
 #include "libpandabase/utils/utils.h"
+#include "compiler/compiler_options.h"
+#include "cpu_features.h"
 #include "encoder64_test.h"
 
 namespace ark::compiler {
@@ -836,6 +838,150 @@ TEST_F(Encoder64Test, JumpTestTest)
     EXPECT_TRUE((TestJumpTest<uint64_t, Condition::TST_EQ, true>(this)));
     EXPECT_TRUE((TestJumpTest<uint64_t, Condition::TST_NE, true>(this)));
 }
+
+/// Runs `test` for the code generated without and with the CPU `feature`, the latter if the host supports it
+template <typename Test>
+void RunWithCpuFeature(const std::string &feature, bool hostHasFeature, Test test)
+{
+    auto features = g_options.GetCompilerCpuFeatures();
+    g_options.SetCompilerCpuFeatures({"none"});
+    g_options.AdjustCpuFeatures(true);
+    test();
+    if (hostHasFeature) {
+        g_options.SetCompilerCpuFeatures({feature});
+        g_options.AdjustCpuFeatures(true);
+        test();
+    }
+    g_options.SetCompilerCpuFeatures(features);
+    g_options.AdjustCpuFeatures(true);
+}
+
+template <typename T, bool IS_LEADING>
+bool TestCountZeroBits(Encoder64Test *test)
+{
+    static_assert(std::is_unsigned_v<T>);
+    // Initialize
+    test->PreWork();
+
+    // First type-dependency
+    auto param = test->GetParameter(TypeInfo(T(0)), 0);
+
+    // Main test call
+    if constexpr (IS_LEADING) {
+        test->GetEncoder()->EncodeCountLeadingZeroBits(param, param);
+    } else {
+        test->GetEncoder()->EncodeCountTrailingZeroBits(param, param);
+    }
+
+    // Finalize
+    test->PostWork<T>();
+
+    // If encode unsupported - now print error
+    if (!test->GetEncoder()->GetResult()) {
+        std::cerr << "Unsupported for " << TypeName<T>() << "\n";
+        return false;
+    }
+    // Change this for enable print disasm
+    test->Dump(false);
+
+    constexpr T BITS = sizeof(T) * BITS_PER_BYTE;
+    if (!test->CallCode<T>(0, BITS)) {
+        return false;
+    }
+    // Main test loop:
+    for (uint64_t i = 0; i < ITERATION; ++i) {
+        T shift = RandomGen<uint8_t>() % BITS;
+        T value = (i % 2U == 0) ? (RandomGen<T>() >> shift) : (RandomGen<T>() << shift);
+        if (value == 0) {
+            continue;
+        }
+        T result = IS_LEADING ? Clz(value) : Ctz(value);
+        if (!test->CallCode<T>(value, result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(Encoder64Test, CountLeadingZeroBitsTest)
+{
+    RunWithCpuFeature("lzcnt", CpuFeaturesHasLzcnt(), [this]() {
+        EXPECT_TRUE((TestCountZeroBits<uint32_t, true>(this)));
+        EXPECT_TRUE((TestCountZeroBits<uint64_t, true>(this)));
+    });
+}
+
+TEST_F(Encoder64Test, CountTrailingZeroBitsTest)
+{
+    RunWithCpuFeature("bmi1", CpuFeaturesHasBmi1(), [this]() {
+        EXPECT_TRUE((TestCountZeroBits<uint32_t, false>(this)));
+        EXPECT_TRUE((TestCountZeroBits<uint64_t, false>(this)));
+    });
+}
+
+template <typename T, ShiftType SHIFT_TYPE>
+bool TestShiftByReg(Encoder64Test *test)
+{
+    // Initialize
+    test->PreWork();
+
+    // First type-dependency
+    auto param1 = test->GetParameter(TypeInfo(T(0)), 0);
+    auto param2 = test->GetParameter(TypeInfo(T(0)), 1);
+
+    // Main test call
+    if constexpr (SHIFT_TYPE == ShiftType::LSL) {
+        test->GetEncoder()->EncodeShl(param1, param1, param2);
+    } else if constexpr (SHIFT_TYPE == ShiftType::LSR) {
+        test->GetEncoder()->EncodeShr(param1, param1, param2);
+    } else {
+        test->GetEncoder()->EncodeAShr(param1, param1, param2);
+    }
+
+    // Finalize
+    test->PostWork<T>();
+
+    // If encode unsupported - now print error
+    if (!test->GetEncoder()->GetResult()) {
+        std::cerr << "Unsupported for " << TypeName<T>() << "\n";
+        return false;
+    }
+    // Change this for enable print disasm
+    test->Dump(false);
+
+    using UnsignedT = std::make_unsigned_t<T>;
+    // Main test loop:
+    for (uint64_t i = 0; i < ITERATION; ++i) {
+        T value = RandomGen<T>();
+        // The shift count is taken modulo the type size
+        T count = RandomGen<uint8_t>();
+        T shift = count % (sizeof(T) * BITS_PER_BYTE);
+        T result {0};
+        if constexpr (SHIFT_TYPE == ShiftType::LSL) {
+            result = static_cast<UnsignedT>(value) << shift;
+        } else if constexpr (SHIFT_TYPE == ShiftType::LSR) {
+            result = static_cast<UnsignedT>(value) >> shift;
+        } else {
+            result = value >> shift;  // NOLINT(hicpp-signed-bitwise)
+        }
+        if (!test->CallCode<T>(value, count, result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST_F(Encoder64Test, ShiftByRegTest)
+{
+    RunWithCpuFeature("bmi2", CpuFeaturesHasBmi2(), [this]() {
+        EXPECT_TRUE((TestShiftByReg<int32_t, ShiftType::LSL>(this)));
+        EXPECT_TRUE((TestShiftByReg<int64_t, ShiftType::LSL>(this)));
+        EXPECT_TRUE((TestShiftByReg<int32_t, ShiftType::LSR>(this)));
+        EXPECT_TRUE((TestShiftByReg<int64_t, ShiftType::LSR>(this)));
+        EXPECT_TRUE((TestShiftByReg<int32_t, ShiftType::ASR>(this)));
+        EXPECT_TRUE((TestShiftByReg<int64_t, ShiftType::ASR>(this)));
+    });
+}
 // NOLINTEND(readability-magic-numbers)
 
 }  // namespace ark::compiler
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,7 @@
 #include "aot/aot_manager.h"
 #include "aot/aot_builder/aot_builder.h"
 #include "aot/compiled_method.h"
+#include "compiler/compiler_options.h"
 #include "compiler/code_info/code_info_builder.h"
 #include "os/exec.h"
 #include "assembly-parser.h"
@@ -469,6 +470,65 @@ TEST_F(AotTest, PaocGcType)
     RunAotdump(aotFname.GetFileName());
 }
 
+TEST_F(AotTest, PaocCpuFeatures)
+{
+    if (RUNTIME_ARCH != Arch::X86_64) {
+        GTEST_SKIP();
+    }
+
+    TmpFile aotFname("./test.pn");
+    TmpFile pandaFname("test.pf");
+
+    {
+        auto source = R"(
+            .function u32 main() {
+                ldai 42
+                return
+            }
+        )";
+
+        pandasm::Parser parser;
+        auto res = parser.Parse(source);
+        ASSERT_TRUE(res);
+        ASSERT_TRUE(pandasm::AsmEmitter::Emit(pandaFname.GetFileName(), res.Value()));
+    }
+
+    {
+        // Without the option the host features are not used, so the file is loaded on any CPU
+        auto res = os::exec::Exec(GetPaocFile(), "--paoc-panda-files", pandaFname.GetFileName(), "--paoc-output",
+                                  aotFname.GetFileName(), "--gc-type=epsilon", "--paoc-use-cha=false");
+        ASSERT_TRUE(res) << "paoc failed with error: " << res.Error().ToString();
+        ASSERT_EQ(res.Value(), 0U);
+        AotManager aotManager;
+        auto added = aotManager.AddFile(aotFname.GetFileName(), nullptr,
+                                        static_cast<uint32_t>(mem::GCType::EPSILON_GC));
+        ASSERT_TRUE(added) << added.Error();
+    }
+
+    {
+        // x86-64-v3 tier
+        auto res = os::exec::Exec(GetPaocFile(), "--paoc-panda-files", pandaFname.GetFileName(), "--paoc-output",
+                                  aotFname.GetFileName(), "--gc-type=epsilon", "--paoc-use-cha=false",
+                                  "--compiler-cpu-features=sse42,popcnt,lzcnt,bmi1,bmi2,avx2");
+        ASSERT_TRUE(res) << "paoc failed with error: " << res.Error().ToString();
+        ASSERT_EQ(res.Value(), 0U);
+    }
+
+    {
+        AotManager aotManager;
+        auto res = aotManager.AddFile(aotFname.GetFileName(), nullptr, static_cast<uint32_t>(mem::GCType::EPSILON_GC));
+        // The code generator doesn't emit SSE4.2 and AVX2, so only the CPUs without the bit manipulation ones fail
+        auto archFeatures = CompilerOptions::GetArchCpuFeatures(RUNTIME_ARCH, false);
+        if ((CompilerOptions::GetHostCpuFeatures() & archFeatures) == archFeatures) {
+            ASSERT_TRUE(res) << res.Error();
+        } else {
+            ASSERT_FALSE(res);
+            ASSERT_NE(res.Error().find("AOT file requires CPU features: "), std::string::npos) << res.Error();
+        }
+    }
+    RunAotdump(aotFname.GetFileName());
+}
+
 TEST_F(AotTest, FileManagerLoadAbc)
 {
     if (RUNTIME_ARCH != Arch::X86_64) {
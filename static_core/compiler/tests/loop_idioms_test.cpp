@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -120,6 +120,206 @@ protected:
 
         return GraphComparator().Compare(initial, expected);
     }
+
+    bool CheckArrayReduction(DataType::Type type, Opcode opcode, RuntimeInterface::IntrinsicId expectedIntrinsic)
+    {
+        auto initial = CreateEmptyGraph();
+        GRAPH(initial)
+        {
+            // NOLINTBEGIN(readability-magic-numbers)
+            PARAMETER(0U, 0U).ref();
+            PARAMETER(1U, 1U).type(type);
+            CONSTANT(2U, 0U);
+            CONSTANT(3U, 1U);
+            CONSTANT(4U, 42U);
+
+            BASIC_BLOCK(2U, 3U, 4U)
+            {
+                INST(5U, Opcode::SaveState).Inputs(0U, 1U).SrcVregs({0U, 1U});
+                INST(6U, Opcode::NullCheck).ref().Inputs(0U, 5U);
+                INST(7U, Opcode::LenArray).i32().Inputs(6U);
+                INST(8U, Opcode::Compare).b().Inputs(4U, 7U).CC(CC_LT).SrcType(DataType::INT32);
+                INST(9U, Opcode::IfImm).Inputs(8U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(3U, 4U, 3U)
+            {
+                INST(10U, Opcode::Phi).i32().Inputs(2U, 15U);
+                INST(11U, Opcode::Phi).type(type).Inputs(1U, 13U);
+                INST(12U, Opcode::LoadArray).type(type).Inputs(6U, 10U);
+                INST(13U, opcode).type(type).Inputs(11U, 12U);
+                INST(15U, Opcode::Add).i32().Inputs(10U, 3U);
+                INST(16U, Opcode::Compare).b().Inputs(4U, 15U).CC(CC_LE).SrcType(DataType::INT32);
+                INST(17U, Opcode::IfImm).Inputs(16U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(4U, -1L)
+            {
+                INST(18U, Opcode::Phi).type(type).Inputs(1U, 13U);
+                INST(19U, Opcode::Return).type(type).Inputs(18U);
+            }
+            // NOLINTEND(readability-magic-numbers)
+        }
+
+        if (!initial->RunPass<LoopIdioms>()) {
+            return false;
+        }
+        initial->RunPass<Cleanup>();
+
+        auto expected = CreateEmptyGraph();
+        GRAPH(expected)
+        {
+            // NOLINTBEGIN(readability-magic-numbers)
+            PARAMETER(0U, 0U).ref();
+            PARAMETER(1U, 1U).type(type);
+            CONSTANT(2U, 0U);
+            CONSTANT(4U, 42U);
+
+            BASIC_BLOCK(2U, 3U, 4U)
+            {
+                INST(5U, Opcode::SaveState).Inputs(0U, 1U).SrcVregs({0U, 1U});
+                INST(6U, Opcode::NullCheck).ref().Inputs(0U, 5U);
+                INST(7U, Opcode::LenArray).i32().Inputs(6U);
+                INST(8U, Opcode::Compare).b().Inputs(4U, 7U).CC(CC_LT).SrcType(DataType::INT32);
+                INST(9U, Opcode::IfImm).Inputs(8U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(3U, 4U)
+            {
+                INST(20U, Opcode::Intrinsic)
+                    .type(type)
+                    .Inputs({{DataType::REFERENCE, 6U}, {type, 1U}, {DataType::INT32, 2U}, {DataType::INT32, 4U}})
+                    .IntrinsicId(expectedIntrinsic)
+                    .SetFlag(compiler::inst_flags::NO_HOIST)
+                    .SetFlag(compiler::inst_flags::NO_DCE)
+                    .SetFlag(compiler::inst_flags::NO_CSE)
+                    .SetFlag(compiler::inst_flags::BARRIER)
+                    .ClearFlag(compiler::inst_flags::REQUIRE_STATE)
+                    .ClearFlag(compiler::inst_flags::RUNTIME_CALL);
+            }
+
+            BASIC_BLOCK(4U, -1L)
+            {
+                INST(18U, Opcode::Phi).type(type).Inputs(1U, 20U);
+                INST(19U, Opcode::Return).type(type).Inputs(18U);
+            }
+            // NOLINTEND(readability-magic-numbers)
+        }
+
+        return GraphComparator().Compare(initial, expected);
+    }
+
+    bool CheckArrayMap(DataType::Type type, Opcode opcode, RuntimeInterface::IntrinsicId expectedIntrinsic)
+    {
+        auto initial = CreateEmptyGraph();
+        GRAPH(initial)
+        {
+            // NOLINTBEGIN(readability-magic-numbers)
+            PARAMETER(0U, 0U).ref();
+            PARAMETER(1U, 1U).ref();
+            PARAMETER(2U, 2U).type(type);
+            CONSTANT(3U, 0U);
+            CONSTANT(4U, 1U);
+
+            BASIC_BLOCK(2U, 3U, 4U)
+            {
+                INST(5U, Opcode::SaveState).Inputs(0U, 1U, 2U).SrcVregs({0U, 1U, 2U});
+                INST(6U, Opcode::NullCheck).ref().Inputs(0U, 5U);
+                INST(7U, Opcode::NullCheck).ref().Inputs(1U, 5U);
+                INST(8U, Opcode::LenArray).i32().Inputs(6U);
+                INST(9U, Opcode::Compare).b().Inputs(3U, 8U).CC(CC_LT).SrcType(DataType::INT32);
+                INST(10U, Opcode::IfImm).Inputs(9U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(3U, 4U, 3U)
+            {
+                INST(11U, Opcode::Phi).i32().Inputs(3U, 15U);
+                INST(12U, Opcode::LoadArray).type(type).Inputs(7U, 11U);
+                INST(13U, opcode).type(type).Inputs(12U, 2U);
+                INST(14U, Opcode::StoreArray).type(type).Inputs(6U, 11U, 13U);
+                INST(15U, Opcode::Add).i32().Inputs(11U, 4U);
+                INST(16U, Opcode::Compare).b().Inputs(8U, 15U).CC(CC_LE).SrcType(DataType::INT32);
+                INST(17U, Opcode::IfImm).Inputs(16U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(4U, -1L)
+            {
+                INST(18U, Opcode::ReturnVoid).v0id();
+            }
+            // NOLINTEND(readability-magic-numbers)
+        }
+
+        if (!initial->RunPass<LoopIdioms>()) {
+            return false;
+        }
+        initial->RunPass<Cleanup>();
+
+        auto expected = CreateEmptyGraph();
+        GRAPH(expected)
+        {
+            // NOLINTBEGIN(readability-magic-numbers)
+            PARAMETER(0U, 0U).ref();
+            PARAMETER(1U, 1U).ref();
+            PARAMETER(2U, 2U).type(type);
+            CONSTANT(3U, 0U);
+            CONSTANT(4U, 1U);
+            CONSTANT(19U, 6U);  // LoopIdioms::ITERATIONS_THRESHOLD
+
+            BASIC_BLOCK(2U, 5U, 4U)
+            {
+                INST(5U, Opcode::SaveState).Inputs(0U, 1U, 2U).SrcVregs({0U, 1U, 2U});
+                INST(6U, Opcode::NullCheck).ref().Inputs(0U, 5U);
+                INST(7U, Opcode::NullCheck).ref().Inputs(1U, 5U);
+                INST(8U, Opcode::LenArray).i32().Inputs(6U);
+                INST(9U, Opcode::Compare).b().Inputs(3U, 8U).CC(CC_LT).SrcType(DataType::INT32);
+                INST(10U, Opcode::IfImm).Inputs(9U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(5U, 3U, 6U)
+            {
+                INST(20U, Opcode::Sub).i32().Inputs(8U, 3U);
+                INST(21U, Opcode::Compare).b().Inputs(20U, 19U).SrcType(DataType::INT32).CC(CC_LE);
+                INST(22U, Opcode::IfImm).Inputs(21U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(3U, 4U, 3U)
+            {
+                INST(11U, Opcode::Phi).i32().Inputs(3U, 15U);
+                INST(12U, Opcode::LoadArray).type(type).Inputs(7U, 11U);
+                INST(13U, opcode).type(type).Inputs(12U, 2U);
+                INST(14U, Opcode::StoreArray).type(type).Inputs(6U, 11U, 13U);
+                INST(15U, Opcode::Add).i32().Inputs(11U, 4U);
+                INST(16U, Opcode::Compare).b().Inputs(8U, 15U).CC(CC_LE).SrcType(DataType::INT32);
+                INST(17U, Opcode::IfImm).Inputs(16U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+            }
+
+            BASIC_BLOCK(6U, 4U)
+            {
+                INST(23U, Opcode::Intrinsic)
+                    .v0id()
+                    .Inputs({{DataType::REFERENCE, 6U},
+                             {DataType::REFERENCE, 7U},
+                             {type, 2U},
+                             {DataType::INT32, 3U},
+                             {DataType::INT32, 8U}})
+                    .IntrinsicId(expectedIntrinsic)
+                    .SetFlag(compiler::inst_flags::NO_HOIST)
+                    .SetFlag(compiler::inst_flags::NO_DCE)
+                    .SetFlag(compiler::inst_flags::NO_CSE)
+                    .SetFlag(compiler::inst_flags::BARRIER)
+                    .ClearFlag(compiler::inst_flags::REQUIRE_STATE)
+                    .ClearFlag(compiler::inst_flags::RUNTIME_CALL);
+            }
+
+            BASIC_BLOCK(4U, -1L)
+            {
+                INST(18U, Opcode::ReturnVoid).v0id();
+            }
+            // NOLINTEND(readability-magic-numbers)
+        }
+
+        return GraphComparator().Compare(initial, expected);
+    }
 };
 
 TEST_F(LoopIdiomsTest, FillArray)
@@ -531,4 +731,155 @@ TEST_F(LoopIdiomsTest, MismatchingConditions)
     ASSERT_TRUE(GetGraph()->RunPass<LoopIdioms>());
 }
 
+TEST_F(LoopIdiomsTest, ReduceArray)
+{
+    if (GetGraph()->GetArch() == Arch::AARCH32) {
+        GTEST_SKIP();
+    }
+
+    EXPECT_TRUE(
+        CheckArrayReduction(DataType::INT32, Opcode::Add, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_32));
+    EXPECT_TRUE(
+        CheckArrayReduction(DataType::UINT32, Opcode::Add, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_32));
+    EXPECT_TRUE(
+        CheckArrayReduction(DataType::INT64, Opcode::Add, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_64));
+    EXPECT_TRUE(
+        CheckArrayReduction(DataType::INT32, Opcode::Xor, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_XOR_32));
+    EXPECT_TRUE(
+        CheckArrayReduction(DataType::UINT64, Opcode::Xor, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_XOR_64));
+
+    // Floating point addition is not associative, the order of the elements must be kept
+    EXPECT_FALSE(CheckArrayReduction(DataType::FLOAT64, Opcode::Add, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayReduction(DataType::FLOAT32, Opcode::Add, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayReduction(DataType::INT16, Opcode::Add, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayReduction(DataType::INT32, Opcode::Mul, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayReduction(DataType::INT32, Opcode::Sub, RuntimeInterface::IntrinsicId::COUNT));
+}
+
+TEST_F(LoopIdiomsTest, ReductionWithGuard)
+{
+    if (GetGraph()->GetArch() == Arch::AARCH32) {
+        GTEST_SKIP();
+    }
+
+    GRAPH(GetGraph())
+    {
+        // NOLINTBEGIN(readability-magic-numbers)
+        PARAMETER(0U, 0U).ref();
+        CONSTANT(1U, 0U);
+        CONSTANT(2U, 1U);
+
+        BASIC_BLOCK(2U, 3U, 4U)
+        {
+            INST(3U, Opcode::SaveState).Inputs(0U).SrcVregs({0U});
+            INST(4U, Opcode::NullCheck).ref().Inputs(0U, 3U);
+            INST(5U, Opcode::LenArray).i32().Inputs(4U);
+            INST(6U, Opcode::Compare).b().Inputs(1U, 5U).CC(CC_LT).SrcType(DataType::INT32);
+            INST(7U, Opcode::IfImm).Inputs(6U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+        }
+
+        BASIC_BLOCK(3U, 4U, 3U)
+        {
+            INST(8U, Opcode::Phi).i32().Inputs(1U, 12U);
+            INST(9U, Opcode::Phi).i32().Inputs(1U, 11U);
+            INST(10U, Opcode::LoadArray).i32().Inputs(4U, 8U);
+            INST(11U, Opcode::Add).i32().Inputs(10U, 9U);
+            INST(12U, Opcode::Add).i32().Inputs(8U, 2U);
+            INST(13U, Opcode::Compare).b().Inputs(5U, 12U).CC(CC_LE).SrcType(DataType::INT32);
+            INST(14U, Opcode::IfImm).Inputs(13U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+        }
+
+        BASIC_BLOCK(4U, -1L)
+        {
+            INST(15U, Opcode::Phi).i32().Inputs(1U, 11U);
+            INST(16U, Opcode::Return).i32().Inputs(15U);
+        }
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    ASSERT_TRUE(GetGraph()->RunPass<LoopIdioms>());
+
+    // The sum is merged from the loop, which is kept for the short arrays, and from the intrinsic
+    auto ret = &INS(16U);
+    auto phi = ret->GetInput(0U).GetInst();
+    ASSERT_EQ(phi, &INS(15U));
+    auto merge = phi->GetInput(1U).GetInst();
+    ASSERT_TRUE(merge->IsPhi());
+    ASSERT_EQ(merge->GetInputsCount(), 2U);
+    ASSERT_EQ(merge->GetInput(0U).GetInst(), &INS(11U));
+    auto intrinsic = merge->GetInput(1U).GetInst();
+    ASSERT_TRUE(intrinsic->IsIntrinsic());
+    ASSERT_EQ(intrinsic->CastToIntrinsic()->GetIntrinsicId(),
+              RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_SUM_32);
+    ASSERT_EQ(intrinsic->GetInput(0U).GetInst(), &INS(4U));
+    ASSERT_EQ(intrinsic->GetInput(1U).GetInst(), &INS(1U));
+    ASSERT_EQ(intrinsic->GetInput(2U).GetInst(), &INS(1U));
+    ASSERT_EQ(intrinsic->GetInput(3U).GetInst(), &INS(5U));
+}
+
+TEST_F(LoopIdiomsTest, ReductionUsedOutsideOfLoop)
+{
+    if (GetGraph()->GetArch() == Arch::AARCH32) {
+        GTEST_SKIP();
+    }
+
+    GRAPH(GetGraph())
+    {
+        // NOLINTBEGIN(readability-magic-numbers)
+        PARAMETER(0U, 0U).ref();
+        CONSTANT(1U, 0U);
+        CONSTANT(2U, 1U);
+
+        BASIC_BLOCK(2U, 3U, 4U)
+        {
+            INST(3U, Opcode::SaveState).Inputs(0U).SrcVregs({0U});
+            INST(4U, Opcode::NullCheck).ref().Inputs(0U, 3U);
+            INST(5U, Opcode::LenArray).i32().Inputs(4U);
+            INST(6U, Opcode::Compare).b().Inputs(1U, 5U).CC(CC_LT).SrcType(DataType::INT32);
+            INST(7U, Opcode::IfImm).Inputs(6U).Imm(0U).CC(CC_EQ).SrcType(DataType::BOOL);
+        }
+
+        BASIC_BLOCK(3U, 4U, 3U)
+        {
+            INST(8U, Opcode::Phi).i32().Inputs(1U, 12U);
+            INST(9U, Opcode::Phi).i32().Inputs(1U, 11U);
+            INST(10U, Opcode::LoadArray).i32().Inputs(4U, 8U);
+            INST(11U, Opcode::Add).i32().Inputs(10U, 9U);
+            INST(12U, Opcode::Add).i32().Inputs(8U, 2U);
+            INST(13U, Opcode::Compare).b().Inputs(5U, 12U).CC(CC_LE).SrcType(DataType::INT32);
+            INST(14U, Opcode::IfImm).Inputs(13U).Imm(0U).CC(CC_NE).SrcType(DataType::BOOL);
+        }
+
+        BASIC_BLOCK(4U, -1L)
+        {
+            // the sum without the last element is not computed by the intrinsic
+            INST(15U, Opcode::Phi).i32().Inputs(1U, 9U);
+            INST(16U, Opcode::Return).i32().Inputs(15U);
+        }
+        // NOLINTEND(readability-magic-numbers)
+    }
+
+    ASSERT_FALSE(GetGraph()->RunPass<LoopIdioms>());
+}
+
+TEST_F(LoopIdiomsTest, MapArray)
+{
+    if (GetGraph()->GetArch() == Arch::AARCH32) {
+        GTEST_SKIP();
+    }
+
+    EXPECT_TRUE(
+        CheckArrayMap(DataType::INT32, Opcode::Add, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_ADD_SCALAR_32));
+    EXPECT_TRUE(
+        CheckArrayMap(DataType::UINT32, Opcode::Mul, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_MUL_SCALAR_32));
+    EXPECT_TRUE(
+        CheckArrayMap(DataType::FLOAT64, Opcode::Add, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_ADD_SCALAR_F64));
+    EXPECT_TRUE(
+        CheckArrayMap(DataType::FLOAT64, Opcode::Mul, RuntimeInterface::IntrinsicId::LIB_CALL_ARRAY_MUL_SCALAR_F64));
+
+    EXPECT_FALSE(CheckArrayMap(DataType::INT64, Opcode::Add, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayMap(DataType::FLOAT32, Opcode::Mul, RuntimeInterface::IntrinsicId::COUNT));
+    EXPECT_FALSE(CheckArrayMap(DataType::INT32, Opcode::Sub, RuntimeInterface::IntrinsicId::COUNT));
+}
+
 }  // namespace ark::compiler
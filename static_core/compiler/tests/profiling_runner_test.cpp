@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,10 @@
 #include "unit_test.h"
 #include "panda_runner.h"
 #include "runtime/jit/profiling_data.h"
+#include "runtime/jit/profiling_loader.h"
+#include "runtime/jit/profiling_saver.h"
+
+#include <cstdio>
 
 namespace ark::test {
 class ProfilingRunnerTest : public testing::Test {};
@@ -72,6 +76,31 @@ TEST_F(ProfilingRunnerTest, BranchStatisticsCpp)
     Runtime::Destroy();
 }
 
+TEST_F(ProfilingRunnerTest, SaveAndLoadProfile)
+{
+    const std::string profileFile = "profiling_runner_test_profile.bin";
+    PandaRunner runner;
+    runner.GetRuntimeOptions().SetCompilerProfilingThreshold(1U);
+    runner.GetRuntimeOptions().SetInterpreterType("cpp");
+    auto runtime = runner.CreateRuntime();
+    runner.Run(runtime, SOURCE, std::vector<std::string> {});
+    ASSERT_TRUE(ProfilingSaver::Save(profileFile, runtime->GetClassLinker()));
+
+    auto method = runner.GetMethod("foo");
+    ProfilingLoader loader;
+    ASSERT_TRUE(loader.Load(profileFile));
+    ASSERT_NE(loader.FindMethod(*method), nullptr);
+    ASSERT_EQ(132U, loader.GetBranchTakenCounter(*method, 0x10U));
+    ASSERT_EQ(199U, loader.GetBranchNotTakenCounter(*method, 0x09U));
+    ASSERT_EQ(67U, loader.GetBranchNotTakenCounter(*method, 0x10U));
+    ASSERT_EQ(0U, loader.GetBranchTakenCounter(*method, 0x11U));
+
+    ProfilingLoader malformed;
+    ASSERT_FALSE(malformed.Load("profiling_runner_test_absent.bin"));
+    Runtime::Destroy();
+    std::remove(profileFile.c_str());
+}
+
 #ifndef PANDA_COMPILER_TARGET_AARCH32
 TEST_F(ProfilingRunnerTest, BranchStatistics)
 {
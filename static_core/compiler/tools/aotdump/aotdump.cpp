@@ -15,6 +15,7 @@
 
 #include "aot_manager.h"
 #include "aotdump_options.h"
+#include "compiler/compiler_options.h"
 #include "class_data_accessor.h"
 #include "file.h"
 #include "file-inl.h"
@@ -226,6 +227,8 @@ public:
         (*stream_) << "  env checksum: " << aotHeader->environmentChecksum << std::endl;
         (*stream_) << "  arch: " << GetArchString(static_cast<Arch>(aotHeader->arch)) << std::endl;
         (*stream_) << "  gc_type: " << mem::GCStringFromType(static_cast<mem::GCType>(aotHeader->gcType)) << std::endl;
+        (*stream_) << "  cpu_features: " << CompilerOptions::CpuFeaturesMaskToString(aotHeader->cpuFeatures)
+                   << std::endl;
         (*stream_) << "  files_count: " << aotHeader->filesCount << std::endl;
         (*stream_) << "  files_offset: " << aotHeader->filesOffset << std::endl;
         (*stream_) << "  classes_offset: " << aotHeader->classesOffset << std::endl;
@@ -267,7 +267,8 @@ private:
             arch = GetArchFromString(compiler::g_options.GetCompilerCrossArch());
             crossCompilation = arch != RUNTIME_ARCH;
         }
-        ark::compiler::g_options.AdjustCpuFeatures(crossCompilation);
+        // The AOT files are run on other CPUs, so x86-64 stays on the baseline unless the features are set, like Irtoc
+        ark::compiler::g_options.AdjustCpuFeatures(crossCompilation || arch == Arch::X86_64);
 
         if (arch == Arch::NONE) {
             LOG_PAOC(ERROR) << "Invalid --compiler-cross-arch option:" << compiler::g_options.GetCompilerCrossArch();
@@ -279,6 +280,8 @@ private:
         }
         paoc_->aotBuilder_ = paoc_->CreateAotBuilder();
         paoc_->aotBuilder_->SetArch(arch);
+        bool llvmBackend = paoc_->paocOptions_->GetPaocMode() == "llvm";
+        paoc_->aotBuilder_->SetCpuFeatures(ark::compiler::g_options.GetCpuFeaturesMask(arch, llvmBackend));
 
         // Initialize GC:
         auto runtimeLang = paoc_->runtimeOptions_->GetRuntimeType();
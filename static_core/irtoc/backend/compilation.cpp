@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -184,14 +184,16 @@ Compilation::Result Compilation::Run()
     allocator_ = std::make_unique<ArenaAllocator>(SpaceType::SPACE_TYPE_COMPILER);
     localAllocator_ = std::make_unique<ArenaAllocator>(SpaceType::SPACE_TYPE_COMPILER);
 
+    // Irtoc code is linked into the runtime, which runs on any x86-64 CPU, so the build host features are not
+    // detected for x86-64, e.g. `lzcnt` silently executes as `bsr` on the CPUs without LZCNT
     if (RUNTIME_ARCH == Arch::X86_64 && compiler::g_options.WasSetCompilerCrossArch()) {
         arch_ = GetArchFromString(compiler::g_options.GetCompilerCrossArch());
         if (arch_ == Arch::NONE) {
             LOG(FATAL, IRTOC) << "FATAL: unknown arch: " << compiler::g_options.GetCompilerCrossArch();
         }
-        compiler::g_options.AdjustCpuFeatures(arch_ != RUNTIME_ARCH);
+        compiler::g_options.AdjustCpuFeatures(arch_ != RUNTIME_ARCH || arch_ == Arch::X86_64);
     } else {
-        compiler::g_options.AdjustCpuFeatures(false);
+        compiler::g_options.AdjustCpuFeatures(RUNTIME_ARCH == Arch::X86_64);
     }
 
     LOG(INFO, IRTOC) << "Start Irtoc compilation for " << GetArchString(arch_) << "...";
@@ -352,6 +352,14 @@ LLVMAotCompiler::LLVMAotCompiler(ark::compiler::RuntimeInterface *runtime, ark::
         [this](uint32_t moduleId) { return std::make_shared<WrappedModule>(CreateModule(moduleId)); });
 }
 
+static constexpr std::array<std::pair<compiler::CpuFeature, const char *>, 5U> X86_64_LLVM_FEATURES = {{
+    {compiler::POPCNT, "+popcnt"},
+    {compiler::LZCNT, "+lzcnt"},
+    {compiler::BMI1, "+bmi"},
+    {compiler::BMI2, "+bmi2"},
+    {compiler::AVX2, "+avx2"},
+}};
+
 /* static */
 std::vector<std::string> LLVMAotCompiler::GetFeaturesForArch(Arch arch)
 {
@@ -370,6 +378,11 @@ std::vector<std::string> LLVMAotCompiler::GetFeaturesForArch(Arch arch)
             if (ark::compiler::g_options.IsCpuFeatureEnabled(compiler::SSE42)) {
                 features.emplace_back("+sse4.2");
             }
+            for (const auto &[feature, llvmFeature] : X86_64_LLVM_FEATURES) {
+                if (ark::compiler::g_options.IsCpuFeatureEnabled(feature)) {
+                    features.emplace_back(llvmFeature);
+                }
+            }
             return features;
         default:
             return {};
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -46,4 +46,34 @@ bool CpuFeaturesHasJscvt()
 #else
 #error "Unsupported target"
 #endif
+
+bool CpuFeaturesHasSse42()
+{
+    return false;
+}
+
+bool CpuFeaturesHasPopcnt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasLzcnt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasBmi1()
+{
+    return false;
+}
+
+bool CpuFeaturesHasBmi2()
+{
+    return false;
+}
+
+bool CpuFeaturesHasAvx2()
+{
+    return false;
+}
 }  // namespace ark::compiler
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_features.h"
+
+#include <cstdint>
+
+#if defined(__GNUC__) || defined(__clang__)
+#include <cpuid.h>
+#endif
+
+namespace ark::compiler {
+#if defined(__GNUC__) || defined(__clang__)
+namespace {
+// CPUID.01H:ECX
+constexpr uint32_t SSE42_BIT = 20U;
+constexpr uint32_t POPCNT_BIT = 23U;
+constexpr uint32_t OSXSAVE_BIT = 27U;
+constexpr uint32_t AVX_BIT = 28U;
+// CPUID.(EAX=07H,ECX=0):EBX
+constexpr uint32_t BMI1_BIT = 3U;
+constexpr uint32_t AVX2_BIT = 5U;
+constexpr uint32_t BMI2_BIT = 8U;
+// CPUID.80000001H:ECX
+constexpr uint32_t LZCNT_BIT = 5U;
+constexpr uint32_t EXTENDED_LEAF = 0x80000001U;
+constexpr uint32_t STRUCTURED_LEAF = 7U;
+// XCR0 bits of the SSE and AVX states, which must be saved by OS to use AVX registers
+constexpr uint32_t XCR0_AVX_STATE = 0x6U;
+
+bool HasBit(uint32_t reg, uint32_t bit)
+{
+    return ((reg >> bit) & 1U) != 0;
+}
+
+uint32_t GetCpuidEcx(uint32_t leaf)
+{
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+    if (__get_cpuid(leaf, &eax, &ebx, &ecx, &edx) == 0) {
+        return 0;
+    }
+    return ecx;
+}
+
+uint32_t GetStructuredFeaturesEbx()
+{
+    uint32_t eax = 0;
+    uint32_t ebx = 0;
+    uint32_t ecx = 0;
+    uint32_t edx = 0;
+    if (__get_cpuid_count(STRUCTURED_LEAF, 0, &eax, &ebx, &ecx, &edx) == 0) {
+        return 0;
+    }
+    return ebx;
+}
+}  // namespace
+
+bool CpuFeaturesHasCrc32()
+{
+    return false;
+}
+
+bool CpuFeaturesHasJscvt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasSse42()
+{
+    return HasBit(GetCpuidEcx(1U), SSE42_BIT);
+}
+
+bool CpuFeaturesHasPopcnt()
+{
+    return HasBit(GetCpuidEcx(1U), POPCNT_BIT);
+}
+
+bool CpuFeaturesHasLzcnt()
+{
+    return HasBit(GetCpuidEcx(EXTENDED_LEAF), LZCNT_BIT);
+}
+
+bool CpuFeaturesHasBmi1()
+{
+    return HasBit(GetStructuredFeaturesEbx(), BMI1_BIT);
+}
+
+bool CpuFeaturesHasBmi2()
+{
+    return HasBit(GetStructuredFeaturesEbx(), BMI2_BIT);
+}
+
+bool CpuFeaturesHasAvx2()
+{
+    uint32_t ecx = GetCpuidEcx(1U);
+    if (!HasBit(ecx, OSXSAVE_BIT) || !HasBit(ecx, AVX_BIT) || !HasBit(GetStructuredFeaturesEbx(), AVX2_BIT)) {
+        return false;
+    }
+    uint32_t xcr0 = 0;
+    uint32_t xcr0High = 0;
+    // NOLINTNEXTLINE(hicpp-no-assembler)
+    asm volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0));
+    return (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+}
+#else
+bool CpuFeaturesHasCrc32()
+{
+    return false;
+}
+
+bool CpuFeaturesHasJscvt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasSse42()
+{
+    return false;
+}
+
+bool CpuFeaturesHasPopcnt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasLzcnt()
+{
+    return false;
+}
+
+bool CpuFeaturesHasBmi1()
+{
+    return false;
+}
+
+bool CpuFeaturesHasBmi2()
+{
+    return false;
+}
+
+bool CpuFeaturesHasAvx2()
+{
+    return false;
+}
+#endif
+}  // namespace ark::compiler
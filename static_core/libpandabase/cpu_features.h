@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2022-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -21,6 +21,12 @@
 namespace ark::compiler {
 PANDA_PUBLIC_API bool CpuFeaturesHasCrc32();
 PANDA_PUBLIC_API bool CpuFeaturesHasJscvt();
+PANDA_PUBLIC_API bool CpuFeaturesHasSse42();
+PANDA_PUBLIC_API bool CpuFeaturesHasPopcnt();
+PANDA_PUBLIC_API bool CpuFeaturesHasLzcnt();
+PANDA_PUBLIC_API bool CpuFeaturesHasBmi1();
+PANDA_PUBLIC_API bool CpuFeaturesHasBmi2();
+PANDA_PUBLIC_API bool CpuFeaturesHasAvx2();
 }  // namespace ark::compiler
 
 namespace ark {
@@ -131,4 +131,29 @@ uint64_t BaseMemStats::GetTotalFootprint() const
     return std::accumulate(begin(allocated_), end(allocated_), 0UL) - std::accumulate(begin(freed_), end(freed_), 0UL);
 }
 
+void BaseMemStats::RecordCodeCacheReserved(size_t size)
+{
+    // Atomic with relaxed order reason: the counter is used only for statistics
+    codeCacheReserved_.fetch_add(size, std::memory_order_relaxed);
+}
+
+void BaseMemStats::RecordCodeCacheReleased(size_t size)
+{
+    // Atomic with relaxed order reason: the counter is used only for statistics
+    uint64_t oldValue = codeCacheReserved_.fetch_sub(size, std::memory_order_relaxed);
+    (void)oldValue;
+    ASSERT(oldValue >= size);
+}
+
+uint64_t BaseMemStats::GetCodeCacheReserved() const
+{
+    // Atomic with relaxed order reason: the counter is used only for statistics
+    return codeCacheReserved_.load(std::memory_order_relaxed);
+}
+
+uint64_t BaseMemStats::GetCodeCacheFragmentation() const
+{
+    return helpers::UnsignedDifferenceUint64(GetCodeCacheReserved(), GetFootprint(SpaceType::SPACE_TYPE_CODE));
+}
+
 }  // namespace ark
@@ -38,7 +38,6 @@ public:
 
     PANDA_PUBLIC_API void RecordAllocateRaw(size_t size, SpaceType typeMem);
 
-    // NOTE(aemelenko): call RecordFreeRaw when CodeAllocator supports deallocate
     // NOTE(aemelenko): call RecordFreeRaw when ArenaAllocator supports deallocate
     PANDA_PUBLIC_API void RecordFreeRaw(size_t size, SpaceType typeMem);
 
@@ -52,6 +51,13 @@ public:
     [[nodiscard]] PANDA_PUBLIC_API uint64_t GetFootprintHeap() const;
     [[nodiscard]] PANDA_PUBLIC_API uint64_t GetTotalFootprint() const;
 
+    // code cache occupancy: pages which are held by the compiled code
+    PANDA_PUBLIC_API void RecordCodeCacheReserved(size_t size);
+    PANDA_PUBLIC_API void RecordCodeCacheReleased(size_t size);
+    [[nodiscard]] PANDA_PUBLIC_API uint64_t GetCodeCacheReserved() const;
+    /// @return bytes of the reserved code cache pages which are not occupied by the code
+    [[nodiscard]] PANDA_PUBLIC_API uint64_t GetCodeCacheFragmentation() const;
+
 protected:
     PANDA_PUBLIC_API void RecordAllocate(size_t size, SpaceType typeMem);
     PANDA_PUBLIC_API void RecordMoved(size_t size, SpaceType typeMem);
@@ -60,6 +66,7 @@ protected:
 private:
     std::array<std::atomic_uint64_t, SPACE_TYPE_SIZE> allocated_ {0};
     std::array<std::atomic_uint64_t, SPACE_TYPE_SIZE> freed_ {0};
+    std::atomic_uint64_t codeCacheReserved_ {0};
 };
 
 }  // namespace ark
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -19,7 +19,9 @@
 #include "trace/trace.h"
 
 #include <securec.h>
+#include <algorithm>
 #include <cstring>
+#include <limits>
 
 namespace ark {
 
@@ -38,6 +40,10 @@ CodeAllocator::CodeAllocator(BaseMemStats *memStats)
 
 CodeAllocator::~CodeAllocator()
 {
+    for (auto &[execView, chunk] : slotChunks_) {
+        os::mem::UnmapRaw(ToVoidPtr(execView), chunk.second);
+        os::mem::UnmapRaw(chunk.first, chunk.second);
+    }
     codeRangeStart_ = nullptr;
     codeRangeEnd_ = nullptr;
 }
@@ -45,11 +51,29 @@ CodeAllocator::~CodeAllocator()
 void *CodeAllocator::AllocateCode(size_t size, const void *codeBuff)
 {
     trace::ScopedTrace scopedTrace("Allocate Code");
-    void *codePtr = arenaAllocator_.Alloc(size, PAGE_LOG_ALIGN);
-    if (UNLIKELY(codePtr == nullptr || memcpy_s(codePtr, size, codeBuff, size) != EOK)) {
-        return nullptr;
+    os::memory::LockHolder lock(lock_);
+    std::byte *codePtr = nullptr;
+    auto sizeClass = sharedPagesEnabled_ ? GetSizeClass(size) : std::nullopt;
+    if (sizeClass.has_value()) {
+        codePtr = AllocateSlot(sizeClass.value());
+        if (codePtr != nullptr) {
+            WriteToSlot(codePtr, size, codeBuff);
+        }
+    }
+    if (codePtr == nullptr) {
+        size_t pagesSize = AlignUp(std::max<size_t>(size, 1U), os::mem::GetPageSize());
+        codePtr = AllocatePages(pagesSize);
+        if (UNLIKELY(codePtr == nullptr)) {
+            return nullptr;
+        }
+        os::mem::MapRange<std::byte> memRange(codePtr, pagesSize);
+        if (UNLIKELY(!memRange.MakeReadWrite() || memcpy_s(codePtr, size, codeBuff, size) != EOK)) {
+            FreePages(codePtr, pagesSize);
+            return nullptr;
+        }
+        ProtectCode(memRange);
     }
-    ProtectCode(os::mem::MapRange<std::byte>(static_cast<std::byte *>(codePtr), size));
+    blocks_.emplace(ToUintPtr(codePtr), size);
     memStats_->RecordAllocateRaw(size, SpaceType::SPACE_TYPE_CODE);
     CodeRangeUpdate(codePtr, size);
     return codePtr;
@@ -58,13 +82,85 @@ void *CodeAllocator::AllocateCode(size_t size, const void *codeBuff)
 os::mem::MapRange<std::byte> CodeAllocator::AllocateCodeUnprotected(size_t size)
 {
     trace::ScopedTrace scopedTrace("Allocate Code");
-    void *codePtr = arenaAllocator_.Alloc(size, PAGE_LOG_ALIGN);
+    os::memory::LockHolder lock(lock_);
+    // The caller writes the code after the allocation, so the memory can't be shared with other code
+    size_t pagesSize = AlignUp(std::max<size_t>(size, 1U), os::mem::GetPageSize());
+    std::byte *codePtr = AllocatePages(pagesSize);
     if (UNLIKELY(codePtr == nullptr)) {
         return os::mem::MapRange<std::byte>(nullptr, 0);
     }
+    if (UNLIKELY(!os::mem::MapRange<std::byte>(codePtr, pagesSize).MakeReadWrite())) {
+        FreePages(codePtr, pagesSize);
+        return os::mem::MapRange<std::byte>(nullptr, 0);
+    }
+    blocks_.emplace(ToUintPtr(codePtr), size);
     memStats_->RecordAllocateRaw(size, SpaceType::SPACE_TYPE_CODE);
     CodeRangeUpdate(codePtr, size);
-    return os::mem::MapRange<std::byte>(static_cast<std::byte *>(codePtr), size);
+    return os::mem::MapRange<std::byte>(codePtr, size);
+}
+
+bool CodeAllocator::FreeCode(const void *code)
+{
+    trace::ScopedTrace scopedTrace("Free Code");
+    os::memory::LockHolder lock(lock_);
+    auto addr = ToUintPtr(code);
+    auto it = blocks_.upper_bound(addr);
+    if (it == blocks_.begin()) {
+        return false;
+    }
+    --it;
+    auto [start, size] = *it;
+    if (addr >= start + std::max<size_t>(size, 1U)) {
+        return false;
+    }
+    blocks_.erase(it);
+    usedCode_.erase(start);
+    auto page = AlignDown(start, os::mem::GetPageSize());
+    if (slotPages_.count(page) != 0) {
+        FreeSlot(reinterpret_cast<std::byte *>(page), reinterpret_cast<std::byte *>(start));
+    } else {
+        FreePages(reinterpret_cast<std::byte *>(start), AlignUp(std::max<size_t>(size, 1U), os::mem::GetPageSize()));
+    }
+    memStats_->RecordFreeRaw(size, SpaceType::SPACE_TYPE_CODE);
+    return true;
+}
+
+void CodeAllocator::RetireCode(const void *code)
+{
+    os::memory::LockHolder lock(lock_);
+    retiredCode_.push_back(code);
+}
+
+bool CodeAllocator::HasRetiredCode()
+{
+    os::memory::LockHolder lock(lock_);
+    return !retiredCode_.empty();
+}
+
+bool CodeAllocator::IsAllocatedCode(const void *code)
+{
+    os::memory::LockHolder lock(lock_);
+    return blocks_.count(ToUintPtr(code)) != 0;
+}
+
+void CodeAllocator::MarkCodeUsed(const void *code)
+{
+    os::memory::LockHolder lock(lock_);
+    if (blocks_.count(ToUintPtr(code)) != 0) {
+        usedCode_.insert(ToUintPtr(code));
+    }
+}
+
+bool CodeAllocator::IsCodeUsed(const void *code)
+{
+    os::memory::LockHolder lock(lock_);
+    return usedCode_.count(ToUintPtr(code)) != 0;
+}
+
+void CodeAllocator::ClearCodeUsage()
+{
+    os::memory::LockHolder lock(lock_);
+    usedCode_.clear();
 }
 
 /* static */
@@ -91,4 +187,182 @@ void CodeAllocator::CodeRangeUpdate(void *ptr, size_t size)
     }
 }
 
+std::byte *CodeAllocator::AllocatePages(size_t size)
+{
+    ASSERT(IsAligned(size, os::mem::GetPageSize()));
+    std::byte *mem = nullptr;
+    // First fit: the lowest addresses are reused first to keep the code cache compact
+    for (auto it = freePages_.begin(); it != freePages_.end(); ++it) {
+        auto [start, runSize] = *it;
+        if (runSize < size) {
+            continue;
+        }
+        freePages_.erase(it);
+        if (runSize > size) {
+            freePages_.emplace(start + size, runSize - size);
+        }
+        mem = reinterpret_cast<std::byte *>(start);
+        break;
+    }
+    if (mem == nullptr) {
+        mem = static_cast<std::byte *>(arenaAllocator_.Alloc(size, PAGE_LOG_ALIGN));
+        if (UNLIKELY(mem == nullptr)) {
+            return nullptr;
+        }
+    }
+    memStats_->RecordCodeCacheReserved(size);
+    return mem;
+}
+
+void CodeAllocator::FreePages(std::byte *mem, size_t size)
+{
+    ASSERT(IsAligned(ToUintPtr(mem), os::mem::GetPageSize()) && IsAligned(size, os::mem::GetPageSize()));
+    // Catch the stale calls to the released code
+    os::mem::MakeMemWithProtFlag(mem, size, os::mem::MMAP_PROT_NONE);
+    auto start = ToUintPtr(mem);
+    // The pages stay reserved for the next code, but their memory is not kept
+    os::mem::ReleasePages(start, start + size);
+    memStats_->RecordCodeCacheReleased(size);
+    auto next = freePages_.lower_bound(start);
+    if (next != freePages_.end() && next->first == start + size) {
+        size += next->second;
+        next = freePages_.erase(next);
+    }
+    if (next != freePages_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == start) {
+            prev->second += size;
+            return;
+        }
+    }
+    freePages_.emplace_hint(next, start, size);
+}
+
+std::byte *CodeAllocator::AllocateSlot(size_t sizeClass)
+{
+    size_t pageSize = os::mem::GetPageSize();
+    auto &partial = partialPages_[sizeClass];
+    uintptr_t page;
+    if (partial.empty()) {
+        auto mem = AllocateSlotPage();
+        if (UNLIKELY(mem == nullptr)) {
+            return nullptr;
+        }
+        page = ToUintPtr(mem);
+        auto &slotPage = slotPages_[page];
+        slotPage.sizeClass = sizeClass;
+        size_t slotsCount = pageSize / GetSlotSize(sizeClass);
+        ASSERT(slotsCount <= std::numeric_limits<uint16_t>::max());
+        slotPage.freeSlots.reserve(slotsCount);
+        // Slots are taken from the back, so the lowest slot is used first
+        for (size_t i = slotsCount; i > 0; --i) {
+            slotPage.freeSlots.push_back(static_cast<uint16_t>(i - 1U));
+        }
+        partial.insert(page);
+    } else {
+        page = *partial.begin();
+    }
+    auto &slotPage = slotPages_[page];
+    ASSERT(!slotPage.freeSlots.empty());
+    size_t slot = slotPage.freeSlots.back();
+    slotPage.freeSlots.pop_back();
+    slotPage.usedSlots++;
+    if (slotPage.freeSlots.empty()) {
+        partial.erase(page);
+    }
+    return reinterpret_cast<std::byte *>(page + slot * GetSlotSize(sizeClass));
+}
+
+void CodeAllocator::FreeSlot(std::byte *page, std::byte *slot)
+{
+    auto pageAddr = ToUintPtr(page);
+    auto it = slotPages_.find(pageAddr);
+    ASSERT(it != slotPages_.end());
+    auto &slotPage = it->second;
+    size_t sizeClass = slotPage.sizeClass;
+    ASSERT(IsAligned(ToUintPtr(slot) - pageAddr, GetSlotSize(sizeClass)));
+    slotPage.freeSlots.push_back(static_cast<uint16_t>((ToUintPtr(slot) - pageAddr) / GetSlotSize(sizeClass)));
+    ASSERT(slotPage.usedSlots > 0);
+    slotPage.usedSlots--;
+    if (slotPage.usedSlots != 0) {
+        partialPages_[sizeClass].insert(pageAddr);
+        return;
+    }
+    // The page is empty, so it can be reused by any size class
+    partialPages_[sizeClass].erase(pageAddr);
+    slotPages_.erase(it);
+    FreeSlotPage(page);
+}
+
+std::byte *CodeAllocator::AllocateSlotPage()
+{
+    size_t pageSize = os::mem::GetPageSize();
+    if (freeSlotPages_.empty()) {
+        size_t chunkSize = SLOT_CHUNK_PAGES * pageSize;
+        auto [execView, writeView] = os::mem::MapExecWriteViewsRaw(chunkSize);
+        if (UNLIKELY(execView == nullptr)) {
+            if (slotChunks_.empty()) {
+                // Slot pages are shared by the code which may be executed during the write, so they can't be
+                // made writable even for a moment. Without the second view every code gets its own pages.
+                LOG(DEBUG, RUNTIME) << "CodeAllocator: shared code pages are not supported, use a page per code";
+                sharedPagesEnabled_ = false;
+            }
+            return nullptr;
+        }
+        slotChunks_.emplace(ToUintPtr(execView), std::make_pair(writeView, chunkSize));
+        for (size_t offset = 0; offset < chunkSize; offset += pageSize) {
+            freeSlotPages_.insert(ToUintPtr(execView) + offset);
+        }
+    } else {
+        auto reused = *freeSlotPages_.begin();
+        os::mem::MakeMemWithProtFlag(ToVoidPtr(reused), pageSize, os::mem::MMAP_PROT_READ | os::mem::MMAP_PROT_EXEC);
+    }
+    auto page = freeSlotPages_.extract(freeSlotPages_.begin()).value();
+    memStats_->RecordCodeCacheReserved(pageSize);
+    return reinterpret_cast<std::byte *>(page);
+}
+
+void CodeAllocator::FreeSlotPage(std::byte *page)
+{
+    size_t pageSize = os::mem::GetPageSize();
+    // Catch the stale calls to the released code
+    os::mem::MakeMemWithProtFlag(page, pageSize, os::mem::MMAP_PROT_NONE);
+    // The memory is shared by the two views, so it is released through the writable one
+    auto writePage = ToUintPtr(GetWriteView(ToUintPtr(page)));
+    os::mem::ReleaseSharedPages(writePage, writePage + pageSize);
+    memStats_->RecordCodeCacheReleased(pageSize);
+    freeSlotPages_.insert(ToUintPtr(page));
+}
+
+void CodeAllocator::WriteToSlot(std::byte *dst, size_t size, const void *src)
+{
+    // Other threads may execute the code from this page, so the code is written through the writable view
+    std::byte *writeDst = GetWriteView(ToUintPtr(dst));
+    [[maybe_unused]] auto res = memcpy_s(writeDst, size, src, size);
+    ASSERT(res == EOK);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    __builtin___clear_cache(reinterpret_cast<char *>(dst), reinterpret_cast<char *>(dst + size));
+}
+
+std::byte *CodeAllocator::GetWriteView(uintptr_t execAddr)
+{
+    auto chunk = std::prev(slotChunks_.upper_bound(execAddr));
+    ASSERT(execAddr >= chunk->first && execAddr < chunk->first + chunk->second.second);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return chunk->second.first + (execAddr - chunk->first);
+}
+
+/* static */
+std::optional<size_t> CodeAllocator::GetSizeClass(size_t size)
+{
+    // Code bigger than a half of the page doesn't gain anything from sharing the page
+    size_t maxSlotSize = os::mem::GetPageSize() / 2U;
+    for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES_COUNT && GetSlotSize(sizeClass) <= maxSlotSize; ++sizeClass) {
+        if (size <= GetSlotSize(sizeClass)) {
+            return sizeClass;
+        }
+    }
+    return std::nullopt;
+}
+
 }  // namespace ark
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -20,10 +20,23 @@
 #include "os/mem.h"
 #include "os/mutex.h"
 
+#include <array>
+#include <map>
+#include <optional>
+#include <set>
+#include <vector>
+
 namespace ark {
 
 class BaseMemStats;
 
+/**
+ * Allocator for the executable code (JIT code cache).
+ * Small code buffers are packed into shared executable pages by size classes, bigger ones get their own page runs.
+ * The shared pages are never writable: they are mapped twice and the code is written through the writable view.
+ * The code can be released with FreeCode and the released pages are reused by the next allocations, their memory is
+ * given back to the OS until then.
+ */
 class CodeAllocator {
 public:
     PANDA_PUBLIC_API explicit CodeAllocator(BaseMemStats *memStats);
@@ -52,14 +65,100 @@ public:
      */
     PANDA_PUBLIC_API static void ProtectCode(os::mem::MapRange<std::byte> memRange);
 
+    /**
+     * @brief Releases the code allocated by AllocateCode or AllocateCodeUnprotected.
+     * The caller must guarantee that the code is not executed and is not referenced by any frame.
+     * @param code any address inside the allocated code
+     * @return false if @param code does not belong to the allocated code
+     */
+    PANDA_PUBLIC_API bool FreeCode(const void *code);
+
+    /**
+     * @brief Marks the code as not used by the runtime anymore.
+     * The memory is released by FreeRetiredCode once the code is not referenced by any frame.
+     */
+    PANDA_PUBLIC_API void RetireCode(const void *code);
+
+    /**
+     * @brief Releases the retired code which is not in use anymore
+     * @param isInUse predicate which returns true if the retired code is still referenced
+     * @return number of released code buffers
+     */
+    template <class IsInUse>
+    size_t FreeRetiredCode(const IsInUse &isInUse)
+    {
+        std::vector<const void *> retired;
+        {
+            os::memory::LockHolder lock(lock_);
+            retired.swap(retiredCode_);
+        }
+        size_t freed = 0;
+        std::vector<const void *> stillUsed;
+        for (auto *code : retired) {
+            if (isInUse(code)) {
+                stillUsed.push_back(code);
+            } else if (FreeCode(code)) {
+                ++freed;
+            }
+        }
+        os::memory::LockHolder lock(lock_);
+        retiredCode_.insert(retiredCode_.end(), stillUsed.begin(), stillUsed.end());
+        return freed;
+    }
+
+    /// @return true if there is retired code waiting to be released
+    PANDA_PUBLIC_API bool HasRetiredCode();
+
+    /// @return true if @param code is the start of the code allocated by AllocateCode or AllocateCodeUnprotected
+    PANDA_PUBLIC_API bool IsAllocatedCode(const void *code);
+
+    /**
+     * @brief Marks the allocated code as recently used, the mark is dropped by ClearCodeUsage or when the code is
+     * released. The runtime keeps the marked code when it evicts the cold code.
+     * @param code start of the allocated code
+     */
+    PANDA_PUBLIC_API void MarkCodeUsed(const void *code);
+
+    /// @return true if @param code was marked by MarkCodeUsed since the last ClearCodeUsage
+    PANDA_PUBLIC_API bool IsCodeUsed(const void *code);
+
+    /// Drops the marks set by MarkCodeUsed
+    PANDA_PUBLIC_API void ClearCodeUsage();
+
     /// Fast check if the given program counter belongs to JIT code
     PANDA_PUBLIC_API bool InAllocatedCodeRange(const void *pc);
 
 private:
     void CodeRangeUpdate(void *ptr, size_t size);
 
+    /* size classes machinery, all the methods require lock_ */
+    std::byte *AllocatePages(size_t size);
+    void FreePages(std::byte *mem, size_t size);
+    std::byte *AllocateSlot(size_t sizeClass);
+    void FreeSlot(std::byte *page, std::byte *slot);
+    std::byte *AllocateSlotPage();
+    void FreeSlotPage(std::byte *page);
+    void WriteToSlot(std::byte *dst, size_t size, const void *src);
+    std::byte *GetWriteView(uintptr_t execAddr);
+    static std::optional<size_t> GetSizeClass(size_t size);
+    static size_t GetSlotSize(size_t sizeClass)
+    {
+        return MIN_SLOT_SIZE << sizeClass;
+    }
+
 private:
     static const Alignment PAGE_LOG_ALIGN;
+    // Slot sizes are MIN_SLOT_SIZE * 2^i, the slot alignment is enough for any code alignment
+    static constexpr size_t MIN_SLOT_SIZE = 64U;
+    static constexpr size_t SIZE_CLASSES_COUNT = 6U;
+    // Number of the slot pages mapped at once
+    static constexpr size_t SLOT_CHUNK_PAGES = 64U;
+
+    struct SlotPage {
+        size_t sizeClass {0};
+        size_t usedSlots {0};
+        std::vector<uint16_t> freeSlots;
+    };
 
     // NOTE(dtrubenkov): Remove when some CodeCache space will be implemented, currently used for avoid memleak noise
     ArenaAllocator arenaAllocator_;
@@ -67,6 +166,25 @@ private:
     os::memory::RWLock codeRangeLock_;
     void *codeRangeStart_ {nullptr};
     void *codeRangeEnd_ {nullptr};
+
+    os::memory::Mutex lock_;
+    // start of the allocated code -> requested size
+    std::map<uintptr_t, size_t> blocks_ GUARDED_BY(lock_);
+    // page address -> page with slots of the same size class
+    std::map<uintptr_t, SlotPage> slotPages_ GUARDED_BY(lock_);
+    // pages which have at least one free slot, per size class
+    std::array<std::set<uintptr_t>, SIZE_CLASSES_COUNT> partialPages_ GUARDED_BY(lock_);
+    // start of the free page run -> size of the run, adjacent runs are merged
+    std::map<uintptr_t, size_t> freePages_ GUARDED_BY(lock_);
+    // start of the executable view of the slot pages chunk -> (start of the writable view, size of the chunk)
+    std::map<uintptr_t, std::pair<std::byte *, size_t>> slotChunks_ GUARDED_BY(lock_);
+    // slot pages which are not used by any size class, the lowest ones are reused first
+    std::set<uintptr_t> freeSlotPages_ GUARDED_BY(lock_);
+    std::vector<const void *> retiredCode_ GUARDED_BY(lock_);
+    // start of the allocated code which was marked as recently used
+    std::set<uintptr_t> usedCode_ GUARDED_BY(lock_);
+    // false if the platform can't map the memory twice, so the code pages can't be shared
+    bool sharedPagesEnabled_ GUARDED_BY(lock_) {true};
 };
 
 }  // namespace ark
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -25,4 +25,7 @@ size_t MemConfig::codeCacheSizeLimit_ = 0;
 size_t MemConfig::compilerMemorySizeLimit_ = 0;
 size_t MemConfig::framesMemorySizeLimit_ = 0;
 size_t MemConfig::nativeStacksMemorySizeLimit_ = 0;
+bool MemConfig::useHugePages_ = false;
+bool MemConfig::pretouchHeap_ = false;
+bool MemConfig::releasePagesLazily_ = false;
 }  // namespace ark::mem
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -47,12 +47,28 @@ public:
         Initialize(objectPoolSize, internalSize, compilerSize, codeSize, framesSize, stacksSize, objectPoolSize);
     }
 
+    /**
+     * Set the policies of the OS pages used by the pools, must be called before the pool manager is initialized
+     * @param useHugePages - back the object space and the big internal pools with transparent huge pages
+     * @param pretouchHeap - populate the pages of the initial heap in background
+     * @param releasePagesLazily - return the pages of the free pools to the OS lazily (MADV_FREE)
+     */
+    static void InitializePagesPolicy(bool useHugePages, bool pretouchHeap, bool releasePagesLazily)
+    {
+        useHugePages_ = useHugePages;
+        pretouchHeap_ = pretouchHeap;
+        releasePagesLazily_ = releasePagesLazily;
+    }
+
     static void Finalize()
     {
         isInitialized_ = false;
         heapSizeLimit_ = 0;
         internalMemorySizeLimit_ = 0;
         codeCacheSizeLimit_ = 0;
+        useHugePages_ = false;
+        pretouchHeap_ = false;
+        releasePagesLazily_ = false;
     }
 
     static size_t GetInitialHeapSizeLimit()
@@ -97,6 +113,21 @@ public:
         return nativeStacksMemorySizeLimit_;
     }
 
+    static bool UseHugePages()
+    {
+        return useHugePages_;
+    }
+
+    static bool IsHeapPretouchEnabled()
+    {
+        return pretouchHeap_;
+    }
+
+    static bool ReleasePagesLazily()
+    {
+        return releasePagesLazily_;
+    }
+
     MemConfig() = delete;
 
     ~MemConfig() = delete;
@@ -114,6 +145,9 @@ private:
     PANDA_PUBLIC_API static size_t framesMemorySizeLimit_;        // Max memory used for frames
     PANDA_PUBLIC_API static size_t nativeStacksMemorySizeLimit_;  // Limit for manually (i.e. not by OS means on
                                                                   // thread creation) allocated native stacks
+    PANDA_PUBLIC_API static bool useHugePages_;                   // Back the heap with transparent huge pages
+    PANDA_PUBLIC_API static bool pretouchHeap_;                   // Populate the initial heap at startup
+    PANDA_PUBLIC_API static bool releasePagesLazily_;             // Return free pages to OS with MADV_FREE
 };
 
 }  // namespace ark::mem
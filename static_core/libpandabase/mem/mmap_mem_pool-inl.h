@@ -16,6 +16,7 @@
 #ifndef LIBPANDABASE_MEM_MMAP_MEM_POOL_INLINE_H
 #define LIBPANDABASE_MEM_MMAP_MEM_POOL_INLINE_H
 
+#include <algorithm>
 #include <utility>
 #ifdef PANDA_QEMU_BUILD
 // Unfortunately, madvise on QEMU works differently, and we should zeroed pages by hand.
@@ -24,6 +25,7 @@
 #include "mmap_mem_pool.h"
 #include "mem.h"
 #include "os/mem.h"
+#include "os/thread.h"
 #include "utils/logger.h"
 #include "mem/arena-inl.h"
 #include "mem/mem_config.h"
@@ -62,8 +64,10 @@ inline Pool MmapPoolMap::PopFreePool(size_t size)
         auto newFreePoolsIter = freePools_.insert(std::pair<size_t, MmapPool *>(newPool.GetSize(), newMmapPool));
         newMmapPool->SetFreePoolsIter(newFreePoolsIter);
         newMmapPool->SetReturnedToOS(mmapPool->IsReturnedToOS());
+        newMmapPool->SetReturnedLazily(mmapPool->IsReturnedLazily());
     }
-    if (OS_ALLOC_POLICY == OSPagesAllocPolicy::ZEROED_MEMORY && !mmapPool->IsReturnedToOS()) {
+    if (OS_ALLOC_POLICY == OSPagesAllocPolicy::ZEROED_MEMORY &&
+        (!mmapPool->IsReturnedToOS() || mmapPool->IsReturnedLazily())) {
         uintptr_t poolStart = ToUintPtr(pool.GetMem());
         size_t poolSize = pool.GetSize();
         LOG_MMAP_MEM_POOL(DEBUG) << "Return pages to OS from Free Pool to get zeroed memory: start = " << pool.GetMem()
@@ -77,6 +81,7 @@ template <OSPagesPolicy OS_PAGES_POLICY>
 inline std::pair<size_t, OSPagesPolicy> MmapPoolMap::PushFreePool(Pool pool)
 {
     bool returnedToOs = OS_PAGES_POLICY == OSPagesPolicy::IMMEDIATE_RETURN;
+    bool returnedLazily = false;
     auto mmapPoolElement = poolMap_.find(pool.GetMem());
     if (UNLIKELY(mmapPoolElement == poolMap_.end())) {
         LOG_MMAP_MEM_POOL(FATAL) << "can't find mmap pool in the pool map when PushFreePool";
@@ -90,6 +95,7 @@ inline std::pair<size_t, OSPagesPolicy> MmapPoolMap::PushFreePool(Pool pool)
         unreturnedPool_ = unreturnedPool_.GetMmapPool() == prevPool ? UnreturnedToOSPool() : unreturnedPool_;
         ASSERT(ToUintPtr(prevPool->GetMem()) + prevPool->GetSize() == ToUintPtr(mmapPool->GetMem()));
         returnedToOs = returnedToOs && prevPool->IsReturnedToOS();
+        returnedLazily = returnedLazily || prevPool->IsReturnedLazily();
         freePools_.erase(prevPool->GetFreePoolsIter());
         prevPool->SetSize(prevPool->GetSize() + mmapPool->GetSize());
         delete mmapPool;
@@ -102,6 +108,7 @@ inline std::pair<size_t, OSPagesPolicy> MmapPoolMap::PushFreePool(Pool pool)
         unreturnedPool_ = unreturnedPool_.GetMmapPool() == nextPool ? UnreturnedToOSPool() : unreturnedPool_;
         ASSERT(ToUintPtr(mmapPool->GetMem()) + mmapPool->GetSize() == ToUintPtr(nextPool->GetMem()));
         returnedToOs = returnedToOs && nextPool->IsReturnedToOS();
+        returnedLazily = returnedLazily || nextPool->IsReturnedLazily();
         freePools_.erase(nextPool->GetFreePoolsIter());
         mmapPool->SetSize(nextPool->GetSize() + mmapPool->GetSize());
         delete nextPool;
@@ -111,7 +118,8 @@ inline std::pair<size_t, OSPagesPolicy> MmapPoolMap::PushFreePool(Pool pool)
         poolMap_.erase(mmapPoolElement);
         size_t size = mmapPool->GetSize();
         delete mmapPool;
-        if (returnedToOs) {
+        // The lazily returned pages may be not zeroed, so they are returned to OS again with the main pool
+        if (returnedToOs && !returnedLazily) {
             return {size, OSPagesPolicy::IMMEDIATE_RETURN};
         }
         return {size, OSPagesPolicy::NO_RETURN};
@@ -120,6 +128,7 @@ inline std::pair<size_t, OSPagesPolicy> MmapPoolMap::PushFreePool(Pool pool)
     auto res = freePools_.insert(std::pair<size_t, MmapPool *>(mmapPool->GetSize(), mmapPool));
     mmapPool->SetFreePoolsIter(res);
     mmapPool->SetReturnedToOS(returnedToOs);
+    mmapPool->SetReturnedLazily(returnedToOs && returnedLazily);
     return {0, OS_PAGES_POLICY};
 }
 
@@ -168,19 +177,24 @@ inline MmapMemPool::MmapMemPool() : MemPool("MmapMemPool"), nonObjectSpacesCurre
         LOG_MMAP_MEM_POOL(FATAL) << "The memory limits is too high. We can't allocate so much memory from the system";
     }
     ASSERT(objectSpaceSize <= PANDA_MAX_HEAP_SIZE);
+    // Object space must be aligned to PANDA_POOL_ALIGNMENT_IN_BYTES (and to the huge page size if they are used)
+    size_t alignment = GetPoolsAlignment(objectSpaceSize);
 #if defined(PANDA_USE_32_BIT_POINTER) && !defined(PANDA_TARGET_WINDOWS)
     void *mem = ark::os::mem::MapRWAnonymousInFirst4GB(ToVoidPtr(PANDA_32BITS_HEAP_START_ADDRESS), objectSpaceSize,
-                                                       // Object space must be aligned to PANDA_POOL_ALIGNMENT_IN_BYTES
-                                                       PANDA_POOL_ALIGNMENT_IN_BYTES);
+                                                       alignment);
     ASSERT((ToUintPtr(mem) < PANDA_32BITS_HEAP_END_OBJECTS_ADDRESS) || (objectSpaceSize == 0));
     ASSERT(ToUintPtr(mem) + objectSpaceSize <= PANDA_32BITS_HEAP_END_OBJECTS_ADDRESS);
 #else
-    // We should get aligned to PANDA_POOL_ALIGNMENT_IN_BYTES size
-    void *mem = ark::os::mem::MapRWAnonymousWithAlignmentRaw(objectSpaceSize, PANDA_POOL_ALIGNMENT_IN_BYTES);
+    void *mem = ark::os::mem::MapRWAnonymousWithAlignmentRaw(objectSpaceSize, alignment);
 #endif
     LOG_IF(((mem == nullptr) && (objectSpaceSize != 0)), FATAL, MEMORYPOOL)
         << "MmapMemPool: couldn't mmap " << objectSpaceSize << " bytes of memory for the system";
-    ASSERT(AlignUp(ToUintPtr(mem), PANDA_POOL_ALIGNMENT_IN_BYTES) == ToUintPtr(mem));
+    ASSERT(AlignUp(ToUintPtr(mem), alignment) == ToUintPtr(mem));
+    if (mem != nullptr && alignment == os::mem::HUGE_PAGE_SIZE) {
+        if (auto error = os::mem::AdviseHugePages(mem, objectSpaceSize)) {
+            LOG_MMAP_MEM_POOL(WARNING) << "Cannot use huge pages for the object space: " << error->ToString();
+        }
+    }
     minObjectMemoryAddr_ = ToUintPtr(mem);
     mmapedObjectMemorySize_ = objectSpaceSize;
     commonSpace_.Initialize(minObjectMemoryAddr_, objectSpaceSize);
@@ -195,6 +209,39 @@ inline MmapMemPool::MmapMemPool() : MemPool("MmapMemPool"), nonObjectSpacesCurre
         mem::MemConfig::GetNativeStacksMemorySizeLimit();
     LOG_MMAP_MEM_POOL(DEBUG) << "Successfully initialized MMapMemPool. Object memory start from addr "
                              << ToVoidPtr(minObjectMemoryAddr_) << " Preallocated size is equal to " << objectSpaceSize;
+    if (mem::MemConfig::IsHeapPretouchEnabled() && mem != nullptr) {
+        // The pools are allocated from the beginning of the object space, so the initial heap is populated
+        size_t pretouchSize = std::min<size_t>(mem::MemConfig::GetInitialHeapSizeLimit(), objectSpaceSize);
+        pretouchThread_ = std::thread(&MmapMemPool::PretouchObjectSpace, this, pretouchSize);
+    }
+}
+
+/* static */
+inline size_t MmapMemPool::GetPoolsAlignment(size_t size)
+{
+    static_assert(os::mem::HUGE_PAGE_SIZE % PANDA_POOL_ALIGNMENT_IN_BYTES == 0);
+    if (mem::MemConfig::UseHugePages() && size >= os::mem::HUGE_PAGE_SIZE) {
+        return os::mem::HUGE_PAGE_SIZE;
+    }
+    return PANDA_POOL_ALIGNMENT_IN_BYTES;
+}
+
+inline void MmapMemPool::PretouchObjectSpace(size_t size)
+{
+    ASSERT(size <= mmapedObjectMemorySize_);
+    os::thread::SetThreadName(os::thread::GetNativeHandle(), "HeapPretouch");
+    for (size_t offset = 0; offset < size; offset += PRETOUCH_MEM_SIZE) {
+        // Atomic with relaxed order reason: the flag is only checked to stop the thread earlier
+        if (stopPretouch_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        size_t chunkSize = std::min(PRETOUCH_MEM_SIZE, size - offset);
+        if (auto error = os::mem::PopulatePages(ToVoidPtr(minObjectMemoryAddr_ + offset), chunkSize)) {
+            LOG_MMAP_MEM_POOL(WARNING) << "Cannot pretouch the object space: " << error->ToString();
+            return;
+        }
+    }
+    LOG_MMAP_MEM_POOL(DEBUG) << "Pretouched " << size << " bytes of the object space";
 }
 
 inline bool MmapPoolMap::FindAndSetUnreturnedFreePool()
@@ -226,14 +273,21 @@ inline void MmapPoolMap::ReleasePagesInUnreturnedPool(size_t poolSize)
 
 inline void MmapPoolMap::ReleasePagesInFreePools()
 {
-    IterateOverFreePools([](size_t poolSize, MmapPool *pool) {
+    bool lazily = mem::MemConfig::ReleasePagesLazily();
+    IterateOverFreePools([lazily](size_t poolSize, MmapPool *pool) {
         // Iterate over non returned to OS pools:
         if (!pool->IsReturnedToOS()) {
             pool->SetReturnedToOS(true);
             auto poolStart = ToUintPtr(pool->GetMem());
             LOG_MMAP_MEM_POOL(DEBUG) << "Return pages to OS from Free Pool: start = " << pool->GetMem() << " with size "
-                                     << poolSize;
-            os::mem::ReleasePages(poolStart, poolStart + poolSize);
+                                     << poolSize << (lazily ? " lazily" : "");
+            if (lazily) {
+                // The pages stay mapped until the OS needs them, so the reused pool is not faulted in again
+                pool->SetReturnedLazily(true);
+                os::mem::ReleasePagesLazily(poolStart, poolStart + poolSize);
+            } else {
+                os::mem::ReleasePages(poolStart, poolStart + poolSize);
+            }
         }
     });
 }
@@ -255,6 +309,11 @@ inline void MmapMemPool::ClearNonObjectMmapedPools()
 
 inline MmapMemPool::~MmapMemPool()
 {
+    if (pretouchThread_.joinable()) {
+        // Atomic with relaxed order reason: the join below synchronizes with the thread
+        stopPretouch_.store(true, std::memory_order_relaxed);
+        pretouchThread_.join();
+    }
     ClearNonObjectMmapedPools();
     void *mmapedMemAddr = ToVoidPtr(minObjectMemoryAddr_);
     if (mmapedMemAddr == nullptr) {
@@ -312,9 +371,15 @@ inline void *MmapMemPool::AllocRawMemNonObjectImpl(size_t size, SpaceType spaceT
     void *mem = nullptr;
     if (LIKELY(nonObjectSpacesMaxSize_[SpaceTypeToIndex(spaceType)] >=
                nonObjectSpacesCurrentSize_[SpaceTypeToIndex(spaceType)] + size)) {
-        mem = ark::os::mem::MapRWAnonymousWithAlignmentRaw(size, PANDA_POOL_ALIGNMENT_IN_BYTES);
+        // Big internal pools hold the card tables and the mark bitmaps, which are scanned as the heap is
+        size_t alignment = spaceType == SpaceType::SPACE_TYPE_INTERNAL ? GetPoolsAlignment(size)
+                                                                         : PANDA_POOL_ALIGNMENT_IN_BYTES;
+        mem = ark::os::mem::MapRWAnonymousWithAlignmentRaw(size, alignment);
         if (mem != nullptr) {
             nonObjectSpacesCurrentSize_[SpaceTypeToIndex(spaceType)] += size;
+            if (alignment == os::mem::HUGE_PAGE_SIZE) {
+                os::mem::AdviseHugePages(mem, size);
+            }
         }
     }
     LOG_MMAP_MEM_POOL(DEBUG) << "Occupied memory for " << SpaceTypeToString(spaceType) << " - " << std::dec
@@ -22,7 +22,9 @@
 #include "libpandabase/os/mutex.h"
 #include "libpandabase/mem/space.h"
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -61,6 +63,19 @@ public:
     void SetReturnedToOS(bool value)
     {
         returnedToOs_ = value;
+        returnedLazily_ = false;
+    }
+
+    /// The pages of the pool were returned to OS with MADV_FREE, so they may be still not zeroed
+    bool IsReturnedLazily() const
+    {
+        return returnedLazily_;
+    }
+
+    void SetReturnedLazily(bool value)
+    {
+        ASSERT(!value || returnedToOs_);
+        returnedLazily_ = value;
     }
 
     void SetSize(size_t size)
@@ -93,6 +108,7 @@ public:
 private:
     Pool pool_;
     bool returnedToOs_;
+    bool returnedLazily_ {false};
     // record the iterator of the pool in the multimap
     FreePoolsIter freePoolsIter_;
 };
@@ -218,6 +234,7 @@ public:
     using InterruptFlag = std::atomic<ReleasePagesStatus>;
 
     static constexpr size_t RELEASE_MEM_SIZE = 8_MB;
+    static constexpr size_t PRETOUCH_MEM_SIZE = 8_MB;
 
     /**
      * Get min address in pool
@@ -301,6 +318,11 @@ private:
 
     MmapMemPool();
 
+    /// @return alignment of the pools of the object space and the big internal pools
+    static size_t GetPoolsAlignment(size_t size);
+    /// Populates the pages of the initial heap, runs in the pretouch thread
+    void PretouchObjectSpace(size_t size);
+
     // A super class for raw memory allocation for spaces.
     class SpaceMemory {
     public:
@@ -408,6 +430,9 @@ private:
     // AllocRawMem is called both from alloc and externally
     mutable os::memory::RecursiveMutex lock_;
 
+    std::thread pretouchThread_;
+    std::atomic<bool> stopPretouch_ {false};
+
     friend class PoolManager;
     friend class MemPool<MmapMemPool>;
     friend class MMapMemPoolTest;
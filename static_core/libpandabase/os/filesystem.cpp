@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,7 @@
 #include "os/filesystem.h"
 #include "os/file.h"
 #include "utils/logger.h"
+#include <cstdio>
 #include <sys/types.h>
 #include <sys/stat.h>
 #if defined(PANDA_TARGET_WINDOWS)
@@ -141,4 +142,20 @@ std::string NormalizePath(const std::string &path)
     return ss.str();
 }
 
+bool WriteFileAtomically(const std::string &filepath, const std::function<bool(const file::File &)> &write)
+{
+    std::string tmpFilepath = filepath + ".tmp";
+    auto file = file::Open(tmpFilepath, file::Mode::READWRITECREATE);
+    if (!file.IsValid()) {
+        return false;
+    }
+    bool written = file.ClearData() && write(file);
+    file.Close();
+    if (!written || std::rename(tmpFilepath.c_str(), filepath.c_str()) != 0) {
+        std::remove(tmpFilepath.c_str());
+        return false;
+    }
+    return true;
+}
+
 }  // namespace ark::os
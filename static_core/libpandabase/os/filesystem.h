@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,8 @@
 #define PANDA_FILESYSTEM_H
 
 #include "macros.h"
+#include "os/file.h"
+#include <functional>
 #include <string>
 
 #if defined(PANDA_TARGET_WINDOWS)
@@ -45,6 +47,14 @@ PANDA_PUBLIC_API std::string RemoveExtension(const std::string &filepath);
 
 PANDA_PUBLIC_API std::string NormalizePath(const std::string &filepath);
 
+/**
+ * Writes the file aside, to <filepath>.tmp, by the write callback and renames it to filepath. So a reader never
+ * sees a partially written file, and the processes which have mapped the old file are not affected.
+ * Returns false and removes the temporary file if it can't be written.
+ */
+PANDA_PUBLIC_API bool WriteFileAtomically(const std::string &filepath,
+                                          const std::function<bool(const file::File &)> &write);
+
 }  // namespace ark::os
 
 #endif  // PANDA_FILESYSTEM_H
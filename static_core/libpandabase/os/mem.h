@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -35,6 +35,7 @@
 #include <memory>
 #include <optional>
 #include <type_traits>
+#include <utility>
 
 namespace ark::os::mem {
 
@@ -371,6 +372,16 @@ void *MapRWAnonymousInFirst4GB(void *minMem, size_t size, size_t iterativeStep =
  */
 void *MapRWAnonymousFixedRaw(void *mem, size_t size, bool forcePoison = true);
 
+/**
+ * Map the same anonymous memory twice: the first view is readable and executable, the second one is readable and
+ * writable. The data written through the second view is visible through the first one, so the executable memory can be
+ * updated without making it writable.
+ * Both views should be unmapped with UnmapRaw.
+ * @param size - size in bytes, should be multiple of PAGE_SIZE
+ * @return pair of the executable and the writable views, {nullptr, nullptr} if the platform doesn't support it
+ */
+PANDA_PUBLIC_API std::pair<std::byte *, std::byte *> MapExecWriteViewsRaw(size_t size);
+
 /**
  * Unmap previously mapped memory.
  * Note: memory will be unpoisoned before unmapping in ASAN targets.
@@ -420,6 +431,68 @@ inline int ReleasePages([[maybe_unused]] uintptr_t pagesStart, [[maybe_unused]]
 #endif
 }
 
+/**
+ * Release pages [pages_start, pages_end] of a shared writable mapping to os together with their backing memory,
+ * so the pages read as zeroes through all the views of the memory, e.g. the ones of MapExecWriteViewsRaw.
+ * @param pages_start - address of pages beginning in the writable view, should be multiple of PAGE_SIZE
+ * @param pages_end - address of pages ending in the writable view, should be multiple of PAGE_SIZE
+ * @return
+ */
+inline int ReleaseSharedPages([[maybe_unused]] uintptr_t pagesStart, [[maybe_unused]] uintptr_t pagesEnd)
+{
+    ASSERT(pagesStart % os::mem::GetPageSize() == 0);
+    ASSERT(pagesEnd % os::mem::GetPageSize() == 0);
+    ASSERT(pagesEnd >= pagesStart);
+#if defined(PANDA_TARGET_UNIX) && defined(MADV_REMOVE)
+    return madvise(ToVoidPtr(pagesStart), pagesEnd - pagesStart, MADV_REMOVE);
+#else
+    // The shared views are not supported there
+    return 0;
+#endif
+}
+
+/**
+ * Release pages [pages_start, pages_end] to os lazily: the OS reclaims them only under memory pressure,
+ * so the pages which are reused before that are not faulted in again.
+ * Note: the content of the pages is undefined after the call, they are not guaranteed to be zeroed.
+ * Falls back to ReleasePages if the lazy release is not supported.
+ * @param pages_start - address of pages beginning, should be multiple of PAGE_SIZE
+ * @param pages_end - address of pages ending, should be multiple of PAGE_SIZE
+ * @return
+ */
+inline int ReleasePagesLazily(uintptr_t pagesStart, uintptr_t pagesEnd)
+{
+#if defined(PANDA_TARGET_UNIX) && defined(MADV_FREE)
+    ASSERT(pagesStart % os::mem::GetPageSize() == 0);
+    ASSERT(pagesEnd % os::mem::GetPageSize() == 0);
+    ASSERT(pagesEnd >= pagesStart);
+    if (madvise(ToVoidPtr(pagesStart), pagesEnd - pagesStart, MADV_FREE) == 0) {
+        return 0;
+    }
+#endif
+    return ReleasePages(pagesStart, pagesEnd);
+}
+
+/// Size of the transparent huge pages, the memory advised with AdviseHugePages should be aligned to it
+static constexpr size_t HUGE_PAGE_SIZE = 2_MB;
+
+/**
+ * Ask the OS to back the memory with transparent huge pages.
+ * @param mem - pointer to the memory, should be multiple of PAGE_SIZE
+ * @param size - size of the memory, should be multiple of PAGE_SIZE
+ * @return Error object if any error occur
+ */
+PANDA_PUBLIC_API std::optional<Error> AdviseHugePages(void *mem, size_t size);
+
+/**
+ * Populate the pages of the memory with READ | WRITE protection, i.e. fault them in without changing their content.
+ * The memory may be used by other threads at the same time.
+ * @param mem - pointer to the memory, should be multiple of PAGE_SIZE
+ * @param size - size of the memory, should be multiple of PAGE_SIZE
+ * @return Error object if any error occur or the population is not supported
+ */
+PANDA_PUBLIC_API std::optional<Error> PopulatePages(void *mem, size_t size);
+
 /**
  * Tag anonymous memory with a debug name.
  * @param mem - pointer to the memory
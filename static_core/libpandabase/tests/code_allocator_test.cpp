@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,13 @@
 #include "mem/pool_manager.h"
 #include "mem/base_mem_stats.h"
 
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "utils/logger.h"
 
@@ -68,7 +75,194 @@ TEST_F(CodeAllocatorTest, AllocateBuffTest)
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
         ASSERT_EQ(static_cast<uint8_t *>(codeBuff)[i], 0xCCU);
     }
-    ASSERT_TRUE(IsAligned(codeBuff, 4U * SIZE_1K));
+    // Small code is packed into the shared pages, slots are aligned enough for any code alignment
+    ASSERT_TRUE(IsAligned(codeBuff, 64U));
+}
+
+TEST_F(CodeAllocatorTest, SmallCodeSharesPageTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 100U> buff1 {};
+    buff1.fill(0x11U);
+    std::array<uint8_t, 100U> buff2 {};
+    buff2.fill(0x22U);
+    auto *code1 = static_cast<uint8_t *>(ca.AllocateCode(buff1.size(), buff1.data()));
+    auto *code2 = static_cast<uint8_t *>(ca.AllocateCode(buff2.size(), buff2.data()));
+    ASSERT_NE(code1, nullptr);
+    ASSERT_NE(code2, nullptr);
+    size_t pageSize = os::mem::GetPageSize();
+    ASSERT_EQ(AlignDown(ToUintPtr(code1), pageSize), AlignDown(ToUintPtr(code2), pageSize));
+    ASSERT_EQ(std::memcmp(code1, buff1.data(), buff1.size()), 0);
+    ASSERT_EQ(std::memcmp(code2, buff2.data(), buff2.size()), 0);
+    ASSERT_EQ(stats.GetFootprint(SpaceType::SPACE_TYPE_CODE), buff1.size() + buff2.size());
+    ASSERT_EQ(stats.GetCodeCacheReserved(), pageSize);
+    ASSERT_EQ(stats.GetCodeCacheFragmentation(), pageSize - buff1.size() - buff2.size());
+}
+
+TEST_F(CodeAllocatorTest, FreeCodeTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 200U> buff {};
+    buff.fill(0xCCU);
+    void *code1 = ca.AllocateCode(buff.size(), buff.data());
+    void *code2 = ca.AllocateCode(buff.size(), buff.data());
+    // Any address inside the code can be used to free it
+    ASSERT_TRUE(ca.FreeCode(ToVoidPtr(ToUintPtr(code1) + buff.size() / 2U)));
+    ASSERT_FALSE(ca.FreeCode(code1));
+    ASSERT_EQ(stats.GetFootprint(SpaceType::SPACE_TYPE_CODE), buff.size());
+    // The released slot is reused
+    void *code3 = ca.AllocateCode(buff.size(), buff.data());
+    ASSERT_EQ(code3, code1);
+    ASSERT_TRUE(ca.FreeCode(code2));
+    ASSERT_TRUE(ca.FreeCode(code3));
+    ASSERT_EQ(stats.GetFootprint(SpaceType::SPACE_TYPE_CODE), 0U);
+    ASSERT_EQ(stats.GetCodeCacheReserved(), 0U);
+}
+
+TEST_F(CodeAllocatorTest, LargeCodeReuseTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    size_t pageSize = os::mem::GetPageSize();
+    std::vector<uint8_t> buff(pageSize + 1U, 0xCCU);
+    void *code1 = ca.AllocateCode(buff.size(), buff.data());
+    void *code2 = ca.AllocateCode(buff.size(), buff.data());
+    ASSERT_TRUE(IsAligned(code1, pageSize));
+    ASSERT_TRUE(IsAligned(code2, pageSize));
+    ASSERT_EQ(stats.GetCodeCacheReserved(), 4U * pageSize);
+    ASSERT_TRUE(ca.FreeCode(code1));
+    ASSERT_TRUE(ca.FreeCode(code2));
+    ASSERT_EQ(stats.GetCodeCacheReserved(), 0U);
+    // The released pages are merged, so the bigger code fits into them
+    std::vector<uint8_t> bigBuff(3U * pageSize, 0xDDU);
+    void *code3 = ca.AllocateCode(bigBuff.size(), bigBuff.data());
+    ASSERT_EQ(code3, std::min(code1, code2));
+    ASSERT_EQ(std::memcmp(code3, bigBuff.data(), bigBuff.size()), 0);
+    ASSERT_TRUE(ca.InAllocatedCodeRange(code3));
+}
+
+#ifdef PANDA_TARGET_UNIX
+TEST_F(CodeAllocatorTest, ReleasedPagesAreZeroedTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    size_t pageSize = os::mem::GetPageSize();
+    std::vector<uint8_t> buff(2U * pageSize, 0xCCU);
+    auto *code1 = static_cast<uint8_t *>(ca.AllocateCode(buff.size(), buff.data()));
+    ASSERT_TRUE(ca.FreeCode(code1));
+    // The smaller code reuses the pages, the rest of them is not the old code anymore
+    std::vector<uint8_t> smallBuff(pageSize + 1U, 0xDDU);
+    auto *code2 = static_cast<uint8_t *>(ca.AllocateCode(smallBuff.size(), smallBuff.data()));
+    ASSERT_EQ(code2, code1);
+    ASSERT_EQ(std::memcmp(code2, smallBuff.data(), smallBuff.size()), 0);
+    for (size_t i = smallBuff.size(); i < buff.size(); i++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ASSERT_EQ(code2[i], 0U);
+    }
+}
+#endif
+
+#if defined(PANDA_TARGET_UNIX) && !defined(PANDA_TARGET_MACOS)
+// @return permissions of the mapping which contains the address, e.g. "r-xs"
+static std::string GetMappingPermissions(const void *addr)
+{
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        std::istringstream fields(line);
+        uintptr_t start = 0;
+        uintptr_t end = 0;
+        char dash = 0;
+        std::string perms;
+        fields >> std::hex >> start >> dash >> end >> perms;
+        if (ToUintPtr(addr) >= start && ToUintPtr(addr) < end) {
+            return perms;
+        }
+    }
+    return "";
+}
+
+TEST_F(CodeAllocatorTest, SharedPageIsNeverWritableTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 100U> buff1 {};
+    buff1.fill(0x11U);
+    auto *code1 = static_cast<uint8_t *>(ca.AllocateCode(buff1.size(), buff1.data()));
+    ASSERT_NE(code1, nullptr);
+    ASSERT_EQ(GetMappingPermissions(code1).substr(0, 3U), "r-x");
+    // The code is added to the page which already contains the executable code
+    std::array<uint8_t, 100U> buff2 {};
+    buff2.fill(0x22U);
+    auto *code2 = static_cast<uint8_t *>(ca.AllocateCode(buff2.size(), buff2.data()));
+    ASSERT_NE(code2, nullptr);
+    ASSERT_EQ(GetMappingPermissions(code2).substr(0, 3U), "r-x");
+    ASSERT_EQ(std::memcmp(code1, buff1.data(), buff1.size()), 0);
+    ASSERT_EQ(std::memcmp(code2, buff2.data(), buff2.size()), 0);
+}
+
+TEST_F(CodeAllocatorTest, ReleasedSlotPageIsZeroedTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 1000U> buff1 {};
+    buff1.fill(0x11U);
+    auto *code1 = static_cast<uint8_t *>(ca.AllocateCode(buff1.size(), buff1.data()));
+    ASSERT_TRUE(ca.FreeCode(code1));
+    ASSERT_EQ(stats.GetCodeCacheReserved(), 0U);
+    // The empty page is reused by another size class, its memory was given back through the shared views
+    std::array<uint8_t, 100U> buff2 {};
+    buff2.fill(0x22U);
+    auto *code2 = static_cast<uint8_t *>(ca.AllocateCode(buff2.size(), buff2.data()));
+    ASSERT_EQ(code2, code1);
+    ASSERT_EQ(std::memcmp(code2, buff2.data(), buff2.size()), 0);
+    for (size_t i = buff2.size(); i < buff1.size(); i++) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        ASSERT_EQ(code2[i], 0U);
+    }
+}
+#endif
+
+TEST_F(CodeAllocatorTest, RetiredCodeTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 16U> buff {};
+    void *code1 = ca.AllocateCode(buff.size(), buff.data());
+    void *code2 = ca.AllocateCode(buff.size(), buff.data());
+    ca.RetireCode(code1);
+    ca.RetireCode(code2);
+    ASSERT_TRUE(ca.HasRetiredCode());
+    ASSERT_EQ(ca.FreeRetiredCode([code1](const void *code) { return code == code1; }), 1U);
+    ASSERT_TRUE(ca.HasRetiredCode());
+    ASSERT_EQ(ca.FreeRetiredCode([](const void *) { return false; }), 1U);
+    ASSERT_FALSE(ca.HasRetiredCode());
+    ASSERT_EQ(stats.GetFootprint(SpaceType::SPACE_TYPE_CODE), 0U);
+}
+
+TEST_F(CodeAllocatorTest, CodeUsageTest)
+{
+    BaseMemStats stats;
+    CodeAllocator ca(&stats);
+    std::array<uint8_t, 16U> buff {};
+    void *code1 = ca.AllocateCode(buff.size(), buff.data());
+    void *code2 = ca.AllocateCode(buff.size(), buff.data());
+    ASSERT_TRUE(ca.IsAllocatedCode(code1));
+    ASSERT_FALSE(ca.IsAllocatedCode(ToVoidPtr(ToUintPtr(code1) + 1U)));
+    ca.MarkCodeUsed(code1);
+    ASSERT_TRUE(ca.IsCodeUsed(code1));
+    ASSERT_FALSE(ca.IsCodeUsed(code2));
+    ca.ClearCodeUsage();
+    ASSERT_FALSE(ca.IsCodeUsed(code1));
+    // The mark of the released code is dropped, so the next code in its place is not used
+    ca.MarkCodeUsed(code2);
+    ASSERT_TRUE(ca.FreeCode(code2));
+    ASSERT_FALSE(ca.IsAllocatedCode(code2));
+    void *code3 = ca.AllocateCode(buff.size(), buff.data());
+    ASSERT_EQ(code3, code2);
+    ASSERT_FALSE(ca.IsCodeUsed(code3));
 }
 
 // NOLINTEND(readability-magic-numbers)
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "os/filesystem.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace ark::os::test {
+
+static std::string ReadFile(const std::string &filepath)
+{
+    std::ifstream in(filepath, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+TEST(FilesystemTest, WriteFileAtomically)
+{
+    const std::string filepath = "filesystem_test_atomic.bin";
+    const std::string first = "first content";
+    const std::string second = "second";
+    auto writeString = [](const std::string &str) {
+        return [&str](const file::File &file) { return file.WriteAll(str.data(), str.size()); };
+    };
+
+    ASSERT_TRUE(WriteFileAtomically(filepath, writeString(first)));
+    ASSERT_EQ(ReadFile(filepath), first);
+    // The old content is replaced, not overwritten in place
+    ASSERT_TRUE(WriteFileAtomically(filepath, writeString(second)));
+    ASSERT_EQ(ReadFile(filepath), second);
+    ASSERT_FALSE(IsFileExists(filepath + ".tmp"));
+
+    // A failed write leaves the file as it was
+    ASSERT_FALSE(WriteFileAtomically(filepath, [](const file::File &file) {
+        file.WriteAll("partial", sizeof("partial"));
+        return false;
+    }));
+    ASSERT_EQ(ReadFile(filepath), second);
+    ASSERT_FALSE(IsFileExists(filepath + ".tmp"));
+
+    ASSERT_FALSE(WriteFileAtomically("no_such_dir/filesystem_test_atomic.bin", writeString(first)));
+    std::remove(filepath.c_str());
+}
+
+}  // namespace ark::os::test
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -46,6 +46,16 @@ protected:
         return instance_;
     }
 
+    MmapMemPool *CreateMMapMemPoolWithPagesPolicy(size_t objectPoolSize, bool useHugePages, bool pretouchHeap,
+                                                  bool releasePagesLazily)
+    {
+        ASSERT(instance_ == nullptr);
+        SetupMemConfig(objectPoolSize, 0U, 0U, 0U, 0U, 0U);
+        mem::MemConfig::InitializePagesPolicy(useHugePages, pretouchHeap, releasePagesLazily);
+        instance_ = new MmapMemPool();
+        return instance_;
+    }
+
     void ReturnedToOsTest(OSPagesPolicy firstPoolPolicy, OSPagesPolicy secondPoolPolicy, OSPagesPolicy thirdPoolPolicy,
                           bool needFourthPool, bool bigPoolRealloc)
     {
@@ -107,6 +117,67 @@ protected:
         DeleteMMapMemPool(memPool);
     }
 
+    void LazilyReturnedToOsTest()
+    {
+        static constexpr size_t MMAP_MEMORY_SIZE = 16_MB;
+        static constexpr size_t POOL_SIZE = 4_MB;
+        MmapMemPool *memPool = CreateMMapMemPoolWithPagesPolicy(MMAP_MEMORY_SIZE, false, false, true);
+        auto first = memPool->AllocPool(POOL_SIZE, SpaceType::SPACE_TYPE_OBJECT, AllocatorType::HUMONGOUS_ALLOCATOR);
+        auto second = memPool->AllocPool(POOL_SIZE, SpaceType::SPACE_TYPE_OBJECT, AllocatorType::HUMONGOUS_ALLOCATOR);
+        ASSERT_TRUE(first.GetMem() != nullptr);
+        ASSERT_TRUE(second.GetMem() != nullptr);
+        FillMemory(first.GetMem(), first.GetSize());
+        memPool->FreePool<OSPagesPolicy::NO_RETURN>(first.GetMem(), first.GetSize());
+        memPool->ReleaseFreePagesToOS();
+        // The lazily released pool may keep its content, but the zeroed pool must be cleared anyway
+        first = memPool->AllocPool<OSPagesAllocPolicy::ZEROED_MEMORY>(POOL_SIZE, SpaceType::SPACE_TYPE_OBJECT,
+                                                                     AllocatorType::HUMONGOUS_ALLOCATOR);
+        ASSERT_TRUE(first.GetMem() != nullptr);
+        ASSERT_TRUE(IsZeroMemory(first.GetMem(), first.GetSize()));
+        FillMemory(first.GetMem(), first.GetSize());
+        FillMemory(second.GetMem(), second.GetSize());
+        // The last pool is merged with the free space, which is expected to be zeroed
+        memPool->FreePool<OSPagesPolicy::NO_RETURN>(second.GetMem(), second.GetSize());
+        memPool->ReleaseFreePagesToOS();
+        memPool->FreePool<OSPagesPolicy::IMMEDIATE_RETURN>(first.GetMem(), first.GetSize());
+        auto big = memPool->AllocPool<OSPagesAllocPolicy::ZEROED_MEMORY>(MMAP_MEMORY_SIZE, SpaceType::SPACE_TYPE_OBJECT,
+                                                                        AllocatorType::HUMONGOUS_ALLOCATOR);
+        ASSERT_TRUE(big.GetMem() != nullptr);
+        ASSERT_TRUE(IsZeroMemory(big.GetMem(), big.GetSize()));
+        memPool->FreePool(big.GetMem(), big.GetSize());
+        DeleteMMapMemPool(memPool);
+    }
+
+    void HugePagesTest()
+    {
+        static constexpr size_t MMAP_MEMORY_SIZE = 16_MB;
+        MmapMemPool *memPool = CreateMMapMemPoolWithPagesPolicy(MMAP_MEMORY_SIZE, true, false, false);
+        ASSERT_EQ(memPool->GetMinObjectAddress() % os::mem::HUGE_PAGE_SIZE, 0U);
+        auto pool = memPool->AllocPool(4_MB, SpaceType::SPACE_TYPE_OBJECT, AllocatorType::HUMONGOUS_ALLOCATOR);
+        ASSERT_TRUE(pool.GetMem() != nullptr);
+        FillMemory(pool.GetMem(), pool.GetSize());
+        memPool->FreePool(pool.GetMem(), pool.GetSize());
+        DeleteMMapMemPool(memPool);
+    }
+
+    /// The pool is deleted while the pretouch thread is still populating the heap
+    void PretouchInterruptedTest()
+    {
+        static constexpr size_t MMAP_MEMORY_SIZE = 256_MB;
+        static constexpr size_t ITERATIONS = 8U;
+        for (size_t i = 0; i < ITERATIONS; i++) {
+            MmapMemPool *memPool = CreateMMapMemPoolWithPagesPolicy(MMAP_MEMORY_SIZE, false, true, false);
+            // The pool is used concurrently with the pretouch, which doesn't change the content of the pages
+            auto pool = memPool->AllocPool(4_MB, SpaceType::SPACE_TYPE_OBJECT, AllocatorType::HUMONGOUS_ALLOCATOR);
+            ASSERT_TRUE(pool.GetMem() != nullptr);
+            FillMemory(pool.GetMem(), pool.GetSize());
+            ASSERT_TRUE(IsFilledMemory(pool.GetMem(), pool.GetSize()));
+            memPool->FreePool(pool.GetMem(), pool.GetSize());
+            // The destructor stops and joins the pretouch thread before the object space is unmapped
+            DeleteMMapMemPool(memPool);
+        }
+    }
+
 private:
     void SetupMemConfig(size_t objectPoolSize, size_t internalSize, size_t compilerSize, size_t codeSize,
                         size_t framesSize, size_t stacksSize)
@@ -150,6 +221,19 @@ private:
         return true;
     }
 
+    bool IsFilledMemory(void *start, size_t size)
+    {
+        size_t itEnd = size / sizeof(uint64_t);
+        auto *pointer = static_cast<uint64_t *>(start);
+        for (size_t i = 0; i < itEnd; i++) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            if (pointer[i] != MAGIC_VALUE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     static constexpr uint64_t MAGIC_VALUE = 0xDEADBEEF;
 
     MmapMemPool *instance_;
@@ -361,4 +445,19 @@ TEST_F(MMapMemPoolTest, ReturnedToOsPlusZeroingMemoryTest)
     }
 }
 
+TEST_F(MMapMemPoolTest, LazilyReturnedToOsPlusZeroingMemoryTest)
+{
+    LazilyReturnedToOsTest();
+}
+
+TEST_F(MMapMemPoolTest, HugePagesAlignmentTest)
+{
+    HugePagesTest();
+}
+
+TEST_F(MMapMemPoolTest, PretouchInterruptedTest)
+{
+    PretouchInterruptedTest();
+}
+
 }  // namespace ark
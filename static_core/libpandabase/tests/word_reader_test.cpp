@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/word_reader.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+namespace ark::test {
+
+TEST(WordReaderTest, ReadWordsAndPaddedData)
+{
+    // 2 words, then 5 bytes of data padded to 8
+    std::array<uint32_t, 5U> words {1U, 2U, 0U, 0U, 3U};
+    std::memcpy(&words[2U], "abcde", 5U);
+    WordReader reader(reinterpret_cast<const uint8_t *>(words.data()), sizeof(words));
+
+    uint32_t value = 0;
+    ASSERT_TRUE(reader.Read(&value));
+    EXPECT_EQ(value, 1U);
+    ASSERT_TRUE(reader.Read(&value));
+    EXPECT_EQ(value, 2U);
+    const uint8_t *data = reader.ReadData(5U);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::memcmp(data, "abcde", 5U), 0);
+    EXPECT_EQ(reader.GetOffset(), 4U * sizeof(uint32_t));
+    ASSERT_TRUE(reader.Read(&value));
+    EXPECT_EQ(value, 3U);
+    EXPECT_FALSE(reader.Read(&value));
+}
+
+TEST(WordReaderTest, Truncated)
+{
+    std::array<uint32_t, 2U> words {1U, 2U};
+    WordReader reader(reinterpret_cast<const uint8_t *>(words.data()), sizeof(words) - 1U);
+
+    uint32_t value = 0;
+    ASSERT_TRUE(reader.Read(&value));
+    // The second word is cut, and neither the word nor a huge data size is read past the end
+    EXPECT_FALSE(reader.Read(&value));
+    EXPECT_EQ(reader.ReadData(std::numeric_limits<size_t>::max()), nullptr);
+    EXPECT_EQ(reader.GetOffset(), sizeof(uint32_t));
+}
+
+TEST(WordReaderTest, HasWords)
+{
+    std::array<uint32_t, 3U> words {};
+    WordReader reader(reinterpret_cast<const uint8_t *>(words.data()), sizeof(words));
+
+    EXPECT_TRUE(reader.HasWords(3U));
+    EXPECT_FALSE(reader.HasWords(4U));
+    EXPECT_FALSE(reader.HasWords(std::numeric_limits<uint32_t>::max()));
+    uint32_t value = 0;
+    ASSERT_TRUE(reader.Read(&value));
+    EXPECT_TRUE(reader.HasWords(2U));
+    EXPECT_FALSE(reader.HasWords(3U));
+}
+
+}  // namespace ark::test
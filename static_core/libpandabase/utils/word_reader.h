@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LIBPANDABASE_UTILS_WORD_READER_H_
+#define LIBPANDABASE_UTILS_WORD_READER_H_
+
+#include "macros.h"
+#include "utils/bit_utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ark {
+
+/**
+ * Reader of the files which consist of 32-bit words, with the byte data padded to the word size.
+ * The reads are bounds checked, so a truncated or corrupted file makes them fail instead of reading past the end.
+ */
+class WordReader {
+public:
+    WordReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+    ~WordReader() = default;
+
+    bool Read(uint32_t *value)
+    {
+        const uint8_t *data = ReadData(sizeof(*value));
+        if (data == nullptr) {
+            return false;
+        }
+        std::memcpy(value, data, sizeof(*value));
+        return true;
+    }
+
+    /// Checks the size of an array before allocating it, so a corrupted count can't request a huge allocation
+    bool HasWords(uint64_t count) const
+    {
+        return count <= (size_ - offset_) / sizeof(uint32_t);
+    }
+
+    /// Returns nullptr if the file is truncated
+    const uint8_t *ReadData(size_t size)
+    {
+        if (size > size_ - offset_) {
+            return nullptr;
+        }
+        size_t paddedSize = RoundUp(size, sizeof(uint32_t));
+        if (paddedSize > size_ - offset_) {
+            return nullptr;
+        }
+        const uint8_t *data = data_ + offset_;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        offset_ += paddedSize;
+        return data;
+    }
+
+    size_t GetOffset() const
+    {
+        return offset_;
+    }
+
+    NO_COPY_SEMANTIC(WordReader);
+    NO_MOVE_SEMANTIC(WordReader);
+
+private:
+    const uint8_t *data_;
+    size_t size_;
+    size_t offset_ {0};
+};
+
+}  // namespace ark
+
+#endif  // LIBPANDABASE_UTILS_WORD_READER_H_
@@ -16,9 +16,11 @@
 #include "file_writer.h"
 #include "zlib.h"
 
+#include <algorithm>
+
 namespace ark::panda_file {
 
-FileWriter::FileWriter(const std::string &fileName) : checksum_(adler32(0, nullptr, 0))
+FileWriter::FileWriter(const std::string &fileName, size_t bufferSize) : checksum_(adler32(0, nullptr, 0))
 {
 #ifdef PANDA_TARGET_WINDOWS
     constexpr char const *MODE = "wb";
@@ -27,21 +29,52 @@ FileWriter::FileWriter(const std::string &fileName) : checksum_(adler32(0, nullp
 #endif
 
     file_ = fopen(fileName.c_str(), MODE);
+    if (file_ != nullptr) {
+        // Writes to the file are done by the buffer, so the stdio buffering is useless
+        setvbuf(file_, nullptr, _IONBF, 0);
+        buffer_.resize(std::max<size_t>(bufferSize, 1U));
+    }
 }
 
 FileWriter::~FileWriter()
 {
     if (file_ != nullptr) {
+        Flush();
         fclose(file_);
     }
 }
 
-bool FileWriter::WriteByte(uint8_t data)
+void FileWriter::UpdateChecksum()
+{
+    if (countChecksum_ && bufferSize_ > checksumPos_) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        checksum_ = adler32(checksum_, buffer_.data() + checksumPos_, bufferSize_ - checksumPos_);
+    }
+    checksumPos_ = bufferSize_;
+}
+
+uint32_t FileWriter::GetChecksum() const
 {
-    return WriteBytes({data});
+    if (countChecksum_ && bufferSize_ > checksumPos_) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return adler32(checksum_, buffer_.data() + checksumPos_, bufferSize_ - checksumPos_);
+    }
+    return checksum_;
 }
 
-bool FileWriter::WriteBytes(const std::vector<uint8_t> &bytes)
+bool FileWriter::Flush()
+{
+    if (file_ == nullptr) {
+        return false;
+    }
+    UpdateChecksum();
+    size_t size = bufferSize_;
+    bufferSize_ = 0;
+    checksumPos_ = 0;
+    return fwrite(buffer_.data(), sizeof(uint8_t), size, file_) == size;
+}
+
+bool FileWriter::WriteBytes(Span<const uint8_t> bytes)
 {
     if (file_ == nullptr) {
         return false;
@@ -51,16 +84,54 @@ bool FileWriter::WriteBytes(const std::vector<uint8_t> &bytes)
         return true;
     }
 
-    if (countChecksum_) {
-        checksum_ = adler32(checksum_, bytes.data(), bytes.size());
+    if (bytes.size() > buffer_.size() - bufferSize_) {
+        if (!Flush()) {
+            return false;
+        }
+        if (bytes.size() >= buffer_.size()) {
+            // Too big for the buffer, write it directly
+            if (countChecksum_) {
+                checksum_ = adler32(checksum_, bytes.data(), bytes.size());
+            }
+            if (fwrite(bytes.data(), sizeof(uint8_t), bytes.size(), file_) != bytes.size()) {
+                return false;
+            }
+            offset_ += bytes.size();
+            return true;
+        }
     }
 
-    if (fwrite(bytes.data(), sizeof(decltype(bytes.back())), bytes.size(), file_) != bytes.size()) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (memcpy_s(buffer_.data() + bufferSize_, buffer_.size() - bufferSize_, bytes.data(), bytes.size()) != EOK) {
         return false;
     }
-
+    bufferSize_ += bytes.size();
     offset_ += bytes.size();
     return true;
 }
 
+bool FileWriter::WriteChecksum(size_t offset)
+{
+    if (!Flush()) {
+        return false;
+    }
+    if (fseek(file_, static_cast<int64_t>(offset), SEEK_SET) != 0) {
+        LOG(FATAL, RUNTIME) << "Unable to write checksum by offset: " << static_cast<int64_t>(offset);
+        UNREACHABLE();
+    }
+    static constexpr size_t BYTE_MASK = 0xff;
+    std::array<uint8_t, sizeof(checksum_)> out {};
+    uint32_t checksum = checksum_;
+    for (auto &byte : out) {
+        byte = checksum & BYTE_MASK;
+        checksum >>= std::numeric_limits<uint8_t>::digits;
+    }
+    auto res = fwrite(out.data(), sizeof(uint8_t), out.size(), file_) == out.size();
+    if (fseek(file_, 0, SEEK_END) != 0) {
+        LOG(FATAL, RUNTIME) << "Unable to write checksum by offset: " << static_cast<int64_t>(offset);
+        UNREACHABLE();
+    }
+    return res;
+}
+
 }  // namespace ark::panda_file
@@ -19,11 +19,13 @@
 #include "utils/span.h"
 #include "utils/type_helpers.h"
 #include "utils/leb128.h"
+#include "mem/mem.h"
 #include "securec.h"
 
 #include <cstdint>
 #include <cerrno>
 
+#include <array>
 #include <limits>
 #include <vector>
 
@@ -35,6 +37,17 @@ public:
 
     virtual bool WriteBytes(const std::vector<uint8_t> &bytes) = 0;
 
+    /// Writes the bytes without an intermediate container, the writers with a buffer should override it
+    virtual bool WriteBytes(Span<const uint8_t> bytes)
+    {
+        for (auto byte : bytes) {
+            if (!WriteByte(byte)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     virtual size_t GetOffset() const = 0;
 
     virtual void CountChecksum(bool /* counting */) {}
@@ -62,34 +75,31 @@ public:
         static constexpr size_t BYTE_MASK = 0xff;
         [[maybe_unused]] static constexpr size_t BYTE_WIDTH = std::numeric_limits<uint8_t>::digits;
 
+        std::array<uint8_t, sizeof(T)> out {};
         for (size_t i = 0; i < sizeof(T); i++) {
-            if (!WriteByte(data & BYTE_MASK)) {
-                return false;
-            }
+            out[i] = data & BYTE_MASK;
 
             if constexpr (sizeof(T) > sizeof(uint8_t)) {
                 data >>= BYTE_WIDTH;
             }
         }
-        return true;
+        return WriteBytes(Span<const uint8_t>(out.data(), out.size()));
     }
 
     template <class T>
     bool WriteUleb128(T v)
     {
-        size_t n = leb128::UnsignedEncodingSize(v);
-        std::vector<uint8_t> out(n);
-        leb128::EncodeUnsigned(v, out.data());
-        return WriteBytes(out);
+        std::array<uint8_t, MaxLeb128Size<T>()> out {};
+        size_t n = leb128::EncodeUnsigned(v, out.data());
+        return WriteBytes(Span<const uint8_t>(out.data(), n));
     }
 
     template <class T>
     bool WriteSleb128(T v)
     {
-        size_t n = leb128::SignedEncodingSize(v);
-        std::vector<uint8_t> out(n);
-        leb128::EncodeSigned(v, out.data());
-        return WriteBytes(out);
+        std::array<uint8_t, MaxLeb128Size<T>()> out {};
+        size_t n = leb128::EncodeSigned(v, out.data());
+        return WriteBytes(Span<const uint8_t>(out.data(), n));
     }
 
     // default methods
@@ -98,6 +108,13 @@ public:
 
     NO_COPY_SEMANTIC(Writer);
     NO_MOVE_SEMANTIC(Writer);
+
+private:
+    template <class T>
+    static constexpr size_t MaxLeb128Size()
+    {
+        return (sizeof(T) * std::numeric_limits<uint8_t>::digits + leb128::PAYLOAD_WIDTH - 1) / leb128::PAYLOAD_WIDTH;
+    }
 };
 
 class MemoryWriter : public Writer {
@@ -167,9 +184,16 @@ private:
     size_t offset_ {0};
 };
 
+/**
+ * Writes the file through a userspace buffer: the bytes are copied to the buffer and it is written to the file
+ * by large chunks. The checksum is counted over the buffered chunks as well.
+ * The buffer is flushed by WriteChecksum, Flush and the destructor.
+ */
 class FileWriter : public Writer {
 public:
-    explicit FileWriter(const std::string &fileName);
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1_MB;
+
+    explicit FileWriter(const std::string &fileName, size_t bufferSize = DEFAULT_BUFFER_SIZE);
 
     ~FileWriter() override;
 
@@ -178,36 +202,38 @@ public:
 
     void CountChecksum(bool counting) override
     {
+        UpdateChecksum();
         countChecksum_ = counting;
     }
 
-    bool WriteChecksum(size_t offset) override
+    bool WriteChecksum(size_t offset) override;
+
+    bool WriteByte(uint8_t data) override
     {
-        if (fseek(file_, static_cast<int64_t>(offset), SEEK_SET) != 0) {
-            LOG(FATAL, RUNTIME) << "Unable to write checksum by offset: " << static_cast<int64_t>(offset);
-            UNREACHABLE();
-        }
-        auto res = Write<uint32_t>(checksum_);
-        if (fseek(file_, static_cast<int64_t>(offset), SEEK_END) != 0) {
-            LOG(FATAL, RUNTIME) << "Unable to write checksum by offset: " << static_cast<int64_t>(offset);
-            UNREACHABLE();
+        if (UNLIKELY(bufferSize_ == buffer_.size()) && !Flush()) {
+            return false;
         }
-        return res;
+        buffer_[bufferSize_++] = data;
+        ++offset_;
+        return true;
     }
 
-    bool WriteByte(uint8_t data) override;
+    bool WriteBytes(const std::vector<uint8_t> &bytes) override
+    {
+        return WriteBytes(Span<const uint8_t>(bytes.data(), bytes.size()));
+    }
+
+    bool WriteBytes(Span<const uint8_t> bytes) override;
 
-    bool WriteBytes(const std::vector<uint8_t> &bytes) override;
+    /// Writes the buffered data to the file
+    bool Flush();
 
     size_t GetOffset() const override
     {
         return offset_;
     }
 
-    uint32_t GetChecksum() const
-    {
-        return checksum_;
-    }
+    uint32_t GetChecksum() const;
 
     explicit operator bool() const
     {
@@ -215,7 +241,14 @@ public:
     }
 
 private:
+    // Counts the checksum of the buffered bytes which are not counted yet
+    void UpdateChecksum();
+
     FILE *file_;
+    std::vector<uint8_t> buffer_;
+    size_t bufferSize_ {0};
+    // Position in the buffer from which the checksum is not counted yet
+    size_t checksumPos_ {0};
     size_t offset_ {0};
     uint32_t checksum_;
     bool countChecksum_ {false};
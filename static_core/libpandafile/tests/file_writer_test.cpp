@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file.h"
+#include "file_item_container.h"
+#include "file_writer.h"
+#include "modifiers.h"
+#include "os/file.h"
+
+#include "zlib.h"
+
+#include <cstdio>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ark::panda_file::test {
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+/// The writer which writes every byte by a separate fwrite, as FileWriter did before the buffering
+class UnbufferedFileWriter : public Writer {
+public:
+    explicit UnbufferedFileWriter(const std::string &fileName)
+        : file_(fopen(fileName.c_str(), "wb")), checksum_(adler32(0, nullptr, 0))
+    {
+    }
+
+    ~UnbufferedFileWriter() override
+    {
+        if (file_ != nullptr) {
+            fclose(file_);
+        }
+    }
+
+    NO_COPY_SEMANTIC(UnbufferedFileWriter);
+    NO_MOVE_SEMANTIC(UnbufferedFileWriter);
+
+    void CountChecksum(bool counting) override
+    {
+        countChecksum_ = counting;
+    }
+
+    bool WriteChecksum(size_t offset) override
+    {
+        if (fseek(file_, static_cast<int64_t>(offset), SEEK_SET) != 0) {
+            return false;
+        }
+        auto res = Write<uint32_t>(checksum_);
+        return fseek(file_, 0, SEEK_END) == 0 && res;
+    }
+
+    bool WriteByte(uint8_t data) override
+    {
+        return WriteBytes(std::vector<uint8_t> {data});
+    }
+
+    bool WriteBytes(const std::vector<uint8_t> &bytes) override
+    {
+        if (countChecksum_) {
+            checksum_ = adler32(checksum_, bytes.data(), bytes.size());
+        }
+        if (fwrite(bytes.data(), sizeof(uint8_t), bytes.size(), file_) != bytes.size()) {
+            return false;
+        }
+        offset_ += bytes.size();
+        return true;
+    }
+
+    size_t GetOffset() const override
+    {
+        return offset_;
+    }
+
+private:
+    FILE *file_;
+    size_t offset_ {0};
+    uint32_t checksum_;
+    bool countChecksum_ {false};
+};
+
+/// Fills the container with the classes, fields, methods and strings, the file is about 2-3 MB
+static void FillContainer(ItemContainer *container, size_t classesCount)
+{
+    auto *i32Type = container->GetOrCreatePrimitiveTypeItem(Type::TypeId::I32);
+    auto *voidType = container->GetOrCreatePrimitiveTypeItem(Type::TypeId::VOID);
+    std::vector<MethodParamItem> params;
+    params.emplace_back(i32Type);
+    auto *proto = container->GetOrCreateProtoItem(voidType, params);
+    for (size_t i = 0; i < classesCount; ++i) {
+        auto name = "Lstd/core/GeneratedClassWithAQuiteLongNameToLookLikeAStdlibOne" + std::to_string(i) + ";";
+        auto *classItem = container->GetOrCreateClassItem(name);
+        classItem->SetAccessFlags(ACC_PUBLIC);
+        for (size_t j = 0; j < 4U; ++j) {
+            auto suffix = std::to_string(i) + "_" + std::to_string(j);
+            classItem->AddField(container->GetOrCreateStringItem("field" + suffix), i32Type, ACC_PUBLIC);
+            classItem->AddMethod(container->GetOrCreateStringItem("method" + suffix), proto, ACC_PUBLIC | ACC_STATIC,
+                                 params);
+        }
+    }
+}
+
+static std::vector<uint8_t> ReadFile(const std::string &fileName)
+{
+    std::ifstream in(fileName, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+template <class WriterT>
+static std::vector<uint8_t> WriteClasses(size_t classesCount, const std::string &fileName)
+{
+    ItemContainer container;
+    FillContainer(&container, classesCount);
+    {
+        WriterT writer(fileName);
+        EXPECT_TRUE(container.Write(&writer));
+    }
+    return ReadFile(fileName);
+}
+
+TEST(FileWriterTest, SameAsMemoryWriter)
+{
+    const std::string fileName = "test_file_writer_same.abc";
+    // The small buffers check the flushes inside the writes
+    for (size_t bufferSize : std::initializer_list<size_t> {1U, 7U, 4096U, FileWriter::DEFAULT_BUFFER_SIZE}) {
+        ItemContainer fileContainer;
+        FillContainer(&fileContainer, 50U);
+        uint32_t checksum = 0;
+        {
+            FileWriter writer(fileName, bufferSize);
+            ASSERT_TRUE(fileContainer.Write(&writer));
+            checksum = writer.GetChecksum();
+        }
+
+        ItemContainer memContainer;
+        FillContainer(&memContainer, 50U);
+        MemoryWriter memWriter;
+        ASSERT_TRUE(memContainer.Write(&memWriter));
+        auto expected = memWriter.GetData();
+        // MemoryWriter doesn't write the checksum
+        constexpr size_t CHECKSUM_OFFSET = 8U;
+        constexpr size_t DATA_OFFSET = 12U;
+        ASSERT_EQ(checksum, adler32(1, expected.data() + DATA_OFFSET, expected.size() - DATA_OFFSET));
+        for (size_t i = 0; i < sizeof(uint32_t); ++i) {
+            expected[CHECKSUM_OFFSET + i] = (checksum >> (i * 8U)) & 0xffU;
+        }
+        ASSERT_EQ(ReadFile(fileName), expected) << "buffer size " << bufferSize;
+        ASSERT_NE(File::Open(fileName), nullptr);
+    }
+}
+
+TEST(FileWriterTest, LargeWrites)
+{
+    const std::string fileName = "test_file_writer_large.bin";
+    std::vector<uint8_t> small(100U, 0x11U);
+    std::vector<uint8_t> large(1000U, 0x22U);
+    {
+        FileWriter writer(fileName, 256U);
+        writer.CountChecksum(true);
+        ASSERT_TRUE(writer.WriteBytes(small));
+        ASSERT_TRUE(writer.WriteBytes(large));
+        ASSERT_TRUE(writer.WriteByte(0x33U));
+        ASSERT_EQ(writer.GetOffset(), small.size() + large.size() + 1U);
+        std::vector<uint8_t> all = small;
+        all.insert(all.end(), large.begin(), large.end());
+        all.push_back(0x33U);
+        ASSERT_EQ(writer.GetChecksum(), adler32(1, all.data(), all.size()));
+        ASSERT_TRUE(writer.Flush());
+        ASSERT_EQ(ReadFile(fileName), all);
+    }
+}
+
+TEST(FileWriterTest, WriteToInvalidFile)
+{
+    FileWriter writer("");
+    ASSERT_FALSE(static_cast<bool>(writer));
+    ASSERT_FALSE(writer.WriteByte(0));
+    ASSERT_FALSE(writer.WriteBytes(std::vector<uint8_t> {1, 2}));
+}
+
+TEST(FileWriterTest, SameAsUnbufferedWriter)
+{
+    constexpr size_t CLASSES_COUNT = 200;
+    auto unbufferedData = WriteClasses<UnbufferedFileWriter>(CLASSES_COUNT, "test_file_writer_unbuffered.abc");
+    auto bufferedData = WriteClasses<FileWriter>(CLASSES_COUNT, "test_file_writer_buffered.abc");
+    ASSERT_EQ(unbufferedData, bufferedData);
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+}  // namespace ark::panda_file::test
@@ -277,6 +277,39 @@ void *MapRWAnonymousFixedRaw(void *mem, size_t size, bool forcePoison)
     return result;
 }
 
+std::pair<std::byte *, std::byte *> MapExecWriteViewsRaw([[maybe_unused]] size_t size)
+{
+#ifdef PANDA_TARGET_MACOS
+    return {nullptr, nullptr};
+#else
+    ASSERT(size % GetPageSize() == 0);
+    int fd = memfd_create("panda-code", MFD_CLOEXEC);
+    if (fd == -1) {
+        return {nullptr, nullptr};
+    }
+    // The views keep the memory alive, the descriptor is not needed after the mapping
+    if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
+        close(fd);
+        return {nullptr, nullptr};
+    }
+    // NOLINTNEXTLINE(hicpp-signed-bitwise)
+    void *execView = mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    // NOLINTNEXTLINE(hicpp-signed-bitwise)
+    void *writeView = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (execView == MAP_FAILED || writeView == MAP_FAILED) {
+        if (execView != MAP_FAILED) {
+            munmap(execView, size);
+        }
+        if (writeView != MAP_FAILED) {
+            munmap(writeView, size);
+        }
+        return {nullptr, nullptr};
+    }
+    return {static_cast<std::byte *>(execView), static_cast<std::byte *>(writeView)};
+#endif
+}
+
 std::optional<Error> UnmapRaw(void *mem, size_t size)
 {
     ASAN_UNPOISON_MEMORY_REGION(mem, size);
@@ -320,6 +353,36 @@ std::optional<Error> TagAnonymousMemory([[maybe_unused]] const void *mem, [[mayb
     return {};
 }
 
+std::optional<Error> AdviseHugePages([[maybe_unused]] void *mem, [[maybe_unused]] size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    ASSERT(size % GetPageSize() == 0);
+    ASSERT(ToUintPtr(mem) % GetPageSize() == 0);
+    if (UNLIKELY(madvise(mem, size, MADV_HUGEPAGE) != 0)) {
+        return Error(errno);
+    }
+    return {};
+#else
+    return Error("Transparent huge pages are not supported");
+#endif  // MADV_HUGEPAGE
+}
+
+std::optional<Error> PopulatePages([[maybe_unused]] void *mem, [[maybe_unused]] size_t size)
+{
+    // MADV_POPULATE_WRITE (Linux 5.14) faults the pages in without writing to them,
+    // so the memory may be concurrently used by the allocators
+#ifdef MADV_POPULATE_WRITE
+    ASSERT(size % GetPageSize() == 0);
+    ASSERT(ToUintPtr(mem) % GetPageSize() == 0);
+    if (UNLIKELY(madvise(mem, size, MADV_POPULATE_WRITE) != 0)) {
+        return Error(errno);
+    }
+    return {};
+#else
+    return Error("Population of the pages is not supported");
+#endif  // MADV_POPULATE_WRITE
+}
+
 size_t GetNativeBytesFromMallinfo()
 {
     size_t mallinfoBytes;
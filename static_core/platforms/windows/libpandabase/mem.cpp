@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -337,6 +337,11 @@ void AlignedFree(void *mem)
     _aligned_free(mem);
 }
 
+std::pair<std::byte *, std::byte *> MapExecWriteViewsRaw([[maybe_unused]] size_t size)
+{
+    return {nullptr, nullptr};
+}
+
 std::optional<Error> UnmapRaw(void *mem, size_t size)
 {
     ASAN_UNPOISON_MEMORY_REGION(mem, size);
@@ -354,6 +359,16 @@ std::optional<Error> TagAnonymousMemory([[maybe_unused]] const void *mem, [[mayb
     return {};
 }
 
+std::optional<Error> AdviseHugePages([[maybe_unused]] void *mem, [[maybe_unused]] size_t size)
+{
+    return Error("Transparent huge pages are not supported");
+}
+
+std::optional<Error> PopulatePages([[maybe_unused]] void *mem, [[maybe_unused]] size_t size)
+{
+    return Error("Population of the pages is not supported");
+}
+
 size_t GetNativeBytesFromMallinfo()
 {
     return DEFAULT_NATIVE_BYTES_FROM_MALLINFO;
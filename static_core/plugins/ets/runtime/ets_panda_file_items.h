@@ -112,6 +112,7 @@ static constexpr std::string_view STACK_OVERFLOW_ERROR                 = "Lstd/c
 // Error classes
 static constexpr std::string_view ERROR_OPTIONS                        = "Lescompat/ErrorOptions;";
 static constexpr std::string_view RANGE_ERROR                          = "Lescompat/RangeError;";
+static constexpr std::string_view SYNTAX_ERROR                         = "Lstd/core/SyntaxError;";
 static constexpr std::string_view VERIFY_ERROR                         = "Lescompat/VerifyError;";
 
 // interop/js
@@ -28,6 +28,7 @@
 #include "plugins/ets/runtime/mem/ets_reference_processor.h"
 #include "plugins/ets/runtime/napi/ets_mangle.h"
 #include "plugins/ets/runtime/napi/ets_napi_invoke_interface.h"
+#include "plugins/ets/runtime/regexp/regexp_cache.h"
 #include "plugins/ets/runtime/types/ets_method.h"
 #include "plugins/ets/runtime/types/ets_string.h"
 #include "runtime/compiler.h"
@@ -134,7 +135,9 @@ Expected<PandaEtsVM *, PandaString> PandaEtsVM::Create(Runtime *runtime, const R
         // emulate_js
         Runtime::GetOptions().IsCoroutineJsMode(plugins::LangToRuntimeType(panda_file::SourceLang::ETS)),
         // workers_count
-        Runtime::GetOptions().GetCoroutineWorkersCount(plugins::LangToRuntimeType(panda_file::SourceLang::ETS))};
+        Runtime::GetOptions().GetCoroutineWorkersCount(plugins::LangToRuntimeType(panda_file::SourceLang::ETS)),
+        // enable_work_stealing
+        Runtime::GetOptions().IsCoroutineEnableWorkStealing(plugins::LangToRuntimeType(panda_file::SourceLang::ETS))};
     vm->coroutineManager_->Initialize(cfg, runtime, vm);
 
     return vm;
@@ -169,6 +172,7 @@ PandaEtsVM::PandaEtsVM(Runtime *runtime, const RuntimeOptions &options, mem::Mem
     compiler_ = allocator->New<Compiler>(heapManager->GetCodeAllocator(), allocator, options,
                                          heapManager->GetMemStats(), runtimeIface_);
     stringTable_ = allocator->New<StringTable>();
+    regexpCache_ = allocator->New<RegExpCache>();
     monitorPool_ = allocator->New<MonitorPool>(allocator);
     referenceProcessor_ = allocator->New<mem::ets::EtsReferenceProcessor>(mm_->GetGC());
 
@@ -194,6 +198,7 @@ PandaEtsVM::~PandaEtsVM()
     allocator->Delete(coroutineManager_);
     allocator->Delete(referenceProcessor_);
     allocator->Delete(monitorPool_);
+    allocator->Delete(regexpCache_);
     allocator->Delete(stringTable_);
     allocator->Delete(compiler_);
 
@@ -581,6 +586,7 @@ void PandaEtsVM::SweepVmRefs(const GCObjectVisitor &gcObjectVisitor)
             }
         }
     }
+    regexpCache_->SweepOwners(gcObjectVisitor);
 }
 
 void PandaEtsVM::VisitVmRoots(const GCRootVisitor &visitor)
@@ -697,6 +703,7 @@ void PandaEtsVM::UpdateVmRefs()
         std::for_each(promiseListeners_.begin(), promiseListeners_.end(),
                       [](auto &entry) { entry.UpdateRefToMovedObject(); });
     }
+    regexpCache_->UpdateOwners();
 }
 
 static mem::Reference *EtsNapiObjectToGlobalReference(ets_object globalRef)
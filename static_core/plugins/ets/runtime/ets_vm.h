@@ -62,6 +62,8 @@
 
 namespace ark::ets {
 
+class RegExpCache;
+
 class PromiseListener {
 public:
     PromiseListener() = default;
@@ -315,6 +317,11 @@ public:
         return atomicsMutex_;
     }
 
+    RegExpCache *GetRegExpCache()
+    {
+        return regexpCache_;
+    }
+
 protected:
     bool CheckEntrypointSignature(Method *entrypoint) override;
     Expected<int, Runtime::Error> InvokeEntrypointImpl(Method *entrypoint,
@@ -367,6 +374,7 @@ private:
     Rendezvous *rendezvous_ {nullptr};
     CompilerInterface *compiler_ {nullptr};
     StringTable *stringTable_ {nullptr};
+    RegExpCache *regexpCache_ {nullptr};
     MonitorPool *monitorPool_ {nullptr};
     CoroutineManager *coroutineManager_ {nullptr};
     mem::Reference *oomObjRef_ {nullptr};
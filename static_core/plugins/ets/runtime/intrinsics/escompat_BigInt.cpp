@@ -0,0 +1,590 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "intrinsics.h"
+#include "libpandabase/utils/bit_utils.h"
+#include "libpandabase/utils/math_helpers.h"
+#include "libpandabase/utils/span.h"
+#include "plugins/ets/runtime/types/ets_array.h"
+#include "plugins/ets/runtime/types/ets_string.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/mem/panda_string.h"
+
+namespace ark::ets::intrinsics {
+
+namespace {
+
+// The magnitudes of escompat.BigInt are stored in int[] as 32-bit limbs from the least significant one without the
+// leading zero limbs. The intrinsics copy them to the native memory, so the GC may move the arrays while the result
+// is allocated.
+using Limb = uint32_t;
+using DoubleLimb = uint64_t;
+using Magnitude = PandaVector<Limb>;
+using LimbSpan = Span<const Limb>;
+
+constexpr size_t LIMB_BITS = 32U;
+constexpr DoubleLimb LIMB_MASK = std::numeric_limits<Limb>::max();
+// The operands shorter than this number of limbs are multiplied with the schoolbook algorithm
+constexpr size_t KARATSUBA_THRESHOLD = 40U;
+constexpr uint32_t MAX_RADIX = 36U;
+constexpr uint32_t DECIMAL_RADIX = 10U;
+constexpr std::string_view DIGITS = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Keep in sync with BigInt.ets
+enum class BitwiseOp : int32_t { AND = 0, OR = 1, XOR = 2 };
+
+void Normalize(Magnitude *mag)
+{
+    while (!mag->empty() && mag->back() == 0) {
+        mag->pop_back();
+    }
+}
+
+LimbSpan Trim(LimbSpan mag)
+{
+    size_t size = mag.Size();
+    while (size != 0 && mag[size - 1] == 0) {
+        --size;
+    }
+    return mag.First(size);
+}
+
+Magnitude ReadMagnitude(EtsIntArray *array)
+{
+    Span<EtsInt> data(array->GetData<EtsInt>(), array->GetLength());
+    Magnitude mag(data.Size());
+    std::transform(data.begin(), data.end(), mag.begin(), [](EtsInt limb) { return static_cast<Limb>(limb); });
+    Normalize(&mag);
+    return mag;
+}
+
+EtsIntArray *CreateMagnitude(Magnitude mag)
+{
+    Normalize(&mag);
+    auto *array = EtsIntArray::Create(mag.size());
+    if (UNLIKELY(array == nullptr)) {
+        return nullptr;
+    }
+    Span<EtsInt> data(array->GetData<EtsInt>(), array->GetLength());
+    std::transform(mag.begin(), mag.end(), data.begin(), [](Limb limb) { return static_cast<EtsInt>(limb); });
+    return array;
+}
+
+int Compare(LimbSpan lhs, LimbSpan rhs)
+{
+    if (lhs.Size() != rhs.Size()) {
+        return lhs.Size() < rhs.Size() ? -1 : 1;
+    }
+    for (size_t i = lhs.Size(); i-- > 0;) {
+        if (lhs[i] != rhs[i]) {
+            return lhs[i] < rhs[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+/// acc += addend * 2^(32 * offset)
+void AddAt(Magnitude *acc, LimbSpan addend, size_t offset)
+{
+    if (acc->size() < offset + addend.Size()) {
+        acc->resize(offset + addend.Size(), 0);
+    }
+    DoubleLimb carry = 0;
+    size_t i = 0;
+    for (; i < addend.Size(); ++i) {
+        DoubleLimb sum = static_cast<DoubleLimb>((*acc)[offset + i]) + addend[i] + carry;
+        (*acc)[offset + i] = static_cast<Limb>(sum);
+        carry = sum >> LIMB_BITS;
+    }
+    for (i += offset; carry != 0 && i < acc->size(); ++i) {
+        DoubleLimb sum = static_cast<DoubleLimb>((*acc)[i]) + carry;
+        (*acc)[i] = static_cast<Limb>(sum);
+        carry = sum >> LIMB_BITS;
+    }
+    if (carry != 0) {
+        acc->push_back(static_cast<Limb>(carry));
+    }
+}
+
+/// acc -= subtrahend, acc must be not less than subtrahend
+void SubtractFrom(Magnitude *acc, LimbSpan subtrahend)
+{
+    ASSERT(Compare(Trim(LimbSpan(*acc)), Trim(subtrahend)) >= 0);
+    Limb borrow = 0;
+    for (size_t i = 0; i < acc->size() && (i < subtrahend.Size() || borrow != 0); ++i) {
+        DoubleLimb sub = static_cast<DoubleLimb>(i < subtrahend.Size() ? subtrahend[i] : 0) + borrow;
+        borrow = static_cast<DoubleLimb>((*acc)[i]) < sub ? 1U : 0U;
+        (*acc)[i] = static_cast<Limb>(static_cast<DoubleLimb>((*acc)[i]) - sub);
+    }
+    Normalize(acc);
+}
+
+Magnitude Add(LimbSpan lhs, LimbSpan rhs)
+{
+    Magnitude result(lhs.begin(), lhs.end());
+    AddAt(&result, rhs, 0);
+    return result;
+}
+
+void SchoolbookMultiply(LimbSpan lhs, LimbSpan rhs, Magnitude *result)
+{
+    ASSERT(result->size() >= lhs.Size() + rhs.Size());
+    for (size_t i = 0; i < lhs.Size(); ++i) {
+        DoubleLimb carry = 0;
+        for (size_t j = 0; j < rhs.Size(); ++j) {
+            DoubleLimb cur = static_cast<DoubleLimb>(lhs[i]) * rhs[j] + (*result)[i + j] + carry;
+            (*result)[i + j] = static_cast<Limb>(cur);
+            carry = cur >> LIMB_BITS;
+        }
+        (*result)[i + rhs.Size()] = static_cast<Limb>(carry);
+    }
+}
+
+Magnitude Multiply(LimbSpan lhs, LimbSpan rhs);
+
+/// Karatsuba multiplication of the operands of the close sizes: lhs.Size() / 2 < rhs.Size() <= lhs.Size()
+void KaratsubaMultiply(LimbSpan lhs, LimbSpan rhs, Magnitude *result)
+{
+    size_t half = (lhs.Size() + 1) / 2;
+    ASSERT(rhs.Size() > half);
+    LimbSpan lhsLow = Trim(lhs.First(half));
+    LimbSpan lhsHigh = lhs.SubSpan(half);
+    LimbSpan rhsLow = Trim(rhs.First(half));
+    LimbSpan rhsHigh = rhs.SubSpan(half);
+
+    Magnitude low = Multiply(lhsLow, rhsLow);
+    Magnitude high = Multiply(lhsHigh, rhsHigh);
+    Magnitude lhsSum = Add(lhsLow, lhsHigh);
+    Magnitude rhsSum = Add(rhsLow, rhsHigh);
+    // (lhsLow + lhsHigh) * (rhsLow + rhsHigh) - low - high = lhsLow * rhsHigh + lhsHigh * rhsLow
+    Magnitude middle = Multiply(LimbSpan(lhsSum), LimbSpan(rhsSum));
+    SubtractFrom(&middle, LimbSpan(low));
+    SubtractFrom(&middle, LimbSpan(high));
+
+    AddAt(result, LimbSpan(low), 0);
+    AddAt(result, LimbSpan(middle), half);
+    AddAt(result, LimbSpan(high), 2U * half);
+}
+
+Magnitude Multiply(LimbSpan lhs, LimbSpan rhs)
+{
+    if (lhs.Size() < rhs.Size()) {
+        std::swap(lhs, rhs);
+    }
+    if (rhs.Empty()) {
+        return {};
+    }
+    Magnitude result(lhs.Size() + rhs.Size(), 0);
+    if (rhs.Size() < KARATSUBA_THRESHOLD) {
+        SchoolbookMultiply(lhs, rhs, &result);
+    } else if (rhs.Size() <= (lhs.Size() + 1) / 2) {
+        // Too unbalanced operands for Karatsuba, multiply the chunks of lhs of the rhs size
+        for (size_t offset = 0; offset < lhs.Size(); offset += rhs.Size()) {
+            LimbSpan chunk = Trim(lhs.SubSpan(offset, std::min(rhs.Size(), lhs.Size() - offset)));
+            Magnitude product = Multiply(chunk, rhs);
+            AddAt(&result, LimbSpan(product), offset);
+        }
+    } else {
+        KaratsubaMultiply(lhs, rhs, &result);
+    }
+    Normalize(&result);
+    return result;
+}
+
+Magnitude ShiftLeft(LimbSpan mag, size_t shift)
+{
+    if (mag.Empty()) {
+        return {};
+    }
+    size_t limbShift = shift / LIMB_BITS;
+    size_t bitShift = shift % LIMB_BITS;
+    Magnitude result(mag.Size() + limbShift + 1U, 0);
+    for (size_t i = 0; i < mag.Size(); ++i) {
+        DoubleLimb shifted = static_cast<DoubleLimb>(mag[i]) << bitShift;
+        result[i + limbShift] |= static_cast<Limb>(shifted);
+        result[i + limbShift + 1U] = static_cast<Limb>(shifted >> LIMB_BITS);
+    }
+    Normalize(&result);
+    return result;
+}
+
+Magnitude ShiftRight(LimbSpan mag, size_t shift)
+{
+    size_t limbShift = shift / LIMB_BITS;
+    size_t bitShift = shift % LIMB_BITS;
+    if (limbShift >= mag.Size()) {
+        return {};
+    }
+    Magnitude result(mag.Size() - limbShift, 0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        DoubleLimb value = mag[i + limbShift];
+        if (i + limbShift + 1U < mag.Size()) {
+            value |= static_cast<DoubleLimb>(mag[i + limbShift + 1U]) << LIMB_BITS;
+        }
+        result[i] = static_cast<Limb>(value >> bitShift);
+    }
+    Normalize(&result);
+    return result;
+}
+
+/// mag = mag / divisor, @return the remainder
+Limb DivideByLimb(Magnitude *mag, Limb divisor)
+{
+    ASSERT(divisor != 0);
+    DoubleLimb remainder = 0;
+    for (size_t i = mag->size(); i-- > 0;) {
+        DoubleLimb cur = (remainder << LIMB_BITS) | (*mag)[i];
+        (*mag)[i] = static_cast<Limb>(cur / divisor);
+        remainder = cur % divisor;
+    }
+    Normalize(mag);
+    return static_cast<Limb>(remainder);
+}
+
+/// mag = mag * factor + addend
+void MultiplyAdd(Magnitude *mag, Limb factor, Limb addend)
+{
+    DoubleLimb carry = addend;
+    for (auto &limb : *mag) {
+        DoubleLimb cur = static_cast<DoubleLimb>(limb) * factor + carry;
+        limb = static_cast<Limb>(cur);
+        carry = cur >> LIMB_BITS;
+    }
+    if (carry != 0) {
+        mag->push_back(static_cast<Limb>(carry));
+    }
+}
+
+/// Subtracts qhat * divisor from the window of the dividend, @return true if the result is negative
+bool MultiplySubtract(Magnitude *dividend, size_t offset, LimbSpan divisor, DoubleLimb qhat)
+{
+    DoubleLimb carry = 0;
+    int64_t borrow = 0;
+    for (size_t i = 0; i < divisor.Size(); ++i) {
+        DoubleLimb product = qhat * divisor[i] + carry;
+        carry = product >> LIMB_BITS;
+        int64_t diff =
+            static_cast<int64_t>((*dividend)[offset + i]) - borrow - static_cast<int64_t>(product & LIMB_MASK);
+        (*dividend)[offset + i] = static_cast<Limb>(diff);
+        borrow = diff < 0 ? 1 : 0;
+    }
+    int64_t diff = static_cast<int64_t>((*dividend)[offset + divisor.Size()]) - borrow - static_cast<int64_t>(carry);
+    (*dividend)[offset + divisor.Size()] = static_cast<Limb>(diff);
+    return diff < 0;
+}
+
+void AddBack(Magnitude *dividend, size_t offset, LimbSpan divisor)
+{
+    DoubleLimb carry = 0;
+    for (size_t i = 0; i < divisor.Size(); ++i) {
+        DoubleLimb sum = static_cast<DoubleLimb>((*dividend)[offset + i]) + divisor[i] + carry;
+        (*dividend)[offset + i] = static_cast<Limb>(sum);
+        carry = sum >> LIMB_BITS;
+    }
+    (*dividend)[offset + divisor.Size()] += static_cast<Limb>(carry);
+}
+
+/// Knuth's algorithm D (The Art of Computer Programming, vol. 2, 4.3.1)
+void Divide(LimbSpan dividend, LimbSpan divisor, Magnitude *quotient, Magnitude *remainder)
+{
+    ASSERT(!divisor.Empty() && divisor[divisor.Size() - 1] != 0);
+    if (Compare(dividend, divisor) < 0) {
+        quotient->clear();
+        remainder->assign(dividend.begin(), dividend.end());
+        return;
+    }
+    if (divisor.Size() == 1) {
+        quotient->assign(dividend.begin(), dividend.end());
+        Limb rem = DivideByLimb(quotient, divisor[0]);
+        remainder->clear();
+        if (rem != 0) {
+            remainder->push_back(rem);
+        }
+        return;
+    }
+    // Normalize the operands, so the most significant bit of the divisor is set and qhat is at most 2 more than q
+    auto shift = static_cast<size_t>(Clz(divisor[divisor.Size() - 1]));
+    Magnitude v = ShiftLeft(divisor, shift);
+    Magnitude u = ShiftLeft(dividend, shift);
+    size_t n = divisor.Size();
+    size_t m = dividend.Size() - n;
+    u.resize(dividend.Size() + 1U, 0);
+    ASSERT(v.size() == n);
+    LimbSpan vSpan(v);
+    DoubleLimb vTop = v[n - 1U];
+    DoubleLimb vNext = v[n - 2U];
+
+    quotient->assign(m + 1U, 0);
+    for (size_t j = m + 1U; j-- > 0;) {
+        DoubleLimb numerator = (static_cast<DoubleLimb>(u[j + n]) << LIMB_BITS) | u[j + n - 1U];
+        DoubleLimb qhat = numerator / vTop;
+        DoubleLimb rhat = numerator % vTop;
+        while (qhat > LIMB_MASK || qhat * vNext > ((rhat << LIMB_BITS) | u[j + n - 2U])) {
+            --qhat;
+            rhat += vTop;
+            if (rhat > LIMB_MASK) {
+                break;
+            }
+        }
+        if (MultiplySubtract(&u, j, vSpan, qhat)) {
+            // qhat is still one more than q in rare cases
+            --qhat;
+            AddBack(&u, j, vSpan);
+        }
+        (*quotient)[j] = static_cast<Limb>(qhat);
+    }
+    Normalize(quotient);
+    u.resize(n);
+    *remainder = ShiftRight(LimbSpan(u), shift);
+}
+
+/// Converts the magnitude to the two's complement form of the given length
+Magnitude ToTwosComplement(LimbSpan mag, bool negative, size_t length)
+{
+    Magnitude result(length, 0);
+    std::copy(mag.begin(), mag.end(), result.begin());
+    if (negative) {
+        DoubleLimb carry = 1;
+        for (auto &limb : result) {
+            DoubleLimb cur = static_cast<DoubleLimb>(static_cast<Limb>(~limb)) + carry;
+            limb = static_cast<Limb>(cur);
+            carry = cur >> LIMB_BITS;
+        }
+    }
+    return result;
+}
+
+Magnitude Bitwise(LimbSpan lhs, bool lhsNegative, LimbSpan rhs, bool rhsNegative, BitwiseOp op)
+{
+    // One more limb for the sign
+    size_t length = std::max(lhs.Size(), rhs.Size()) + 1U;
+    Magnitude result = ToTwosComplement(lhs, lhsNegative, length);
+    Magnitude other = ToTwosComplement(rhs, rhsNegative, length);
+    for (size_t i = 0; i < length; ++i) {
+        switch (op) {
+            case BitwiseOp::AND:
+                result[i] &= other[i];
+                break;
+            case BitwiseOp::OR:
+                result[i] |= other[i];
+                break;
+            case BitwiseOp::XOR:
+                result[i] ^= other[i];
+                break;
+            default:
+                UNREACHABLE();
+        }
+    }
+    bool negative = (result.back() >> (LIMB_BITS - 1U)) != 0;
+    // The two's complement of the negative value is its magnitude as well
+    result = ToTwosComplement(LimbSpan(result), negative, length);
+    Normalize(&result);
+    return result;
+}
+
+uint32_t DigitValue(uint16_t ch)
+{
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    }
+    if (ch >= 'a' && ch <= 'z') {
+        return ch - 'a' + DECIMAL_RADIX;
+    }
+    ASSERT(ch >= 'A' && ch <= 'Z');
+    return ch - 'A' + DECIMAL_RADIX;
+}
+
+/// Number of digits in radix, which fit into a limb, and the radix in this power
+std::pair<size_t, Limb> GetDigitsPerLimb(uint32_t radix)
+{
+    size_t digits = 1;
+    DoubleLimb power = radix;
+    while (power * radix <= LIMB_MASK) {
+        power *= radix;
+        ++digits;
+    }
+    return {digits, static_cast<Limb>(power)};
+}
+
+/// The digits are validated by BigInt.ets, the underscores are skipped
+template <class Char>
+Magnitude Parse(Span<const Char> digits, uint32_t radix)
+{
+    Magnitude mag;
+    if (helpers::math::IsPowerOfTwo(radix)) {
+        auto bitsPerDigit = static_cast<size_t>(Ctz(radix));
+        size_t bit = 0;
+        for (size_t i = digits.Size(); i-- > 0;) {
+            if (digits[i] == '_') {
+                continue;
+            }
+            size_t index = bit / LIMB_BITS;
+            if (mag.size() < index + 2U) {
+                mag.resize(index + 2U, 0);
+            }
+            DoubleLimb value = static_cast<DoubleLimb>(DigitValue(digits[i])) << (bit % LIMB_BITS);
+            mag[index] |= static_cast<Limb>(value);
+            mag[index + 1U] |= static_cast<Limb>(value >> LIMB_BITS);
+            bit += bitsPerDigit;
+        }
+        Normalize(&mag);
+        return mag;
+    }
+    auto [digitsPerLimb, limbRadix] = GetDigitsPerLimb(radix);
+    Limb chunk = 0;
+    Limb chunkRadix = 1;
+    size_t chunkDigits = 0;
+    for (auto ch : digits) {
+        if (ch == '_') {
+            continue;
+        }
+        chunk = chunk * radix + DigitValue(ch);
+        chunkRadix *= radix;
+        if (++chunkDigits == digitsPerLimb) {
+            MultiplyAdd(&mag, limbRadix, chunk);
+            chunk = 0;
+            chunkRadix = 1;
+            chunkDigits = 0;
+        }
+    }
+    if (chunkDigits != 0) {
+        MultiplyAdd(&mag, chunkRadix, chunk);
+    }
+    Normalize(&mag);
+    return mag;
+}
+
+PandaString ToString(LimbSpan mag, uint32_t radix, bool negative)
+{
+    if (mag.Empty()) {
+        return "0";
+    }
+    // The digits are generated from the least significant one
+    PandaString result;
+    if (helpers::math::IsPowerOfTwo(radix)) {
+        auto bitsPerDigit = static_cast<size_t>(Ctz(radix));
+        size_t totalBits = mag.Size() * LIMB_BITS - static_cast<size_t>(Clz(mag[mag.Size() - 1]));
+        result.reserve(totalBits / bitsPerDigit + 2U);
+        for (size_t bit = 0; bit < totalBits; bit += bitsPerDigit) {
+            DoubleLimb value = mag[bit / LIMB_BITS];
+            if (bit / LIMB_BITS + 1U < mag.Size()) {
+                value |= static_cast<DoubleLimb>(mag[bit / LIMB_BITS + 1U]) << LIMB_BITS;
+            }
+            result.push_back(DIGITS[(value >> (bit % LIMB_BITS)) & (radix - 1U)]);
+        }
+    } else {
+        auto [digitsPerLimb, limbRadix] = GetDigitsPerLimb(radix);
+        Magnitude rest(mag.begin(), mag.end());
+        while (!rest.empty()) {
+            Limb chunk = DivideByLimb(&rest, limbRadix);
+            for (size_t i = 0; i < digitsPerLimb && (chunk != 0 || !rest.empty()); ++i) {
+                result.push_back(DIGITS[chunk % radix]);
+                chunk /= radix;
+            }
+        }
+    }
+    if (negative) {
+        result.push_back('-');
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+}  // namespace
+
+extern "C" EtsIntArray *EscompatBigIntAddMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    Magnitude result = ReadMagnitude(lhs);
+    AddAt(&result, LimbSpan(ReadMagnitude(rhs)), 0);
+    return CreateMagnitude(std::move(result));
+}
+
+extern "C" EtsIntArray *EscompatBigIntSubtractMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    Magnitude result = ReadMagnitude(lhs);
+    SubtractFrom(&result, LimbSpan(ReadMagnitude(rhs)));
+    return CreateMagnitude(std::move(result));
+}
+
+extern "C" EtsInt EscompatBigIntCompareMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    return Compare(LimbSpan(ReadMagnitude(lhs)), LimbSpan(ReadMagnitude(rhs)));
+}
+
+extern "C" EtsIntArray *EscompatBigIntMultiplyMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    return CreateMagnitude(Multiply(LimbSpan(ReadMagnitude(lhs)), LimbSpan(ReadMagnitude(rhs))));
+}
+
+extern "C" EtsIntArray *EscompatBigIntDivideMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    Magnitude quotient;
+    Magnitude remainder;
+    Divide(LimbSpan(ReadMagnitude(lhs)), LimbSpan(ReadMagnitude(rhs)), &quotient, &remainder);
+    return CreateMagnitude(std::move(quotient));
+}
+
+extern "C" EtsIntArray *EscompatBigIntRemainderMagnitudes(EtsIntArray *lhs, EtsIntArray *rhs)
+{
+    Magnitude quotient;
+    Magnitude remainder;
+    Divide(LimbSpan(ReadMagnitude(lhs)), LimbSpan(ReadMagnitude(rhs)), &quotient, &remainder);
+    return CreateMagnitude(std::move(remainder));
+}
+
+extern "C" EtsIntArray *EscompatBigIntShiftLeftMagnitude(EtsIntArray *mag, EtsLong shift)
+{
+    ASSERT(shift >= 0);
+    return CreateMagnitude(ShiftLeft(LimbSpan(ReadMagnitude(mag)), static_cast<size_t>(shift)));
+}
+
+extern "C" EtsIntArray *EscompatBigIntShiftRightMagnitude(EtsIntArray *mag, EtsLong shift)
+{
+    ASSERT(shift >= 0);
+    return CreateMagnitude(ShiftRight(LimbSpan(ReadMagnitude(mag)), static_cast<size_t>(shift)));
+}
+
+extern "C" EtsIntArray *EscompatBigIntBitwiseMagnitudes(EtsIntArray *lhs, EtsBoolean lhsNegative, EtsIntArray *rhs,
+                                                        EtsBoolean rhsNegative, EtsInt op)
+{
+    return CreateMagnitude(Bitwise(LimbSpan(ReadMagnitude(lhs)), lhsNegative != 0, LimbSpan(ReadMagnitude(rhs)),
+                                   rhsNegative != 0, static_cast<BitwiseOp>(op)));
+}
+
+extern "C" EtsIntArray *EscompatBigIntParseMagnitude(EtsString *str, EtsInt begin, EtsInt radix)
+{
+    ASSERT(begin >= 0 && begin <= str->GetLength());
+    ASSERT(radix >= 2 && static_cast<uint32_t>(radix) <= MAX_RADIX);
+    auto length = static_cast<size_t>(str->GetLength() - begin);
+    if (str->IsUtf16()) {
+        Span<const uint16_t> digits(str->GetDataUtf16(), str->GetLength());
+        return CreateMagnitude(Parse(digits.SubSpan(begin, length), static_cast<uint32_t>(radix)));
+    }
+    Span<const uint8_t> digits(str->GetDataMUtf8(), str->GetLength());
+    return CreateMagnitude(Parse(digits.SubSpan(begin, length), static_cast<uint32_t>(radix)));
+}
+
+extern "C" EtsString *EscompatBigIntMagnitudeToString(EtsIntArray *mag, EtsBoolean negative, EtsInt radix)
+{
+    ASSERT(radix >= 2 && static_cast<uint32_t>(radix) <= MAX_RADIX);
+    PandaString result = ToString(LimbSpan(ReadMagnitude(mag)), static_cast<uint32_t>(radix), negative != 0);
+    return EtsString::CreateFromMUtf8(result.data(), static_cast<uint32_t>(result.size()));
+}
+
+}  // namespace ark::ets::intrinsics
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -13,22 +13,36 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include "include/class_helper.h"
 #include "include/coretypes/array.h"
 #include "include/managed_thread.h"
+#include "include/mem/panda_containers.h"
+#include "include/mem/panda_string.h"
 #include "macros.h"
 #include "mem/vm_handle.h"
 #include "napi/ets_napi.h"
 #include "runtime/handle_scope-inl.h"
 #include "intrinsics.h"
 #include "type.h"
+#include "plugins/ets/runtime/ets_class_linker.h"
+#include "plugins/ets/runtime/ets_coroutine.h"
+#include "plugins/ets/runtime/ets_errors.h"
+#include "plugins/ets/runtime/ets_panda_file_items.h"
+#include "plugins/ets/runtime/ets_vm.h"
 #include "types/ets_array.h"
 #include "types/ets_class.h"
+#include "types/ets_field.h"
+#include "types/ets_method.h"
 #include "types/ets_primitives.h"
 #include "types/ets_box_primitive-inl.h"
 #include "types/ets_string.h"
+#include "types/ets_type.h"
 #include "utils/json_builder.h"
 
 namespace {
@@ -308,6 +322,859 @@ ark::JsonObjectBuilder ObjectToJSON(ark::ets::EtsObject *d)
 }  // namespace
 
 namespace ark::ets::intrinsics {
+
+namespace {
+
+/// Kinds of the types which JSON.parse can materialize, see JSON.checkType in escompat/json.ets
+enum class JsonTargetKind { NULL_VALUE, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+bool IsBooleanPrimitive(EtsClass *cls)
+{
+    return cls->GetRuntimeClass()->GetType().GetId() == panda_file::Type::TypeId::U1;
+}
+
+JsonTargetKind GetJsonTargetKind(EtsClass *cls)
+{
+    if (cls == nullptr) {
+        return JsonTargetKind::NULL_VALUE;
+    }
+    if (cls->IsPrimitive()) {
+        // Only double and boolean primitives pass JSON.checkType
+        return IsBooleanPrimitive(cls) ? JsonTargetKind::BOOLEAN : JsonTargetKind::NUMBER;
+    }
+    if (cls->IsStringClass()) {
+        return JsonTargetKind::STRING;
+    }
+    if (cls->IsArrayClass()) {
+        return JsonTargetKind::ARRAY;
+    }
+    std::string_view descriptor = cls->GetDescriptor();
+    if (descriptor == panda_file_items::class_descriptors::BOX_DOUBLE) {
+        return JsonTargetKind::NUMBER;
+    }
+    if (descriptor == panda_file_items::class_descriptors::BOX_BOOLEAN) {
+        return JsonTargetKind::BOOLEAN;
+    }
+    return JsonTargetKind::OBJECT;
+}
+
+PandaString GetJsonTargetName(EtsClass *cls)
+{
+    if (cls == nullptr) {
+        return "null";
+    }
+    if (cls->IsPrimitive()) {
+        return IsBooleanPrimitive(cls) ? "boolean" : "double";
+    }
+    return ClassHelper::GetName<PandaString>(reinterpret_cast<const uint8_t *>(cls->GetDescriptor()));
+}
+
+/**
+ * Word-at-a-time checks for the JSON scanner: a 64-bit word holds WORD_CHARS characters of the type CharT.
+ * The checks only tell whether some character of the word matches, the exact position is found by a scalar loop.
+ */
+template <typename CharT>
+class JsonWordScanner {
+public:
+    static constexpr size_t WORD_CHARS = sizeof(uint64_t) / sizeof(CharT);
+
+    static uint64_t Load(const CharT *data)
+    {
+        // The compilers fold the loop into a single unaligned load
+        uint64_t word = 0;
+        for (size_t i = 0; i < WORD_CHARS; ++i) {
+            word |= static_cast<uint64_t>(data[i]) << (i * LANE_BITS);
+        }
+        return word;
+    }
+
+    /// @return true if the word has a quote, a backslash or a control character
+    static bool HasStringSpecial(uint64_t word)
+    {
+        return (HasZero(word ^ QUOTES) | HasZero(word ^ BACKSLASHES) | HasLess(word, CONTROL_CHARS_END)) != 0;
+    }
+
+    static bool IsAllSpaces(uint64_t word)
+    {
+        return word == SPACES;
+    }
+
+private:
+    static constexpr size_t LANE_BITS = std::numeric_limits<CharT>::digits;
+    static constexpr uint64_t LANE_ONES = std::numeric_limits<uint64_t>::max() / std::numeric_limits<CharT>::max();
+    static constexpr uint64_t LANE_HIGH_BITS = LANE_ONES << (LANE_BITS - 1U);
+    static constexpr uint64_t CONTROL_CHARS_END = 0x20;
+    static constexpr uint64_t QUOTES = LANE_ONES * '"';
+    static constexpr uint64_t BACKSLASHES = LANE_ONES * '\\';
+    static constexpr uint64_t SPACES = LANE_ONES * ' ';
+
+    /// @return non-zero if some lane of the word is zero
+    static uint64_t HasZero(uint64_t word)
+    {
+        return (word - LANE_ONES) & ~word & LANE_HIGH_BITS;
+    }
+
+    /// @return non-zero if some lane of the word is less than the bound, the bound must not exceed the lane high bit
+    static uint64_t HasLess(uint64_t word, uint64_t bound)
+    {
+        return (word - LANE_ONES * bound) & ~word & LANE_HIGH_BITS;
+    }
+};
+
+/**
+ * JSON.parse which builds the objects of the expected type right from the text, without the intermediate JSONValue
+ * tree. The text is read in place from the source string: CharT is uint8_t for the compressed strings and uint16_t
+ * for the UTF-16 ones. The source may be moved by GC on any allocation, so the data pointer is re-read from the
+ * handle by every scanning method and is never kept across allocations.
+ * All the methods return false or nullptr with a pending exception on errors.
+ */
+template <typename CharT>
+class TypedJsonParser {
+public:
+    TypedJsonParser(EtsCoroutine *coroutine, VMHandle<EtsString> source)
+        : coroutine_(coroutine), source_(source), length_(source->GetLength())
+    {
+    }
+
+    ~TypedJsonParser() = default;
+
+    NO_COPY_SEMANTIC(TypedJsonParser);
+    NO_MOVE_SEMANTIC(TypedJsonParser);
+
+    EtsObject *Parse(EtsClass *cls)
+    {
+        EtsObject *result = ParseValue(cls);
+        if (Failed()) {
+            return nullptr;
+        }
+        SkipWhitespace();
+        if (pos_ != length_) {
+            ThrowSyntaxError("Unexpected data after JSON");
+            return nullptr;
+        }
+        return result;
+    }
+
+private:
+    using WordScanner = JsonWordScanner<CharT>;
+
+    struct FieldInfo {
+        EtsField *field;
+        EtsClass *type;
+    };
+
+    struct ClassInfo {
+        Method *constructor {nullptr};
+        PandaVector<FieldInfo> fields;
+    };
+
+    // The parser is recursive, so the nesting is limited to keep the native stack of a coroutine safe
+    static constexpr size_t MAX_DEPTH = 512;
+    // Integers with this many digits are exact in double, so they don't need strtod
+    static constexpr size_t MAX_EXACT_INTEGER_DIGITS = 15;
+    static constexpr int DECIMAL_BASE = 10;
+    static constexpr uint16_t HEX_BASE = 16;
+    static constexpr size_t UNICODE_ESCAPE_DIGITS = 4;
+
+    const CharT *Data()
+    {
+        if constexpr (std::is_same_v<CharT, uint8_t>) {
+            return source_->GetDataMUtf8();
+        } else {
+            return source_->GetDataUtf16();
+        }
+    }
+
+    bool Failed() const
+    {
+        return coroutine_->HasPendingException();
+    }
+
+    static bool IsWhitespace(CharT c)
+    {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    static bool IsDigit(CharT c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    static bool IsNumberStart(CharT c)
+    {
+        return c == '-' || IsDigit(c);
+    }
+
+    static bool IsStringSpecial(CharT c)
+    {
+        return c == '"' || c == '\\' || c < ' ';
+    }
+
+    void SkipWhitespace()
+    {
+        const CharT *data = Data();
+        while (pos_ < length_ && IsWhitespace(data[pos_])) {
+            ++pos_;
+            // Indentation of a pretty-printed text is skipped by words
+            while (pos_ + WordScanner::WORD_CHARS <= length_ &&
+                   WordScanner::IsAllSpaces(WordScanner::Load(data + pos_))) {
+                pos_ += WordScanner::WORD_CHARS;
+            }
+        }
+    }
+
+    bool SkipWhitespaceToValue()
+    {
+        SkipWhitespace();
+        if (pos_ >= length_) {
+            return ThrowSyntaxError("Unexpected end of JSON input");
+        }
+        return true;
+    }
+
+    bool EnterNested()
+    {
+        if (++depth_ > MAX_DEPTH) {
+            return ThrowSyntaxError("JSON is nested too deeply");
+        }
+        return true;
+    }
+
+    bool ThrowSyntaxError(std::string_view message)
+    {
+        PandaStringStream ss;
+        ss << message << " at position " << pos_;
+        ThrowEtsError(coroutine_, panda_file_items::class_descriptors::SYNTAX_ERROR, ss.str().c_str());
+        return false;
+    }
+
+    bool ThrowError(const PandaString &message)
+    {
+        ThrowEtsError(coroutine_, panda_file_items::class_descriptors::ERROR, message.c_str());
+        return false;
+    }
+
+    bool ThrowUnexpectedValue(EtsClass *cls, CharT c)
+    {
+        std::string_view got;
+        if (c == '{') {
+            got = "object";
+        } else if (c == '[') {
+            got = "array";
+        } else if (c == '"') {
+            got = "string";
+        } else if (c == 't' || c == 'f') {
+            got = "boolean";
+        } else if (c == 'n') {
+            got = "null";
+        } else if (IsNumberStart(c)) {
+            got = "number";
+        } else {
+            return ThrowSyntaxError("Unexpected character");
+        }
+        PandaStringStream ss;
+        ss << GetJsonTargetName(cls) << " is expected, but get " << got << " at position " << pos_;
+        return ThrowError(ss.str());
+    }
+
+    size_t SkipDigits(const CharT *data)
+    {
+        size_t start = pos_;
+        while (pos_ < length_ && IsDigit(data[pos_])) {
+            ++pos_;
+        }
+        return pos_ - start;
+    }
+
+    /// Scans the number at pos_, the strict JSON grammar is checked. The value is not computed if result is nullptr
+    bool ScanNumber(EtsDouble *result)
+    {
+        const CharT *data = Data();
+        size_t start = pos_;
+        bool negative = data[pos_] == '-';
+        if (negative) {
+            ++pos_;
+        }
+        size_t integerStart = pos_;
+        if (pos_ < length_ && data[pos_] == '0') {
+            ++pos_;
+        } else if (SkipDigits(data) == 0) {
+            return ThrowSyntaxError("No number after minus sign");
+        }
+        bool isInteger = true;
+        if (pos_ < length_ && data[pos_] == '.') {
+            ++pos_;
+            if (SkipDigits(data) == 0) {
+                return ThrowSyntaxError("Unterminated fractional number");
+            }
+            isInteger = false;
+        }
+        if (pos_ < length_ && (data[pos_] == 'e' || data[pos_] == 'E')) {
+            ++pos_;
+            if (pos_ < length_ && (data[pos_] == '+' || data[pos_] == '-')) {
+                ++pos_;
+            }
+            if (SkipDigits(data) == 0) {
+                return ThrowSyntaxError("Exponent part is missing a number");
+            }
+            isInteger = false;
+        }
+        if (result == nullptr) {
+            return true;
+        }
+        if (isInteger && pos_ - integerStart <= MAX_EXACT_INTEGER_DIGITS) {
+            int64_t value = 0;
+            for (size_t i = integerStart; i < pos_; ++i) {
+                value = value * DECIMAL_BASE + (data[i] - '0');
+            }
+            *result = negative ? -static_cast<EtsDouble>(value) : static_cast<EtsDouble>(value);
+            return true;
+        }
+        numberBuffer_.clear();
+        for (size_t i = start; i < pos_; ++i) {
+            numberBuffer_.push_back(static_cast<char>(data[i]));
+        }
+        *result = std::strtod(numberBuffer_.c_str(), nullptr);
+        return true;
+    }
+
+    bool ScanLiteral(std::string_view literal)
+    {
+        const CharT *data = Data();
+        if (length_ - pos_ < literal.size()) {
+            return ThrowSyntaxError("Unexpected end of JSON input");
+        }
+        for (size_t i = 0; i < literal.size(); ++i) {
+            if (data[pos_ + i] != static_cast<CharT>(literal[i])) {
+                return ThrowSyntaxError("Unexpected token");
+            }
+        }
+        pos_ += literal.size();
+        return true;
+    }
+
+    bool ScanBoolean(EtsBoolean *result)
+    {
+        if (Data()[pos_] == 't') {
+            *result = ToEtsBoolean(true);
+            return ScanLiteral("true");
+        }
+        *result = ToEtsBoolean(false);
+        return ScanLiteral("false");
+    }
+
+    static int HexDigitValue(CharT c)
+    {
+        if (IsDigit(c)) {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + DECIMAL_BASE;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + DECIMAL_BASE;
+        }
+        return -1;
+    }
+
+    /// Scans the escape sequence at pos_ (the backslash), the decoded character is appended to stringBuffer_
+    template <bool DECODE>
+    bool ScanEscape(const CharT *data)
+    {
+        ++pos_;
+        if (pos_ >= length_) {
+            return ThrowSyntaxError("Unterminated string in JSON");
+        }
+        uint16_t decoded = 0;
+        switch (data[pos_]) {
+            case '"':
+                decoded = '"';
+                break;
+            case '\\':
+                decoded = '\\';
+                break;
+            case '/':
+                decoded = '/';
+                break;
+            case 'b':
+                decoded = '\b';
+                break;
+            case 'f':
+                decoded = '\f';
+                break;
+            case 'n':
+                decoded = '\n';
+                break;
+            case 'r':
+                decoded = '\r';
+                break;
+            case 't':
+                decoded = '\t';
+                break;
+            case 'u': {
+                if (length_ - pos_ <= UNICODE_ESCAPE_DIGITS) {
+                    return ThrowSyntaxError("Bad Unicode escape");
+                }
+                for (size_t i = 1; i <= UNICODE_ESCAPE_DIGITS; ++i) {
+                    int digit = HexDigitValue(data[pos_ + i]);
+                    if (digit < 0) {
+                        return ThrowSyntaxError("Bad Unicode escape");
+                    }
+                    decoded = decoded * HEX_BASE + static_cast<uint16_t>(digit);
+                }
+                pos_ += UNICODE_ESCAPE_DIGITS;
+                break;
+            }
+            default:
+                return ThrowSyntaxError("Bad escaped character");
+        }
+        ++pos_;
+        if constexpr (DECODE) {
+            stringBuffer_.push_back(decoded);
+        }
+        return true;
+    }
+
+    /// Scans the string at pos_ (the opening quote), the value is decoded to stringBuffer_ if DECODE is true
+    template <bool DECODE>
+    bool ScanString()
+    {
+        const CharT *data = Data();
+        ASSERT(data[pos_] == '"');
+        ++pos_;
+        if constexpr (DECODE) {
+            stringBuffer_.clear();
+        }
+        while (true) {
+            size_t start = pos_;
+            while (pos_ + WordScanner::WORD_CHARS <= length_ &&
+                   !WordScanner::HasStringSpecial(WordScanner::Load(data + pos_))) {
+                pos_ += WordScanner::WORD_CHARS;
+            }
+            while (pos_ < length_ && !IsStringSpecial(data[pos_])) {
+                ++pos_;
+            }
+            if constexpr (DECODE) {
+                stringBuffer_.insert(stringBuffer_.end(), data + start, data + pos_);
+            }
+            if (pos_ >= length_) {
+                return ThrowSyntaxError("Unterminated string in JSON");
+            }
+            if (data[pos_] == '"') {
+                ++pos_;
+                return true;
+            }
+            if (data[pos_] != '\\') {
+                return ThrowSyntaxError("Bad control character in string literal");
+            }
+            if (!ScanEscape<DECODE>(data)) {
+                return false;
+            }
+        }
+    }
+
+    /// Compares the key in stringBuffer_ with the MUTF-8 field name
+    bool KeyEquals(const char *name) const
+    {
+        constexpr uint16_t ASCII_END = 0x80;
+        size_t keyLength = stringBuffer_.size();
+        size_t i = 0;
+        for (; i < keyLength && stringBuffer_[i] < ASCII_END; ++i) {
+            if (name[i] == '\0' || static_cast<uint8_t>(name[i]) != stringBuffer_[i]) {
+                return false;
+            }
+        }
+        if (i == keyLength) {
+            return name[i] == '\0';
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::string_view nameTail(name + i);
+        auto tailLength = static_cast<uint32_t>(keyLength - i);
+        size_t tailSize = utf::Utf16ToMUtf8Size(stringBuffer_.data() + i, tailLength) - 1;
+        if (tailSize != nameTail.size()) {
+            return false;
+        }
+        PandaVector<uint8_t> tail(tailSize);
+        utf::ConvertRegionUtf16ToMUtf8(stringBuffer_.data() + i, tail.data(), tailLength, tailSize, 0);
+        return std::equal(tail.begin(), tail.end(), nameTail.begin(),
+                          [](uint8_t a, char b) { return a == static_cast<uint8_t>(b); });
+    }
+
+    /// The fields are usually listed in the declaration order, so the search starts from the expected one
+    size_t FindField(const ClassInfo &info, size_t expected) const
+    {
+        size_t count = info.fields.size();
+        for (size_t i = 0; i < count; ++i) {
+            size_t index = (expected + i) % count;
+            if (KeyEquals(info.fields[index].field->GetName())) {
+                return index;
+            }
+        }
+        return count;
+    }
+
+    const ClassInfo *GetClassInfo(EtsClass *cls)
+    {
+        auto it = classes_.find(cls);
+        if (it != classes_.end()) {
+            return &it->second;
+        }
+        auto *classLinker = PandaEtsVM::GetCurrent()->GetClassLinker();
+        if (!cls->IsInitialized() && !classLinker->InitializeClass(coroutine_, cls)) {
+            return nullptr;
+        }
+        ClassInfo info;
+        cls->EnumerateMethods([&info](EtsMethod *method) {
+            if (method->GetPandaMethod()->IsInstanceConstructor() && method->GetParametersNum() == 0) {
+                info.constructor = method->GetPandaMethod();
+                return true;
+            }
+            return false;
+        });
+        if (info.constructor == nullptr) {
+            ThrowError("Incorrect type: " + GetJsonTargetName(cls));
+            return nullptr;
+        }
+        cls->EnumerateBaseClasses([&info](EtsClass *c) {
+            for (auto &field : c->GetRuntimeClass()->GetInstanceFields()) {
+                auto *etsField = EtsField::FromRuntimeField(&field);
+                info.fields.push_back({etsField, etsField->GetType()});
+            }
+            return false;
+        });
+        if (Failed()) {
+            return nullptr;
+        }
+        return &classes_.emplace(cls, std::move(info)).first->second;
+    }
+
+    EtsObject *ParseString()
+    {
+        if (!ScanString<true>()) {
+            return nullptr;
+        }
+        auto length = static_cast<ets_int>(stringBuffer_.size());
+        auto *string = EtsString::CreateFromUtf16(stringBuffer_.data(), length);
+        return string != nullptr ? string->AsObject() : nullptr;
+    }
+
+    /// Parses the value of the reference type cls, nullptr is also returned for the JSON null
+    EtsObject *ParseValue(EtsClass *cls)
+    {
+        if (!SkipWhitespaceToValue()) {
+            return nullptr;
+        }
+        CharT c = Data()[pos_];
+        switch (GetJsonTargetKind(cls)) {
+            case JsonTargetKind::NULL_VALUE:
+                if (c == 'n') {
+                    ScanLiteral("null");
+                    return nullptr;
+                }
+                break;
+            case JsonTargetKind::BOOLEAN:
+                if (c == 't' || c == 'f') {
+                    EtsBoolean value = ToEtsBoolean(false);
+                    return ScanBoolean(&value) ? EtsBoxPrimitive<EtsBoolean>::Create(coroutine_, value) : nullptr;
+                }
+                break;
+            case JsonTargetKind::NUMBER:
+                if (IsNumberStart(c)) {
+                    EtsDouble value = 0;
+                    return ScanNumber(&value) ? EtsBoxPrimitive<EtsDouble>::Create(coroutine_, value) : nullptr;
+                }
+                break;
+            case JsonTargetKind::STRING:
+                if (c == '"') {
+                    return ParseString();
+                }
+                break;
+            case JsonTargetKind::ARRAY:
+                if (c == '[') {
+                    return ParseArray(cls);
+                }
+                break;
+            case JsonTargetKind::OBJECT:
+                if (c == '{') {
+                    return ParseObject(cls);
+                }
+                break;
+        }
+        ThrowUnexpectedValue(cls, c);
+        return nullptr;
+    }
+
+    /// Parses the value of the primitive type cls or of its box
+    template <typename T>
+    bool ParsePrimitive(EtsClass *cls, T *result)
+    {
+        if (!SkipWhitespaceToValue()) {
+            return false;
+        }
+        CharT c = Data()[pos_];
+        if constexpr (std::is_same_v<T, EtsBoolean>) {
+            if (c == 't' || c == 'f') {
+                return ScanBoolean(result);
+            }
+        } else {
+            if (IsNumberStart(c)) {
+                return ScanNumber(result);
+            }
+        }
+        return ThrowUnexpectedValue(cls, c);
+    }
+
+    /// Parses the array at pos_, parseElement is called for every element
+    template <typename ParseElementFn>
+    bool ParseElements(ParseElementFn parseElement)
+    {
+        if (!EnterNested()) {
+            return false;
+        }
+        ++pos_;
+        SkipWhitespace();
+        if (pos_ < length_ && Data()[pos_] == ']') {
+            ++pos_;
+            --depth_;
+            return true;
+        }
+        while (true) {
+            if (!parseElement()) {
+                return false;
+            }
+            SkipWhitespace();
+            if (pos_ >= length_) {
+                return ThrowSyntaxError("Unexpected end of JSON input");
+            }
+            CharT c = Data()[pos_];
+            if (c == ']') {
+                ++pos_;
+                --depth_;
+                return true;
+            }
+            if (c != ',') {
+                return ThrowSyntaxError("Expected ',' or ']' after array element");
+            }
+            ++pos_;
+        }
+    }
+
+    /// Parses the object at pos_, parseMember is called for every member with the key in stringBuffer_
+    template <bool DECODE_KEYS, typename ParseMemberFn>
+    bool ParseMembers(ParseMemberFn parseMember)
+    {
+        if (!EnterNested()) {
+            return false;
+        }
+        ++pos_;
+        SkipWhitespace();
+        if (pos_ < length_ && Data()[pos_] == '}') {
+            ++pos_;
+            --depth_;
+            return true;
+        }
+        while (true) {
+            SkipWhitespace();
+            if (pos_ >= length_ || Data()[pos_] != '"') {
+                return ThrowSyntaxError("Expected property name");
+            }
+            if (!ScanString<DECODE_KEYS>()) {
+                return false;
+            }
+            SkipWhitespace();
+            if (pos_ >= length_ || Data()[pos_] != ':') {
+                return ThrowSyntaxError("Expected ':' after property name");
+            }
+            ++pos_;
+            if (!parseMember()) {
+                return false;
+            }
+            SkipWhitespace();
+            if (pos_ >= length_) {
+                return ThrowSyntaxError("Unexpected end of JSON input");
+            }
+            CharT c = Data()[pos_];
+            if (c == '}') {
+                ++pos_;
+                --depth_;
+                return true;
+            }
+            if (c != ',') {
+                return ThrowSyntaxError("Expected ',' or '}' after property value");
+            }
+            ++pos_;
+        }
+    }
+
+    /// Checks the syntax of the value which has no field to be stored to
+    bool SkipValue()
+    {
+        if (!SkipWhitespaceToValue()) {
+            return false;
+        }
+        CharT c = Data()[pos_];
+        switch (c) {
+            case '{':
+                return ParseMembers<false>([this]() { return SkipValue(); });
+            case '[':
+                return ParseElements([this]() { return SkipValue(); });
+            case '"':
+                return ScanString<false>();
+            case 't':
+                return ScanLiteral("true");
+            case 'f':
+                return ScanLiteral("false");
+            case 'n':
+                return ScanLiteral("null");
+            default:
+                if (IsNumberStart(c)) {
+                    return ScanNumber(nullptr);
+                }
+                return ThrowSyntaxError("Unexpected character");
+        }
+    }
+
+    template <typename ArrayT>
+    EtsObject *ParsePrimitiveArray(EtsClass *componentClass)
+    {
+        using ValueT = typename ArrayT::ValueType;
+        PandaVector<ValueT> values;
+        bool ok = ParseElements([this, componentClass, &values]() {
+            ValueT value {};
+            if (!ParsePrimitive(componentClass, &value)) {
+                return false;
+            }
+            values.push_back(value);
+            return true;
+        });
+        if (!ok) {
+            return nullptr;
+        }
+        auto *array = ArrayT::Create(static_cast<uint32_t>(values.size()));
+        if (array == nullptr) {
+            return nullptr;
+        }
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            array->Set(i, values[i]);
+        }
+        return array->AsObject();
+    }
+
+    EtsObject *ParseArray(EtsClass *arrayClass)
+    {
+        EtsClass *componentClass = arrayClass->GetComponentType();
+        if (componentClass->IsPrimitive()) {
+            if (IsBooleanPrimitive(componentClass)) {
+                return ParsePrimitiveArray<EtsBooleanArray>(componentClass);
+            }
+            return ParsePrimitiveArray<EtsDoubleArray>(componentClass);
+        }
+        [[maybe_unused]] HandleScope<ObjectHeader *> scope(coroutine_);
+        // The elements are kept in handles until the array of the exact length is allocated
+        PandaVector<VMHandle<EtsObject>> elements;
+        bool ok = ParseElements([this, componentClass, &elements]() {
+            EtsObject *element = ParseValue(componentClass);
+            if (Failed()) {
+                return false;
+            }
+            elements.emplace_back(coroutine_, element != nullptr ? element->GetCoreType() : nullptr);
+            return true;
+        });
+        if (!ok) {
+            return nullptr;
+        }
+        auto *array = EtsArray::Create<EtsObjectArray>(arrayClass, static_cast<uint32_t>(elements.size()));
+        if (array == nullptr) {
+            return nullptr;
+        }
+        for (uint32_t i = 0; i < elements.size(); ++i) {
+            array->Set(i, elements[i].GetPtr());
+        }
+        return array->AsObject();
+    }
+
+    bool ParseField(VMHandle<EtsObject> &object, const FieldInfo &info)
+    {
+        if (info.type->IsPrimitive()) {
+            if (IsBooleanPrimitive(info.type)) {
+                EtsBoolean value = ToEtsBoolean(false);
+                if (!ParsePrimitive(info.type, &value)) {
+                    return false;
+                }
+                object->SetFieldPrimitive(info.field, value);
+                return true;
+            }
+            EtsDouble value = 0;
+            if (!ParsePrimitive(info.type, &value)) {
+                return false;
+            }
+            object->SetFieldPrimitive(info.field, value);
+            return true;
+        }
+        EtsObject *value = ParseValue(info.type);
+        if (Failed()) {
+            return false;
+        }
+        object->SetFieldObject(info.field, value);
+        return true;
+    }
+
+    EtsObject *ParseObject(EtsClass *cls)
+    {
+        const ClassInfo *info = GetClassInfo(cls);
+        if (info == nullptr) {
+            return nullptr;
+        }
+        [[maybe_unused]] HandleScope<ObjectHeader *> scope(coroutine_);
+        EtsObject *created = EtsObject::Create(cls);
+        if (created == nullptr) {
+            return nullptr;
+        }
+        VMHandle<EtsObject> object(coroutine_, created->GetCoreType());
+        std::array<Value, 1> args {Value(object->GetCoreType())};
+        info->constructor->InvokeVoid(coroutine_, args.data());
+        if (Failed()) {
+            return nullptr;
+        }
+
+        // The flags of the assigned fields of the nested objects are stacked in the same vector
+        size_t fieldsCount = info->fields.size();
+        size_t assignedBase = assigned_.size();
+        assigned_.resize(assignedBase + fieldsCount, false);
+        size_t expectedField = 0;
+        bool ok = ParseMembers<true>([&]() {
+            size_t index = FindField(*info, expectedField);
+            if (index == fieldsCount || assigned_[assignedBase + index]) {
+                // The unknown keys are ignored, the first one of the duplicated keys is used
+                return SkipValue();
+            }
+            assigned_[assignedBase + index] = true;
+            expectedField = index + 1;
+            return ParseField(object, info->fields[index]);
+        });
+        for (size_t i = 0; ok && i < fieldsCount; ++i) {
+            if (!assigned_[assignedBase + i]) {
+                ThrowError(PandaString("Cannot find ") + info->fields[i].field->GetName() + " in keys of " +
+                           GetJsonTargetName(cls));
+                ok = false;
+            }
+        }
+        assigned_.resize(assignedBase);
+        return ok ? object.GetPtr() : nullptr;
+    }
+
+    EtsCoroutine *coroutine_;
+    VMHandle<EtsString> source_;
+    size_t length_;
+    size_t pos_ {0};
+    size_t depth_ {0};
+    PandaVector<uint16_t> stringBuffer_;
+    PandaString numberBuffer_;
+    PandaVector<bool> assigned_;
+    PandaUnorderedMap<EtsClass *, ClassInfo> classes_;
+};
+
+}  // namespace
 EtsString *EscompatJSONStringifyObj(EtsObject *d)
 {
     ASSERT(d != nullptr);
@@ -351,4 +1218,30 @@ EtsString *EscompatJSONStringifyObj(EtsObject *d)
     return etsResString;
 }
 
+EtsObject *EscompatJSONParseTyped(EtsString *str, EtsObject *type)
+{
+    ASSERT(str != nullptr && type != nullptr);
+    auto *coroutine = EtsCoroutine::GetCurrent();
+    [[maybe_unused]] auto _ = HandleScope<ObjectHeader *>(coroutine);
+    auto source = VMHandle<EtsString>(coroutine, str->GetCoreType());
+
+    auto *classLinker = PandaEtsVM::GetCurrent()->GetClassLinker();
+    auto *typeClass = classLinker->GetClass(panda_file_items::class_descriptors::TYPE.data());
+    // The descriptor of the type, see std.core.Type
+    auto *typeDescField = typeClass->GetFieldIDByName("td");
+    ASSERT(typeDescField != nullptr);
+    auto typeDesc = EtsString::FromEtsObject(type->GetFieldObject(typeDescField))->GetMutf8();
+    EtsClass *cls = nullptr;
+    if (typeDesc != NULL_TYPE_DESC) {
+        cls = classLinker->GetClass(typeDesc.c_str());
+        if (cls == nullptr) {
+            return nullptr;
+        }
+    }
+    if (source->IsUtf16()) {
+        return TypedJsonParser<uint16_t>(coroutine, source).Parse(cls);
+    }
+    return TypedJsonParser<uint8_t>(coroutine, source).Parse(cls);
+}
+
 }  // namespace ark::ets::intrinsics
@@ -19,6 +19,7 @@
 #include "include/mem/panda_containers.h"
 #include "macros.h"
 #include "mem/vm_handle.h"
+#include "plugins/ets/runtime/regexp/regexp_cache.h"
 #include "plugins/ets/runtime/regexp/regexp_executor.h"
 #include "plugins/ets/runtime/types/ets_array.h"
 #include "plugins/ets/runtime/types/ets_string.h"
@@ -33,6 +34,7 @@
 namespace ark::ets::intrinsics {
 using RegExpParser = ark::RegExpParser;
 using RegExpExecutor = ark::ets::RegExpExecutor;
+using RegExpCache = ark::ets::RegExpCache;
 using RegExpMatchResult = ark::RegExpMatchResult<PandaString>;
 using Array = ark::coretypes::Array;
 
@@ -42,6 +44,7 @@ constexpr const int LAST_PAREN_FIELDS_COUNT = 10;
 
 constexpr const char *GROUP_NAMES_FIELD_NAME = "groupNames";
 constexpr const char *BUFFER_FIELD_NAME = "buffer";
+constexpr const char *PROGRAM_FIELD_NAME = "program_";
 constexpr const char *LAST_INDEX_FIELD_NAME = "lastIndex";
 constexpr const char *PATTERN_FIELD_NAME = "pattern_";
 constexpr const char *FLAGS_FIELD_NAME = "flags_";
@@ -70,6 +73,20 @@ EtsObject *GetFieldObjectByName(EtsObject *object, const char *name)
     return object->GetFieldObject(field);
 }
 
+RegExpCache::Entry *GetProgram(EtsObject *regexp)
+{
+    EtsField *field = regexp->GetClass()->GetDeclaredFieldIDByName(PROGRAM_FIELD_NAME);
+    ASSERT(field != nullptr);
+    return reinterpret_cast<RegExpCache::Entry *>(regexp->GetFieldPrimitive<EtsLong>(field));
+}
+
+void SetProgram(EtsObject *regexp, RegExpCache::Entry *program)
+{
+    EtsField *field = regexp->GetClass()->GetDeclaredFieldIDByName(PROGRAM_FIELD_NAME);
+    ASSERT(field != nullptr);
+    regexp->SetFieldPrimitive<EtsLong>(field, reinterpret_cast<EtsLong>(program));
+}
+
 uint32_t CastToBitMask(EtsString *checkStr)
 {
     uint32_t flagsBits = 0;
@@ -135,15 +152,13 @@ void SetFlags(EtsObject *regexpObject, EtsString *checkStr)
     regexp->SetFieldObject(flagsField, newFlags->AsObject());
 }
 
-void SetBuffer(EtsObject *regexpObject, const RegExpParser &parser)
+void SetBuffer(EtsObject *regexpObject, const uint8_t *buffer, size_t bufferSize)
 {
     auto *coroutine = EtsCoroutine::GetCurrent();
     [[maybe_unused]] HandleScope<ObjectHeader *> scope(coroutine);
     VMHandle<EtsObject> regexp(coroutine, regexpObject->GetCoreType());
     auto *regexpClass = regexp->GetClass();
 
-    auto bufferSize = parser.GetOriginBufferSize();
-    auto *buffer = parser.GetOriginBuffer();
     EtsField *bufferField = regexpClass->GetDeclaredFieldIDByName(BUFFER_FIELD_NAME);
     VMHandle<EtsByteArray> etsBuffer(coroutine, EtsByteArray::Create(bufferSize)->GetCoreType());
     for (size_t i = 0; i < bufferSize; ++i) {
@@ -152,7 +167,7 @@ void SetBuffer(EtsObject *regexpObject, const RegExpParser &parser)
     regexp.GetPtr()->SetFieldObject(bufferField, etsBuffer->AsObject());
 }
 
-void SetGroupNames(EtsObject *regexpObject, const RegExpParser &parser)
+void SetGroupNames(EtsObject *regexpObject, const PandaVector<PandaString> &groupName)
 {
     auto *coroutine = EtsCoroutine::GetCurrent();
     [[maybe_unused]] HandleScope<ObjectHeader *> scope(coroutine);
@@ -162,7 +177,6 @@ void SetGroupNames(EtsObject *regexpObject, const RegExpParser &parser)
     auto *classLinker = PandaEtsVM::GetCurrent()->GetClassLinker();
     auto *stringClass = classLinker->GetClassRoot(EtsClassRoot::STRING);
 
-    auto groupName = parser.GetGroupNames();
     EtsObjectArray *etsGroupNames = EtsObjectArray::Create(stringClass, groupName.size());
     VMHandle<EtsObjectArray> arrHandle(coroutine, etsGroupNames->GetCoreType());
 
@@ -190,14 +204,31 @@ extern "C" EtsObject *EscompatRegExpCompile(EtsObject *regexpObj)
     auto flagsBits = static_cast<uint8_t>(CastToBitMask(flags.GetPtr()));
     SetFlags(regexp.GetPtr(), flags.GetPtr());
 
-    RegExpParser parser = RegExpParser();
     PandaString pattern = ConvertToString(patternStr->GetCoreType());
+    auto *cache = PandaEtsVM::GetCurrent()->GetRegExpCache();
+    auto *oldProgram = GetProgram(regexp.GetPtr());
+    if (oldProgram != nullptr) {
+        SetProgram(regexp.GetPtr(), nullptr);
+        cache->RemoveOwner(regexp->GetCoreType(), oldProgram);
+    }
+    auto *program = cache->Acquire(pattern, flagsBits);
+    if (program == nullptr) {
+        RegExpParser parser = RegExpParser();
+        parser.Init(const_cast<char *>(reinterpret_cast<const char *>(pattern.c_str())), pattern.size(), flagsBits);
+        parser.Parse();
+        if (parser.IsError()) {
+            SetGroupNames(regexp.GetPtr(), parser.GetGroupNames());
+            SetBuffer(regexp.GetPtr(), parser.GetOriginBuffer(), parser.GetOriginBufferSize());
+            return regexp.GetPtr();
+        }
+        program = cache->Add(pattern, flagsBits, parser);
+    }
 
-    parser.Init(const_cast<char *>(reinterpret_cast<const char *>(pattern.c_str())), pattern.size(), flagsBits);
-    parser.Parse();
-
-    SetGroupNames(regexp.GetPtr(), parser);
-    SetBuffer(regexp.GetPtr(), parser);
+    SetGroupNames(regexp.GetPtr(), program->GetGroupNames());
+    SetBuffer(regexp.GetPtr(), program->GetByteCode().data(), program->GetByteCode().size());
+    // The reference is released when the object dies or gets recompiled
+    SetProgram(regexp.GetPtr(), program);
+    cache->AddOwner(regexp->GetCoreType(), program);
 
     return regexp.GetPtr();
 }
@@ -269,7 +300,7 @@ void SetUnsuccessfulMatchLegacyProperties(EtsClass *type)
 }
 
 RegExpMatchResult Execute(EtsObject *regexpObj, EtsString *inputStrObj, EtsInt stringLength, EtsInt lastIndex,
-                          bool hasIndices)
+                          uint32_t flagsBits)
 {
     auto *coroutine = EtsCoroutine::GetCurrent();
     [[maybe_unused]] HandleScope<ObjectHeader *> scope(coroutine);
@@ -291,10 +322,17 @@ RegExpMatchResult Execute(EtsObject *regexpObj, EtsString *inputStrObj, EtsInt s
         strBuffer = u8Buffer.data();
     }
 
+    // The program compiled for the current source and flags brings the prefilter and the DFA
+    auto *program = GetProgram(regexp.GetPtr());
+    if (program != nullptr) {
+        executor.SetPrefilter(program->GetPrefilter());
+        executor.SetDfa(program->GetDfa());
+    }
+
     auto *etsBuffer = reinterpret_cast<EtsByteArray *>(GetFieldObjectByName(regexp.GetPtr(), BUFFER_FIELD_NAME));
     auto *buffer = reinterpret_cast<uint8_t *>(etsBuffer->GetData<int8_t>());
     bool ret = executor.Execute(strBuffer, lastIndex, stringLength, buffer, isUtf16);
-    return executor.GetResult(ret, hasIndices);
+    return executor.GetResult(ret, (flagsBits & RegExpParser::FLAG_HASINDICES) != 0);
 }
 
 void SetResultField(EtsObject *regexpExecArrayObj, const PandaVector<std::pair<bool, PandaString>> &matches,
@@ -432,7 +470,7 @@ extern "C" EtsObject *EscompatRegExpExec(EtsObject *obj, EtsString *str)
         return regexpExecArrayObject.GetPtr();
     }
 
-    auto execResult = Execute(regexp.GetPtr(), strHandle.GetPtr(), stringLength, lastIndex, hasIndices);
+    auto execResult = Execute(regexp.GetPtr(), strHandle.GetPtr(), stringLength, lastIndex, flagsBits);
     if (!execResult.isSuccess) {
         SetLastIndexField(regexp.GetPtr(), lastIndexField, global, sticky, 0.0);
         SetUnsuccessfulMatchLegacyProperties(regexpClass);
@@ -0,0 +1,396 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "intrinsics.h"
+#include "libpandabase/utils/bit_helpers.h"
+#include "libpandabase/utils/bit_utils.h"
+#include "libpandabase/utils/span.h"
+#include "plugins/ets/runtime/types/ets_array.h"
+#include "runtime/include/mem/panda_containers.h"
+
+namespace ark::ets::intrinsics {
+
+namespace {
+
+// The bulk operations of escompat typed arrays work directly on the byte[] backing the ArrayBuffer. The elements are
+// stored in the little-endian order, which is the native one for all the supported targets, and are aligned, because
+// the array data and the byte offsets of the typed arrays are aligned to the element size.
+
+// Keep in sync with typedArray.ets.j2 and typedUArray.ets.j2, Uint8ClampedArray has the kind of Uint8Array
+enum class TypedArrayKind : int32_t {
+    INT8 = 0,
+    INT16 = 1,
+    INT32 = 2,
+    BIGINT64 = 3,
+    FLOAT32 = 4,
+    FLOAT64 = 5,
+    UINT8 = 6,
+    UINT16 = 7,
+    UINT32 = 8,
+    BIGUINT64 = 9
+};
+
+// The search loops check the blocks of this number of elements without early exits, so the compilers vectorize them
+constexpr size_t SEARCH_BLOCK_SIZE = 16U;
+// Matches are accumulated in the integer of the element width, so the comparisons and the reduction share the lanes
+template <class T>
+using SearchMask = helpers::UnsignedTypeHelperT<sizeof(T) * BITS_PER_BYTE>;
+// Shorter arrays are sorted with std::sort
+constexpr size_t RADIX_SORT_THRESHOLD = 64U;
+constexpr size_t RADIX_BITS = 8U;
+constexpr size_t RADIX_SIZE = 1U << RADIX_BITS;
+
+template <class T>
+Span<T> GetElements(EtsByteArray *data, int32_t byteBegin, int32_t byteEnd)
+{
+    ASSERT(byteBegin >= 0 && byteBegin <= byteEnd && static_cast<size_t>(byteEnd) <= data->GetLength());
+    ASSERT(byteBegin % sizeof(T) == 0 && (byteEnd - byteBegin) % sizeof(T) == 0);
+    auto *begin = data->GetData<uint8_t>() + byteBegin;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    ASSERT(reinterpret_cast<uintptr_t>(begin) % alignof(T) == 0);
+    return Span<T>(reinterpret_cast<T *>(begin), static_cast<size_t>(byteEnd - byteBegin) / sizeof(T));
+}
+
+/// Converts the bits passed from the managed code to the element value
+template <class T>
+T FromBits(int64_t bits)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return bit_cast<float>(static_cast<uint32_t>(bits));
+    } else if constexpr (std::is_same_v<T, double>) {
+        return bit_cast<double>(bits);
+    } else {
+        return static_cast<T>(bits);
+    }
+}
+
+/// The value which is out of the range of the integer element type is never found, instead of matching its truncation
+template <class T>
+bool IsElementValue(int64_t bits)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return true;
+    } else {
+        return static_cast<int64_t>(static_cast<T>(bits)) == bits;
+    }
+}
+
+template <class T, class Predicate>
+int32_t FindFirst(Span<T> elements, Predicate predicate)
+{
+    size_t i = 0;
+    for (; i + SEARCH_BLOCK_SIZE <= elements.Size(); i += SEARCH_BLOCK_SIZE) {
+        SearchMask<T> found = 0;
+        for (size_t j = 0; j < SEARCH_BLOCK_SIZE; ++j) {
+            found |= static_cast<SearchMask<T>>(predicate(elements[i + j]));
+        }
+        if (found != 0) {
+            break;
+        }
+    }
+    for (; i < elements.Size(); ++i) {
+        if (predicate(elements[i])) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+template <class T, class Predicate>
+int32_t FindLast(Span<T> elements, Predicate predicate)
+{
+    size_t end = elements.Size();
+    for (; end >= SEARCH_BLOCK_SIZE; end -= SEARCH_BLOCK_SIZE) {
+        SearchMask<T> found = 0;
+        for (size_t j = end - SEARCH_BLOCK_SIZE; j < end; ++j) {
+            found |= static_cast<SearchMask<T>>(predicate(elements[j]));
+        }
+        if (found != 0) {
+            break;
+        }
+    }
+    for (size_t i = end; i-- > 0;) {
+        if (predicate(elements[i])) {
+            return static_cast<int32_t>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * Strict equality is used by indexOf and lastIndexOf: NaN is not found, -0 and +0 are equal.
+ * includes uses SameValueZero, which differs only in finding NaN.
+ */
+template <class T>
+int32_t IndexOf(Span<T> elements, int64_t bits, bool sameValueZero, bool last)
+{
+    if (!IsElementValue<T>(bits)) {
+        return -1;
+    }
+    auto value = FromBits<T>(bits);
+    if constexpr (std::is_floating_point_v<T>) {
+        if (std::isnan(value)) {
+            if (!sameValueZero) {
+                return -1;
+            }
+            auto isNan = [](T element) { return element != element; };
+            return last ? FindLast(elements, isNan) : FindFirst(elements, isNan);
+        }
+    }
+    auto isEqual = [value](T element) { return element == value; };
+    return last ? FindLast(elements, isEqual) : FindFirst(elements, isEqual);
+}
+
+/// LSD radix sort of the integers, the passes over the bytes which are equal in all the elements are skipped
+template <class T>
+void RadixSort(Span<T> elements)
+{
+    using Key = std::make_unsigned_t<T>;
+    // Flipping the sign bit orders the signed values as unsigned ones, the unsigned values are the keys as they are
+    constexpr auto SIGN_BIT =
+        std::is_signed_v<T> ? static_cast<Key>(Key(1) << (sizeof(T) * BITS_PER_BYTE - 1U)) : static_cast<Key>(0);
+    PandaVector<Key> keys(elements.Size());
+    PandaVector<Key> buffer(elements.Size());
+    std::transform(elements.begin(), elements.end(), keys.begin(),
+                   [](T element) { return static_cast<Key>(static_cast<Key>(element) ^ SIGN_BIT); });
+    for (size_t shift = 0; shift < sizeof(T) * BITS_PER_BYTE; shift += RADIX_BITS) {
+        std::array<size_t, RADIX_SIZE> counts {};
+        for (auto key : keys) {
+            ++counts[(key >> shift) & (RADIX_SIZE - 1U)];
+        }
+        if (counts[(keys[0] >> shift) & (RADIX_SIZE - 1U)] == keys.size()) {
+            continue;
+        }
+        size_t offset = 0;
+        for (auto &count : counts) {
+            offset += count;
+            count = offset - count;
+        }
+        for (auto key : keys) {
+            buffer[counts[(key >> shift) & (RADIX_SIZE - 1U)]++] = key;
+        }
+        keys.swap(buffer);
+    }
+    std::transform(keys.begin(), keys.end(), elements.begin(),
+                   [](Key key) { return static_cast<T>(static_cast<Key>(key ^ SIGN_BIT)); });
+}
+
+/// Numeric order of TypedArray.prototype.sort: -0 is before +0, NaNs are at the end
+template <class T>
+bool FloatLess(T lhs, T rhs)
+{
+    if (std::isnan(rhs)) {
+        return !std::isnan(lhs);
+    }
+    if (lhs == rhs) {
+        return std::signbit(lhs) && !std::signbit(rhs);
+    }
+    return lhs < rhs;
+}
+
+template <class T>
+void Sort(Span<T> elements)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        std::sort(elements.begin(), elements.end(), FloatLess<T>);
+    } else {
+        if (elements.Size() < RADIX_SORT_THRESHOLD) {
+            std::sort(elements.begin(), elements.end());
+        } else {
+            RadixSort(elements);
+        }
+    }
+}
+
+template <class Visitor>
+auto VisitKind(int32_t kind, Visitor visitor)
+{
+    switch (static_cast<TypedArrayKind>(kind)) {
+        case TypedArrayKind::INT8:
+            return visitor(int8_t {});
+        case TypedArrayKind::INT16:
+            return visitor(int16_t {});
+        case TypedArrayKind::INT32:
+            return visitor(int32_t {});
+        case TypedArrayKind::BIGINT64:
+            return visitor(int64_t {});
+        case TypedArrayKind::FLOAT32:
+            return visitor(float {});
+        case TypedArrayKind::FLOAT64:
+            return visitor(double {});
+        case TypedArrayKind::UINT8:
+            return visitor(uint8_t {});
+        case TypedArrayKind::UINT16:
+            return visitor(uint16_t {});
+        case TypedArrayKind::UINT32:
+            return visitor(uint32_t {});
+        case TypedArrayKind::BIGUINT64:
+            return visitor(uint64_t {});
+        default:
+            UNREACHABLE();
+    }
+}
+
+template <class T, class Array>
+void SetFromArray(EtsByteArray *data, int32_t byteBegin, Array *src)
+{
+    auto size = static_cast<size_t>(src->GetLength()) * sizeof(T);
+    ASSERT(byteBegin >= 0 && static_cast<size_t>(byteBegin) + size <= data->GetLength());
+    if (size != 0) {
+        auto *dst = data->GetData<uint8_t>() + byteBegin;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        [[maybe_unused]] auto res = memcpy_s(dst, data->GetLength() - byteBegin, src->template GetData<T>(), size);
+        ASSERT(res == EOK);
+    }
+}
+
+/**
+ * The unsigned typed arrays are set from the arrays of the wider signed type, so the values are truncated to the
+ * element type as the managed setter does, or clamped for Uint8ClampedArray
+ */
+template <class Array>
+void SetUnsignedFromArray(EtsByteArray *data, int32_t kind, int32_t byteBegin, Array *src, bool clamp)
+{
+    VisitKind(kind, [=](auto type) {
+        using T = decltype(type);
+        if constexpr (std::is_unsigned_v<T>) {
+            using Src = typename Array::ValueType;
+            auto size = static_cast<int32_t>(src->GetLength() * sizeof(T));
+            auto elements = GetElements<T>(data, byteBegin, byteBegin + size);
+            Span<const Src> values(src->template GetData<Src>(), src->GetLength());
+            if constexpr (sizeof(T) < sizeof(Src)) {
+                if (clamp) {
+                    static constexpr auto MAX = static_cast<Src>(std::numeric_limits<T>::max());
+                    std::transform(values.begin(), values.end(), elements.begin(),
+                                   [](Src value) { return static_cast<T>(std::clamp<Src>(value, 0, MAX)); });
+                    return;
+                }
+            }
+            ASSERT(!clamp);
+            std::transform(values.begin(), values.end(), elements.begin(),
+                           [](Src value) { return static_cast<T>(value); });
+        } else {
+            UNREACHABLE();
+        }
+    });
+}
+
+}  // namespace
+
+extern "C" void EscompatTypedArrayFill(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsInt byteEnd, EtsLong bits)
+{
+    VisitKind(kind, [=](auto type) {
+        using T = decltype(type);
+        auto elements = GetElements<T>(data, byteBegin, byteEnd);
+        std::fill(elements.begin(), elements.end(), FromBits<T>(bits));
+    });
+}
+
+extern "C" EtsInt EscompatTypedArrayIndexOf(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsInt byteEnd,
+                                            EtsLong bits, EtsBoolean sameValueZero)
+{
+    return VisitKind(kind, [=](auto type) {
+        using T = decltype(type);
+        auto elements = GetElements<T>(data, byteBegin, byteEnd);
+        return IndexOf(elements, bits, sameValueZero != 0, false);
+    });
+}
+
+extern "C" EtsInt EscompatTypedArrayLastIndexOf(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsInt byteEnd,
+                                                EtsLong bits)
+{
+    return VisitKind(kind, [=](auto type) {
+        using T = decltype(type);
+        auto elements = GetElements<T>(data, byteBegin, byteEnd);
+        return IndexOf(elements, bits, false, true);
+    });
+}
+
+extern "C" void EscompatTypedArrayReverse(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsInt byteEnd)
+{
+    VisitKind(kind, [=](auto type) {
+        auto elements = GetElements<decltype(type)>(data, byteBegin, byteEnd);
+        std::reverse(elements.begin(), elements.end());
+    });
+}
+
+extern "C" void EscompatTypedArraySort(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsInt byteEnd)
+{
+    VisitKind(kind, [=](auto type) { Sort(GetElements<decltype(type)>(data, byteBegin, byteEnd)); });
+}
+
+extern "C" void EscompatTypedArrayCopyWithin(EtsByteArray *data, EtsInt byteTarget, EtsInt byteBegin, EtsInt byteEnd)
+{
+    ASSERT(byteBegin >= 0 && byteBegin <= byteEnd && static_cast<size_t>(byteEnd) <= data->GetLength());
+    ASSERT(byteTarget >= 0 && static_cast<size_t>(byteTarget + byteEnd - byteBegin) <= data->GetLength());
+    auto size = static_cast<size_t>(byteEnd - byteBegin);
+    if (size != 0) {
+        auto *bytes = data->GetData<uint8_t>();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto *dst = bytes + byteTarget;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        [[maybe_unused]] auto res = memmove_s(dst, data->GetLength() - byteTarget, bytes + byteBegin, size);
+        ASSERT(res == EOK);
+    }
+}
+
+extern "C" void EscompatTypedArraySetInt8(EtsByteArray *data, EtsInt byteBegin, EtsByteArray *src)
+{
+    SetFromArray<EtsByte>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetInt16(EtsByteArray *data, EtsInt byteBegin, EtsShortArray *src)
+{
+    SetFromArray<EtsShort>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetInt32(EtsByteArray *data, EtsInt byteBegin, EtsIntArray *src)
+{
+    SetFromArray<EtsInt>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetBigInt64(EtsByteArray *data, EtsInt byteBegin, EtsLongArray *src)
+{
+    SetFromArray<EtsLong>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetFloat32(EtsByteArray *data, EtsInt byteBegin, EtsFloatArray *src)
+{
+    SetFromArray<EtsFloat>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetFloat64(EtsByteArray *data, EtsInt byteBegin, EtsDoubleArray *src)
+{
+    SetFromArray<EtsDouble>(data, byteBegin, src);
+}
+
+extern "C" void EscompatTypedArraySetUnsignedInt(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsIntArray *src,
+                                                 EtsBoolean clamp)
+{
+    SetUnsignedFromArray(data, kind, byteBegin, src, clamp != 0);
+}
+
+extern "C" void EscompatTypedArraySetUnsignedLong(EtsByteArray *data, EtsInt kind, EtsInt byteBegin, EtsLongArray *src,
+                                                  EtsBoolean clamp)
+{
+    SetUnsignedFromArray(data, kind, byteBegin, src, clamp != 0);
+}
+
+}  // namespace ark::ets::intrinsics
@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "plugins/ets/runtime/regexp/regexp_cache.h"
+#include "runtime/include/runtime.h"
+#include "runtime/mem/object_helpers.h"
+
+namespace ark::ets {
+
+RegExpCache::Entry::Entry(PandaString pattern, uint32_t flags, const RegExpParser &parser)
+    : pattern_(std::move(pattern)),
+      flags_(flags),
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      byteCode_(parser.GetOriginBuffer(), parser.GetOriginBuffer() + parser.GetOriginBufferSize()),
+      groupNames_(parser.GetGroupNames()),
+      dfa_(byteCode_.data())
+{
+    prefilter_.Analyze(byteCode_.data());
+}
+
+RegExpCache::~RegExpCache()
+{
+    auto allocator = Runtime::GetCurrent()->GetInternalAllocator();
+    os::memory::LockHolder ownersLock(ownersLock_);
+    os::memory::LockHolder lock(lock_);
+    for (auto &[owner, entry] : owners_) {
+        removedEntries_.push_back(entry);
+    }
+    owners_.clear();
+    for (auto *entry : removedEntries_) {
+        if (entry->isEvicted_ && --entry->refCount_ == 0) {
+            allocator->Delete(entry);
+        }
+    }
+    removedEntries_.clear();
+    for (auto *entry : lru_) {
+        allocator->Delete(entry);
+    }
+    lru_.clear();
+    entries_.clear();
+}
+
+RegExpCache::Entry *RegExpCache::Acquire(const PandaString &pattern, uint32_t flags)
+{
+    os::memory::LockHolder lock(lock_);
+    auto it = entries_.find(Key(pattern, flags));
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+    Touch(it->second);
+    return it->second;
+}
+
+RegExpCache::Entry *RegExpCache::Add(const PandaString &pattern, uint32_t flags, const RegExpParser &parser)
+{
+    ASSERT(!parser.IsError());
+    auto allocator = Runtime::GetCurrent()->GetInternalAllocator();
+    // Bytecode analysis is done out of the lock
+    auto *entry = allocator->New<Entry>(pattern, flags, parser);
+
+    os::memory::LockHolder lock(lock_);
+    auto [it, inserted] = entries_.emplace(Key(pattern, flags), entry);
+    if (!inserted) {
+        // Another thread has compiled the same pattern meanwhile
+        allocator->Delete(entry);
+        Touch(it->second);
+        return it->second;
+    }
+    lru_.push_front(entry);
+    entry->lruPosition_ = lru_.begin();
+    entry->refCount_ = 1;
+    Evict();
+    return entry;
+}
+
+void RegExpCache::Release(Entry *entry)
+{
+    os::memory::LockHolder lock(lock_);
+    ASSERT(entry->refCount_ != 0);
+    if (--entry->refCount_ == 0 && entry->isEvicted_) {
+        Runtime::GetCurrent()->GetInternalAllocator()->Delete(entry);
+    }
+}
+
+void RegExpCache::AddOwner(ObjectHeader *owner, Entry *entry)
+{
+    os::memory::LockHolder lock(ownersLock_);
+    [[maybe_unused]] auto [it, inserted] = owners_.emplace(owner, entry);
+    ASSERT(inserted);
+}
+
+void RegExpCache::RemoveOwner(ObjectHeader *owner, Entry *entry)
+{
+    os::memory::LockHolder lock(ownersLock_);
+    // exec on another thread may still use the program, so it is kept until the next sweep
+    auto it = owners_.find(owner);
+    ASSERT(it != owners_.end() && it->second == entry);
+    removedEntries_.push_back(entry);
+    owners_.erase(it);
+}
+
+void RegExpCache::SweepOwners(const GCObjectVisitor &gcObjectVisitor)
+{
+    os::memory::LockHolder lock(ownersLock_);
+    for (auto *entry : removedEntries_) {
+        Release(entry);
+    }
+    removedEntries_.clear();
+    auto it = owners_.begin();
+    while (it != owners_.end()) {
+        if (gcObjectVisitor(it->first) == ObjectStatus::DEAD_OBJECT) {
+            Release(it->second);
+            it = owners_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void RegExpCache::UpdateOwners()
+{
+    os::memory::LockHolder lock(ownersLock_);
+    // The keys are rehashed after all the moved owners are taken out, so a new address can't meet an old one
+    PandaVector<std::pair<ObjectHeader *, Entry *>> moved;
+    auto it = owners_.begin();
+    while (it != owners_.end()) {
+        if (it->first->IsForwarded()) {
+            moved.emplace_back(mem::GetForwardAddress(it->first), it->second);
+            it = owners_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto &[owner, entry] : moved) {
+        auto [pos, inserted] = owners_.emplace(owner, entry);
+        if (!inserted) {
+            // The key of a dead object which is not swept yet, its place is taken by the moved object
+            removedEntries_.push_back(pos->second);
+            pos->second = entry;
+        }
+    }
+}
+
+void RegExpCache::Touch(Entry *entry)
+{
+    entry->refCount_++;
+    lru_.splice(lru_.begin(), lru_, entry->lruPosition_);
+}
+
+void RegExpCache::Evict()
+{
+    auto allocator = Runtime::GetCurrent()->GetInternalAllocator();
+    while (lru_.size() > MAX_ENTRIES) {
+        Entry *victim = lru_.back();
+        lru_.pop_back();
+        entries_.erase(Key(victim->pattern_, victim->flags_));
+        if (victim->refCount_ == 0) {
+            allocator->Delete(victim);
+        } else {
+            // Deleted by the last Release
+            victim->isEvicted_ = true;
+        }
+    }
+}
+
+}  // namespace ark::ets
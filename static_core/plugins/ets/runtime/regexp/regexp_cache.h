@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_PLUGINS_ETS_RUNTIME_REGEXP_CACHE_H
+#define PANDA_PLUGINS_ETS_RUNTIME_REGEXP_CACHE_H
+
+#include "libpandabase/mem/mem.h"
+#include "libpandabase/os/mutex.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/mem/panda_string.h"
+#include "runtime/regexp/ecmascript/regexp_dfa.h"
+#include "runtime/regexp/ecmascript/regexp_parser.h"
+#include "runtime/regexp/ecmascript/regexp_prefilter.h"
+
+namespace ark::ets {
+
+/**
+ * Compiled programs of regular expressions keyed by (pattern, flags), shared by all RegExp objects of the VM.
+ * Creating a RegExp with a known source skips the parser, and every exec of it reuses the prefilter and the
+ * DFA states built by the previous calls. Least recently used programs are evicted; an entry stays alive
+ * until the last user releases it. A compiled RegExp object owns a reference to its program, so exec does not
+ * look the program up; the references of dead objects are released when the VM sweeps its weak references.
+ */
+class RegExpCache {
+public:
+    static constexpr size_t MAX_ENTRIES = 128;
+
+    class Entry {
+    public:
+        Entry(PandaString pattern, uint32_t flags, const RegExpParser &parser);
+        ~Entry() = default;
+
+        NO_COPY_SEMANTIC(Entry);
+        NO_MOVE_SEMANTIC(Entry);
+
+        const PandaVector<uint8_t> &GetByteCode() const
+        {
+            return byteCode_;
+        }
+
+        const PandaVector<PandaString> &GetGroupNames() const
+        {
+            return groupNames_;
+        }
+
+        const RegExpPrefilter *GetPrefilter() const
+        {
+            return &prefilter_;
+        }
+
+        RegExpDfa *GetDfa()
+        {
+            return dfa_.IsSupported() ? &dfa_ : nullptr;
+        }
+
+    private:
+        friend class RegExpCache;
+
+        PandaString pattern_;
+        uint32_t flags_;
+        PandaVector<uint8_t> byteCode_;
+        PandaVector<PandaString> groupNames_;
+        RegExpPrefilter prefilter_;
+        // Refers to byteCode_, which is never reallocated
+        RegExpDfa dfa_;
+        uint32_t refCount_ {0};
+        bool isEvicted_ {false};
+        PandaList<Entry *>::iterator lruPosition_;
+    };
+
+    RegExpCache() = default;
+    ~RegExpCache();
+
+    NO_COPY_SEMANTIC(RegExpCache);
+    NO_MOVE_SEMANTIC(RegExpCache);
+
+    /// Returns the program with a reference held for the caller or nullptr if the pattern is not cached
+    Entry *Acquire(const PandaString &pattern, uint32_t flags);
+
+    /// Caches the program of a successfully parsed pattern and returns it acquired
+    Entry *Add(const PandaString &pattern, uint32_t flags, const RegExpParser &parser);
+
+    void Release(Entry *entry);
+
+    /// Passes the reference acquired by the caller to the RegExp object
+    void AddOwner(ObjectHeader *owner, Entry *entry);
+
+    /// Drops the reference of a recompiled RegExp object, the program is released by the next sweep
+    void RemoveOwner(ObjectHeader *owner, Entry *entry);
+
+    /// Releases the programs of dead RegExp objects
+    void SweepOwners(const GCObjectVisitor &gcObjectVisitor);
+
+    /// Updates the owners moved by GC
+    void UpdateOwners();
+
+private:
+    using Key = std::pair<PandaString, uint32_t>;
+
+    void Touch(Entry *entry) REQUIRES(lock_);
+    void Evict() REQUIRES(lock_);
+
+    os::memory::Mutex lock_;
+    PandaMap<Key, Entry *> entries_ GUARDED_BY(lock_);
+    // Most recently used entries go first
+    PandaList<Entry *> lru_ GUARDED_BY(lock_);
+
+    // Taken before lock_
+    os::memory::Mutex ownersLock_;
+    // Keyed by the RegExp object, which refers to a single program at a time
+    PandaUnorderedMap<ObjectHeader *, Entry *> owners_ GUARDED_BY(ownersLock_);
+    // Programs of the recompiled objects, exec on another thread may still use them until the next sweep
+    PandaVector<Entry *> removedEntries_ GUARDED_BY(ownersLock_);
+};
+}  // namespace ark::ets
+
+#endif  // PANDA_PLUGINS_ETS_RUNTIME_REGEXP_CACHE_H
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -32,19 +32,28 @@ namespace ark::ets {
 
 bool EtsSharedMemory::Waiter::Wait(std::optional<uint64_t> timeout)
 {
-    auto mutex = &EtsCoroutine::GetCurrent()->GetPandaVM()->GetAtomicsMutex();
+    auto *coroutine = EtsCoroutine::GetCurrent();
+    auto *mutex = &coroutine->GetPandaVM()->GetAtomicsMutex();
     if (timeout.has_value()) {
-        auto ms = timeout.value();
-        return cv_.TimedWait(mutex, ms);
+        // Coroutine events have no timeout, so the timed wait still blocks the worker thread
+        ScopedNativeCodeThread n(coroutine);
+        return cv_.TimedWait(mutex, timeout.value());
     }
 
-    cv_.Wait(mutex);
+    // The event is locked before the mutex is released, so the notification cannot be lost
+    event_.Lock();
+    mutex->Unlock();
+    coroutine->GetCoroutineManager()->Await(&event_);  // will unlock the event
+    ScopedNativeCodeThread n(coroutine);
+    mutex->Lock();
     return false;
 }
 
 void EtsSharedMemory::Waiter::SignalAll()
 {
     cv_.SignalAll();
+    event_.SetHappened();
+    EtsCoroutine::GetCurrent()->GetCoroutineManager()->UnblockWaiters(&event_);
 }
 
 EtsSharedMemory *EtsSharedMemory::Create(size_t length)
@@ -81,7 +90,7 @@ void EtsSharedMemory::UnlinkWaiter(Waiter &waiter)
         next->SetPrev(prev);
     }
     if (GetHeadWaiter() == &waiter) {
-        SetHeadWaiter(nullptr);
+        SetHeadWaiter(next);
     }
 }
 
@@ -187,8 +196,6 @@ EtsSharedMemory::WaitResult Wait(EtsSharedMemory *mem, uint32_t byteOffset, Inte
         // 2. Wait
         bool timedOut = false;
         while (!waiter.IsNotified() && !timedOut) {
-            ScopedNativeCodeThread nCv(coroutine);
-
             timedOut = waiter.Wait(timeout);
             LOG(DEBUG, ATOMICS) << "Wait: woke up, waiter: " << reinterpret_cast<size_t>(&waiter);
         }
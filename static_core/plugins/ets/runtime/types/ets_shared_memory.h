@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -30,6 +30,7 @@
 #include "plugins/ets/runtime/ets_class_root.h"
 #include "plugins/ets/runtime/ets_vm.h"
 #include "plugins/ets/runtime/types/ets_array.h"
+#include "runtime/coroutines/coroutine_events.h"
 
 namespace ark::ets {
 
@@ -95,6 +96,11 @@ public:
     public:
         explicit Waiter(uint32_t offset) : offset_(offset) {}
 
+        /**
+         * Waits for the notification with the atomics mutex held, the mutex is released while waiting.
+         * Without a timeout only the current coroutine is suspended and the worker runs the other coroutines.
+         * @return true if the timeout has expired
+         */
         bool Wait(std::optional<uint64_t> timeout);
 
         void SignalAll();
@@ -138,6 +144,8 @@ public:
 
     private:
         os::memory::ConditionVariable cv_ {os::memory::ConditionVariable()};
+        // Happens on the notification, wakes up the suspended coroutine
+        GenericEvent event_;
         std::atomic<bool> notified_ {std::atomic<bool>(false)};
         uint32_t offset_;
 
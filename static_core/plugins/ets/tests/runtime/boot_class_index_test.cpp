@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "assembly-emitter.h"
+#include "assembly-parser.h"
+#include "libpandabase/os/file.h"
+#include "libpandabase/utils/logger.h"
+#include "libpandabase/utils/utf.h"
+#include "runtime/boot_class_index.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/class_linker_extension.h"
+#include "runtime/include/managed_thread.h"
+#include "runtime/include/runtime.h"
+#include "runtime/include/runtime_options.h"
+#include "runtime/include/thread_scopes.h"
+
+namespace ark::ets::test {
+
+class BootClassIndexTest : public testing::Test {
+public:
+    BootClassIndexTest()
+    {
+        std::remove(INDEX_FILE);
+    }
+
+    ~BootClassIndexTest() override
+    {
+        std::remove(INDEX_FILE);
+    }
+
+    NO_COPY_SEMANTIC(BootClassIndexTest);
+    NO_MOVE_SEMANTIC(BootClassIndexTest);
+
+protected:
+    static constexpr const char *INDEX_FILE = "boot_class_index_test.bin";
+
+    static void CreateRuntime(bool useIndex)
+    {
+        RuntimeOptions options;
+        options.SetShouldLoadBootPandaFiles(true);
+        options.SetShouldInitializeIntrinsics(false);
+        options.SetCompilerEnableJit(false);
+        options.SetGcType("epsilon");
+        options.SetLoadRuntimes({"ets"});
+        options.SetSnapshotDeserializeEnabled(false);
+        options.SetBootClassIndexEnabled(useIndex);
+
+        auto stdlib = std::getenv("PANDA_STD_LIB");
+        if (stdlib == nullptr) {
+            std::cerr << "PANDA_STD_LIB env variable should be set and point to etsstdlib.abc" << std::endl;
+            std::abort();
+        }
+        options.SetBootPandaFiles({stdlib});
+
+        Logger::InitializeStdLogging(Logger::Level::ERROR, 0);
+
+        ASSERT_TRUE(Runtime::Create(options));
+    }
+
+    static PandaVector<const uint8_t *> GetStdlibDescriptors()
+    {
+        const auto *pf = Runtime::GetCurrent()->GetClassLinker()->GetBootPandaFiles().front();
+        PandaVector<const uint8_t *> descriptors;
+        for (auto offset : pf->GetClasses()) {
+            panda_file::File::EntityId id(offset);
+            if (!pf->IsExternal(id)) {
+                descriptors.push_back(pf->GetStringData(id).data);
+            }
+        }
+        return descriptors;
+    }
+
+    static std::unique_ptr<const panda_file::File> EmitFile(const char *source)
+    {
+        pandasm::Parser parser;
+        auto res = parser.Parse(source);
+        return pandasm::AsmEmitter::Emit(res.Value());
+    }
+
+    // Both files define LDup;, each one also has a class of its own
+    static constexpr const char *FIRST_SOURCE = R"(
+        .language eTS
+        .record Dup {}
+        .record OnlyFirst {}
+    )";
+    static constexpr const char *SECOND_SOURCE = R"(
+        .language eTS
+        .record Dup {}
+        .record OnlySecond {}
+    )";
+};
+
+TEST_F(BootClassIndexTest, FindStdlibClasses)
+{
+    CreateRuntime(false);
+    const auto &bootFiles = Runtime::GetCurrent()->GetClassLinker()->GetBootPandaFiles();
+    BootClassIndex index;
+    ASSERT_TRUE(index.Build(bootFiles));
+    ASSERT_EQ(index.GetFilesCount(), bootFiles.size());
+
+    auto descriptors = GetStdlibDescriptors();
+    EXPECT_EQ(index.GetClassesCount(), descriptors.size());
+    for (const auto *descriptor : descriptors) {
+        auto [id, pf] = index.Find(descriptor);
+        ASSERT_TRUE(id.IsValid()) << utf::Mutf8AsCString(descriptor);
+        ASSERT_EQ(pf, bootFiles.front());
+        ASSERT_EQ(id, pf->GetClassId(descriptor));
+    }
+    EXPECT_FALSE(index.Find(utf::CStringAsMutf8("Lstd/core/NoSuchClass;")).first.IsValid());
+    EXPECT_FALSE(index.Find(utf::CStringAsMutf8("")).first.IsValid());
+    Runtime::Destroy();
+}
+
+TEST_F(BootClassIndexTest, SaveAndLoad)
+{
+    CreateRuntime(false);
+    const auto &bootFiles = Runtime::GetCurrent()->GetClassLinker()->GetBootPandaFiles();
+    {
+        BootClassIndex index;
+        ASSERT_TRUE(index.Build(bootFiles));
+        ASSERT_TRUE(index.Save(INDEX_FILE));
+    }
+
+    BootClassIndex index;
+    ASSERT_TRUE(index.Load(INDEX_FILE, bootFiles));
+    for (const auto *descriptor : GetStdlibDescriptors()) {
+        ASSERT_EQ(index.Find(descriptor).first, bootFiles.front()->GetClassId(descriptor));
+    }
+
+    // The index is valid only for the same boot files
+    EXPECT_FALSE(index.Load(INDEX_FILE, {}));
+    EXPECT_EQ(index.GetFilesCount(), 0U);
+    EXPECT_FALSE(index.Find(GetStdlibDescriptors().front()).first.IsValid());
+    EXPECT_FALSE(index.Load("boot_class_index_test_absent.bin", bootFiles));
+    Runtime::Destroy();
+}
+
+TEST_F(BootClassIndexTest, FirstDefinitionWins)
+{
+    CreateRuntime(false);
+    auto first = EmitFile(FIRST_SOURCE);
+    auto second = EmitFile(SECOND_SOURCE);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    BootClassIndex index;
+    ASSERT_TRUE(index.Build({first.get(), second.get()}));
+    EXPECT_EQ(index.GetFilesCount(), 2U);
+    EXPECT_EQ(index.GetClassesCount(), 3U);
+    auto dup = utf::CStringAsMutf8("LDup;");
+    EXPECT_EQ(index.Find(dup), BootClassIndex::ClassEntry(first->GetClassId(dup), first.get()));
+    auto onlySecond = utf::CStringAsMutf8("LOnlySecond;");
+    EXPECT_EQ(index.Find(onlySecond), BootClassIndex::ClassEntry(second->GetClassId(onlySecond), second.get()));
+    Runtime::Destroy();
+}
+
+// The boot files added after the index was built are searched by the class linker one by one
+TEST_F(BootClassIndexTest, FilesAddedAfterBuild)
+{
+    CreateRuntime(true);
+    {
+        auto *classLinker = Runtime::GetCurrent()->GetClassLinker();
+        auto *context = classLinker->GetExtension(panda_file::SourceLang::ETS)->GetBootContext();
+        auto first = EmitFile(FIRST_SOURCE);
+        auto second = EmitFile(SECOND_SOURCE);
+        ASSERT_NE(first, nullptr);
+        ASSERT_NE(second, nullptr);
+        const auto *firstFile = first.get();
+        const auto *secondFile = second.get();
+        classLinker->AddPandaFile(std::move(first));
+        classLinker->AddPandaFile(std::move(second));
+
+        ScopedManagedCodeThread scope(ManagedThread::GetCurrent());
+        Class *dup = classLinker->GetClass(utf::CStringAsMutf8("LDup;"), false, context);
+        ASSERT_NE(dup, nullptr);
+        EXPECT_EQ(dup->GetPandaFile(), firstFile);
+        Class *onlySecond = classLinker->GetClass(utf::CStringAsMutf8("LOnlySecond;"), false, context);
+        ASSERT_NE(onlySecond, nullptr);
+        EXPECT_EQ(onlySecond->GetPandaFile(), secondFile);
+        // The indexed stdlib classes are still found
+        EXPECT_NE(classLinker->GetClass(utf::CStringAsMutf8("Lstd/core/Object;"), false, context), nullptr);
+    }
+    Runtime::Destroy();
+}
+
+}  // namespace ark::ets::test
@@ -0,0 +1,167 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "libpandabase/os/file.h"
+#include "libpandabase/utils/logger.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/class_linker_extension.h"
+#include "runtime/include/coretypes/string.h"
+#include "runtime/include/managed_thread.h"
+#include "runtime/include/panda_vm.h"
+#include "runtime/include/runtime.h"
+#include "runtime/include/runtime_options.h"
+#include "runtime/include/thread_scopes.h"
+#include "runtime/startup_snapshot.h"
+#include "runtime/string_table.h"
+
+namespace ark::ets::test {
+
+class StartupSnapshotTest : public testing::Test {
+public:
+    StartupSnapshotTest()
+    {
+        std::remove(SNAPSHOT_FILE);
+    }
+
+    ~StartupSnapshotTest() override
+    {
+        std::remove(SNAPSHOT_FILE);
+    }
+
+    NO_COPY_SEMANTIC(StartupSnapshotTest);
+    NO_MOVE_SEMANTIC(StartupSnapshotTest);
+
+protected:
+    static constexpr const char *SNAPSHOT_FILE = "startup_snapshot_test.bin";
+
+    static void CreateRuntime(bool serialize, bool deserialize)
+    {
+        RuntimeOptions options;
+        options.SetShouldLoadBootPandaFiles(true);
+        options.SetShouldInitializeIntrinsics(false);
+        options.SetCompilerEnableJit(false);
+        options.SetGcType("epsilon");
+        options.SetLoadRuntimes({"ets"});
+        options.SetSnapshotSerializeEnabled(serialize);
+        options.SetSnapshotDeserializeEnabled(deserialize);
+        options.SetSnapshotFile(SNAPSHOT_FILE);
+
+        auto stdlib = std::getenv("PANDA_STD_LIB");
+        if (stdlib == nullptr) {
+            std::cerr << "PANDA_STD_LIB env variable should be set and point to etsstdlib.abc" << std::endl;
+            std::abort();
+        }
+        options.SetBootPandaFiles({stdlib});
+
+        Logger::InitializeStdLogging(Logger::Level::ERROR, 0);
+
+        ASSERT_TRUE(Runtime::Create(options));
+    }
+
+    static const panda_file::File *GetStdlib()
+    {
+        return Runtime::GetCurrent()->GetClassLinker()->GetBootPandaFiles().front();
+    }
+
+    /// Interns the names of all the stdlib classes as the string ids, as a long-running app resolves its literals
+    static void InternClassNames()
+    {
+        auto *runtime = Runtime::GetCurrent();
+        ScopedManagedCodeThread scope(ManagedThread::GetCurrent());
+        const auto *pf = GetStdlib();
+        auto ctx = runtime->GetLanguageContext(panda_file::SourceLang::ETS);
+        auto *stringTable = runtime->GetPandaVM()->GetStringTable();
+        for (auto offset : pf->GetClasses()) {
+            panda_file::File::EntityId id(offset);
+            if (pf->IsExternal(id)) {
+                continue;
+            }
+            stringTable->GetOrInternInternalString(*pf, id, ctx);
+        }
+    }
+};
+
+TEST_F(StartupSnapshotTest, SerializeAndDeserialize)
+{
+    CreateRuntime(true, false);
+    InternClassNames();
+    Runtime::Destroy();
+    {
+        auto file = os::file::Open(SNAPSHOT_FILE, os::file::Mode::READONLY);
+        ASSERT_TRUE(file.IsValid());
+        file.Close();
+    }
+
+    CreateRuntime(false, true);
+    {
+        auto *runtime = Runtime::GetCurrent();
+        ScopedManagedCodeThread scope(ManagedThread::GetCurrent());
+        const auto *pf = GetStdlib();
+        auto *stringTable = runtime->GetPandaVM()->GetStringTable();
+        size_t restored = 0;
+        for (auto offset : pf->GetClasses()) {
+            panda_file::File::EntityId id(offset);
+            if (pf->IsExternal(id)) {
+                continue;
+            }
+            auto *string = stringTable->GetInternalStringFast(*pf, id);
+            ASSERT_NE(string, nullptr);
+            // The restored string is the same as the one decoded from the file
+            auto ctx = runtime->GetLanguageContext(panda_file::SourceLang::ETS);
+            auto sd = pf->GetStringData(id);
+            auto *expected = coretypes::String::CreateFromMUtf8(sd.data, sd.utf16Length, sd.isAscii, ctx,
+                                                                runtime->GetPandaVM());
+            ASSERT_TRUE(coretypes::String::StringsAreEqual(string, expected));
+            ASSERT_EQ(string->GetHashcode(), expected->GetHashcode());
+            ++restored;
+        }
+        EXPECT_GT(restored, 0U);
+    }
+    Runtime::Destroy();
+}
+
+// Only the serialization has to be enabled explicitly, and a runtime without the snapshot file starts as before
+TEST_F(StartupSnapshotTest, DefaultOptions)
+{
+    RuntimeOptions options;
+    EXPECT_FALSE(options.IsSnapshotSerializeEnabled());
+    EXPECT_TRUE(options.IsSnapshotDeserializeEnabled());
+
+    CreateRuntime(false, true);
+    EXPECT_NE(GetStdlib(), nullptr);
+    Runtime::Destroy();
+}
+
+TEST_F(StartupSnapshotTest, MismatchedSnapshot)
+{
+    {
+        auto file = os::file::Open(SNAPSHOT_FILE, os::file::Mode::READWRITECREATE);
+        os::file::FileHolder holder(file);
+        uint32_t header[] = {StartupSnapshot::MAGIC, StartupSnapshot::VERSION, 1U, 0U, 0U};
+        ASSERT_TRUE(file.WriteAll(header, sizeof(header)));
+    }
+    CreateRuntime(false, false);
+    EXPECT_FALSE(StartupSnapshot::Deserialize(Runtime::GetCurrent(), SNAPSHOT_FILE));
+    EXPECT_FALSE(StartupSnapshot::Deserialize(Runtime::GetCurrent(), "startup_snapshot_test_absent.bin"));
+    Runtime::Destroy();
+}
+
+}  // namespace ark::ets::test
@@ -20,6 +20,7 @@ from pathlib import Path
 import os
 import subprocess
 import argparse
+import time
 
 SRC_PATH = os.path.realpath(os.path.dirname(__file__))
 
@@ -86,6 +87,7 @@ class EtsBenchmarksRunner:
         self.prefix = ["adb", "shell", f"LD_LIBRARY_PATH={args.libdir}"] if self.is_device else []
         self.ark_opts = ark_opts
         self.aot_opts = aot_opts
+        self.process_time = args.process_time
 
     def dump_output_to_file(self, pipe, file_ext):
         dumpfile = open(os.path.join(self.host_output_dir, self.current_bench_name, f"test.{file_ext}"), "w")
@@ -136,11 +138,15 @@ class EtsBenchmarksRunner:
         cmd = self.prefix + [self.ark, f"--boot-panda-files={self.stdlib_path}", "--load-runtimes=ets",
                                         "--compiler-ignore-failures=false"] \
                                         + self.ark_opts + additional_opts + [bin_filepath,  "_GLOBAL::main"]
+        start = time.monotonic()
         proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
         stdout, stderr = proc.communicate(timeout=5400)
+        process_time = time.monotonic() - start
         self.dump_stdout(stdout, "ark")
         if proc.returncode == 0:
             self.logger.debug(f"{self.current_bench_name} PASS")
+            if self.process_time:
+                return True, process_time
             return True, float(stdout.decode('ascii').split("\n")[0])
         self.logger.debug(f"{self.current_bench_name} FAIL (execute)")
         self.logger.debug("How to reproduce: " + " ".join(cmd) + "\n")
@@ -282,6 +288,8 @@ parser.add_argument("--test-name",
                     help="Run a specific benchmark.")
 parser.add_argument("--test-list",
                     help="List with benchmarks to be launched.")
+parser.add_argument("--process-time", action="store_true",
+                    help="Report the time of the whole ark process, the startup included, instead of the loop")
 parser.add_argument("--log-level", choices=["silence", "info", "debug"], default="info",
                     help="Log level. Default: '%(default)s'")
 
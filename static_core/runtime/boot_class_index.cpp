@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/boot_class_index.h"
+
+#include <algorithm>
+
+#include "libpandabase/os/file.h"
+#include "libpandabase/os/filesystem.h"
+#include "libpandabase/os/mem.h"
+#include "libpandabase/utils/hash.h"
+#include "libpandabase/utils/logger.h"
+#include "libpandabase/utils/utf.h"
+#include "libpandabase/utils/word_reader.h"
+#include "runtime/boot_files_header.h"
+
+namespace ark {
+
+/*
+ * Layout of the index file, all the values are 32-bit words:
+ *   magic, version, boot files (see boot_files_header.h),
+ *   number of classes, number of buckets, {seed} for every bucket,
+ *   number of slots, {descriptor hash, boot file index, class offset} for every slot.
+ */
+
+void BootClassIndex::Clear()
+{
+    files_.clear();
+    seeds_.clear();
+    slots_.clear();
+    classesCount_ = 0;
+}
+
+bool BootClassIndex::Build(const PandaVector<const panda_file::File *> &files)
+{
+    struct Key {
+        const uint8_t *descriptor;
+        uint32_t hash;
+        uint32_t fileIndex;
+        uint32_t classOffset;
+    };
+
+    Clear();
+    PandaVector<Key> keys;
+    for (uint32_t i = 0; i < files.size(); ++i) {
+        const auto *pf = files[i];
+        for (uint32_t offset : pf->GetClasses()) {
+            panda_file::File::EntityId id(offset);
+            if (pf->IsExternal(id)) {
+                continue;
+            }
+            const uint8_t *descriptor = pf->GetStringData(id).data;
+            keys.push_back({descriptor, GetHash32String(descriptor), i, offset});
+        }
+    }
+    // Stable sort keeps the files order, so the first definition of a class survives
+    std::stable_sort(keys.begin(), keys.end(), [](const Key &lhs, const Key &rhs) {
+        return lhs.hash != rhs.hash ? lhs.hash < rhs.hash
+                                    : utf::CompareMUtf8ToMUtf8(lhs.descriptor, rhs.descriptor) < 0;
+    });
+    keys.erase(std::unique(keys.begin(), keys.end(),
+                           [](const Key &lhs, const Key &rhs) {
+                               return lhs.hash == rhs.hash && utf::IsEqual(lhs.descriptor, rhs.descriptor);
+                           }),
+               keys.end());
+
+    size_t bucketsCount = keys.size() / BUCKET_SIZE + 1;
+    // Load factor 0.8 keeps the search of the seeds short
+    size_t slotsCount = keys.size() + keys.size() / 4U + 1;
+    PandaVector<PandaVector<uint32_t>> buckets(bucketsCount);
+    for (uint32_t i = 0; i < keys.size(); ++i) {
+        buckets[keys[i].hash % bucketsCount].push_back(i);
+    }
+    PandaVector<uint32_t> order(bucketsCount);
+    for (uint32_t i = 0; i < bucketsCount; ++i) {
+        order[i] = i;
+    }
+    // The largest buckets are placed first, while most of the slots are free
+    std::stable_sort(order.begin(), order.end(),
+                     [&buckets](uint32_t lhs, uint32_t rhs) { return buckets[lhs].size() > buckets[rhs].size(); });
+
+    seeds_.resize(bucketsCount, 0);
+    slots_.resize(slotsCount, {0, EMPTY_SLOT, 0});
+    PandaVector<uint32_t> positions;
+    for (uint32_t bucket : order) {
+        if (buckets[bucket].empty()) {
+            break;
+        }
+        uint32_t seed = 1;
+        for (; seed < MAX_SEED; ++seed) {
+            positions.clear();
+            for (uint32_t key : buckets[bucket]) {
+                uint32_t pos = GetHash32StringWithSeed(keys[key].descriptor, seed) % slotsCount;
+                if (slots_[pos].fileIndex != EMPTY_SLOT ||
+                    std::find(positions.begin(), positions.end(), pos) != positions.end()) {
+                    break;
+                }
+                positions.push_back(pos);
+            }
+            if (positions.size() == buckets[bucket].size()) {
+                break;
+            }
+        }
+        if (seed == MAX_SEED) {
+            LOG(WARNING, CLASS_LINKER) << "Cannot build the boot class index of " << keys.size() << " classes";
+            Clear();
+            return false;
+        }
+        seeds_[bucket] = seed;
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const auto &key = keys[buckets[bucket][i]];
+            slots_[positions[i]] = {key.hash, key.fileIndex, key.classOffset};
+        }
+    }
+    files_ = files;
+    classesCount_ = keys.size();
+    LOG(DEBUG, CLASS_LINKER) << "Built the boot class index of " << classesCount_ << " classes in " << files_.size()
+                             << " boot panda files";
+    return true;
+}
+
+BootClassIndex::ClassEntry BootClassIndex::Find(const uint8_t *descriptor) const
+{
+    if (classesCount_ == 0) {
+        return {};
+    }
+    uint32_t hash = GetHash32String(descriptor);
+    uint32_t seed = seeds_[hash % seeds_.size()];
+    const Slot &slot = slots_[GetHash32StringWithSeed(descriptor, seed) % slots_.size()];
+    if (slot.fileIndex == EMPTY_SLOT || slot.hash != hash) {
+        return {};
+    }
+    const auto *pf = files_[slot.fileIndex];
+    panda_file::File::EntityId id(slot.classOffset);
+    if (utf::CompareMUtf8ToMUtf8(pf->GetStringData(id).data, descriptor) != 0) {
+        return {};
+    }
+    return {id, pf};
+}
+
+bool BootClassIndex::Save(const std::string &fileName) const
+{
+    PandaVector<uint8_t> data;
+    WriteWord(&data, MAGIC);
+    WriteWord(&data, VERSION);
+    WriteBootFiles(&data, files_);
+    WriteWord(&data, static_cast<uint32_t>(classesCount_));
+    WriteWord(&data, static_cast<uint32_t>(seeds_.size()));
+    for (uint32_t seed : seeds_) {
+        WriteWord(&data, seed);
+    }
+    WriteWord(&data, static_cast<uint32_t>(slots_.size()));
+    for (const auto &slot : slots_) {
+        WriteWord(&data, slot.hash);
+        WriteWord(&data, slot.fileIndex);
+        WriteWord(&data, slot.classOffset);
+    }
+
+    // The index is written aside and renamed, so the processes which are reading the old one are not affected
+    bool written = os::WriteFileAtomically(
+        fileName, [&data](const os::file::File &file) { return file.WriteAll(data.data(), data.size()); });
+    if (!written) {
+        LOG(ERROR, CLASS_LINKER) << "Cannot write boot class index file '" << fileName << "'";
+        return false;
+    }
+    return true;
+}
+
+bool BootClassIndex::Load(const std::string &fileName, const PandaVector<const panda_file::File *> &files)
+{
+    Clear();
+    auto file = os::file::Open(fileName, os::file::Mode::READONLY);
+    if (!file.IsValid()) {
+        LOG(DEBUG, CLASS_LINKER) << "No boot class index file '" << fileName << "'";
+        return false;
+    }
+    os::file::FileHolder holder(file);
+    auto size = file.GetFileSize();
+    if (!size.HasValue() || size.Value() == 0) {
+        return false;
+    }
+    auto mapping = os::mem::MapFile(file, os::mem::MMAP_PROT_READ, os::mem::MMAP_FLAG_PRIVATE, size.Value());
+    if (mapping.Get() == nullptr) {
+        LOG(ERROR, CLASS_LINKER) << "Cannot map boot class index file '" << fileName << "'";
+        return false;
+    }
+
+    WordReader reader(reinterpret_cast<const uint8_t *>(mapping.Get()), size.Value());
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t classesCount = 0;
+    uint32_t bucketsCount = 0;
+    if (!reader.Read(&magic) || magic != MAGIC || !reader.Read(&version) || version != VERSION ||
+        !CheckBootFiles(&reader, files) || !reader.Read(&classesCount) || !reader.Read(&bucketsCount) ||
+        bucketsCount == 0) {
+        LOG(INFO, CLASS_LINKER) << "Boot class index '" << fileName << "' doesn't match the boot panda files";
+        return false;
+    }
+    if (!reader.HasWords(bucketsCount)) {
+        return false;
+    }
+    seeds_.resize(bucketsCount);
+    for (auto &seed : seeds_) {
+        if (!reader.Read(&seed)) {
+            Clear();
+            return false;
+        }
+    }
+    uint32_t slotsCount = 0;
+    constexpr size_t SLOT_WORDS = 3;
+    if (!reader.Read(&slotsCount) || slotsCount == 0 ||
+        !reader.HasWords(static_cast<uint64_t>(slotsCount) * SLOT_WORDS)) {
+        Clear();
+        return false;
+    }
+    slots_.resize(slotsCount);
+    for (auto &slot : slots_) {
+        if (!reader.Read(&slot.hash) || !reader.Read(&slot.fileIndex) || !reader.Read(&slot.classOffset)) {
+            Clear();
+            return false;
+        }
+        if (slot.fileIndex == EMPTY_SLOT) {
+            continue;
+        }
+        // The offsets are dereferenced by Find, so they must stay inside the files even if the index is corrupted
+        if (slot.fileIndex >= files.size() || slot.classOffset >= files[slot.fileIndex]->GetHeader()->fileSize) {
+            Clear();
+            return false;
+        }
+    }
+    files_ = files;
+    classesCount_ = classesCount;
+    LOG(DEBUG, CLASS_LINKER) << "Loaded the boot class index '" << fileName << "' of " << classesCount_ << " classes";
+    return true;
+}
+
+}  // namespace ark
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_BOOT_CLASS_INDEX_H
+#define PANDA_RUNTIME_BOOT_CLASS_INDEX_H
+
+#include <string>
+#include <utility>
+
+#include "libpandabase/macros.h"
+#include "libpandafile/file.h"
+#include "runtime/include/mem/panda_containers.h"
+
+namespace ark {
+
+/**
+ * Index of the classes defined in the boot panda files, a perfect hash of their descriptors built by the
+ * hash-and-displace scheme: the hash of a descriptor selects a bucket and the seed of the bucket selects the slot.
+ * A lookup costs two hashes and one comparison of descriptors instead of a binary search in every boot file.
+ * Foreign classes are not indexed, a class defined in several boot files is taken from the first one.
+ *
+ * The index covers the boot files loaded before it was built. It can be saved to a file, which is valid only
+ * for the same boot files identified by their names and checksums.
+ */
+class BootClassIndex {
+public:
+    using ClassEntry = std::pair<panda_file::File::EntityId, const panda_file::File *>;
+
+    BootClassIndex() = default;
+    ~BootClassIndex() = default;
+
+    NO_COPY_SEMANTIC(BootClassIndex);
+    NO_MOVE_SEMANTIC(BootClassIndex);
+
+    /// Returns false and leaves the index empty if no perfect hash is found
+    PANDA_PUBLIC_API bool Build(const PandaVector<const panda_file::File *> &files);
+
+    PANDA_PUBLIC_API bool Load(const std::string &fileName, const PandaVector<const panda_file::File *> &files);
+
+    PANDA_PUBLIC_API bool Save(const std::string &fileName) const;
+
+    /// Returns an invalid id if the class is not defined in the indexed files
+    PANDA_PUBLIC_API ClassEntry Find(const uint8_t *descriptor) const;
+
+    /// The index covers this number of the first boot files
+    size_t GetFilesCount() const
+    {
+        return files_.size();
+    }
+
+    size_t GetClassesCount() const
+    {
+        return classesCount_;
+    }
+
+    static constexpr uint32_t MAGIC = 0x58494342U;  // "BCIX"
+    static constexpr uint32_t VERSION = 1U;
+
+private:
+    struct Slot {
+        uint32_t hash;
+        uint32_t fileIndex;
+        uint32_t classOffset;
+    };
+
+    // File index of an empty slot
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+    // Average number of descriptors in a bucket
+    static constexpr size_t BUCKET_SIZE = 4;
+    static constexpr uint32_t MAX_SEED = 1U << 16U;
+
+    void Clear();
+
+    PandaVector<const panda_file::File *> files_;
+    PandaVector<uint32_t> seeds_;
+    PandaVector<Slot> slots_;
+    size_t classesCount_ {0};
+};
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_BOOT_CLASS_INDEX_H
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/boot_files_header.h"
+
+#include <string_view>
+
+#include "libpandabase/utils/bit_utils.h"
+
+namespace ark {
+
+void WriteWord(PandaVector<uint8_t> *data, uint32_t value)
+{
+    WritePaddedData(data, reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+}
+
+void WritePaddedData(PandaVector<uint8_t> *data, const uint8_t *value, size_t size)
+{
+    data->insert(data->end(), value, value + size);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    data->resize(RoundUp(data->size(), sizeof(uint32_t)), 0);
+}
+
+void WriteBootFiles(PandaVector<uint8_t> *data, const PandaVector<const panda_file::File *> &bootFiles)
+{
+    WriteWord(data, static_cast<uint32_t>(bootFiles.size()));
+    for (const auto *pf : bootFiles) {
+        const auto &name = pf->GetFilename();
+        WriteWord(data, pf->GetHeader()->checksum);
+        WriteWord(data, static_cast<uint32_t>(name.size()));
+        WritePaddedData(data, reinterpret_cast<const uint8_t *>(name.data()), name.size());
+    }
+}
+
+bool CheckBootFiles(WordReader *reader, const PandaVector<const panda_file::File *> &bootFiles)
+{
+    uint32_t count = 0;
+    if (!reader->Read(&count) || count != bootFiles.size()) {
+        return false;
+    }
+    for (const auto *pf : bootFiles) {
+        uint32_t checksum = 0;
+        uint32_t nameLength = 0;
+        if (!reader->Read(&checksum) || !reader->Read(&nameLength) || checksum != pf->GetHeader()->checksum) {
+            return false;
+        }
+        const auto *name = reinterpret_cast<const char *>(reader->ReadData(nameLength));
+        if (name == nullptr || pf->GetFilename() != std::string_view(name, nameLength)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace ark
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_BOOT_FILES_HEADER_H
+#define PANDA_RUNTIME_BOOT_FILES_HEADER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "libpandabase/utils/word_reader.h"
+#include "libpandafile/file.h"
+#include "runtime/include/mem/panda_containers.h"
+
+namespace ark {
+
+/*
+ * The files which the runtime derives from the boot panda files, the startup snapshot and the boot class index,
+ * consist of 32-bit words with the byte data padded to the word size. They store the boot files they are valid for:
+ *   number of boot files, {checksum, name length, name} for every boot file.
+ */
+
+void WriteWord(PandaVector<uint8_t> *data, uint32_t value);
+
+void WritePaddedData(PandaVector<uint8_t> *data, const uint8_t *value, size_t size);
+
+void WriteBootFiles(PandaVector<uint8_t> *data, const PandaVector<const panda_file::File *> &bootFiles);
+
+/// Returns false if the stored boot files differ from the given ones in the order, the names or the checksums
+bool CheckBootFiles(WordReader *reader, const PandaVector<const panda_file::File *> &bootFiles);
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_BOOT_FILES_HEADER_H
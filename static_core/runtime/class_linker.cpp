@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -182,9 +182,10 @@ bool ClassLinker::InitializeRoots(ManagedThread *thread)
 using ClassEntry = std::pair<panda_file::File::EntityId, const panda_file::File *>;
 using PandaFiles = PandaVector<const panda_file::File *>;
 
-static ClassEntry FindClassInPandaFiles(const uint8_t *descriptor, const PandaFiles &pandaFiles)
+static ClassEntry FindClassInPandaFiles(const uint8_t *descriptor, const PandaFiles &pandaFiles, size_t first = 0)
 {
-    for (auto *pf : pandaFiles) {
+    for (size_t i = first; i < pandaFiles.size(); ++i) {
+        auto *pf = pandaFiles[i];
         auto classId = pf->GetClassId(descriptor);
         if (classId.IsValid() && !pf->IsExternal(classId)) {
             return {classId, pf};
@@ -194,6 +195,27 @@ static ClassEntry FindClassInPandaFiles(const uint8_t *descriptor, const PandaFi
     return {};
 }
 
+ClassEntry ClassLinker::FindClassInBootPandaFiles(const uint8_t *descriptor)
+{
+    auto entry = bootClassIndex_.Find(descriptor);
+    if (entry.first.IsValid()) {
+        return entry;
+    }
+    return FindClassInPandaFiles(descriptor, bootPandaFiles_, bootClassIndex_.GetFilesCount());
+}
+
+void ClassLinker::BuildBootClassIndex(const std::string &fileName)
+{
+    SCOPED_TRACE_STREAM << __FUNCTION__;
+    os::memory::LockHolder lock {bootPandaFilesLock_};
+    if (!fileName.empty() && bootClassIndex_.Load(fileName, bootPandaFiles_)) {
+        return;
+    }
+    if (bootClassIndex_.Build(bootPandaFiles_) && !fileName.empty()) {
+        bootClassIndex_.Save(fileName);
+    }
+}
+
 Class *ClassLinker::FindLoadedClass(const uint8_t *descriptor, ClassLinkerContext *context)
 {
     ASSERT(context != nullptr);
@@ -1180,7 +1202,7 @@ Class *ClassLinker::GetClass(const uint8_t *descriptor, bool needCopyDescriptor,
         {
             {
                 os::memory::LockHolder lock {bootPandaFilesLock_};
-                std::tie(classId, pandaFile) = FindClassInPandaFiles(descriptor, bootPandaFiles_);
+                std::tie(classId, pandaFile) = FindClassInBootPandaFiles(descriptor);
             }
 
             if (!classId.IsValid()) {
@@ -1234,7 +1256,7 @@ Class *ClassLinker::GetClass(const panda_file::File &pf, panda_file::File::Entit
         panda_file::File::EntityId extId;
         {
             os::memory::LockHolder lock {bootPandaFilesLock_};
-            std::tie(extId, pfPtr) = FindClassInPandaFiles(descriptor, bootPandaFiles_);
+            std::tie(extId, pfPtr) = FindClassInBootPandaFiles(descriptor);
         }
 
         if (!extId.IsValid()) {
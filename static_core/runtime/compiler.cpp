@@ -781,7 +781,7 @@ InlineCachesWrapper::CallKind InlineCachesWrapper::GetClasses(PandaRuntimeInterf
     auto method = static_cast<Method *>(m);
     auto profilingData = method->GetProfilingData();
     if (profilingData == nullptr) {
-        return CallKind::UNKNOWN;
+        return GetClassesFromProfile(method, pc, classes);
     }
     auto ic = profilingData->FindInlineCache(pc);
     if (ic == nullptr) {
@@ -801,9 +801,39 @@ InlineCachesWrapper::CallKind InlineCachesWrapper::GetClasses(PandaRuntimeInterf
     return CallKind::POLYMORPHIC;
 }
 
+InlineCachesWrapper::CallKind InlineCachesWrapper::GetClassesFromProfile(
+    Method *method, uintptr_t pc, ArenaVector<RuntimeInterface::ClassPtr> *classes)
+{
+    auto ic = profile_->FindInlineCache(*method, pc);
+    if (ic == nullptr) {
+        return CallKind::UNKNOWN;
+    }
+    if (ic->megamorphic) {
+        return CallKind::MEGAMORPHIC;
+    }
+    ScopedMutatorLock lock;
+    ErrorHandler handler;
+    auto *classLinker = Runtime::GetCurrent()->GetClassLinker();
+    auto *context = method->GetClass()->GetLoadContext();
+    for (const auto &descriptor : ic->receivers) {
+        auto *klass = classLinker->GetClass(utf::CStringAsMutf8(descriptor.c_str()), true, context, &handler);
+        if (klass == nullptr) {
+            // The profile doesn't match the classes of the application
+            classes->clear();
+            return CallKind::UNKNOWN;
+        }
+        classes->push_back(klass);
+    }
+    if (classes->empty()) {
+        return CallKind::UNKNOWN;
+    }
+    return classes->size() == 1 ? CallKind::MONOMORPHIC : CallKind::POLYMORPHIC;
+}
+
 bool UnresolvedTypesWrapper::AddTableSlot(RuntimeInterface::MethodPtr method, uint32_t typeId, SlotKind kind)
 {
     std::pair<uint32_t, UnresolvedTypesInterface::SlotKind> key {typeId, kind};
+    os::memory::LockHolder lock(slotsLock_);
     if (slots_.find(method) == slots_.end()) {
         slots_[method][key] = 0;
         return true;
@@ -818,6 +848,7 @@ bool UnresolvedTypesWrapper::AddTableSlot(RuntimeInterface::MethodPtr method, ui
 
 uintptr_t UnresolvedTypesWrapper::GetTableSlot(RuntimeInterface::MethodPtr method, uint32_t typeId, SlotKind kind) const
 {
+    os::memory::LockHolder lock(slotsLock_);
     ASSERT(slots_.find(method) != slots_.end());
     auto &table = slots_.at(method);
     ASSERT(table.find({typeId, kind}) != table.end());
@@ -863,13 +894,6 @@ bool Compiler::CompileMethod(Method *method, uintptr_t bytecodeOffset, bool osr,
     return false;
 }
 
-template <compiler::TaskRunnerMode RUNNER_MODE>
-void Compiler::CompileMethodLocked(compiler::CompilerTaskRunner<RUNNER_MODE> taskRunner)
-{
-    os::memory::LockHolder lock(compilationLock_);
-    StartCompileMethod<RUNNER_MODE>(std::move(taskRunner));
-}
-
 template <compiler::TaskRunnerMode RUNNER_MODE>
 void Compiler::StartCompileMethod(compiler::CompilerTaskRunner<RUNNER_MODE> taskRunner)
 {
@@ -991,10 +1015,6 @@ uint8_t CompileMethodImpl(coretypes::String *fullMethodName, panda_file::SourceL
 }
 #endif  // PANDA_PRODUCT_BUILD
 
-template void Compiler::CompileMethodLocked<compiler::BACKGROUND_MODE>(
-    compiler::CompilerTaskRunner<compiler::BACKGROUND_MODE>);
-template void Compiler::CompileMethodLocked<compiler::INPLACE_MODE>(
-    compiler::CompilerTaskRunner<compiler::INPLACE_MODE>);
 template void Compiler::StartCompileMethod<compiler::BACKGROUND_MODE>(
     compiler::CompilerTaskRunner<compiler::BACKGROUND_MODE>);
 template void Compiler::StartCompileMethod<compiler::INPLACE_MODE>(
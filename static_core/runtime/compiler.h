@@ -30,6 +30,7 @@
 #include "runtime/include/method.h"
 #include "runtime/include/runtime_options.h"
 #include "runtime/interpreter/frame.h"
+#include "runtime/jit/profiling_loader.h"
 #include "runtime/mem/gc/gc_barrier_set.h"
 #include "runtime/mem/tlab.h"
 #include "runtime/compiler_thread_pool_worker.h"
@@ -67,8 +68,15 @@ public:
 
 class PANDA_PUBLIC_API InlineCachesWrapper : public compiler::InlineCachesInterface {
 public:
+    explicit InlineCachesWrapper(const ProfilingLoader *profile) : profile_(profile) {}
+
     CallKind GetClasses(RuntimeInterface::MethodPtr m, uintptr_t pc,
                         ArenaVector<RuntimeInterface::ClassPtr> *classes) override;
+
+private:
+    CallKind GetClassesFromProfile(Method *method, uintptr_t pc, ArenaVector<RuntimeInterface::ClassPtr> *classes);
+
+    const ProfilingLoader *profile_;
 };
 
 class PANDA_PUBLIC_API UnresolvedTypesWrapper : public UnresolvedTypesInterface {
@@ -77,7 +85,10 @@ public:
     uintptr_t GetTableSlot(RuntimeInterface::MethodPtr method, uint32_t typeId, SlotKind kind) const override;
 
 private:
-    PandaMap<RuntimeInterface::MethodPtr, PandaMap<std::pair<uint32_t, SlotKind>, uintptr_t>> slots_;
+    // JIT threads add slots in parallel, the map nodes are never moved so the slot addresses stay valid
+    mutable os::memory::Mutex slotsLock_;
+    PandaMap<RuntimeInterface::MethodPtr, PandaMap<std::pair<uint32_t, SlotKind>, uintptr_t>> slots_
+        GUARDED_BY(slotsLock_);
 };
 
 class PANDA_PUBLIC_API PandaRuntimeInterface : public RuntimeInterface {
@@ -326,19 +337,28 @@ public:
         return std::string(MethodCast(method)->GetLineNumberAndSourceFile(pc));
     }
 
+    // The counters of the methods, which are not profiled in this run, are taken from the profile added by AddProfile
     int64_t GetBranchTakenCounter(MethodPtr method, uint32_t pc) const override
     {
-        return MethodCast(method)->GetBranchTakenCounter(pc);
+        auto *m = MethodCast(method);
+        return m->IsProfiling() ? m->GetBranchTakenCounter(pc) : profile_.GetBranchTakenCounter(*m, pc);
     }
 
     int64_t GetBranchNotTakenCounter(MethodPtr method, uint32_t pc) const override
     {
-        return MethodCast(method)->GetBranchNotTakenCounter(pc);
+        auto *m = MethodCast(method);
+        return m->IsProfiling() ? m->GetBranchNotTakenCounter(pc) : profile_.GetBranchNotTakenCounter(*m, pc);
     }
 
     int64_t GetThrowTakenCounter(MethodPtr method, uint32_t pc) const override
     {
-        return MethodCast(method)->GetThrowTakenCounter(pc);
+        auto *m = MethodCast(method);
+        return m->IsProfiling() ? m->GetThrowTakenCounter(pc) : profile_.GetThrowTakenCounter(*m, pc);
+    }
+
+    Expected<bool, const char *> AddProfile(std::string_view fname) override
+    {
+        return profile_.Load(fname);
     }
 
     std::string GetMethodFullName(MethodPtr method, bool withSignature) const override
@@ -619,8 +639,9 @@ private:
     }
 
 private:
+    ProfilingLoader profile_;
     ClassHierarchyAnalysisWrapper cha_;
-    InlineCachesWrapper inlineCaches_;
+    InlineCachesWrapper inlineCaches_ {&profile_};
     UnresolvedTypesWrapper unresolvedTypes_;
 };
 
@@ -690,10 +711,7 @@ public:
         compilerWorker_->AddTask(std::move(ctx));
     }
 
-    template <compiler::TaskRunnerMode RUNNER_MODE>
-    void CompileMethodLocked(compiler::CompilerTaskRunner<RUNNER_MODE> taskRunner);
-
-    /// Basic method, which starts compilation. Do not use.
+    /// Basic method, which starts compilation. Different methods may be compiled in parallel.
     template <compiler::TaskRunnerMode RUNNER_MODE>
     void StartCompileMethod(compiler::CompilerTaskRunner<RUNNER_MODE> taskRunner);
 
@@ -762,8 +780,6 @@ private:
     // This allocator is used for GDB debug structures in context of JIT unwind info.
     ArenaAllocator gdbDebugInfoAllocator_;
     compiler::RuntimeInterface *runtimeIface_;
-    // The lock is used for compiler thread synchronization
-    os::memory::Mutex compilationLock_;
     bool noAsyncJit_;
     CompilerWorker *compilerWorker_ {nullptr};
     compiler::JITStats *jitStats_ {nullptr};
@@ -0,0 +1,280 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PANDA_RUNTIME_COMPILER_QUEUE_HEAP_COUNTER_PRIORITY_H_
+#define PANDA_RUNTIME_COMPILER_QUEUE_HEAP_COUNTER_PRIORITY_H_
+
+#include <algorithm>
+
+#include "libpandabase/utils/time.h"
+#include "runtime/compiler_queue_interface.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/method-inl.h"
+
+namespace ark {
+
+/**
+ * The heap counter priority queue has the same semantic as the counter priority queue (see description):
+ * the hottest method (the lesser counter) is extracted first, old tasks are expired and the length is limited.
+ * But instead of sorting the whole queue on every access it keeps the tasks in an indexed binary heap,
+ * so both AddTask and GetTask are O(log n) (plus a constant number of counter refreshes).
+ * Hotness counters are refreshed lazily: the top of the heap is always refreshed before extraction,
+ * and a small batch of other elements is refreshed on every GetTask in a round-robin manner.
+ * Tasks with equal counters are ordered by their insertion order (older first).
+ * Expiration uses a list of the tasks ordered by their insertion timestamps, so only expired tasks are visited.
+ * This queue is thread unsafe (should be used under lock).
+ */
+class CompilerHeapCounterQueue : public CompilerQueueInterface {
+public:
+    explicit CompilerHeapCounterQueue(mem::InternalAllocatorPtr allocator, uint64_t maxLength, uint64_t taskLifeSpan)
+        : allocator_(allocator), heap_(allocator->Adapter()), maxLength_(maxLength), taskLifeSpan_(taskLifeSpan)
+    {
+    }
+
+    CompilerTask GetTask() override
+    {
+        RemoveExpired();
+        if (heap_.empty()) {
+            LOG(DEBUG, COMPILATION_QUEUE) << "Empty " << QUEUE_NAME << ", return nothing";
+            return CompilerTask();
+        }
+        RefreshBatch();
+        // The top must be up to date, otherwise another element may be hotter.
+        // The number of attempts is limited as the counters may be changed concurrently by the interpreter.
+        for (size_t attempts = heap_.size(); attempts > 0; --attempts) {
+            if (!RefreshCounter(heap_.front())) {
+                break;
+            }
+        }
+        auto element = heap_.front();
+        RemoveFromHeap(element);
+        Unlink(element);
+        auto task = std::move(element->GetContext());
+        allocator_->Delete(element);
+        LOG(DEBUG, COMPILATION_QUEUE) << "Extract a task from a " << QUEUE_NAME << ": " << GetTaskDescription(task);
+        return task;
+    }
+
+    // NOLINTNEXTLINE(google-default-arguments)
+    void AddTask(CompilerTask &&ctx, [[maybe_unused]] size_t priority = 0) override
+    {
+        RemoveExpired();
+        if (heap_.size() >= maxLength_) {
+            // Reset the counter of the rejected method
+            ctx.GetMethod()->ResetHotnessCounter();
+            ctx.GetMethod()->AtomicSetCompilationStatus(Method::WAITING,
+                                                        ctx.IsOsr() ? Method::COMPILED : Method::NOT_COMPILED);
+            LOG(DEBUG, COMPILATION_QUEUE) << "Skip adding the task " << GetTaskDescription(ctx)
+                                          << " due to limit of tasks (" << maxLength_ << ") in a " << QUEUE_NAME;
+            return;
+        }
+        LOG(DEBUG, COMPILATION_QUEUE) << "Add an element to a " << QUEUE_NAME << ": " << GetTaskDescription(ctx);
+        auto element = allocator_->New<Element>(std::move(ctx), nextSequence_++);
+        element->heapIndex = heap_.size();
+        heap_.push_back(element);
+        SiftUp(element->heapIndex);
+        // Timestamps are not decreasing, so the tail of the list is always the youngest task
+        element->prev = youngest_;
+        if (youngest_ != nullptr) {
+            youngest_->next = element;
+        } else {
+            oldest_ = element;
+        }
+        youngest_ = element;
+    }
+
+    void Finalize() override
+    {
+        for (auto e : heap_) {
+            allocator_->Delete(e);
+        }
+        heap_.clear();
+        oldest_ = nullptr;
+        youngest_ = nullptr;
+        LOG(DEBUG, COMPILATION_QUEUE) << "Clear a " << QUEUE_NAME;
+    }
+
+protected:
+    size_t GetQueueSize() override
+    {
+        return heap_.size();
+    }
+
+private:
+    static constexpr const char *QUEUE_NAME = "heap counter priority compilation queue";
+    // Number of elements with a refreshed counter per GetTask in addition to the top of the heap
+    static constexpr size_t REFRESH_BATCH_SIZE = 16;
+
+    // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+    struct Element {
+        Element(CompilerTask &&task, uint64_t seq)
+            : timestamp(time::GetCurrentTimeInMillis()),
+              counter(task.GetMethod()->GetHotnessCounter()),
+              sequence(seq),
+              context(std::move(task))
+        {
+        }
+
+        CompilerTask &GetContext()
+        {
+            return context;
+        }
+
+        uint64_t timestamp;
+        int64_t counter;
+        uint64_t sequence;
+        size_t heapIndex {0};
+        Element *prev {nullptr};
+        Element *next {nullptr};
+        CompilerTask context;
+    };
+    // NOLINTEND(misc-non-private-member-variables-in-classes)
+
+    static bool IsHotter(const Element *a, const Element *b)
+    {
+        if (a->counter == b->counter) {
+            return a->sequence < b->sequence;
+        }
+        return a->counter < b->counter;
+    }
+
+    void Place(Element *element, size_t index)
+    {
+        heap_[index] = element;
+        element->heapIndex = index;
+    }
+
+    void SiftUp(size_t index)
+    {
+        auto element = heap_[index];
+        while (index > 0) {
+            size_t parent = (index - 1U) / 2U;
+            if (!IsHotter(element, heap_[parent])) {
+                break;
+            }
+            Place(heap_[parent], index);
+            index = parent;
+        }
+        Place(element, index);
+    }
+
+    void SiftDown(size_t index)
+    {
+        auto element = heap_[index];
+        size_t size = heap_.size();
+        while (true) {
+            size_t child = 2U * index + 1U;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1U < size && IsHotter(heap_[child + 1U], heap_[child])) {
+                ++child;
+            }
+            if (!IsHotter(heap_[child], element)) {
+                break;
+            }
+            Place(heap_[child], index);
+            index = child;
+        }
+        Place(element, index);
+    }
+
+    void Fix(size_t index)
+    {
+        if (index > 0 && IsHotter(heap_[index], heap_[(index - 1U) / 2U])) {
+            SiftUp(index);
+        } else {
+            SiftDown(index);
+        }
+    }
+
+    /// @return true if the counter was changed and the element was moved in the heap
+    bool RefreshCounter(Element *element)
+    {
+        int64_t counter = element->GetContext().GetMethod()->GetHotnessCounter();
+        if (counter == element->counter) {
+            return false;
+        }
+        element->counter = counter;
+        Fix(element->heapIndex);
+        return true;
+    }
+
+    void RefreshBatch()
+    {
+        size_t count = std::min(REFRESH_BATCH_SIZE, heap_.size());
+        for (size_t i = 0; i < count; ++i) {
+            if (refreshCursor_ >= heap_.size()) {
+                refreshCursor_ = 0;
+            }
+            RefreshCounter(heap_[refreshCursor_++]);
+        }
+    }
+
+    void RemoveFromHeap(Element *element)
+    {
+        size_t index = element->heapIndex;
+        auto last = heap_.back();
+        heap_.pop_back();
+        if (last != element) {
+            Place(last, index);
+            Fix(index);
+        }
+    }
+
+    void Unlink(Element *element)
+    {
+        if (element->prev != nullptr) {
+            element->prev->next = element->next;
+        } else {
+            oldest_ = element->next;
+        }
+        if (element->next != nullptr) {
+            element->next->prev = element->prev;
+        } else {
+            youngest_ = element->prev;
+        }
+    }
+
+    void RemoveExpired()
+    {
+        uint64_t curStamp = time::GetCurrentTimeInMillis();
+        while (oldest_ != nullptr && curStamp - oldest_->timestamp >= taskLifeSpan_) {
+            auto element = oldest_;
+            LOG(DEBUG, COMPILATION_QUEUE) << "Remove an expired element from a " << QUEUE_NAME << ": "
+                                          << GetTaskDescription(element->GetContext());
+            RemoveFromHeap(element);
+            Unlink(element);
+            auto ctx = std::move(element->GetContext());
+            ctx.GetMethod()->AtomicSetCompilationStatus(Method::WAITING,
+                                                        ctx.IsOsr() ? Method::COMPILED : Method::NOT_COMPILED);
+            allocator_->Delete(element);
+        }
+    }
+
+    mem::InternalAllocatorPtr allocator_;
+    PandaVector<Element *> heap_;
+    // The list of all elements ordered by timestamp, used for expiration
+    Element *oldest_ {nullptr};
+    Element *youngest_ {nullptr};
+    uint64_t nextSequence_ {0};
+    size_t refreshCursor_ {0};
+    uint64_t maxLength_;
+    // In milliseconds
+    uint64_t taskLifeSpan_;
+};
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_COMPILER_QUEUE_HEAP_COUNTER_PRIORITY_H_
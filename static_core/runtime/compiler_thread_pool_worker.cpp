@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,13 +17,15 @@
 #include "runtime/compiler_thread_pool_worker.h"
 #include "runtime/compiler_queue_simple.h"
 #include "runtime/compiler_queue_aged_counter_priority.h"
+#include "runtime/compiler_queue_heap_counter_priority.h"
 #include "compiler/inplace_task_runner.h"
 
 namespace ark {
 
 CompilerThreadPoolWorker::CompilerThreadPoolWorker(mem::InternalAllocatorPtr internalAllocator, Compiler *compiler,
                                                    bool &noAsyncJit, const RuntimeOptions &options)
-    : CompilerWorker(internalAllocator, compiler)
+    : CompilerWorker(internalAllocator, compiler),
+      threadsCount_(std::max<size_t>(options.GetCompilerThreadsCount(), 1U))
 {
     queue_ = CreateJITTaskQueue(noAsyncJit ? "simple" : options.GetCompilerQueueType(),
                                 options.GetCompilerQueueMaxLength(), options.GetCompilerTaskLifeSpan(),
@@ -55,13 +57,28 @@ CompilerQueueInterface *CompilerThreadPoolWorker::CreateJITTaskQueue(const std::
         return internalAllocator_->New<CompilerPriorityCounterQueue>(internalAllocator_, maxLength, taskLife);
     }
     if (queueType == "aged-counter-priority") {
-        return internalAllocator_->New<CompilerPriorityAgedCounterQueue>(internalAllocator_, taskLife, deathCounter,
+        return internalAllocator_->New<CompilerPriorityAgedCounterQueue>(internalAllocator_, maxLength, deathCounter,
                                                                          epochDuration);
     }
+    if (queueType == "heap-counter-priority") {
+        return internalAllocator_->New<CompilerHeapCounterQueue>(internalAllocator_, maxLength, taskLife);
+    }
     LOG(FATAL, COMPILER) << "Unknown queue type";
     return nullptr;
 }
 
+void CompilerThreadPoolWorker::AddTask(CompilerTask &&ctx)
+{
+    // The task is not moved if it is not added
+    if (threadPool_->TryPutTask(std::move(ctx))) {
+        return;
+    }
+    LOG(DEBUG, COMPILER) << "Compiler queue is full, skip the method "
+                         << reinterpret_cast<const char *>(ctx.GetMethod()->GetName().data);
+    ctx.GetMethod()->ResetHotnessCounter();
+    ctx.GetMethod()->AtomicSetCompilationStatus(Method::WAITING, ctx.IsOsr() ? Method::COMPILED : Method::NOT_COMPILED);
+}
+
 bool CompilerProcessor::Process(CompilerTask &&task)
 {
     InPlaceCompileMethod(std::move(task));
@@ -81,7 +98,7 @@ void CompilerProcessor::InPlaceCompileMethod(CompilerTask &&ctx)
     ScopedCurrentThread sct(&compilerThread);
 
     if (compilerCtx.GetMethod()->AtomicSetCompilationStatus(Method::WAITING, Method::COMPILATION)) {
-        compiler_->CompileMethodLocked<compiler::INPLACE_MODE>(std::move(taskRunner));
+        compiler_->StartCompileMethod<compiler::INPLACE_MODE>(std::move(taskRunner));
     }
 }
 
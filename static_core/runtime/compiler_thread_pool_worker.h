@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -43,7 +43,7 @@ public:
     void InitializeWorker() override
     {
         threadPool_ = internalAllocator_->New<ThreadPool<CompilerTask, CompilerProcessor, Compiler *>>(
-            internalAllocator_, queue_, compiler_, 1, "JIT Thread");
+            internalAllocator_, queue_, compiler_, threadsCount_, "JIT Thread");
     }
 
     void FinalizeWorker() override
@@ -67,10 +67,8 @@ public:
         return !threadPool_->IsActive();
     }
 
-    void AddTask(CompilerTask &&ctx) override
-    {
-        threadPool_->PutTask(std::move(ctx));
-    }
+    /// Never blocks the caller: the task is rejected when the queue is full, so the method may become hot again later
+    void AddTask(CompilerTask &&ctx) override;
 
     ThreadPool<CompilerTask, CompilerProcessor, Compiler *> *GetThreadPool()
     {
@@ -83,6 +81,7 @@ private:
 
     // This queue is used only in ThreadPool. Do not use it from this class.
     CompilerQueueInterface *queue_ {nullptr};
+    size_t threadsCount_ {1};
     ThreadPool<CompilerTask, CompilerProcessor, Compiler *> *threadPool_ {nullptr};
 };
 
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <limits>
@@ -158,6 +159,29 @@ String *String::CreateFromUtf16(const uint16_t *utf16Data, uint32_t utf16Length,
     return string;
 }
 
+/* static */
+String *String::CreateFromStringData(const uint8_t *data, uint32_t length, bool compressed, uint32_t hashcode,
+                                     const LanguageContext &ctx, PandaVM *vm, bool movable)
+{
+    auto string = AllocStringObject(length, compressed, ctx, vm, movable);
+    if (string == nullptr) {
+        return nullptr;
+    }
+
+    // After copying we should have a full barrier, so this writes should happen-before barrier
+    TSAN_ANNOTATE_IGNORE_WRITES_BEGIN();
+    if (length != 0) {
+        auto *dst = compressed ? string->GetDataMUtf8() : reinterpret_cast<uint8_t *>(string->GetDataUtf16());
+        size_t dataSize = compressed ? length : ComputeDataSizeUtf16(length);
+        memcpy_s(dst, dataSize, data, dataSize);
+    }
+    string->SetHashcode(hashcode);
+    TSAN_ANNOTATE_IGNORE_WRITES_END();
+    // String is supposed to be a constant object, so all its data should be visible by all threads
+    arch::FullMemoryBarrier();
+    return string;
+}
+
 /* static */
 String *String::CreateEmptyString(const LanguageContext &ctx, PandaVM *vm)
 {
@@ -997,17 +1021,14 @@ String *String::Concat(String *string1, String *string2, const LanguageContext &
     } else {
         Span<uint16_t> sp(newString->GetDataUtf16(), newLength);
         if (!string1->IsUtf16()) {
-            for (uint32_t i = 0; i < length1; ++i) {
-                sp[i] = string1->At<false>(i);
-            }
+            // Widen the compressed data without the per-character checks of At()
+            std::copy_n(string1->GetDataMUtf8(), length1, sp.Data());
         } else {
             memcpy_s(sp.Data(), sp.SizeBytes(), string1->GetDataUtf16(), length1 << 1U);
         }
         sp = sp.SubSpan(length1);
         if (!string2->IsUtf16()) {
-            for (uint32_t i = 0; i < length2; ++i) {
-                sp[i] = string2->At<false>(i);
-            }
+            std::copy_n(string2->GetDataMUtf8(), length2, sp.Data());
         } else {
             memcpy_s(sp.Data(), sp.SizeBytes(), string2->GetDataUtf16(), length2 << 1U);
         }
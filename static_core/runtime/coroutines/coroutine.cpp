@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -107,6 +107,16 @@ void Coroutine::SetCoroutineStatus(Coroutine::Status newStatus)
     context_->SetStatus(newStatus);
 }
 
+bool Coroutine::IsStackDirty() const
+{
+    // Atomic with relaxed order reason: the pause synchronizes the GC with the mutators
+    if (isStackDirty_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    auto status = GetCoroutineStatus();
+    return status != Status::RUNNABLE && status != Status::BLOCKED;
+}
+
 void Coroutine::Destroy()
 {
     context_->Destroy();
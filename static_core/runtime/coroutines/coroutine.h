@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 #ifndef PANDA_RUNTIME_COROUTINES_COROUTINE_H
 #define PANDA_RUNTIME_COROUTINES_COROUTINE_H
 
+#include <atomic>
 #include <optional>
 #include "runtime/include/runtime.h"
 #include "runtime/include/managed_thread.h"
@@ -133,6 +134,25 @@ public:
 
     bool RetrieveStackInfo(void *&stackAddr, size_t &stackSize, size_t &guardSize) override;
 
+    /**
+     * The frames of a coroutine change only while it is RUNNING, so a suspended coroutine which has not run
+     * since the last GC pause holds no references to the objects allocated after it.
+     */
+    bool IsStackDirty() const override;
+
+    void ClearStackDirty() override
+    {
+        // Atomic with relaxed order reason: the pause synchronizes the GC with the mutators
+        isStackDirty_.store(false, std::memory_order_relaxed);
+    }
+
+    /// Called on every status change of the coroutine
+    void MarkStackDirty()
+    {
+        // Atomic with relaxed order reason: the pause synchronizes the GC with the mutators
+        isStackDirty_.store(true, std::memory_order_relaxed);
+    }
+
     static bool ThreadIsCoroutine(Thread *thread)
     {
         ASSERT(thread != nullptr);
@@ -297,6 +317,7 @@ private:
     std::variant<std::monostate, ManagedEntrypointData, NativeEntrypointData> entrypoint_;
 
     CoroutineContext *context_ = nullptr;
+    std::atomic<bool> isStackDirty_ {true};
     // NOTE(konstanting, #I67QXC): check if we still need this functionality
     bool startSuspended_ = false;
 
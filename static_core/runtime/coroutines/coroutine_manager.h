@@ -31,6 +31,8 @@ struct CoroutineManagerConfig {
     bool emulateJs = false;
     /// Number of coroutine workers for the N:M mode
     uint32_t workersCount = WORKERS_COUNT_AUTO;
+    /// Allow idle coroutine workers to steal runnable coroutines from the busy ones (for the N:M mode)
+    bool enableWorkStealing = false;
 };
 
 /// @brief defines the requested launch mode for a coroutine
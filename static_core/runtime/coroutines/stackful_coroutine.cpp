@@ -59,6 +59,7 @@ void StackfulCoroutineContext::SetStatus(Coroutine::Status newStatus)
     PandaString setter = (Thread::GetCurrent() == nullptr) ? "null" : Coroutine::GetCurrent()->GetName();
     LOG(DEBUG, COROUTINES) << GetCoroutine()->GetName() << ": " << status_ << " -> " << newStatus << " by " << setter;
 #endif
+    GetCoroutine()->MarkStackDirty();
     status_ = newStatus;
 }
 
@@ -92,6 +93,7 @@ void StackfulCoroutineContext::CleanUp()
 #endif  // PANDA_ASAN_ON
     worker_ = nullptr;
     affinityMask_ = stackful_coroutines::AFFINITY_MASK_NONE;
+    started_ = false;
 }
 
 /*static*/ void StackfulCoroutineContext::CoroThreadProc(void *ctx)
@@ -102,6 +104,7 @@ void StackfulCoroutineContext::CleanUp()
 void StackfulCoroutineContext::ThreadProcImpl()
 {
     auto *co = GetCoroutine();
+    started_ = true;
     co->NativeCodeBegin();
     SetStatus(Coroutine::Status::RUNNING);
     if (co->HasManagedEntrypoint()) {
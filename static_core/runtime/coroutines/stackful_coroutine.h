@@ -119,6 +119,15 @@ public:
         affinityMask_ = mask;
     }
 
+    /**
+     * @return true if the coroutine entrypoint has already started its execution. Only the coroutines that have not
+     * been started yet are allowed to be moved to other workers by the work stealing machinery.
+     */
+    bool IsStarted() const
+    {
+        return started_;
+    }
+
 protected:
     void SetStatus(Coroutine::Status newStatus) override;
 
@@ -179,6 +188,7 @@ private:
     Coroutine::Status status_ {Coroutine::Status::CREATED};
     StackfulCoroutineWorker *worker_ = nullptr;
     stackful_coroutines::AffinityMask affinityMask_ = stackful_coroutines::AFFINITY_MASK_NONE;
+    bool started_ = false;
 };
 
 }  // namespace ark
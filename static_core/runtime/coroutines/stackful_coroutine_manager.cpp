@@ -115,6 +115,8 @@ void StackfulCoroutineManager::Initialize(CoroutineManagerConfig config, Runtime
     size_t coroStackAreaSizeBytes = Runtime::GetCurrent()->GetOptions().GetCoroutinesStackMemLimit();
     coroutineCountLimit_ = coroStackAreaSizeBytes / coroStackSizeBytes_;
     jsMode_ = config.emulateJs;
+    // in the JS mode the coroutines are bound to the worker that hosts the JS environment
+    workStealingEnabled_ = config.enableWorkStealing && !jsMode_;
 
     // create and activate workers
     size_t numberOfAvailableCores = std::max(std::thread::hardware_concurrency() / 4ULL, 2ULL);
@@ -392,6 +394,36 @@ StackfulCoroutineWorker *StackfulCoroutineManager::ChooseWorkerForCoroutine(Coro
     return *wIt;
 }
 
+size_t StackfulCoroutineManager::StealRunnablesFor(StackfulCoroutineWorker *thief)
+{
+    ASSERT(thief != nullptr);
+    os::memory::LockHolder lkWorkers(workersLock_);
+    StackfulCoroutineWorker *victim = nullptr;
+    for (auto *w : workers_) {
+        if (w == thief) {
+            continue;
+        }
+        if (victim == nullptr || w->GetLoadFactor() > victim->GetLoadFactor()) {
+            victim = w;
+        }
+    }
+    if (victim == nullptr) {
+        return 0;
+    }
+    return victim->MigrateRunnablesTo(thief);
+}
+
+void StackfulCoroutineManager::WakeUpIdleWorkerFor(StackfulCoroutineWorker *busy)
+{
+    ASSERT(busy != nullptr);
+    os::memory::LockHolder lkWorkers(workersLock_);
+    for (auto *w : workers_) {
+        if (w != busy && w->WakeUpIfIdle()) {
+            return;
+        }
+    }
+}
+
 stackful_coroutines::AffinityMask StackfulCoroutineManager::CalcAffinityMaskFromLaunchMode(CoroutineLaunchMode mode)
 {
     /**
@@ -450,6 +482,10 @@ Coroutine *StackfulCoroutineManager::LaunchImpl(CompletionEvent *completionEvent
     co->GetContext<StackfulCoroutineContext>()->SetAffinityMask(affinityMask);
     auto *w = ChooseWorkerForCoroutine(co);
     w->AddRunnableCoroutine(co, IsJsMode());
+    if (workStealingEnabled_ && w->GetLoadFactor() > 1.0) {
+        // the chosen worker already has a backlog, let an idle peer take a part of it without waiting
+        WakeUpIdleWorkerFor(w);
+    }
 
 #ifndef NDEBUG
     GetCurrentWorker()->PrintRunnables("LaunchImpl end");
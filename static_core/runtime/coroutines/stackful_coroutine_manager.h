@@ -72,6 +72,21 @@ public:
     /// called when a coroutine worker thread starts its execution
     void OnWorkerStartup();
 
+    /// @return true if idle workers are allowed to steal runnable coroutines from their peers
+    bool IsWorkStealingEnabled() const
+    {
+        return workStealingEnabled_;
+    }
+
+    /**
+     * @brief move some migratable runnable coroutines from the most loaded worker to the thief worker
+     * @return number of coroutines moved
+     */
+    size_t StealRunnablesFor(StackfulCoroutineWorker *thief);
+
+    /// wake up one of the idle workers (if any) so it can steal some of the busy worker's runnables
+    void WakeUpIdleWorkerFor(StackfulCoroutineWorker *busy);
+
     /* debugging tools */
     /**
      * For StackfulCoroutineManager implementation: a fatal error is issued if an attempt to switch coroutines on
@@ -156,6 +171,7 @@ private:
     size_t coroutineCountLimit_ = 0;
     size_t coroStackSizeBytes_ = 0;
     bool jsMode_ = false;
+    bool workStealingEnabled_ = false;
 
     /**
      * @brief holds pointers to the cached coroutine instances in order to speedup coroutine creation and destruction.
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <bitset>
 #include "runtime/include/thread_scopes.h"
 #include "runtime/coroutines/stackful_coroutine_manager.h"
 #include "runtime/coroutines/stackful_coroutine.h"
@@ -102,6 +103,54 @@ void StackfulCoroutineWorker::RequestSchedule()
     RequestScheduleImpl();
 }
 
+size_t StackfulCoroutineWorker::MigrateRunnablesTo(StackfulCoroutineWorker *thief)
+{
+    ASSERT(thief != nullptr);
+    ASSERT(thief != this);
+    // the victim is busy anyway, so do not make it wait for the thief
+    if (!runnablesLock_.TryLock()) {
+        return 0;
+    }
+    PandaVector<Coroutine *> migrants;
+    if (active_) {
+        // steal from the tail: these coroutines would have been scheduled by the victim last
+        size_t limit = (runnables_.size() + 1U) / 2U;
+        auto it = runnables_.end();
+        while (it != runnables_.begin() && migrants.size() < limit) {
+            --it;
+            if (IsMigratableTo(*it, thief)) {
+                migrants.push_back(*it);
+                it = runnables_.erase(it);
+            }
+        }
+        UpdateLoadFactor();
+    }
+    runnablesLock_.Unlock();
+
+    // preserve the original order of the migrants in the thief's queue
+    for (auto it = migrants.rbegin(); it != migrants.rend(); ++it) {
+        thief->PushToRunnableQueue(*it);
+    }
+    if (!migrants.empty()) {
+        LOG(DEBUG, COROUTINES) << "StackfulCoroutineWorker::MigrateRunnablesTo: " << thief->GetName() << " stole "
+                               << migrants.size() << " coroutines from " << GetName();
+    }
+    return migrants.size();
+}
+
+bool StackfulCoroutineWorker::WakeUpIfIdle()
+{
+    if (!runnablesLock_.TryLock()) {
+        return false;
+    }
+    bool idle = active_ && runnables_.empty();
+    if (idle) {
+        runnablesCv_.Signal();
+    }
+    runnablesLock_.Unlock();
+    return idle;
+}
+
 void StackfulCoroutineWorker::FinalizeFiberScheduleLoop()
 {
     ASSERT(GetCurrentContext()->GetWorker() == this);
@@ -218,10 +267,39 @@ bool StackfulCoroutineWorker::RunnableCoroutinesExist() const
     return !runnables_.empty();
 }
 
+bool StackfulCoroutineWorker::IsMigratableTo(Coroutine *co, const StackfulCoroutineWorker *thief) const
+{
+    auto *ctx = co->GetContext<StackfulCoroutineContext>();
+    // a started coroutine might still be saving its context on the victim's thread, so leave it alone
+    if (ctx->IsStarted()) {
+        return false;
+    }
+    std::bitset<stackful_coroutines::MAX_WORKERS_COUNT> affinityBits(ctx->GetAffinityMask());
+    return affinityBits.test(thief->GetId());
+}
+
+size_t StackfulCoroutineWorker::TryStealRunnables()
+{
+    // the manager locks the workers list and then the runnables of the peers, so we should not hold our own lock
+    runnablesLock_.Unlock();
+    size_t stolen = coroManager_->StealRunnablesFor(this);
+    runnablesLock_.Lock();
+    return stolen;
+}
+
 void StackfulCoroutineWorker::WaitForRunnables()
 {
-    // NOTE(konstanting): in case of work stealing, use timed wait and try periodically to steal some runnables
+    uint64_t stealingIntervalMs = MIN_WORK_STEALING_INTERVAL_MS;
     while (!RunnableCoroutinesExist() && IsActive()) {
+        if (coroManager_->IsWorkStealingEnabled()) {
+            // wake up periodically and try to steal some runnables from the busy peers, backing off while they
+            // have nothing to share
+            runnablesCv_.TimedWait(&runnablesLock_, stealingIntervalMs);
+            if (!RunnableCoroutinesExist() && IsActive() && TryStealRunnables() == 0) {
+                stealingIntervalMs = std::min(stealingIntervalMs * 2U, MAX_WORK_STEALING_INTERVAL_MS);
+            }
+            continue;
+        }
         runnablesCv_.Wait(
             &runnablesLock_);  // or timed wait? we may miss the signal in some cases (e.g. IsActive() change)...
         if (!RunnableCoroutinesExist() && IsActive()) {
@@ -238,7 +316,6 @@ void StackfulCoroutineWorker::RequestScheduleImpl()
     ASSERT(GetCurrentContext()->GetWorker() == this);
     runnablesLock_.Lock();
 
-    // NOTE(konstanting): implement coro migration, work stealing, etc.
     ScopedNativeCodeThread n(Coroutine::GetCurrent());
     if (RunnableCoroutinesExist()) {
         SuspendCurrentCoroAndScheduleNext();
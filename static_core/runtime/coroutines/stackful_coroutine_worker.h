@@ -113,6 +113,21 @@ public:
     /// @brief schedule the next ready coroutine from the runnables queue for execution
     void RequestSchedule();
 
+    /**
+     * @brief Move up to a half of the migratable runnable coroutines from this worker to the thief worker. Does
+     * nothing if this worker's runnables queue is contended at the moment.
+     * @param thief the worker that will receive the coroutines
+     * @return number of coroutines that were moved
+     */
+    size_t MigrateRunnablesTo(StackfulCoroutineWorker *thief);
+
+    /**
+     * @brief Wake up the worker if it is waiting for runnables, so it can try to steal some from its peers right away
+     * instead of waiting for the next stealing attempt. Does nothing if the worker is busy.
+     * @return true if the worker was idle and has been woken up
+     */
+    bool WakeUpIfIdle();
+
     /// @brief call to delete the fake "schedule loop" coroutine
     void FinalizeFiberScheduleLoop();
 
@@ -127,6 +142,13 @@ public:
 #endif
 
 private:
+    /**
+     * The period of the runnables stealing attempts for an idle worker: it starts from the minimal value and is
+     * doubled after each failed attempt up to the maximal one, so the idle workers do not keep waking up for nothing
+     */
+    static constexpr uint64_t MIN_WORK_STEALING_INTERVAL_MS = 1U;
+    static constexpr uint64_t MAX_WORK_STEALING_INTERVAL_MS = 64U;
+
     /* schedule loop management */
     /// the EP for threaded schedule loops
     void ThreadProc();
@@ -142,6 +164,13 @@ private:
     Coroutine *PopFromRunnableQueue();
     bool RunnableCoroutinesExist() const;
     void WaitForRunnables() REQUIRES(runnablesLock_);
+    /// @return true if the runnable coroutine can be moved from this worker to the thief worker
+    bool IsMigratableTo(Coroutine *co, const StackfulCoroutineWorker *thief) const REQUIRES(runnablesLock_);
+    /**
+     * ask the coroutine manager to move some runnables from the most loaded peer worker to this one
+     * @return number of coroutines stolen
+     */
+    size_t TryStealRunnables() REQUIRES(runnablesLock_);
 
     /* scheduling machinery from high level functions to elementary helpers */
     /**
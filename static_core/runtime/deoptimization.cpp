@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,11 +16,15 @@
 #include "runtime/deoptimization.h"
 
 #include "libpandabase/events/events.h"
+#include "libpandabase/mem/code_allocator.h"
+#include "libpandabase/mem/mem_config.h"
 #include "libpandafile/file_items.h"
+#include "runtime/include/class_linker.h"
 #include "runtime/include/locks.h"
 #include "runtime/include/runtime.h"
 #include "runtime/include/panda_vm.h"
 #include "runtime/profiling/profiling-inl.h"
+#include "runtime/mem/heap_manager.h"
 #include "runtime/mem/rendezvous.h"
 
 namespace ark {
@@ -68,6 +72,90 @@ static void UnpoisonAsanStack([[maybe_unused]] void *ptr)
 #endif  // PANDA_ASAN_ON
 }
 
+// NO_THREAD_SAFETY_ANALYSIS because it doesn't know about mutator_lock status in this scope
+void FreeRetiredCompiledCode(PandaVM *vm) NO_THREAD_SAFETY_ANALYSIS
+{
+    auto codeAllocator = vm->GetHeapManager()->GetCodeAllocator();
+    if (!codeAllocator->HasRetiredCode()) {
+        return;
+    }
+    PandaUnorderedSet<const void *> usedCode;
+    vm->GetThreadManager()->EnumerateThreads([&usedCode](ManagedThread *thread) {
+        ASSERT(thread != nullptr);
+        for (auto stack = StackWalker::Create(thread); stack.HasFrame(); stack.NextFrame()) {
+            if (stack.IsCFrame() && !stack.GetCFrame().IsNativeMethod()) {
+                usedCode.insert(stack.GetCompiledCodeEntry());
+            }
+        }
+        return true;
+    });
+    [[maybe_unused]] auto freed =
+        codeAllocator->FreeRetiredCode([&usedCode](const void *code) { return usedCode.count(code) != 0; });
+    LOG(DEBUG, CLASS_LINKER) << "Released " << freed << " retired compiled code buffers";
+}
+
+/// The code can't be released right now as it may be executed by the deoptimized frames
+static void RetireCompiledCode(PandaVM *vm, Method *method)
+{
+    auto codeAllocator = vm->GetHeapManager()->GetCodeAllocator();
+    if (method->HasCompiledCode() && !method->IsNative()) {
+        codeAllocator->RetireCode(method->GetCompiledEntryPoint());
+    }
+    auto osrCode = vm->GetCompiler()->GetOsrCode(method);
+    if (osrCode != nullptr) {
+        codeAllocator->RetireCode(osrCode);
+    }
+}
+
+// NO_THREAD_SAFETY_ANALYSIS because it doesn't know about mutator_lock status in this scope
+void EvictColdCompiledCode(PandaVM *vm) NO_THREAD_SAFETY_ANALYSIS
+{
+    uint64_t threshold = Runtime::GetOptions().GetCodeCacheEvictionThreshold();
+    uint64_t reserved = vm->GetMemStats()->GetCodeCacheReserved();
+    if (threshold == 0 || reserved * PERCENT_100_U32 < mem::MemConfig::GetCodeCacheSizeLimit() * threshold) {
+        return;
+    }
+    PandaUnorderedSet<Method *> onStack;
+    vm->GetThreadManager()->EnumerateThreads([&onStack](ManagedThread *thread) {
+        ASSERT(thread != nullptr);
+        for (auto stack = StackWalker::Create(thread); stack.HasFrame(); stack.NextFrame()) {
+            if (stack.IsCFrame() && !stack.GetCFrame().IsNativeMethod()) {
+                onStack.insert(stack.GetMethod());
+            }
+        }
+        return true;
+    });
+    auto codeAllocator = vm->GetHeapManager()->GetCodeAllocator();
+    size_t evicted = 0;
+    Runtime::GetCurrent()->GetClassLinker()->EnumerateClasses([&](Class *klass) {
+        for (auto &method : klass->GetMethods()) {
+            const void *code = method.GetCompiledEntryPoint();
+            // The AOT code is not in the code cache
+            if (method.IsNative() || !method.HasCompiledCode() || !codeAllocator->IsAllocatedCode(code) ||
+                onStack.count(&method) != 0 || codeAllocator->IsCodeUsed(code)) {
+                continue;
+            }
+            // The method which is being compiled again keeps its code
+            if (!method.AtomicSetCompilationStatus(Method::COMPILED, Method::NOT_COMPILED)) {
+                continue;
+            }
+            RetireCompiledCode(vm, &method);
+            method.SetInterpreterEntryPoint();
+            vm->GetCompiler()->RemoveOsrCode(&method);
+            method.ResetHotnessCounter();
+            ++evicted;
+        }
+        return true;
+    });
+    // The methods on the stacks now survive the next eviction even if they leave the stacks
+    codeAllocator->ClearCodeUsage();
+    for (auto *method : onStack) {
+        codeAllocator->MarkCodeUsed(method->GetCompiledEntryPoint());
+    }
+    LOG(DEBUG, RUNTIME) << "Evicted " << evicted << " cold compiled methods, the code cache was " << reserved
+                        << " bytes";
+}
+
 // NO_THREAD_SAFETY_ANALYSIS because it doesn't know about mutator_lock status in this scope
 void InvalidateCompiledEntryPoint(const PandaSet<Method *> &methods, bool isCha) NO_THREAD_SAFETY_ANALYSIS
 {
@@ -105,7 +193,7 @@ void InvalidateCompiledEntryPoint(const PandaSet<Method *> &methods, bool isCha)
         if (isCha) {
             EVENT_CHA_DEOPTIMIZE(std::string(method->GetFullName()), inStackCount);
         }
-        // NOTE (Trubenkov)  clean up compiled code(See issue 1706)
+        RetireCompiledCode(vm, method);
         method->SetInterpreterEntryPoint();
         Thread::GetCurrent()->GetVM()->GetCompiler()->RemoveOsrCode(method);
         // If deoptimization ocure during OSR compilation, we reset status after finish the compilation
@@ -113,6 +201,7 @@ void InvalidateCompiledEntryPoint(const PandaSet<Method *> &methods, bool isCha)
             method->SetCompilationStatus(Method::NOT_COMPILED);
         }
     }
+    FreeRetiredCompiledCode(vm);
 }
 
 [[noreturn]] NO_ADDRESS_SANITIZE void Deoptimize(StackWalker *stack, const uint8_t *pc, bool hasException,
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -37,6 +37,19 @@ namespace ark {
 
 void InvalidateCompiledEntryPoint(const PandaSet<Method *> &methods, bool isCha);
 
+/**
+ * @brief Release the invalidated compiled code which is not referenced by any frame anymore.
+ * Must be called when all the mutator threads are suspended.
+ */
+void FreeRetiredCompiledCode(PandaVM *vm);
+
+/**
+ * @brief Evict the JIT code of the cold methods if the code cache is filled over code-cache-eviction-threshold.
+ * A method is cold if it is not on the stacks now and was not there at the previous eviction. The evicted code is
+ * retired and the methods go back to the interpreter. Must be called when all the mutator threads are suspended.
+ */
+void EvictColdCompiledCode(PandaVM *vm);
+
 }  // namespace ark
 
 #endif  // PANDA_DEOPTIMIZATION_H
@@ -1304,8 +1304,13 @@ extern "C" Method *ResolveVirtualMethod(const Method *callee, Frame *frame, cons
     ASSERT(IsAddressInObjectsHeap(obj));
     auto *cls = obj->ClassAddr<Class>();
     ASSERT(cls != nullptr);
-    auto *resolved = cls->ResolveVirtualMethod(callee);
-    ASSERT(resolved != nullptr);
+    auto *cache = ManagedThread::GetCurrent()->GetVirtualCallCache();
+    auto *resolved = cache->Get(pc, caller, cls);
+    if (UNLIKELY(resolved == nullptr)) {
+        resolved = cls->ResolveVirtualMethod(callee);
+        ASSERT(resolved != nullptr);
+        cache->Set(pc, caller, cls, resolved);
+    }
 
     ProfilingData *profData = caller->GetProfilingData();
     auto bytecodeOffset = pc - frame->GetInstruction();
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -117,6 +117,7 @@ Error ArkHotreloadBase::ProcessHotreload()
             (void)this;  // [[maybe_unused]] in lambda capture list is not possible
             ASSERT(thread->GetThreadLang() == lang_);
             thread->GetInterpreterCache()->Clear();
+            thread->ClearVirtualCallCache();
             return true;
         });
         for (auto &hCls : classes_) {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -533,16 +533,14 @@ inline Method *Class::ResolveVirtualMethod(const Method *method) const
             }
         }
 
-        // find method in itable
+        // find method in itable, an interface has the only entry in it
         auto *iface = method->GetClass();
         auto itable = GetITable();
         for (size_t i = 0; i < itable.Size(); i++) {
             auto &entry = itable[i];
-            if (entry.GetInterface() != iface) {
-                continue;
+            if (entry.GetInterface() == iface) {
+                return entry.GetMethods()[method->GetVTableIndex()];
             }
-
-            resolved = entry.GetMethods()[method->GetVTableIndex()];
         }
     } else {
         // find method in vtable
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -28,6 +28,7 @@
 #include "libpandafile/class_data_accessor-inl.h"
 #include "libpandafile/file.h"
 #include "libpandafile/file_items.h"
+#include "runtime/boot_class_index.h"
 #include "runtime/class_linker_context.h"
 #include "runtime/include/class.h"
 #include "runtime/include/field.h"
@@ -128,6 +129,13 @@ public:
         return bootPandaFiles_;
     }
 
+    /**
+     * Indexes the classes of the boot panda files loaded so far. The index is loaded from fileName if it matches
+     * the boot files, otherwise it is built and saved to fileName. An empty fileName means no persistence.
+     * The boot files added later are searched one by one.
+     */
+    PANDA_PUBLIC_API void BuildBootClassIndex(const std::string &fileName = "");
+
     AotManager *GetAotManager()
     {
         return aotManager_.get();
@@ -365,9 +373,14 @@ private:
 
     static bool LayoutFields(Class *klass, Span<Field> fields, bool isStatic, ClassLinkerErrorHandler *errorHandler);
 
+    std::pair<panda_file::File::EntityId, const panda_file::File *> FindClassInBootPandaFiles(
+        const uint8_t *descriptor) REQUIRES(bootPandaFilesLock_);
+
     mem::InternalAllocatorPtr allocator_;
 
     PandaVector<const panda_file::File *> bootPandaFiles_ GUARDED_BY(bootPandaFilesLock_);
+    // Covers the first bootClassIndex_.GetFilesCount() boot files
+    BootClassIndex bootClassIndex_ GUARDED_BY(bootPandaFilesLock_);
 
     struct PandaFileLoadData {
         ClassLinkerContext *context;
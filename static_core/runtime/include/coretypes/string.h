@@ -59,6 +59,11 @@ public:
                                                     const LanguageContext &ctx, PandaVM *vm, bool movable = true,
                                                     bool pinned = false);
 
+    /// Creates a string from the raw data of another string with the known hash code, e.g. from a startup snapshot
+    PANDA_PUBLIC_API static String *CreateFromStringData(const uint8_t *data, uint32_t length, bool compressed,
+                                                         uint32_t hashcode, const LanguageContext &ctx, PandaVM *vm,
+                                                         bool movable = true);
+
     PANDA_PUBLIC_API static String *CreateEmptyString(const LanguageContext &ctx, PandaVM *vm);
 
     PANDA_PUBLIC_API static String *CreateFromString(String *str, const LanguageContext &ctx, PandaVM *vm);
@@ -270,6 +270,25 @@ public:
         return &interpreterCache_;
     }
 
+    /**
+     * The cache takes N entries of 32 bytes, so it is allocated on the first virtual call instead of in every thread.
+     * Many coroutines and the service threads never make one
+     */
+    VirtualCallCache *GetVirtualCallCache()
+    {
+        if (UNLIKELY(virtualCallCache_ == nullptr)) {
+            virtualCallCache_ = CreateVirtualCallCache();
+        }
+        return virtualCallCache_;
+    }
+
+    void ClearVirtualCallCache()
+    {
+        if (virtualCallCache_ != nullptr) {
+            virtualCallCache_->Clear();
+        }
+    }
+
     uintptr_t GetNativePc() const
     {
         return nativePc_;
@@ -442,6 +461,18 @@ public:
 
     virtual void UpdateGCRoots();
 
+    /**
+     * Tells whether the frames of the thread may have changed since the last GC pause which cleared the flag.
+     * A thread with its own OS stack is always considered dirty, only suspended coroutines may be clean.
+     */
+    virtual bool IsStackDirty() const
+    {
+        return true;
+    }
+
+    /// Called by the GC in a pause after the references in the frames have been visited and updated
+    virtual void ClearStackDirty() {}
+
     PANDA_PUBLIC_API void PushLocalObject(ObjectHeader **objectHeader);
 
     PANDA_PUBLIC_API void PopLocalObject();
@@ -804,6 +835,8 @@ private:
 
     PandaString LogThreadStack(ThreadState newState) const;
 
+    VirtualCallCache *CreateVirtualCallCache();
+
     // NO_THREAD_SAFETY_ANALYSIS due to TSAN not being able to determine lock status
     template <SafepointFlag SAFEPOINT = DONT_CHECK_SAFEPOINT, ReadlockFlag READLOCK_FLAG = NO_READLOCK>
     void StoreStatus(ThreadStatus status) NO_THREAD_SAFETY_ANALYSIS
@@ -890,6 +923,7 @@ private:
 
     // Something like custom TLS - it is faster to access via ManagedThread than via thread_local
     InterpreterCache interpreterCache_;
+    VirtualCallCache *virtualCallCache_ {nullptr};
 
     PandaMap<const char *, PandaUniquePtr<CustomTLSData>> customTlsCache_ GUARDED_BY(Locks::customTlsLock_);
 
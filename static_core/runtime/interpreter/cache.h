@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -67,6 +67,55 @@ private:
     std::array<Entry, N> data_ {};
 };
 
+/**
+ * Cache of the targets of the virtual and interface calls. The entries are keyed by the call site and the class of
+ * the receiver, so a polymorphic call site occupies an entry for each of its receivers. The target of a call for
+ * a given receiver class doesn't change while the class is alive, so the cache is cleared only when the classes are
+ * redefined (hot reload).
+ */
+class VirtualCallCache {
+public:
+    Method *Get(const void *pc, Method *caller, const Class *cls) const
+    {
+        const auto &entry = data_[GetIndex(pc, cls)];
+        if (LIKELY(entry.pc == pc && entry.cls == cls && entry.caller == caller)) {
+            return entry.target;
+        }
+        return nullptr;
+    }
+
+    void Set(const void *pc, Method *caller, const Class *cls, Method *target)
+    {
+        data_[GetIndex(pc, cls)] = {pc, caller, cls, target};
+    }
+
+    void Clear()
+    {
+        data_.fill({});
+    }
+
+    static constexpr size_t N = 128;
+
+    struct Entry {
+        const void *pc {nullptr};
+        Method *caller {nullptr};
+        const Class *cls {nullptr};
+        Method *target {nullptr};
+    };
+
+private:
+    static size_t GetIndex(const void *pc, const Class *cls)
+    {
+        // Classes are aligned by 8 bytes at least, so their lowest bits are dropped before the mixing
+        static constexpr size_t CLASS_SHIFT = 3U;
+        auto key = reinterpret_cast<size_t>(pc) ^ (reinterpret_cast<size_t>(cls) >> CLASS_SHIFT);
+        return ark::helpers::math::PowerOfTwoTableSlot(key, N);
+    }
+
+    static_assert(ark::helpers::math::IsPowerOfTwo(N));
+    std::array<Entry, N> data_ {};
+};
+
 }  // namespace ark
 
 #endif  // PANDA_INTERPRETER_CACHE_H_
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -3438,10 +3438,16 @@ public:
         }
         auto *cls = obj->ClassAddr<Class>();
         ASSERT(cls != nullptr);
-        auto *resolved = cls->ResolveVirtualMethod(method);
-        ASSERT(resolved != nullptr);
+        auto *caller = this->GetFrame()->GetMethod();
+        auto *cache = this->GetThread()->GetVirtualCallCache();
+        auto *resolved = cache->Get(this->GetInst().GetAddress(), caller, cls);
+        if (UNLIKELY(resolved == nullptr)) {
+            resolved = cls->ResolveVirtualMethod(method);
+            ASSERT(resolved != nullptr);
+            cache->Set(this->GetInst().GetAddress(), caller, cls, resolved);
+        }
 
-        ProfilingData *profData = this->GetFrame()->GetMethod()->GetProfilingData();
+        ProfilingData *profData = caller->GetProfilingData();
         if (profData != nullptr) {
             profData->UpdateInlineCaches(this->GetBytecodeOffset(), obj->ClassAddr<Class>());
         }
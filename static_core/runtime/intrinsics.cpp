@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -13,9 +13,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <functional>
 #include <limits>
+#include <numeric>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -442,6 +445,72 @@ void Memsetf64(ObjectHeader *array, double value, uint32_t initialIndex, uint32_
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     std::fill(data + initialIndex, data + maxIndex, value);
 }
+
+/*
+ * The reductions and maps below replace the loops over primitive arrays recognized by the compiler.
+ * They are plain loops over the array data, so the compiler of the runtime may vectorize them only for
+ * the baseline ISA of the build (SSE2 on amd64, NEON on arm64), AVX2 is not used.
+ * The integer arithmetic is unsigned to wrap on overflow like the managed code does.
+ */
+
+template <typename T, typename BinaryOp>
+T ArrayReduce(ObjectHeader *array, T value, uint32_t initialIndex, uint32_t maxIndex, BinaryOp op)
+{
+    auto data = reinterpret_cast<T *>(ark::coretypes::Array::Cast(array)->GetData());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return std::accumulate(data + initialIndex, data + maxIndex, value, op);
+}
+
+template <typename T, typename BinaryOp>
+void ArrayMap(ObjectHeader *dst, ObjectHeader *src, T value, uint32_t initialIndex, uint32_t maxIndex, BinaryOp op)
+{
+    auto dstData = reinterpret_cast<T *>(ark::coretypes::Array::Cast(dst)->GetData());
+    auto srcData = reinterpret_cast<T *>(ark::coretypes::Array::Cast(src)->GetData());
+    auto srcBegin = srcData + initialIndex;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto srcEnd = srcData + maxIndex;        // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    auto dstBegin = dstData + initialIndex;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    std::transform(srcBegin, srcEnd, dstBegin, [value, op](T element) { return op(element, value); });
+}
+
+uint32_t ArraySum32(ObjectHeader *array, uint32_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    return ArrayReduce(array, value, initialIndex, maxIndex, std::plus<uint32_t>());
+}
+
+uint64_t ArraySum64(ObjectHeader *array, uint64_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    return ArrayReduce(array, value, initialIndex, maxIndex, std::plus<uint64_t>());
+}
+
+uint32_t ArrayXor32(ObjectHeader *array, uint32_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    return ArrayReduce(array, value, initialIndex, maxIndex, std::bit_xor<uint32_t>());
+}
+
+uint64_t ArrayXor64(ObjectHeader *array, uint64_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    return ArrayReduce(array, value, initialIndex, maxIndex, std::bit_xor<uint64_t>());
+}
+
+void ArrayAddScalar32(ObjectHeader *dst, ObjectHeader *src, uint32_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    ArrayMap(dst, src, value, initialIndex, maxIndex, std::plus<uint32_t>());
+}
+
+void ArrayAddScalarf64(ObjectHeader *dst, ObjectHeader *src, double value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    ArrayMap(dst, src, value, initialIndex, maxIndex, std::plus<double>());
+}
+
+void ArrayMulScalar32(ObjectHeader *dst, ObjectHeader *src, uint32_t value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    ArrayMap(dst, src, value, initialIndex, maxIndex, std::multiplies<uint32_t>());
+}
+
+void ArrayMulScalarf64(ObjectHeader *dst, ObjectHeader *src, double value, uint32_t initialIndex, uint32_t maxIndex)
+{
+    ArrayMap(dst, src, value, initialIndex, maxIndex, std::multiplies<double>());
+}
 }  // namespace ark::intrinsics
 
 #include <intrinsics_gen.h>
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -252,6 +252,16 @@ public:
         return inlineCaches_;
     }
 
+    Span<BranchData> GetBranchData()
+    {
+        return branchData_;
+    }
+
+    Span<ThrowData> GetThrowData()
+    {
+        return throwData_;
+    }
+
     CallSiteInlineCache *FindInlineCache(uintptr_t pc)
     {
         auto ics = GetInlineCaches();
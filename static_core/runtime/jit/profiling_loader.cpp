@@ -0,0 +1,255 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/jit/profiling_loader.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "libpandabase/globals.h"
+#include "libpandabase/os/file.h"
+#include "runtime/include/method.h"
+#include "runtime/jit/profiling_saver.h"
+
+namespace ark {
+
+namespace {
+
+class ProfileReader {
+public:
+    explicit ProfileReader(const PandaVector<uint8_t> &data) : data_(data) {}
+    ~ProfileReader() = default;
+
+    template <class T>
+    bool Read(T *value)
+    {
+        static_assert(std::is_integral_v<T>);
+        if (sizeof(T) > data_.size() - offset_) {
+            return false;
+        }
+        uint64_t result = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            result |= static_cast<uint64_t>(data_[offset_++]) << (i * BITS_PER_BYTE);
+        }
+        *value = static_cast<T>(result);
+        return true;
+    }
+
+    bool ReadString(PandaString *str)
+    {
+        uint32_t length = 0;
+        if (!Read(&length) || length > data_.size() - offset_) {
+            return false;
+        }
+        str->assign(reinterpret_cast<const char *>(data_.data() + offset_), length);
+        offset_ += length;
+        return true;
+    }
+
+    NO_COPY_SEMANTIC(ProfileReader);
+    NO_MOVE_SEMANTIC(ProfileReader);
+
+private:
+    const PandaVector<uint8_t> &data_;
+    size_t offset_ {0};
+};
+
+bool ReadString(ProfileReader *reader, const PandaVector<PandaString> &strings, PandaString *str)
+{
+    uint32_t index = 0;
+    if (!reader->Read(&index) || index >= strings.size()) {
+        return false;
+    }
+    *str = strings[index];
+    return true;
+}
+
+bool ReadInlineCaches(ProfileReader *reader, const PandaVector<PandaString> &strings, uint32_t count,
+                      ProfilingLoader::MethodData *method)
+{
+    for (uint32_t i = 0; i < count; ++i) {
+        ProfilingLoader::InlineCacheProfile ic {};
+        uint32_t receiversCount = 0;
+        if (!reader->Read(&ic.pc) || !reader->Read(&receiversCount)) {
+            return false;
+        }
+        ic.megamorphic = receiversCount == ProfilingSaver::MEGAMORPHIC;
+        if (!ic.megamorphic) {
+            ic.receivers.resize(receiversCount);
+            for (auto &receiver : ic.receivers) {
+                if (!ReadString(reader, strings, &receiver)) {
+                    return false;
+                }
+            }
+        }
+        method->inlineCaches.push_back(std::move(ic));
+    }
+    return true;
+}
+
+bool ReadMethod(ProfileReader *reader, const PandaVector<PandaString> &strings, uint32_t *methodId,
+                ProfilingLoader::MethodData *method)
+{
+    uint32_t icsCount = 0;
+    uint32_t branchesCount = 0;
+    uint32_t throwsCount = 0;
+    if (!reader->Read(methodId) || !reader->Read(&icsCount) || !reader->Read(&branchesCount) ||
+        !reader->Read(&throwsCount) || !ReadInlineCaches(reader, strings, icsCount, method)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < branchesCount; ++i) {
+        ProfilingLoader::BranchProfile branch {};
+        if (!reader->Read(&branch.pc) || !reader->Read(&branch.taken) || !reader->Read(&branch.notTaken)) {
+            return false;
+        }
+        method->branches.push_back(branch);
+    }
+    for (uint32_t i = 0; i < throwsCount; ++i) {
+        ProfilingLoader::ThrowProfile throwSite {};
+        if (!reader->Read(&throwSite.pc) || !reader->Read(&throwSite.taken)) {
+            return false;
+        }
+        method->throws.push_back(throwSite);
+    }
+    auto byPc = [](const auto &lhs, const auto &rhs) { return lhs.pc < rhs.pc; };
+    std::sort(method->inlineCaches.begin(), method->inlineCaches.end(), byPc);
+    std::sort(method->branches.begin(), method->branches.end(), byPc);
+    std::sort(method->throws.begin(), method->throws.end(), byPc);
+    return true;
+}
+
+template <class T>
+const T *FindByPc(const PandaVector<T> &items, uint32_t pc)
+{
+    auto it = std::lower_bound(items.begin(), items.end(), pc, [](const T &item, uint32_t value) {
+        return item.pc < value;
+    });
+    return (it == items.end() || it->pc != pc) ? nullptr : &*it;
+}
+
+PandaString GetBaseName(std::string_view fileName)
+{
+    auto pos = fileName.find_last_of('/');
+    return PandaString(pos == std::string_view::npos ? fileName : fileName.substr(pos + 1));
+}
+
+}  // namespace
+
+Expected<bool, const char *> ProfilingLoader::Load(std::string_view fileName)
+{
+    auto file = os::file::Open(fileName, os::file::Mode::READONLY);
+    if (!file.IsValid()) {
+        return Unexpected("Cannot open the file");
+    }
+    os::file::FileHolder holder(file);
+    auto size = file.GetFileSize();
+    if (!size.HasValue()) {
+        return Unexpected("Cannot get the size of the file");
+    }
+    PandaVector<uint8_t> data(size.Value());
+    if (!file.ReadAll(data.data(), data.size())) {
+        return Unexpected("Cannot read the file");
+    }
+
+    ProfileReader reader(data);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!reader.Read(&magic) || magic != ProfilingSaver::MAGIC || !reader.Read(&version) ||
+        version != ProfilingSaver::VERSION) {
+        return Unexpected("Unknown format of the profile");
+    }
+    uint32_t stringsCount = 0;
+    if (!reader.Read(&stringsCount) || stringsCount > data.size()) {
+        return Unexpected("Malformed profile");
+    }
+    PandaVector<PandaString> strings(stringsCount);
+    for (auto &str : strings) {
+        if (!reader.ReadString(&str)) {
+            return Unexpected("Malformed profile");
+        }
+    }
+    uint32_t filesCount = 0;
+    if (!reader.Read(&filesCount)) {
+        return Unexpected("Malformed profile");
+    }
+    for (uint32_t i = 0; i < filesCount; ++i) {
+        PandaString name;
+        uint32_t checksum = 0;
+        uint32_t methodsCount = 0;
+        if (!ReadString(&reader, strings, &name) || !reader.Read(&checksum) || !reader.Read(&methodsCount)) {
+            return Unexpected("Malformed profile");
+        }
+        auto &methods = files_[std::make_pair(checksum, name)];
+        for (uint32_t j = 0; j < methodsCount; ++j) {
+            uint32_t methodId = 0;
+            MethodData method;
+            if (!ReadMethod(&reader, strings, &methodId, &method)) {
+                return Unexpected("Malformed profile");
+            }
+            methods[methodId] = std::move(method);
+        }
+    }
+    return true;
+}
+
+const ProfilingLoader::MethodData *ProfilingLoader::FindMethod(const Method &method) const
+{
+    const auto *pf = method.GetPandaFile();
+    if (files_.empty() || pf == nullptr) {
+        return nullptr;
+    }
+    auto file = files_.find(std::make_pair(pf->GetHeader()->checksum, GetBaseName(pf->GetFilename())));
+    if (file == files_.end()) {
+        return nullptr;
+    }
+    auto it = file->second.find(method.GetFileId().GetOffset());
+    return it == file->second.end() ? nullptr : &it->second;
+}
+
+const ProfilingLoader::InlineCacheProfile *ProfilingLoader::FindInlineCache(const Method &method, uint32_t pc) const
+{
+    const auto *data = FindMethod(method);
+    return data == nullptr ? nullptr : FindByPc(data->inlineCaches, pc);
+}
+
+const ProfilingLoader::BranchProfile *ProfilingLoader::FindBranch(const Method &method, uint32_t pc) const
+{
+    const auto *data = FindMethod(method);
+    return data == nullptr ? nullptr : FindByPc(data->branches, pc);
+}
+
+int64_t ProfilingLoader::GetBranchTakenCounter(const Method &method, uint32_t pc) const
+{
+    const auto *branch = FindBranch(method, pc);
+    return branch == nullptr ? 0 : branch->taken;
+}
+
+int64_t ProfilingLoader::GetBranchNotTakenCounter(const Method &method, uint32_t pc) const
+{
+    const auto *branch = FindBranch(method, pc);
+    return branch == nullptr ? 0 : branch->notTaken;
+}
+
+int64_t ProfilingLoader::GetThrowTakenCounter(const Method &method, uint32_t pc) const
+{
+    const auto *data = FindMethod(method);
+    if (data == nullptr) {
+        return 0;
+    }
+    const auto *throwSite = FindByPc(data->throws, pc);
+    return throwSite == nullptr ? 0 : throwSite->taken;
+}
+
+}  // namespace ark
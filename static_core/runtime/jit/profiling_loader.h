@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_JIT_PROFILING_LOADER_H
+#define PANDA_RUNTIME_JIT_PROFILING_LOADER_H
+
+#include <cstdint>
+#include <string_view>
+
+#include "libpandabase/macros.h"
+#include "libpandabase/utils/expected.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/mem/panda_string.h"
+
+namespace ark {
+
+class Method;
+
+/// Profile saved by ProfilingSaver, the compiler uses it for the methods which have not been profiled in this run
+class ProfilingLoader {
+public:
+    struct InlineCacheProfile {
+        uint32_t pc;
+        bool megamorphic;
+        PandaVector<PandaString> receivers;
+    };
+
+    struct BranchProfile {
+        uint32_t pc;
+        int64_t taken;
+        int64_t notTaken;
+    };
+
+    struct ThrowProfile {
+        uint32_t pc;
+        int64_t taken;
+    };
+
+    /// All the vectors are sorted by pc
+    struct MethodData {
+        PandaVector<InlineCacheProfile> inlineCaches;
+        PandaVector<BranchProfile> branches;
+        PandaVector<ThrowProfile> throws;
+    };
+
+    ProfilingLoader() = default;
+    ~ProfilingLoader() = default;
+
+    /// Adds the profile from the file, it may be called several times before the compilation is started
+    PANDA_PUBLIC_API Expected<bool, const char *> Load(std::string_view fileName);
+
+    bool IsEmpty() const
+    {
+        return files_.empty();
+    }
+
+    PANDA_PUBLIC_API const MethodData *FindMethod(const Method &method) const;
+
+    PANDA_PUBLIC_API const InlineCacheProfile *FindInlineCache(const Method &method, uint32_t pc) const;
+    PANDA_PUBLIC_API int64_t GetBranchTakenCounter(const Method &method, uint32_t pc) const;
+    PANDA_PUBLIC_API int64_t GetBranchNotTakenCounter(const Method &method, uint32_t pc) const;
+    PANDA_PUBLIC_API int64_t GetThrowTakenCounter(const Method &method, uint32_t pc) const;
+
+    NO_COPY_SEMANTIC(ProfilingLoader);
+    NO_MOVE_SEMANTIC(ProfilingLoader);
+
+private:
+    const BranchProfile *FindBranch(const Method &method, uint32_t pc) const;
+
+    // Profiles of the panda files by their checksums and names without the directories
+    PandaMap<std::pair<uint32_t, PandaString>, PandaUnorderedMap<uint32_t, MethodData>> files_;
+};
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_JIT_PROFILING_LOADER_H
@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/jit/profiling_saver.h"
+
+#include <string_view>
+#include <type_traits>
+
+#include "libpandabase/globals.h"
+#include "libpandabase/os/file.h"
+#include "libpandabase/os/filesystem.h"
+#include "libpandabase/utils/logger.h"
+#include "libpandabase/utils/utf.h"
+#include "runtime/include/class.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/mem/panda_string.h"
+#include "runtime/include/method.h"
+#include "runtime/jit/profiling_data.h"
+
+namespace ark {
+
+namespace {
+
+class ProfileWriter {
+public:
+    ProfileWriter() = default;
+    ~ProfileWriter() = default;
+
+    template <class T>
+    void Write(T value)
+    {
+        static_assert(std::is_integral_v<T>);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            data_.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * BITS_PER_BYTE)));
+        }
+    }
+
+    void WriteString(std::string_view str)
+    {
+        Write(static_cast<uint32_t>(str.size()));
+        data_.insert(data_.end(), str.begin(), str.end());
+    }
+
+    const PandaVector<uint8_t> &GetData() const
+    {
+        return data_;
+    }
+
+    NO_COPY_SEMANTIC(ProfileWriter);
+    NO_MOVE_SEMANTIC(ProfileWriter);
+
+private:
+    PandaVector<uint8_t> data_;
+};
+
+class StringIndexes {
+public:
+    uint32_t Get(std::string_view str)
+    {
+        auto [it, inserted] = indexes_.emplace(PandaString(str), strings_.size());
+        if (inserted) {
+            strings_.push_back(&it->first);
+        }
+        return it->second;
+    }
+
+    void Write(ProfileWriter *writer) const
+    {
+        writer->Write(static_cast<uint32_t>(strings_.size()));
+        for (const auto *str : strings_) {
+            writer->WriteString(*str);
+        }
+    }
+
+private:
+    PandaUnorderedMap<PandaString, uint32_t> indexes_;
+    PandaVector<const PandaString *> strings_;
+};
+
+std::string_view GetBaseName(std::string_view fileName)
+{
+    auto pos = fileName.find_last_of('/');
+    return pos == std::string_view::npos ? fileName : fileName.substr(pos + 1);
+}
+
+void WriteMethod(ProfileWriter *writer, StringIndexes *strings, Method *method, ProfilingData *profilingData)
+{
+    auto inlineCaches = profilingData->GetInlineCaches();
+    auto branches = profilingData->GetBranchData();
+    auto throws = profilingData->GetThrowData();
+    writer->Write(method->GetFileId().GetOffset());
+    writer->Write(static_cast<uint32_t>(inlineCaches.size()));
+    writer->Write(static_cast<uint32_t>(branches.size()));
+    writer->Write(static_cast<uint32_t>(throws.size()));
+    for (auto &ic : inlineCaches) {
+        writer->Write(static_cast<uint32_t>(ic.GetBytecodePc()));
+        auto classes = ic.GetClassesCopy();
+        if (!classes.empty() && CallSiteInlineCache::IsMegamorphic(classes[0])) {
+            writer->Write(ProfilingSaver::MEGAMORPHIC);
+            continue;
+        }
+        writer->Write(static_cast<uint32_t>(classes.size()));
+        for (auto *cls : classes) {
+            writer->Write(strings->Get(utf::Mutf8AsCString(cls->GetDescriptor())));
+        }
+    }
+    for (auto &branch : branches) {
+        writer->Write(static_cast<uint32_t>(branch.GetPc()));
+        writer->Write(static_cast<uint64_t>(branch.GetTakenCounter()));
+        writer->Write(static_cast<uint64_t>(branch.GetNotTakenCounter()));
+    }
+    for (auto &throwSite : throws) {
+        writer->Write(static_cast<uint32_t>(throwSite.GetPc()));
+        writer->Write(static_cast<uint64_t>(throwSite.GetTakenCounter()));
+    }
+}
+
+}  // namespace
+
+/* static */
+bool ProfilingSaver::Save(const std::string &fileName, ClassLinker *classLinker)
+{
+    PandaMap<const panda_file::File *, PandaVector<std::pair<Method *, ProfilingData *>>> methodsByFile;
+    classLinker->EnumerateClasses([&methodsByFile](Class *cls) {
+        for (auto &method : cls->GetMethods()) {
+            auto *profilingData = method.GetProfilingData();
+            if (profilingData != nullptr && method.GetPandaFile() != nullptr) {
+                methodsByFile[method.GetPandaFile()].emplace_back(&method, profilingData);
+            }
+        }
+        return true;
+    });
+
+    StringIndexes strings;
+    ProfileWriter methodsWriter;
+    methodsWriter.Write(static_cast<uint32_t>(methodsByFile.size()));
+    size_t methodsCount = 0;
+    for (auto &[pf, methods] : methodsByFile) {
+        methodsWriter.Write(strings.Get(GetBaseName(pf->GetFilename())));
+        methodsWriter.Write(pf->GetHeader()->checksum);
+        methodsWriter.Write(static_cast<uint32_t>(methods.size()));
+        for (auto &[method, profilingData] : methods) {
+            WriteMethod(&methodsWriter, &strings, method, profilingData);
+        }
+        methodsCount += methods.size();
+    }
+
+    ProfileWriter writer;
+    writer.Write(MAGIC);
+    writer.Write(VERSION);
+    strings.Write(&writer);
+
+    // The profile is written aside and renamed, so paoc never reads a partially written file
+    bool written = os::WriteFileAtomically(fileName, [&writer, &methodsWriter](const os::file::File &file) {
+        return file.WriteAll(writer.GetData().data(), writer.GetData().size()) &&
+               file.WriteAll(methodsWriter.GetData().data(), methodsWriter.GetData().size());
+    });
+    if (!written) {
+        LOG(ERROR, RUNTIME) << "Cannot write profile file '" << fileName << "'";
+        return false;
+    }
+    LOG(INFO, RUNTIME) << "Saved profile of " << methodsCount << " methods to '" << fileName << "'";
+    return true;
+}
+
+}  // namespace ark
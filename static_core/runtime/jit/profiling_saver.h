@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_JIT_PROFILING_SAVER_H
+#define PANDA_RUNTIME_JIT_PROFILING_SAVER_H
+
+#include <cstdint>
+#include <string>
+
+#include "libpandabase/macros.h"
+
+namespace ark {
+
+class ClassLinker;
+
+/**
+ * Writes the profiling data collected by the interpreter to a file, which is loaded by paoc (see ProfilingLoader).
+ *
+ * All the values are little-endian. The strings (panda file names and class descriptors) are stored once in the
+ * string table at the beginning of the file and are referenced by their indexes:
+ *   magic, version, number of strings, {length, characters} for every string,
+ *   number of panda files, {name index, checksum, number of methods, {method} for every method} for every file,
+ * where the method is
+ *   method id, number of inline caches, number of branches, number of throws,
+ *   {pc, number of receivers or MEGAMORPHIC, {descriptor index} for every receiver} for every inline cache,
+ *   {pc, taken counter (64 bits), not taken counter (64 bits)} for every branch,
+ *   {pc, taken counter (64 bits)} for every throw.
+ * The panda files are identified by their names without the directories and checksums, the methods - by their ids.
+ */
+class ProfilingSaver {
+public:
+    static constexpr uint32_t MAGIC = 0x464c5250U;  // "PRLF"
+    static constexpr uint32_t VERSION = 1U;
+    static constexpr uint32_t MEGAMORPHIC = UINT32_MAX;
+
+    /// Saves the profiling data of all the loaded methods, which have been profiled
+    PANDA_PUBLIC_API static bool Save(const std::string &fileName, ClassLinker *classLinker);
+
+private:
+    NO_COPY_SEMANTIC(ProfilingSaver);
+    NO_MOVE_SEMANTIC(ProfilingSaver);
+    ProfilingSaver() = default;
+    ~ProfilingSaver() = default;
+};
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_JIT_PROFILING_SAVER_H
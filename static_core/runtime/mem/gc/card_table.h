@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -116,6 +116,11 @@ public:
         return cardsCount_;
     }
 
+    size_t GetCardIndex(CardPtr card) const  // returns index of the card in the card table
+    {
+        return ToUintPtr(card) - ToUintPtr(cards_);
+    }
+
     uintptr_t GetCardStartAddress(CardPtr card) const;  // returns address of the first byte in the card
     uintptr_t GetCardEndAddress(CardPtr card) const;    // returns address of the last byte in the card
     MemRange GetMemoryRange(CardPtr card) const;        // returns memory range for the card
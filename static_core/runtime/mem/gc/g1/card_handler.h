@@ -25,7 +25,8 @@
 namespace ark::mem {
 class Region;
 
-template <typename LanguageConfig>
+/// NEED_LOCK is true when the cards are handled by several threads in parallel
+template <typename LanguageConfig, bool NEED_LOCK>
 class CardHandler {
 public:
     explicit CardHandler(CardTable *cardTable, size_t regionSizeBits, const std::atomic_bool &deferCards)
@@ -41,7 +42,7 @@ private:
     const std::atomic_bool &deferCards_;
 };
 
-template <typename LanguageConfig>
+template <typename LanguageConfig, bool NEED_LOCK>
 class RegionRemsetBuilder {
 public:
     RegionRemsetBuilder(Region *fromRegion, void *startAddress, void *endAddress, size_t regionSizeBits,
@@ -67,14 +68,14 @@ public:
     }
 
 private:
-    RemsetObjectPointerHandler objectPointerHandler_;
+    RemsetObjectPointerHandler<NEED_LOCK> objectPointerHandler_;
     void *startAddress_;
     void *endAddress_;
     bool *result_;
 };
 
-template <typename LanguageConfig>
-bool CardHandler<LanguageConfig>::Handle(CardTable::CardPtr cardPtr)
+template <typename LanguageConfig, bool NEED_LOCK>
+bool CardHandler<LanguageConfig, NEED_LOCK>::Handle(CardTable::CardPtr cardPtr)
 {
     bool result = true;
     auto *startAddress = ToVoidPtr(cardTable_->GetCardStartAddress(cardPtr));
@@ -89,8 +90,8 @@ bool CardHandler<LanguageConfig>::Handle(CardTable::CardPtr cardPtr)
     ASSERT(region != nullptr);
     ASSERT_PRINT(region->GetLiveBitmap() != nullptr, "Region " << region << " GetLiveBitmap() == nullptr");
     auto *endAddress = ToVoidPtr(cardTable_->GetCardEndAddress(cardPtr));
-    RegionRemsetBuilder<LanguageConfig> remsetBuilder(region, startAddress, endAddress, regionSizeBits_, deferCards_,
-                                                      &result);
+    RegionRemsetBuilder<LanguageConfig, NEED_LOCK> remsetBuilder(region, startAddress, endAddress, regionSizeBits_,
+                                                                 deferCards_, &result);
     if (region->HasFlag(RegionFlag::IS_LARGE_OBJECT)) {
         region->GetLiveBitmap()->CallForMarkedChunkInHumongousRegion<true>(ToVoidPtr(region->Begin()), remsetBuilder);
     } else {
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_MEM_GC_G1_DIRTY_CARD_SET_H
+#define PANDA_RUNTIME_MEM_GC_G1_DIRTY_CARD_SET_H
+
+#include <limits>
+
+#include "libpandabase/macros.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/mem/gc/card_table.h"
+
+namespace ark::mem {
+
+/**
+ * Set of the dirty cards, which are kept in the order of insertion.
+ * The duplicates are filtered out by the dense bitmap with one bit per card of the card table, so an insertion
+ * never hashes or allocates a node
+ */
+class DirtyCardSet {
+public:
+    using CardsVector = PandaVector<CardTable::CardPtr>;
+
+    explicit DirtyCardSet(const CardTable *cardTable)
+        : cardTable_(cardTable), bitmap_((cardTable->GetCardsCount() + WORD_BITS - 1) / WORD_BITS, 0)
+    {
+    }
+
+    ~DirtyCardSet() = default;
+
+    NO_COPY_SEMANTIC(DirtyCardSet);
+    NO_MOVE_SEMANTIC(DirtyCardSet);
+
+    /// @return true if the card was not in the set
+    bool Insert(CardTable::CardPtr card)
+    {
+        auto idx = cardTable_->GetCardIndex(card);
+        auto &word = bitmap_[idx / WORD_BITS];
+        auto mask = 1ULL << (idx % WORD_BITS);
+        if ((word & mask) != 0) {
+            return false;
+        }
+        word |= mask;
+        cards_.push_back(card);
+        return true;
+    }
+
+    /// Removes the first count cards in the order of insertion
+    void EraseFirst(size_t count)
+    {
+        ASSERT(count <= cards_.size());
+        for (size_t i = 0; i < count; ++i) {
+            ResetBit(cards_[i]);
+        }
+        cards_.erase(cards_.begin(), cards_.begin() + count);
+    }
+
+    void Clear()
+    {
+        // Reset the bits of the inserted cards only, the bitmap is much larger than a usual number of dirty cards
+        for (auto *card : cards_) {
+            ResetBit(card);
+        }
+        cards_.clear();
+    }
+
+    const CardsVector &GetCards() const
+    {
+        return cards_;
+    }
+
+    CardsVector &GetCards()
+    {
+        return cards_;
+    }
+
+    size_t Size() const
+    {
+        return cards_.size();
+    }
+
+    bool Empty() const
+    {
+        return cards_.empty();
+    }
+
+private:
+    static constexpr size_t WORD_BITS = std::numeric_limits<uint64_t>::digits;
+
+    void ResetBit(CardTable::CardPtr card)
+    {
+        auto idx = cardTable_->GetCardIndex(card);
+        bitmap_[idx / WORD_BITS] &= ~(1ULL << (idx % WORD_BITS));
+    }
+
+    const CardTable *cardTable_;
+    PandaVector<uint64_t> bitmap_;
+    CardsVector cards_;
+};
+
+}  // namespace ark::mem
+
+#endif  // PANDA_RUNTIME_MEM_GC_G1_DIRTY_CARD_SET_H
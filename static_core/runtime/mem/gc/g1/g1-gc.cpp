@@ -587,6 +587,12 @@ void G1GC<LanguageConfig>::WorkerTaskProcessing(GCWorkersTask *task, [[maybe_unu
                 wasInterrupted ? ReleasePagesStatus::WAS_INTERRUPTED : ReleasePagesStatus::FINISHED;
             break;
         }
+        case GCWorkersTaskTypes::TASK_UPDATE_REMSET_REFS: {
+            auto *cardsRange = task->Cast<GCUpdateRemsetWorkersTask>()->GetCardsRange();
+            updateRemsetWorker_->ProcessCardsRange(*cardsRange);
+            this->GetInternalAllocator()->Delete(cardsRange);
+            break;
+        }
         case GCWorkersTaskTypes::TASK_ENQUEUE_REMSET_REFS: {
             auto *movedObjectsRange = task->Cast<GCUpdateRefsWorkersTask<false>>()->GetMovedObjectsRange();
             auto *taskUpdatedRefsQueue =
@@ -1097,6 +1103,7 @@ void G1GC<LanguageConfig>::RunGC(GCTask &task, const CollectionSet &collectibleR
         CollectAndMove<false>(collectibleRegions);
         ClearRefsFromRemsetsCache();
         this->GetObjectGenAllocator()->InvalidateSpaceData();
+        ClearStackDirtyFlags();
     }
     if (youngPauseTime > 0) {
         this->GetStats()->AddTimeValue(youngPauseTime, TimeTypeStats::YOUNG_PAUSED_TIME);
@@ -1162,7 +1169,11 @@ MemRange G1GC<LanguageConfig>::MixedMarkAndCacheRefs(const GCTask &task, const C
     {
         GCScope<TRACE_TIMING> markingCollectionSetRootsTrace("Marking roots collection-set", this);
 
-        this->VisitRoots(gcMarkCollectionSet, VisitGCRootFlags::ACCESS_ROOT_NONE);
+        auto rootFlags = VisitGCRootFlags::ACCESS_ROOT_NONE;
+        if (CanSkipCleanStacks()) {
+            rootFlags = rootFlags | VisitGCRootFlags::ACCESS_ROOT_ONLY_DIRTY_STACKS;
+        }
+        this->VisitRoots(gcMarkCollectionSet, rootFlags);
     }
     {
         GCScope<TRACE_TIMING> markStackTiming("MarkStack", this);
@@ -1394,7 +1405,26 @@ void G1GC<LanguageConfig>::UpdateRefsToMovedObjects(MovedObjectsContainer<FULL_G
         }
         this->GetWorkersTaskPool()->WaitUntilTasksEnd();
     }
-    this->CommonUpdateRefsToMovedObjects();
+    auto rootFlags = VisitGCRootFlags::ACCESS_ROOT_ALL;
+    if (!FULL_GC && CanSkipCleanStacks()) {
+        rootFlags = rootFlags | VisitGCRootFlags::ACCESS_ROOT_ONLY_DIRTY_STACKS;
+    }
+    this->CommonUpdateRefsToMovedObjects(rootFlags);
+}
+
+template <class LanguageConfig>
+bool G1GC<LanguageConfig>::CanSkipCleanStacks() const
+{
+    return !this->IsFullGC() && collectionSet_.Tenured().empty() && collectionSet_.Humongous().empty();
+}
+
+template <class LanguageConfig>
+void G1GC<LanguageConfig>::ClearStackDirtyFlags()
+{
+    this->GetPandaVm()->GetThreadManager()->EnumerateThreads([](ManagedThread *thread) {
+        thread->ClearStackDirty();
+        return true;
+    });
 }
 
 template <class LanguageConfig>
@@ -1705,10 +1735,11 @@ void G1GC<LanguageConfig>::AddOldRegionsAccordingPauseTimeGoal(CollectionSet &co
 {
     auto gcPauseTimeBudget = this->GetSettings()->GetG1MaxGcPauseInMillis() * ark::os::time::MILLIS_TO_MICRO;
     auto candidates = this->GetG1ObjectAllocator()->template GetTopGarbageRegions<false>();
+    // The young part is predicted before any old region is added, G1Analytics expects a young-only set
+    auto expectedYoungCollectionTime = analytics_.PredictYoungCollectionTimeInMicros(collectionSet);
     // add at least one old region to guarantee a progress in mixed collection
     auto *topRegion = candidates.top().second;
     collectionSet.AddRegion(topRegion);
-    auto expectedYoungCollectionTime = analytics_.PredictYoungCollectionTimeInMicros(collectionSet);
     auto expectedTopRegionCollectionTime = analytics_.PredictOldCollectionTimeInMicros(topRegion);
     auto totalPredictedPause = expectedYoungCollectionTime + expectedTopRegionCollectionTime;
     if (gcPauseTimeBudget < expectedTopRegionCollectionTime) {
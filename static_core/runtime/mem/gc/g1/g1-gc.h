@@ -245,6 +245,15 @@ private:
     /// Caches refs from remset and marks objects in collection set (young-generation + maybe some tenured regions).
     MemRange MixedMarkAndCacheRefs(const GCTask &task, const CollectionSet &collectibleRegions);
 
+    /**
+     * Every pause evacuates the whole young space, so the frames of a thread which has not run since the previous
+     * pause refer only to tenured objects. A pause which moves no tenured objects may skip these frames.
+     */
+    bool CanSkipCleanStacks() const;
+
+    /// Marks the frames of all threads as visited, called at the end of a pause which evacuates the young space
+    void ClearStackDirtyFlags();
+
     /**
      * Mark roots and add them to the stack
      * @param objects_stack
@@ -22,6 +22,8 @@
 #include "runtime/mem/rem_set-inl.h"
 
 namespace ark::mem {
+/// NEED_LOCK is true when the cards are refined by several threads in parallel, so they can change one remset
+template <bool NEED_LOCK>
 class RemsetObjectPointerHandler {
 public:
     RemsetObjectPointerHandler(Region *fromRegion, size_t regionSizeBits, const std::atomic_bool &deferCards)
@@ -57,8 +59,7 @@ private:
         ASSERT_PRINT(IsHeapSpace(PoolManager::GetMmapMemPool()->GetSpaceTypeForAddr(obj)),
                      "Not suitable space for to_obj: " << obj);
 
-        // don't need lock because only one thread changes remsets
-        RemSet<>::AddRefWithAddr<false>(fromRemset_, ref, obj);
+        RemSet<>::AddRefWithAddr<NEED_LOCK>(fromRemset_, ref, obj);
         LOG(DEBUG, GC) << "fill rem set " << ref << " -> " << obj;
     }
     RemSetT *fromRemset_;
@@ -19,6 +19,7 @@
 #include "runtime/include/panda_vm.h"
 #include "runtime/mem/gc/g1/card_handler.h"
 #include "runtime/mem/gc/g1/g1-gc.h"
+#include "runtime/mem/gc/workers/gc_workers_task_pool.h"
 #include "runtime/mem/object_helpers-inl.h"
 #include "runtime/mem/rem_set-inl.h"
 
@@ -34,10 +35,11 @@ UpdateRemsetWorker<LanguageConfig>::UpdateRemsetWorker(G1GC<LanguageConfig> *gc,
       minConcurrentCardsToProcess_(minConcurrentCardsToProcess),
       queue_(queue),
       queueLock_(queueLock),
-      updateConcurrent_(updateConcurrent)
+      updateConcurrent_(updateConcurrent),
+      cards_(gc->GetCardTable())
 {
     static constexpr size_t PREALLOCATED_CARDS_SET_SIZE = 256;
-    cards_.reserve(PREALLOCATED_CARDS_SET_SIZE);
+    cards_.GetCards().reserve(PREALLOCATED_CARDS_SET_SIZE);
 }
 
 template <class LanguageConfig>
@@ -80,53 +82,54 @@ void UpdateRemsetWorker<LanguageConfig>::AddPostBarrierBuffer(PandaVector<mem::C
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromDefered(PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromAllSources()
 {
-    os::memory::LockHolder holder(*queueLock_);
-    std::copy(cards_.begin(), cards_.end(), std::inserter(*cards, cards->end()));
-    cards_.clear();
+    FillFromQueue();
+    FillFromThreads();
+    FillFromPostBarrierBuffers();
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromQueue(PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromQueue()
 {
     os::memory::LockHolder holder(*queueLock_);
-    std::copy(queue_->begin(), queue_->end(), std::inserter(*cards, cards->end()));
+    for (auto *card : *queue_) {
+        cards_.Insert(card);
+    }
     queue_->clear();
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromThreads(PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromThreads()
 {
     auto *vm = gc_->GetPandaVm();
     ASSERT(vm != nullptr);
     auto *threadManager = vm->GetThreadManager();
     ASSERT(threadManager != nullptr);
-    threadManager->EnumerateThreads([this, cards](ManagedThread *thread) {
+    threadManager->EnumerateThreads([this](ManagedThread *thread) {
         auto *buffer = thread->GetG1PostBarrierBuffer();
         if (buffer != nullptr) {
-            FillFromPostBarrierBuffer(buffer, cards);
+            FillFromPostBarrierBuffer(buffer);
         }
         return true;
     });
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffers(PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffers()
 {
     auto allocator = gc_->GetInternalAllocator();
     os::memory::LockHolder holder(postBarrierBuffersLock_);
     while (!postBarrierBuffers_.empty()) {
         auto *buffer = postBarrierBuffers_.back();
         postBarrierBuffers_.pop_back();
-        FillFromPostBarrierBuffer(buffer, cards);
+        FillFromPostBarrierBuffer(buffer);
         allocator->Delete(buffer);
     }
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSet::G1PostBarrierRingBufferType *postWrb,
-                                                                   PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSet::G1PostBarrierRingBufferType *postWrb)
 {
     if (postWrb == nullptr) {
         return;
@@ -138,16 +141,15 @@ void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSe
         if (!hasElement) {
             break;
         }
-        cards->insert(card);
+        cards_.Insert(card);
     }
 }
 
 template <class LanguageConfig>
-void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSet::ThreadLocalCardQueues *postWrb,
-                                                                   PandaUnorderedSet<CardTable::CardPtr> *cards)
+void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSet::ThreadLocalCardQueues *postWrb)
 {
     while (!postWrb->empty()) {
-        cards->insert(postWrb->back());
+        cards_.Insert(postWrb->back());
         postWrb->pop_back();
     }
 }
@@ -155,34 +157,72 @@ void UpdateRemsetWorker<LanguageConfig>::FillFromPostBarrierBuffer(GCG1BarrierSe
 template <class LanguageConfig>
 size_t UpdateRemsetWorker<LanguageConfig>::ProcessAllCards()
 {
-    FillFromQueue(&cards_);
-    FillFromThreads(&cards_);
-    FillFromPostBarrierBuffers(&cards_);
-    LOG_IF(!cards_.empty(), DEBUG, GC) << "Started process: " << cards_.size() << " cards";
+    FillFromAllSources();
+    LOG_IF(!cards_.Empty(), DEBUG, GC) << "Started process: " << cards_.Size() << " cards";
 
     size_t cardsSize = 0;
-    CardHandler<LanguageConfig> cardHandler(gc_->GetCardTable(), regionSizeBits_, deferCards_);
-    for (auto it = cards_.begin(); it != cards_.end();) {
-        if (!cardHandler.Handle(*it)) {
+    // Only this thread changes the remsets here
+    CardHandler<LanguageConfig, false> cardHandler(gc_->GetCardTable(), regionSizeBits_, deferCards_);
+    for (auto *card : cards_.GetCards()) {
+        if (!cardHandler.Handle(card)) {
             break;
         }
         cardsSize++;
-
-        it = cards_.erase(it);
     }
-    LOG_IF(!cards_.empty(), DEBUG, GC) << "Processed " << cardsSize << " cards";
+    // The cards which were not processed are deferred till the next iteration
+    cards_.EraseFirst(cardsSize);
+    LOG_IF(!cards_.Empty(), DEBUG, GC) << "Processed " << cardsSize << " cards";
     return cardsSize;
 }
 
+template <class LanguageConfig>
+void UpdateRemsetWorker<LanguageConfig>::ProcessCardsInParallel()
+{
+    auto allocator = gc_->GetInternalAllocator();
+    auto *workersTaskPool = gc_->GetWorkersTaskPool();
+    auto &cards = cards_.GetCards();
+    LOG(DEBUG, GC) << "Started parallel process: " << cards.size() << " cards";
+    for (auto rangeBegin = cards.begin(); rangeBegin != cards.end();) {
+        auto rangeEnd = rangeBegin;
+        if (std::distance(rangeBegin, cards.end()) < static_cast<ptrdiff_t>(GCUpdateRemsetWorkersTask::RANGE_SIZE)) {
+            rangeEnd = cards.end();
+        } else {
+            std::advance(rangeEnd, GCUpdateRemsetWorkersTask::RANGE_SIZE);
+        }
+        auto *cardsRange = allocator->template New<GCUpdateRemsetWorkersTask::CardsRange>(rangeBegin, rangeEnd);
+        rangeBegin = rangeEnd;
+        GCUpdateRemsetWorkersTask gcWorkerTask(cardsRange);
+        if (workersTaskPool->AddTask(GCUpdateRemsetWorkersTask(gcWorkerTask))) {
+            continue;
+        }
+        // Couldn't add new task, so do task processing immediately
+        gc_->WorkerTaskProcessing(&gcWorkerTask, nullptr);
+    }
+    workersTaskPool->WaitUntilTasksEnd();
+    cards_.Clear();
+}
+
+template <class LanguageConfig>
+void UpdateRemsetWorker<LanguageConfig>::ProcessCardsRange(const CardsRange &cards)
+{
+    ASSERT(IsFlag(UpdateRemsetWorkerFlags::IS_PAUSED_BY_GC_THREAD));
+    // The ranges are processed by the GC workers in parallel, and cards of different ranges can change one remset
+    CardHandler<LanguageConfig, true> cardHandler(gc_->GetCardTable(), regionSizeBits_, deferCards_);
+    for (auto *card : cards) {
+        [[maybe_unused]] bool processed = cardHandler.Handle(card);
+        // Cards processing is not deferred during the pause
+        ASSERT(processed);
+    }
+}
+
 template <class LanguageConfig>
 void UpdateRemsetWorker<LanguageConfig>::DrainAllCards(PandaUnorderedSet<CardTable::CardPtr> *cards)
 {
     ASSERT(IsFlag(UpdateRemsetWorkerFlags::IS_PAUSED_BY_GC_THREAD));
     os::memory::LockHolder holder(updateRemsetLock_);
-    FillFromDefered(cards);
-    FillFromQueue(cards);
-    FillFromThreads(cards);
-    FillFromPostBarrierBuffers(cards);
+    FillFromAllSources();
+    cards->insert(cards_.GetCards().begin(), cards_.GetCards().end());
+    cards_.Clear();
 }
 
 template <class LanguageConfig>
@@ -190,6 +230,14 @@ void UpdateRemsetWorker<LanguageConfig>::GCProcessCards()
 {
     ASSERT(IsFlag(UpdateRemsetWorkerFlags::IS_PAUSED_BY_GC_THREAD));
     os::memory::LockHolder holder(updateRemsetLock_);
+    auto *settings = gc_->GetSettings();
+    if (settings->ParallelRefUpdatingEnabled()) {
+        FillFromAllSources();
+        if (cards_.Size() >= settings->G1MinParallelCardsToProcess()) {
+            ProcessCardsInParallel();
+            return;
+        }
+    }
     ProcessAllCards();
 }
 
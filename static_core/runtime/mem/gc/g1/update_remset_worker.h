@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,7 +17,9 @@
 #define PANDA_RUNTIME_MEM_GC_G1_UPDATE_REMSET_WORKER_H
 
 #include "libpandabase/os/mutex.h"
+#include "libpandabase/utils/range.h"
 #include "runtime/mem/gc/card_table.h"
+#include "runtime/mem/gc/g1/dirty_card_set.h"
 #include "runtime/mem/gc/gc_barrier_set.h"
 
 namespace ark::mem {
@@ -75,10 +77,20 @@ public:
 
     /**
      * @brief Process all cards in the GC thread.
+     * If there are many cards and parallel ref updating is enabled, they are processed by gc workers.
      * Can be called only if UpdateRemsetWorker is suspended
      */
     void GCProcessCards();
 
+    using CardsRange = Range<DirtyCardSet::CardsVector::iterator>;
+
+    /**
+     * @brief Process the range of cards in a gc worker.
+     * Can be called only from GCProcessCards tasks
+     * @param cards range of cards for processing
+     */
+    void ProcessCardsRange(const CardsRange &cards);
+
     using RegionVector = PandaVector<Region *>;
 
     /**
@@ -173,15 +185,15 @@ protected:
 #endif
 
 private:
-    void FillFromDefered(PandaUnorderedSet<CardTable::CardPtr> *cards) REQUIRES(updateRemsetLock_);
-    void FillFromQueue(PandaUnorderedSet<CardTable::CardPtr> *cards) REQUIRES(updateRemsetLock_);
-    void FillFromThreads(PandaUnorderedSet<CardTable::CardPtr> *cards) REQUIRES(updateRemsetLock_);
+    void FillFromAllSources() REQUIRES(updateRemsetLock_);
+    void FillFromQueue() REQUIRES(updateRemsetLock_);
+    void FillFromThreads() REQUIRES(updateRemsetLock_);
+
+    void FillFromPostBarrierBuffers();
+    void FillFromPostBarrierBuffer(GCG1BarrierSet::G1PostBarrierRingBufferType *postWrb);
+    void FillFromPostBarrierBuffer(GCG1BarrierSet::ThreadLocalCardQueues *postWrb);
 
-    void FillFromPostBarrierBuffers(PandaUnorderedSet<CardTable::CardPtr> *cards);
-    void FillFromPostBarrierBuffer(GCG1BarrierSet::G1PostBarrierRingBufferType *postWrb,
-                                   PandaUnorderedSet<CardTable::CardPtr> *cards);
-    void FillFromPostBarrierBuffer(GCG1BarrierSet::ThreadLocalCardQueues *postWrb,
-                                   PandaUnorderedSet<CardTable::CardPtr> *cards);
+    void ProcessCardsInParallel() REQUIRES(updateRemsetLock_);
 
     void DoInvalidateRegions(RegionVector *regions) REQUIRES(updateRemsetLock_);
 
@@ -192,7 +204,8 @@ private:
     os::memory::Mutex *queueLock_ {nullptr};
     bool updateConcurrent_;  // used to process references in gc-thread between zygote phases
 
-    PandaUnorderedSet<CardTable::CardPtr> cards_;
+    // Unprocessed cards from all sources, they are deferred if the processing is interrupted
+    DirtyCardSet cards_;
     PandaVector<GCG1BarrierSet::ThreadLocalCardQueues *> postBarrierBuffers_ GUARDED_BY(postBarrierBuffersLock_);
     os::memory::Mutex postBarrierBuffersLock_;
 
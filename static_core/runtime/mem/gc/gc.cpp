@@ -20,6 +20,7 @@
 #include "libpandabase/os/thread.h"
 #include "libpandabase/utils/time.h"
 #include "runtime/assert_gc_scope.h"
+#include "runtime/deoptimization.h"
 #include "runtime/include/class.h"
 #include "runtime/include/coretypes/dyn_objects.h"
 #include "runtime/include/locks.h"
@@ -345,6 +346,10 @@ void GC::RunPhases(GCTask &task)
             [](void *mem, [[maybe_unused]] size_t size) { PoolManager::GetMmapMemPool()->FreePool(mem, size); });
         // - Clear local part:
         ClearLocalInternalAllocatorPools();
+        // The cold code is evicted if the code cache is full, and the invalidated compiled code left by the frames
+        // since the last pause can be released now
+        EvictColdCompiledCode(GetPandaVm());
+        FreeRetiredCompiledCode(GetPandaVm());
 
         size_t bytesInHeapAfterGc = GetPandaVm()->GetMemStats()->GetFootprintHeap();
         // There is case than bytes_in_heap_after_gc > 0 and bytes_in_heap_before_gc == 0.
@@ -820,7 +825,7 @@ void GC::MoveObjectsToPygoteSpace()
 
     // Update because we moved objects from object_allocator -> pygote space
     UpdateRefsToMovedObjectsInPygoteSpace();
-    CommonUpdateRefsToMovedObjects();
+    CommonUpdateRefsToMovedObjects(VisitGCRootFlags::ACCESS_ROOT_ALL);
 
     // Clear the moved objects in old space
     objectAllocator_->FreeObjectsMovedToPygoteSpace();
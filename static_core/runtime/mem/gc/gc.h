@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -571,8 +571,11 @@ protected:
     virtual void MarkReferences(GCMarkingStackType *references, GCPhase gcPhase) = 0;
 
     virtual void UpdateRefsToMovedObjectsInPygoteSpace() = 0;
-    /// Update all refs to moved objects
-    virtual void CommonUpdateRefsToMovedObjects() = 0;
+    /**
+     * Update all refs to moved objects
+     * @param flags - ACCESS_ROOT_ONLY_DIRTY_STACKS skips frames of threads which have not run since the last pause
+     */
+    virtual void CommonUpdateRefsToMovedObjects(VisitGCRootFlags flags) = 0;
 
     virtual void UpdateVmRefs() = 0;
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -96,7 +96,7 @@ std::ostream &operator<<(std::ostream &os, const GCRoot &root)
 template <class LanguageConfig>
 void RootManager<LanguageConfig>::VisitNonHeapRoots(const GCRootVisitor &gcRootVisitor, VisitGCRootFlags flags) const
 {
-    VisitLocalRoots(gcRootVisitor);
+    VisitLocalRoots(gcRootVisitor, flags);
     VisitClassRoots(gcRootVisitor, flags);
     VisitAotStringRoots(gcRootVisitor, flags);
     VisitClassLinkerContextRoots(gcRootVisitor);
@@ -157,10 +157,15 @@ void RootManager<LanguageConfig>::VisitRootsForThread(ManagedThread *thread, con
 }
 
 template <class LanguageConfig>
-void RootManager<LanguageConfig>::VisitLocalRoots(const GCRootVisitor &gcRootVisitor) const
+void RootManager<LanguageConfig>::VisitLocalRoots(const GCRootVisitor &gcRootVisitor, VisitGCRootFlags flags) const
 {
-    auto threadVisitor = [this, &gcRootVisitor](ManagedThread *thread) {
+    bool onlyDirtyStacks = (flags & VisitGCRootFlags::ACCESS_ROOT_ONLY_DIRTY_STACKS) != 0;
+    auto threadVisitor = [this, &gcRootVisitor, onlyDirtyStacks](ManagedThread *thread) {
         VisitRootsForThread(thread, gcRootVisitor);
+        if (onlyDirtyStacks && !thread->IsStackDirty()) {
+            LOG(DEBUG, GC) << "Skip frames of thread " << thread->GetId();
+            return true;
+        }
         for (auto stack = StackWalker::Create(thread); stack.HasFrame(); stack.NextFrame()) {
             LOG(DEBUG, GC) << " VisitRoots frame " << std::hex << stack.GetFp();
             stack.IterateObjects([this, &gcRootVisitor](auto &vreg) {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -45,6 +45,7 @@ enum class VisitGCRootFlags : uint32_t {
     ACCESS_ROOT_NONE = 1U << 2U,
 
     ACCESS_ROOT_AOT_STRINGS_ONLY_YOUNG = 1U << 3U,  // visit only young string roots in aot table
+    ACCESS_ROOT_ONLY_DIRTY_STACKS = 1U << 4U,       // skip frames of threads which have not run since the last pause
 
     START_RECORDING_NEW_ROOT = 1U << 10U,
     END_RECORDING_NEW_ROOT = 1U << 11U,
@@ -88,7 +89,8 @@ public:
                            VisitGCRootFlags flags = VisitGCRootFlags::ACCESS_ROOT_ALL) const;
 
     /// Visit local roots for frame
-    void VisitLocalRoots(const GCRootVisitor &gcRootVisitor) const;
+    void VisitLocalRoots(const GCRootVisitor &gcRootVisitor,
+                         VisitGCRootFlags flags = VisitGCRootFlags::ACCESS_ROOT_ALL) const;
 
     /**
      * Visit card table roots
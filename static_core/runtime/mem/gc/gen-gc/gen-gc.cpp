@@ -363,7 +363,7 @@ void GenGC<LanguageConfig>::UpdateRefsToMovedObjects(PandaVector<ObjectHeader *>
         },
         CardTableProcessedFlag::VISIT_MARKED | CardTableProcessedFlag::VISIT_PROCESSED);
     LOG_DEBUG_GC << "=== Update tenured -> young references. END. ===";
-    this->CommonUpdateRefsToMovedObjects();
+    this->CommonUpdateRefsToMovedObjects(VisitGCRootFlags::ACCESS_ROOT_ALL);
 }
 
 template <class LanguageConfig>
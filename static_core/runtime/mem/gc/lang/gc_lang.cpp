@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -68,11 +68,15 @@ void GCLang<LanguageConfig>::UpdateRefsToMovedObjectsInPygoteSpace()
 }
 
 template <class LanguageConfig>
-void GCLang<LanguageConfig>::CommonUpdateRefsToMovedObjects()
+void GCLang<LanguageConfig>::CommonUpdateRefsToMovedObjects(VisitGCRootFlags flags)
 {
     trace::ScopedTrace scopedTrace(__FUNCTION__);
 
-    auto cb = [this](ManagedThread *thread) {
+    bool onlyDirtyStacks = (flags & VisitGCRootFlags::ACCESS_ROOT_ONLY_DIRTY_STACKS) != 0;
+    auto cb = [this, onlyDirtyStacks](ManagedThread *thread) {
+        if (onlyDirtyStacks && !thread->IsStackDirty()) {
+            return true;
+        }
         UpdateRefsInVRegs(thread);
         return true;
     };
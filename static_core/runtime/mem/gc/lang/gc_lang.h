@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -49,7 +49,7 @@ public:
 protected:
     ~GCLang() override;
     void UpdateRefsToMovedObjectsInPygoteSpace() override;
-    void CommonUpdateRefsToMovedObjects() override;
+    void CommonUpdateRefsToMovedObjects(VisitGCRootFlags flags) override;
 
     void VisitRoots(const GCRootVisitor &gcRootVisitor, VisitGCRootFlags flags) override
     {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,7 @@
 #ifndef PANDA_RUNTIME_MEM_GC_GC_WORKERS_TASKS_H
 #define PANDA_RUNTIME_MEM_GC_GC_WORKERS_TASKS_H
 
+#include "runtime/mem/gc/card_table.h"
 #include "runtime/mem/gc/g1/ref_updater.h"
 #include "runtime/mem/gc/gc_root.h"
 #include "runtime/thread_pool_queue.h"
@@ -140,6 +141,26 @@ public:
     }
 };
 
+class GCUpdateRemsetWorkersTask : public GCWorkersTask {
+public:
+    using CardsRange = Range<PandaVector<CardTable::CardPtr>::iterator>;
+    // Number of dirty cards processed by one gc worker task
+    static constexpr size_t RANGE_SIZE = 256;
+
+    explicit GCUpdateRemsetWorkersTask(CardsRange *cards)
+        : GCWorkersTask(GCWorkersTaskTypes::TASK_UPDATE_REMSET_REFS, cards)
+    {
+    }
+    DEFAULT_COPY_SEMANTIC(GCUpdateRemsetWorkersTask);
+    DEFAULT_MOVE_SEMANTIC(GCUpdateRemsetWorkersTask);
+    ~GCUpdateRemsetWorkersTask() = default;
+
+    CardsRange *GetCardsRange() const
+    {
+        return static_cast<CardsRange *>(storage_);
+    }
+};
+
 template <bool VECTOR>
 class GCUpdateRefsWorkersTask : public GCWorkersTask {
 public:
@@ -105,7 +105,10 @@ PandaString MemStats<T>::GetStatistics()
     statistic << "heap: allocated - " << GetAllocatedHeap() << ", freed - " << GetFreedHeap() << std::endl;
     statistic << "raw memory: allocated - " << GetAllocated(SpaceType::SPACE_TYPE_INTERNAL) << ", freed - "
               << GetFreed(SpaceType::SPACE_TYPE_INTERNAL) << std::endl;
-    statistic << "compiler: allocated - " << GetAllocated(SpaceType::SPACE_TYPE_CODE) << std::endl;
+    statistic << "compiler: allocated - " << GetAllocated(SpaceType::SPACE_TYPE_CODE) << ", freed - "
+              << GetFreed(SpaceType::SPACE_TYPE_CODE) << std::endl;
+    statistic << "code cache: reserved - " << GetCodeCacheReserved() << ", fragmentation - "
+              << GetCodeCacheFragmentation() << std::endl;
     statistic << "ArenaAllocator: allocated - " << GetAllocated(SpaceType::SPACE_TYPE_COMPILER) << std::endl;
     statistic << "total footprint now - " << GetTotalFootprint() << std::endl;
     statistic << "total allocated object - " << GetTotalObjectsAllocated() << std::endl;
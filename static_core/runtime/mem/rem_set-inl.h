@@ -35,9 +35,10 @@ void RemSet<LockConfigT>::AddRef(const ObjectHeader *fromObjAddr, size_t offset)
     ASSERT(fromObjAddr != nullptr);
     auto ref = ToUintPtr(fromObjAddr) + offset;
     auto bitmapBeginAddr = ref & ~DEFAULT_REGION_MASK;
-    os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(remSetLock_);
+    auto &shard = GetShard(bitmapBeginAddr);
+    os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(shard.lock);
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    bitmaps_[bitmapBeginAddr].Set(GetIdxInBitmap(ref, bitmapBeginAddr));
+    shard.bitmaps[bitmapBeginAddr].Set(GetIdxInBitmap(ref, bitmapBeginAddr));
 }
 
 template <typename LockConfigT>
@@ -47,16 +48,20 @@ void RemSet<LockConfigT>::AddRef(const void *fromAddr)
     ASSERT(fromAddr != nullptr);
     auto ref = ToUintPtr(fromAddr);
     auto bitmapBeginAddr = ref & ~DEFAULT_REGION_MASK;
-    os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(remSetLock_);
+    auto &shard = GetShard(bitmapBeginAddr);
+    os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(shard.lock);
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-    bitmaps_[bitmapBeginAddr].Set(GetIdxInBitmap(ref, bitmapBeginAddr));
+    shard.bitmaps[bitmapBeginAddr].Set(GetIdxInBitmap(ref, bitmapBeginAddr));
 }
 
 template <typename LockConfigT>
 void RemSet<LockConfigT>::Clear()
 {
+    for (auto &shard : shards_) {
+        os::memory::LockHolder shardLock(shard.lock);
+        shard.bitmaps.clear();
+    }
     os::memory::LockHolder lock(remSetLock_);
-    bitmaps_.clear();
     refRegions_.clear();
 }
 
@@ -72,10 +77,13 @@ void RemSet<LockConfigT>::InvalidateRegion(Region *invalidRegion)
         refReg->GetRemSet()->RemoveFromRegion<NEED_LOCK>(invalidRegion);
     }
 
-    for (auto entry : invalidRemset->bitmaps_) {
-        auto bitmapBeginAddr = entry.first;
-        auto *fromRegion = AddrToRegion(ToVoidPtr(bitmapBeginAddr));
-        fromRegion->GetRemSet()->RemoveRefRegion<NEED_LOCK>(invalidRegion);
+    for (auto &shard : invalidRemset->shards_) {
+        os::memory::LockHolder<LockConfigT, NEED_LOCK> shardLock(shard.lock);
+        for (const auto &entry : shard.bitmaps) {
+            auto bitmapBeginAddr = entry.first;
+            auto *fromRegion = AddrToRegion(ToVoidPtr(bitmapBeginAddr));
+            fromRegion->GetRemSet()->RemoveRefRegion<NEED_LOCK>(invalidRegion);
+        }
     }
 }
 
@@ -137,11 +145,13 @@ template <typename LockConfigT>
 template <typename RegionPred, typename MemVisitor>
 inline void RemSet<LockConfigT>::Iterate(const RegionPred &regionPred, const MemVisitor &visitor)
 {
-    for (auto &[bitmap_begin_addr, bitmap] : bitmaps_) {
-        auto *region = AddrToRegion(ToVoidPtr(bitmap_begin_addr));
-        if (regionPred(region)) {
-            MemRange bitmapRange(bitmap_begin_addr, bitmap_begin_addr + DEFAULT_REGION_SIZE);
-            bitmap.Iterate(bitmapRange, [region, visitor](const MemRange &range) { visitor(region, range); });
+    for (auto &shard : shards_) {
+        for (auto &[bitmap_begin_addr, bitmap] : shard.bitmaps) {
+            auto *region = AddrToRegion(ToVoidPtr(bitmap_begin_addr));
+            if (regionPred(region)) {
+                MemRange bitmapRange(bitmap_begin_addr, bitmap_begin_addr + DEFAULT_REGION_SIZE);
+                bitmap.Iterate(bitmapRange, [region, visitor](const MemRange &range) { visitor(region, range); });
+            }
         }
     }
 }
@@ -178,10 +188,11 @@ template <typename LockConfigT>
 template <bool NEED_LOCK>
 void RemSet<LockConfigT>::RemoveFromRegion(Region *region)
 {
-    os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(remSetLock_);
     for (auto bitmapBeginAddr = ToUintPtr(region); bitmapBeginAddr < region->End();
          bitmapBeginAddr += DEFAULT_REGION_SIZE) {
-        bitmaps_.erase(bitmapBeginAddr);
+        auto &shard = GetShard(bitmapBeginAddr);
+        os::memory::LockHolder<LockConfigT, NEED_LOCK> lock(shard.lock);
+        shard.bitmaps.erase(bitmapBeginAddr);
     }
 }
 
@@ -193,6 +204,12 @@ void RemSet<LockConfigT>::RemoveRefRegion(Region *region)
     refRegions_.erase(region);
 }
 
+template <typename LockConfigT>
+typename RemSet<LockConfigT>::BitmapsShard &RemSet<LockConfigT>::GetShard(uintptr_t bitmapBeginAddr)
+{
+    return shards_[(bitmapBeginAddr / DEFAULT_REGION_SIZE) % SHARDS_COUNT];
+}
+
 template <typename LockConfigT>
 size_t RemSet<LockConfigT>::GetIdxInBitmap(uintptr_t addr, uintptr_t bitmapBeginAddr)
 {
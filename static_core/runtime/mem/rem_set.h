@@ -16,6 +16,7 @@
 #ifndef PANDA_MEM_GC_G1_REM_SET_H
 #define PANDA_MEM_GC_G1_REM_SET_H
 
+#include <array>
 #include <limits>
 
 namespace ark::mem {
@@ -62,7 +63,11 @@ public:
 
     size_t Size() const
     {
-        return bitmaps_.size();
+        size_t size = 0;
+        for (const auto &shard : shards_) {
+            size += shard.bitmaps.size();
+        }
+        return size;
     }
 
     /**
@@ -131,6 +136,19 @@ public:
     };
 
 private:
+    /**
+     * The bitmaps are sharded by the regions they describe, so the threads which refine cards of different regions
+     * in parallel do not contend on the same lock
+     */
+    struct BitmapsShard {
+        LockConfigT lock;
+        PandaUnorderedMap<uintptr_t, Bitmap> bitmaps;
+    };
+
+    static constexpr size_t SHARDS_COUNT = 4U;
+
+    BitmapsShard &GetShard(uintptr_t bitmapBeginAddr);
+
     static size_t GetIdxInBitmap(uintptr_t addr, uintptr_t bitmapBeginAddr);
     template <bool NEED_LOCK>
     PandaUnorderedSet<Region *> *GetRefRegions();
@@ -141,9 +159,9 @@ private:
     template <bool NEED_LOCK>
     void RemoveRefRegion(Region *region);
 
+    // Guards refRegions_
     LockConfigT remSetLock_;
-    // NOTE(alovkov): make value a Set?
-    PandaUnorderedMap<uintptr_t, Bitmap> bitmaps_;
+    std::array<BitmapsShard, SHARDS_COUNT> shards_;
     PandaUnorderedSet<Region *> refRegions_;
 
     friend class test::RemSetTest;
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -24,15 +24,17 @@ namespace ark {
 
 Monitor *MonitorPool::CreateMonitor(ObjectHeader *obj)
 {
-    os::memory::LockHolder lock(poolLock_);
     for (Monitor::MonitorId i = 0; i < MAX_MONITOR_ID; i++) {
-        lastId_ = (lastId_ + 1) % MAX_MONITOR_ID;
-        if (monitors_.count(lastId_) == 0) {
-            auto monitor = allocator_->New<Monitor>(lastId_);
+        // Atomic with relaxed order reason: the candidate is checked and taken under the shard lock
+        Monitor::MonitorId id = (lastId_.fetch_add(1, std::memory_order_relaxed) + 1) % MAX_MONITOR_ID;
+        auto &shard = GetShard(id);
+        os::memory::LockHolder lock(shard.lock);
+        if (shard.monitors.count(id) == 0) {
+            auto monitor = allocator_->New<Monitor>(id);
             if (monitor == nullptr) {
                 return nullptr;
             }
-            monitors_[lastId_] = monitor;
+            shard.monitors[id] = monitor;
             monitor->SetObject(obj);
             return monitor;
         }
@@ -43,9 +45,10 @@ Monitor *MonitorPool::CreateMonitor(ObjectHeader *obj)
 
 Monitor *MonitorPool::LookupMonitor(Monitor::MonitorId id)
 {
-    os::memory::LockHolder lock(poolLock_);
-    auto it = monitors_.find(id);
-    if (it != monitors_.end()) {
+    auto &shard = GetShard(id);
+    os::memory::LockHolder lock(shard.lock);
+    auto it = shard.monitors.find(id);
+    if (it != shard.monitors.end()) {
         return it->second;
     }
     return nullptr;
@@ -53,37 +56,31 @@ Monitor *MonitorPool::LookupMonitor(Monitor::MonitorId id)
 
 void MonitorPool::FreeMonitor(Monitor::MonitorId id)
 {
-    os::memory::LockHolder lock(poolLock_);
-    auto it = monitors_.find(id);
-    if (it != monitors_.end()) {
+    auto &shard = GetShard(id);
+    os::memory::LockHolder lock(shard.lock);
+    auto it = shard.monitors.find(id);
+    if (it != shard.monitors.end()) {
         auto *monitor = it->second;
-        monitors_.erase(it);
+        shard.monitors.erase(it);
         allocator_->Delete(monitor);
     }
 }
 
 void MonitorPool::DeflateMonitors()
 {
-    os::memory::LockHolder lock(poolLock_);
-    for (auto monitorIter = monitors_.begin(); monitorIter != monitors_.end();) {
-        auto monitor = monitorIter->second;
-        if (monitor->DeflateInternal()) {
-            monitorIter = monitors_.erase(monitorIter);
-            allocator_->Delete(monitor);
-        } else {
-            monitorIter++;
-        }
-    }
+    DeflateMonitorsWithCallBack([]([[maybe_unused]] Monitor *monitor) { return true; });
 }
 
 void MonitorPool::ReleaseMonitors(MTManagedThread *thread)
 {
-    os::memory::LockHolder lock(poolLock_);
-    for (auto &it : monitors_) {
-        auto *monitor = it.second;
-        // Recursive lock is possible
-        while (monitor->GetOwner() == thread) {
-            monitor->Release(thread);
+    for (auto *shard : shards_) {
+        os::memory::LockHolder lock(shard->lock);
+        for (auto &it : shard->monitors) {
+            auto *monitor = it.second;
+            // Recursive lock is possible
+            while (monitor->GetOwner() == thread) {
+                monitor->Release(thread);
+            }
         }
     }
 }
@@ -91,13 +88,12 @@ void MonitorPool::ReleaseMonitors(MTManagedThread *thread)
 PandaSet<Monitor::MonitorId> MonitorPool::GetEnteredMonitorsIds(MTManagedThread *thread)
 {
     PandaSet<Monitor::MonitorId> enteredMonitorsIds;
-    os::memory::LockHolder lock(poolLock_);
-    for (auto &it : monitors_) {
-        auto *monitor = it.second;
+    EnumerateMonitors([thread, &enteredMonitorsIds](Monitor *monitor) {
         if (monitor->GetOwner() == thread) {
             enteredMonitorsIds.insert(monitor->GetId());
         }
-    }
+        return true;
+    });
     return enteredMonitorsIds;
 }
 
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,9 @@
 #ifndef PANDA_RUNTIME_MONITOR_POOL_H_
 #define PANDA_RUNTIME_MONITOR_POOL_H_
 
+#include <array>
+#include <atomic>
+
 #include "libpandabase/os/mutex.h"
 #include "runtime/include/mem/panda_containers.h"
 #include "runtime/include/object_header.h"
@@ -33,13 +36,18 @@ public:
 
     static constexpr Monitor::MonitorId MAX_MONITOR_ID = MarkWord::MONITOR_POINTER_MAX_COUNT;
 
+    // Monitors are spread over the shards by id, so lookups of different monitors do not contend on one lock
+    static constexpr size_t SHARD_COUNT = 16;
+
     template <class Callback>
     void EnumerateMonitors(const Callback &cb)
     {
-        os::memory::LockHolder lock(poolLock_);
-        for (auto &iter : monitors_) {
-            if (!cb(iter.second)) {
-                break;
+        for (auto *shard : shards_) {
+            os::memory::LockHolder lock(shard->lock);
+            for (auto &iter : shard->monitors) {
+                if (!cb(iter.second)) {
+                    return;
+                }
             }
         }
     }
@@ -47,22 +55,25 @@ public:
     template <class Callback>
     void DeflateMonitorsWithCallBack(const Callback &cb)
     {
-        os::memory::LockHolder lock(poolLock_);
-        for (auto monitorIter = monitors_.begin(); monitorIter != monitors_.end();) {
-            auto monitor = monitorIter->second;
-            if (cb(monitor) && monitor->DeflateInternal()) {
-                monitorIter = monitors_.erase(monitorIter);
-                allocator_->Delete(monitor);
-            } else {
-                monitorIter++;
+        for (auto *shard : shards_) {
+            os::memory::LockHolder lock(shard->lock);
+            for (auto monitorIter = shard->monitors.begin(); monitorIter != shard->monitors.end();) {
+                auto monitor = monitorIter->second;
+                if (cb(monitor) && monitor->DeflateInternal()) {
+                    monitorIter = shard->monitors.erase(monitorIter);
+                    allocator_->Delete(monitor);
+                } else {
+                    monitorIter++;
+                }
             }
         }
     }
 
-    explicit MonitorPool(mem::InternalAllocatorPtr allocator) : monitors_(allocator->Adapter())
+    explicit MonitorPool(mem::InternalAllocatorPtr allocator) : allocator_(allocator)
     {
-        lastId_ = 0;
-        allocator_ = allocator;
+        for (auto &shard : shards_) {
+            shard = allocator_->New<Shard>(allocator_);
+        }
     }
 
     ~MonitorPool()
@@ -75,10 +86,13 @@ public:
             TSAN_ANNOTATE_IGNORE_WRITES_BEGIN();
         }
 #endif
-        for (auto &iter : monitors_) {
-            if (iter.second != nullptr) {
-                allocator_->Delete(iter.second);
+        for (auto *shard : shards_) {
+            for (auto &iter : shard->monitors) {
+                if (iter.second != nullptr) {
+                    allocator_->Delete(iter.second);
+                }
             }
+            allocator_->Delete(shard);
         }
 #if defined(PANDA_TSAN_ON)
         if (os::memory::Mutex::DoNotCheckOnTerminationLoop()) {
@@ -100,12 +114,23 @@ public:
     PandaSet<Monitor::MonitorId> GetEnteredMonitorsIds(MTManagedThread *thread);
 
 private:
-    mem::InternalAllocatorPtr allocator_;
-    // Lock for private data protection.
-    os::memory::Mutex poolLock_;
+    struct Shard {
+        explicit Shard(mem::InternalAllocatorPtr allocator) : monitors(allocator->Adapter()) {}
+
+        // Lock for private data protection.
+        os::memory::Mutex lock;
+        PandaUnorderedMap<Monitor::MonitorId, Monitor *> monitors GUARDED_BY(lock);
+    };
 
-    Monitor::MonitorId lastId_ GUARDED_BY(poolLock_);
-    PandaUnorderedMap<Monitor::MonitorId, Monitor *> monitors_ GUARDED_BY(poolLock_);
+    Shard &GetShard(Monitor::MonitorId id)
+    {
+        return *shards_[id % SHARD_COUNT];
+    }
+
+    mem::InternalAllocatorPtr allocator_;
+    // Source of candidate ids, a candidate is taken only if it is free in its shard
+    std::atomic<Monitor::MonitorId> lastId_ {0};
+    std::array<Shard *, SHARD_COUNT> shards_ {};
 };
 
 }  // namespace ark
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -153,6 +153,8 @@ private:
     friend class RegExpParser;
     friend class RegExpOpCode;
     friend class RegExpExecutor;
+    friend class RegExpPrefilter;
+    friend class RegExpDfa;
 
     explicit DynChunk(uint8_t *buf) : buf_(buf), isInternalBuffer_(true) {};
 
@@ -0,0 +1,416 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/regexp/ecmascript/regexp_dfa.h"
+#include "runtime/regexp/ecmascript/regexp_executor.h"
+#include "runtime/regexp/ecmascript/regexp_opcode.h"
+
+#include <algorithm>
+
+namespace ark {
+
+RegExpDfa::RegExpDfa(const uint8_t *byteCode)
+    : byteCode_(const_cast<uint8_t *>(byteCode)),
+      codeSize_(byteCode_.GetU32(0)),
+      flags_(byteCode_.GetU32(RegExpParser::FLAGS_OFFSET)),
+      isSupported_(CheckSupported())
+{
+    startStates_.fill(UNKNOWN_STATE);
+}
+
+bool RegExpDfa::CheckSupported() const
+{
+    uint32_t pc = RegExpParser::OP_START_OFFSET;
+    while (pc < codeSize_) {
+        switch (byteCode_.GetU8(pc)) {
+            case RegExpOpCode::OP_MATCH_AHEAD:
+            case RegExpOpCode::OP_NEGATIVE_MATCH_AHEAD:
+            case RegExpOpCode::OP_MATCH:
+            case RegExpOpCode::OP_PREV:
+            case RegExpOpCode::OP_BACKREFERENCE:
+            case RegExpOpCode::OP_BACKWARD_BACKREFERENCE:
+                return false;
+            default:
+                if (byteCode_.GetU8(pc) >= RegExpOpCode::OP_INVALID) {
+                    return false;
+                }
+                break;
+        }
+        pc += GetOpSize(pc);
+    }
+    return true;
+}
+
+uint32_t RegExpDfa::GetOpSize(uint32_t pc) const
+{
+    uint8_t opCode = byteCode_.GetU8(pc);
+    if (opCode == RegExpOpCode::OP_RANGE) {
+        return byteCode_.GetU16(pc + 1) * RegExpOpCode::OP_SIZE_FOUR + RegExpOpCode::OP_SIZE_THREE;
+    }
+    if (opCode == RegExpOpCode::OP_RANGE32) {
+        return byteCode_.GetU16(pc + 1) * RegExpOpCode::OP_SIZE_EIGHT + RegExpOpCode::OP_SIZE_THREE;
+    }
+    return RegExpOpCode::GetRegExpOpCode(opCode)->GetSize();
+}
+
+bool RegExpDfa::AcceptsChar(uint32_t pc, uint8_t opCode, uint32_t c) const
+{
+    if (opCode == RegExpOpCode::OP_ALL) {
+        return true;
+    }
+    if (opCode == RegExpOpCode::OP_DOTS) {
+        return !IsTerminator(c);
+    }
+    if (HasFlag(RegExpParser::FLAG_IGNORECASE)) {
+        c = static_cast<uint32_t>(RegExpParser::Canonicalize(c, HasFlag(RegExpParser::FLAG_UTF16)));
+    }
+    switch (opCode) {
+        case RegExpOpCode::OP_CHAR:
+            return c == byteCode_.GetU16(pc + 1);
+        case RegExpOpCode::OP_CHAR32:
+            return c == byteCode_.GetU32(pc + 1);
+        case RegExpOpCode::OP_RANGE:
+        case RegExpOpCode::OP_RANGE32: {
+            bool isRange32 = opCode == RegExpOpCode::OP_RANGE32;
+            uint32_t rangeSize = isRange32 ? RegExpOpCode::OP_SIZE_EIGHT : RegExpOpCode::OP_SIZE_FOUR;
+            uint32_t halfSize = rangeSize / 2U;
+            uint32_t rangeCount = byteCode_.GetU16(pc + 1);
+            for (uint32_t i = 0; i < rangeCount; i++) {
+                uint32_t offset = pc + RegExpOpCode::OP_SIZE_THREE + i * rangeSize;
+                uint32_t low = isRange32 ? byteCode_.GetU32(offset) : byteCode_.GetU16(offset);
+                uint32_t high = isRange32 ? byteCode_.GetU32(offset + halfSize) : byteCode_.GetU16(offset + halfSize);
+                if (c >= low && c <= high) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default:
+            UNREACHABLE();
+    }
+}
+
+// Mirrors the checks of RegExpExecutor, including the end of input corner cases
+bool RegExpDfa::CheckAssertion(uint8_t opCode, PrevChar prev, uint32_t c) const
+{
+    switch (opCode) {
+        case RegExpOpCode::OP_LINE_START:
+            return c != END_OF_INPUT &&
+                   (prev == PREV_INPUT_START || (HasFlag(RegExpParser::FLAG_MULTILINE) && prev == PREV_NEW_LINE));
+        case RegExpOpCode::OP_LINE_END:
+            return c == END_OF_INPUT || (HasFlag(RegExpParser::FLAG_MULTILINE) && c == '\n');
+        case RegExpOpCode::OP_WORD_BOUNDARY:
+        case RegExpOpCode::OP_NOT_WORD_BOUNDARY: {
+            bool isBoundary = opCode == RegExpOpCode::OP_WORD_BOUNDARY;
+            if (c == END_OF_INPUT) {
+                return isBoundary;
+            }
+            return isBoundary == ((prev == PREV_WORD) != IsWordChar(static_cast<uint8_t>(c)));
+        }
+        default:
+            UNREACHABLE();
+    }
+}
+
+void RegExpDfa::AddLoopSuccessors(uint32_t pc, uint8_t opCode, const Thread &thread,
+                                  PandaVector<Thread> &worklist) const
+{
+    uint32_t quantifyMin = byteCode_.GetU32(pc + RegExpExecutor::LOOP_MIN_OFFSET);
+    uint32_t quantifyMax = byteCode_.GetU32(pc + RegExpExecutor::LOOP_MAX_OFFSET);
+    uint32_t loopPcEnd = pc + GetOpSize(pc);
+    uint32_t loopPcStart = loopPcEnd + byteCode_.GetU32(pc + RegExpExecutor::LOOP_PC_OFFSET);
+    bool isGreedy = opCode == RegExpOpCode::OP_LOOP_GREEDY;
+    uint32_t loopMax = isGreedy ? quantifyMax : quantifyMin;
+    uint32_t loopCount = static_cast<uint32_t>(thread.back()) + 1U;
+
+    Thread next = thread;
+    // Iterations of an unbounded loop past its minimum are indistinguishable
+    next.back() = static_cast<int32_t>(quantifyMax == INT32_MAX ? std::min(loopCount, quantifyMin) : loopCount);
+    auto addBranch = [&worklist, &next](uint32_t target) {
+        next[0] = static_cast<int32_t>(target);
+        worklist.push_back(next);
+    };
+    if (loopCount < loopMax) {
+        if (loopCount >= quantifyMin) {
+            addBranch(loopPcEnd);
+        }
+        addBranch(loopPcStart);
+    } else {
+        if (!isGreedy && loopCount < quantifyMax) {
+            addBranch(loopPcStart);
+        }
+        addBranch(loopPcEnd);
+    }
+}
+
+/**
+ * Follows all threads of the state through the zero-width operations and moves the ones that
+ * accept the character c to the next set. Reaching MATCH_END means the input has a match.
+ */
+RegExpDfa::Result RegExpDfa::Step(const State &state, uint32_t c, ThreadSet &next) const
+{
+    PandaVector<Thread> worklist(state.threads.begin(), state.threads.end());
+    ThreadSet visited;
+    while (!worklist.empty()) {
+        Thread thread = std::move(worklist.back());
+        worklist.pop_back();
+        if (!visited.insert(thread).second) {
+            continue;
+        }
+        if (visited.size() > MAX_THREADS) {
+            return Result::UNKNOWN;
+        }
+        auto pc = static_cast<uint32_t>(thread[0]);
+        uint8_t opCode = byteCode_.GetU8(pc);
+        uint32_t nextPc = pc + GetOpSize(pc);
+        switch (opCode) {
+            case RegExpOpCode::OP_MATCH_END:
+                return Result::MATCH;
+            case RegExpOpCode::OP_SAVE_START:
+            case RegExpOpCode::OP_SAVE_END:
+            case RegExpOpCode::OP_SAVE_RESET:
+                break;
+            case RegExpOpCode::OP_LINE_START:
+            case RegExpOpCode::OP_LINE_END:
+            case RegExpOpCode::OP_WORD_BOUNDARY:
+            case RegExpOpCode::OP_NOT_WORD_BOUNDARY:
+                if (!CheckAssertion(opCode, state.prev, c)) {
+                    continue;
+                }
+                break;
+            case RegExpOpCode::OP_GOTO:
+                nextPc += byteCode_.GetU32(pc + 1);
+                break;
+            case RegExpOpCode::OP_SPLIT_NEXT:
+            case RegExpOpCode::OP_SPLIT_FIRST: {
+                Thread branch = thread;
+                branch[0] = static_cast<int32_t>(nextPc + byteCode_.GetU32(pc + 1));
+                worklist.push_back(std::move(branch));
+                break;
+            }
+            case RegExpOpCode::OP_PUSH:
+                thread.push_back(0);
+                break;
+            case RegExpOpCode::OP_PUSH_CHAR:
+                thread.push_back(NOT_ADVANCED);
+                break;
+            case RegExpOpCode::OP_POP:
+                thread.pop_back();
+                break;
+            case RegExpOpCode::OP_CHECK_CHAR: {
+                bool isAdvanced = thread.back() == ADVANCED;
+                thread.pop_back();
+                if (!isAdvanced) {
+                    nextPc += byteCode_.GetU32(pc + 1);
+                }
+                break;
+            }
+            case RegExpOpCode::OP_LOOP:
+            case RegExpOpCode::OP_LOOP_GREEDY:
+                AddLoopSuccessors(pc, opCode, thread, worklist);
+                continue;
+            default:
+                if (c != END_OF_INPUT && AcceptsChar(pc, opCode, c)) {
+                    thread[0] = static_cast<int32_t>(nextPc);
+                    std::replace(std::next(thread.begin()), thread.end(), NOT_ADVANCED, ADVANCED);
+                    next.insert(std::move(thread));
+                }
+                continue;
+        }
+        thread[0] = static_cast<int32_t>(nextPc);
+        worklist.push_back(std::move(thread));
+    }
+    return Result::NO_MATCH;
+}
+
+RegExpDfa::PrevChar RegExpDfa::GetPrevChar(uint32_t c)
+{
+    if (c == '\n') {
+        return PREV_NEW_LINE;
+    }
+    // The executor checks word characters by the low byte
+    return IsWordChar(static_cast<uint8_t>(c)) ? PREV_WORD : PREV_OTHER;
+}
+
+int32_t RegExpDfa::AddState(ThreadSet &&threads, PrevChar prev, bool search)
+{
+    if (search) {
+        threads.insert(Thread {static_cast<int32_t>(RegExpParser::OP_START_OFFSET)});
+    }
+    PandaVector<int32_t> key {static_cast<int32_t>(search), prev};
+    for (const auto &thread : threads) {
+        key.push_back(static_cast<int32_t>(thread.size()));
+        key.insert(key.end(), thread.begin(), thread.end());
+    }
+    auto it = stateIds_.find(key);
+    if (it != stateIds_.end()) {
+        return it->second;
+    }
+    if (states_.size() >= MAX_STATES) {
+        return LIMIT_STATE;
+    }
+    auto stateId = static_cast<int32_t>(states_.size());
+    State &state = states_.emplace_back();
+    state.isDead = !search && threads.empty();
+    state.threads = std::move(threads);
+    state.prev = prev;
+    state.search = search;
+    state.transitions.resize(CHAR_TABLE_SIZE, UNKNOWN_STATE);
+    stateIds_.emplace(std::move(key), stateId);
+    return stateId;
+}
+
+int32_t RegExpDfa::ComputeTransition(int32_t stateId, uint32_t c)
+{
+    ThreadSet next;
+    Result result = Step(states_[stateId], c, next);
+    if (result == Result::UNKNOWN) {
+        return LIMIT_STATE;
+    }
+    if (result == Result::MATCH) {
+        return MATCH_STATE;
+    }
+    if (c == END_OF_INPUT) {
+        return NO_MATCH_STATE;
+    }
+    return AddState(std::move(next), GetPrevChar(c), states_[stateId].search);
+}
+
+int32_t RegExpDfa::GetTransition(int32_t stateId, uint32_t c)
+{
+    State &state = states_[stateId];
+    int32_t *cached = nullptr;
+    if (c < CHAR_TABLE_SIZE) {
+        cached = &state.transitions[c];
+    } else if (c == END_OF_INPUT) {
+        cached = &state.endTransition;
+    } else {
+        cached = &state.wideTransitions.try_emplace(c, UNKNOWN_STATE).first->second;
+    }
+    if (*cached != UNKNOWN_STATE) {
+        return *cached;
+    }
+    int32_t target = ComputeTransition(stateId, c);
+    if (target != LIMIT_STATE) {
+        // states_ may have been reallocated while the target was added
+        State &current = states_[stateId];
+        if (c < CHAR_TABLE_SIZE) {
+            current.transitions[c] = target;
+        } else if (c == END_OF_INPUT) {
+            current.endTransition = target;
+        } else {
+            current.wideTransitions[c] = target;
+        }
+    }
+    return target;
+}
+
+uint32_t RegExpDfa::ReadChar(const uint8_t **pp, const uint8_t *end, bool isWideChar) const
+{
+    const uint8_t *cptr = *pp;
+    if (!isWideChar) {
+        *pp += 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return *cptr;
+    }
+    uint32_t c = *reinterpret_cast<const uint16_t *>(cptr);
+    cptr += RegExpExecutor::WIDE_CHAR_SIZE;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (U16_IS_LEAD(c) && HasFlag(RegExpParser::FLAG_UTF16) && cptr < end) {
+        uint16_t c1 = *reinterpret_cast<const uint16_t *>(cptr);
+        if (U16_IS_TRAIL(c1)) {
+            c = static_cast<uint32_t>(U16_GET_SUPPLEMENTARY(c, c1));  // NOLINT(hicpp-signed-bitwise)
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            cptr += RegExpExecutor::WIDE_CHAR_SIZE;
+        }
+    }
+    *pp = cptr;
+    return c;
+}
+
+uint32_t RegExpDfa::ReadPrevChar(const uint8_t *input, const uint8_t *p, bool isWideChar) const
+{
+    if (!isWideChar) {
+        return p[-1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto *cptr = reinterpret_cast<const uint16_t *>(p) - 1;
+    uint32_t c = *cptr;
+    if (U16_IS_TRAIL(c) && HasFlag(RegExpParser::FLAG_UTF16) && reinterpret_cast<const uint8_t *>(cptr) > input) {
+        uint16_t c1 = cptr[-1];  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (U16_IS_LEAD(c1)) {
+            c = static_cast<uint32_t>(U16_GET_SUPPLEMENTARY(c1, c));  // NOLINT(hicpp-signed-bitwise)
+        }
+    }
+    return c;
+}
+
+RegExpDfa::Result RegExpDfa::Match(const uint8_t *input, const uint8_t *start, const uint8_t *end, bool isWideChar,
+                                   bool search)
+{
+    if (!isSupported_) {
+        return Result::UNKNOWN;
+    }
+    // Another thread is extending the automaton, running the executor is cheaper than waiting
+    if (!lock_.TryLock()) {
+        return Result::UNKNOWN;
+    }
+    Result result = MatchLocked(input, start, end, isWideChar, search);
+    lock_.Unlock();
+    return result;
+}
+
+RegExpDfa::Result RegExpDfa::MatchLocked(const uint8_t *input, const uint8_t *start, const uint8_t *end,
+                                         bool isWideChar, bool search)
+{
+    if (isExhausted_) {
+        return Result::UNKNOWN;
+    }
+    PrevChar prev = start == input ? PREV_INPUT_START : GetPrevChar(ReadPrevChar(input, start, isWideChar));
+    int32_t &startState = startStates_[static_cast<size_t>(search) * PREV_KINDS + prev];
+    if (startState == UNKNOWN_STATE) {
+        ThreadSet threads;
+        threads.insert(Thread {static_cast<int32_t>(RegExpParser::OP_START_OFFSET)});
+        startState = AddState(std::move(threads), prev, search);
+    }
+    int32_t stateId = startState;
+    const uint8_t *ptr = start;
+    while (stateId >= 0) {
+        if (states_[stateId].isDead) {
+            return Result::NO_MATCH;
+        }
+        if (ptr >= end) {
+            stateId = GetTransition(stateId, END_OF_INPUT);
+            break;
+        }
+        uint32_t c = ReadChar(&ptr, end, isWideChar);
+        int32_t next = c < CHAR_TABLE_SIZE ? states_[stateId].transitions[c] : UNKNOWN_STATE;
+        stateId = next != UNKNOWN_STATE ? next : GetTransition(stateId, c);
+    }
+    switch (stateId) {
+        case MATCH_STATE:
+            return Result::MATCH;
+        case NO_MATCH_STATE:
+            return Result::NO_MATCH;
+        default:
+            // Too many states for this pattern, release them and always fall back to the executor
+            ASSERT(stateId == LIMIT_STATE);
+            isExhausted_ = true;
+            states_.clear();
+            stateIds_.clear();
+            startStates_.fill(LIMIT_STATE);
+            return Result::UNKNOWN;
+    }
+}
+
+}  // namespace ark
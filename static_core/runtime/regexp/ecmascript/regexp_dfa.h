@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_REGEXP_DFA_H
+#define PANDA_RUNTIME_REGEXP_DFA_H
+
+#include <array>
+#include "libpandabase/os/mutex.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/regexp/ecmascript/regexp_parser.h"
+
+namespace ark {
+
+/**
+ * Lazily built DFA over the bytecode of a pattern without backreferences and lookaround.
+ * A DFA state is the set of backtracking threads alive after the same input prefix. A thread is the
+ * program counter together with the abstract executor stack: loop counters, saturated at the minimum
+ * for unbounded loops, and markers telling whether the loop iteration has consumed a character.
+ * The automaton answers in one pass whether the input contains a match, so the backtracking executor
+ * only runs for the inputs that do match and the rejected inputs never backtrack.
+ */
+class RegExpDfa {
+public:
+    enum class Result : uint8_t { MATCH, NO_MATCH, UNKNOWN };
+
+    static constexpr uint32_t MAX_STATES = 512;
+    static constexpr uint32_t MAX_THREADS = 1024;
+    static constexpr uint32_t CHAR_TABLE_SIZE = 256;
+
+    PANDA_PUBLIC_API explicit RegExpDfa(const uint8_t *byteCode);
+    ~RegExpDfa() = default;
+
+    NO_COPY_SEMANTIC(RegExpDfa);
+    NO_MOVE_SEMANTIC(RegExpDfa);
+
+    bool IsSupported() const
+    {
+        return isSupported_;
+    }
+
+    /**
+     * Checks whether a match starts in [start, end], or exactly at start when search is false.
+     * Returns UNKNOWN when the pattern is not supported, the state limit is reached or the automaton
+     * is busy in another thread; the caller falls back to the backtracking executor then.
+     */
+    PANDA_PUBLIC_API Result Match(const uint8_t *input, const uint8_t *start, const uint8_t *end, bool isWideChar,
+                                  bool search);
+
+private:
+    // Kind of the previous character, the only context the zero-width assertions depend on
+    enum PrevChar : int32_t { PREV_INPUT_START = 0, PREV_WORD, PREV_NEW_LINE, PREV_OTHER, PREV_KINDS };
+
+    // A thread is the program counter followed by the executor stack
+    using Thread = PandaVector<int32_t>;
+    using ThreadSet = PandaSet<Thread>;
+
+    static constexpr int32_t UNKNOWN_STATE = -1;
+    static constexpr int32_t MATCH_STATE = -2;
+    static constexpr int32_t NO_MATCH_STATE = -3;
+    static constexpr int32_t LIMIT_STATE = -4;
+    // PUSH_CHAR markers, loop counters are never negative
+    static constexpr int32_t NOT_ADVANCED = -1;
+    static constexpr int32_t ADVANCED = -2;
+    static constexpr uint32_t END_OF_INPUT = UINT32_MAX;
+
+    struct State {
+        ThreadSet threads;
+        PrevChar prev = PREV_INPUT_START;
+        bool search = false;
+        bool isDead = false;
+        PandaVector<int32_t> transitions;
+        PandaUnorderedMap<uint32_t, int32_t> wideTransitions;
+        int32_t endTransition = UNKNOWN_STATE;
+    };
+
+    bool CheckSupported() const;
+    uint32_t GetOpSize(uint32_t pc) const;
+    bool AcceptsChar(uint32_t pc, uint8_t opCode, uint32_t c) const;
+    bool CheckAssertion(uint8_t opCode, PrevChar prev, uint32_t c) const;
+    void AddLoopSuccessors(uint32_t pc, uint8_t opCode, const Thread &thread, PandaVector<Thread> &worklist) const;
+    Result Step(const State &state, uint32_t c, ThreadSet &next) const;
+    Result MatchLocked(const uint8_t *input, const uint8_t *start, const uint8_t *end, bool isWideChar, bool search)
+        REQUIRES(lock_);
+    int32_t GetTransition(int32_t stateId, uint32_t c) REQUIRES(lock_);
+    int32_t ComputeTransition(int32_t stateId, uint32_t c) REQUIRES(lock_);
+    int32_t AddState(ThreadSet &&threads, PrevChar prev, bool search) REQUIRES(lock_);
+    static PrevChar GetPrevChar(uint32_t c);
+    uint32_t ReadChar(const uint8_t **pp, const uint8_t *end, bool isWideChar) const;
+    uint32_t ReadPrevChar(const uint8_t *input, const uint8_t *p, bool isWideChar) const;
+
+    static bool IsWordChar(uint8_t value)
+    {
+        return ((value >= '0' && value <= '9') || (value >= 'a' && value <= 'z') || (value >= 'A' && value <= 'Z') ||
+                (value == '_'));
+    }
+
+    static bool IsTerminator(uint32_t value)
+    {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        return (value == '\n' || value == '\r' || value == 0x2028 || value == 0x2029);
+    }
+
+    bool HasFlag(uint32_t flag) const
+    {
+        return (flags_ & flag) != 0;
+    }
+
+    DynChunk byteCode_;
+    uint32_t codeSize_;
+    uint32_t flags_;
+    bool isSupported_;
+    os::memory::Mutex lock_;
+    bool isExhausted_ GUARDED_BY(lock_) = false;
+    PandaVector<State> states_ GUARDED_BY(lock_);
+    PandaMap<PandaVector<int32_t>, int32_t> stateIds_ GUARDED_BY(lock_);
+    std::array<int32_t, PREV_KINDS * 2U> startStates_ GUARDED_BY(lock_);
+};
+}  // namespace ark
+#endif  // PANDA_RUNTIME_REGEXP_DFA_H
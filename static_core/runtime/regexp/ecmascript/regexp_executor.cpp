@@ -14,6 +14,7 @@
  */
 
 #include "runtime/regexp/ecmascript/regexp_executor.h"
+#include "runtime/regexp/ecmascript/regexp_dfa.h"
 #include "runtime/regexp/ecmascript/regexp_opcode.h"
 #include "runtime/regexp/ecmascript/mem/dyn_chunk.h"
 #include "utils/logger.h"
@@ -61,14 +62,38 @@ bool RegExpExecutor::Execute(const uint8_t *input, uint32_t lastIndex, uint32_t
     // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
     SetCurrentPtr(input + lastIndex * (isWideChar ? WIDE_CHAR_SIZE : CHAR_SIZE));
     SetCurrentPC(RegExpParser::OP_START_OFFSET);
+    if (!StartSearch()) {
+        return false;
+    }
 
     // first split
-    if ((flags_ & RegExpParser::FLAG_STICKY) == 0) {
+    if (isSearch_) {
         PushRegExpState(STATE_SPLIT, RegExpParser::OP_START_OFFSET);
     }
     return ExecuteInternal(buffer, size);
 }
 
+// Returns false if the accelerators prove there is no match at or after the current position
+bool RegExpExecutor::StartSearch()
+{
+    isSearch_ = (flags_ & RegExpParser::FLAG_STICKY) == 0;
+    if (prefilter_ != nullptr && prefilter_->IsAnchored()) {
+        if (GetCurrentPtr() != input_) {
+            return false;
+        }
+        // Only the input start may match, the search loop would try the other positions in vain
+        isSearch_ = false;
+    }
+    if (isSearch_ && !SkipToCandidate()) {
+        return false;
+    }
+    if (dfa_ != nullptr) {
+        auto result = dfa_->Match(input_, GetCurrentPtr(), inputEnd_, isWideChar_, isSearch_);
+        return result != RegExpDfa::Result::NO_MATCH;
+    }
+    return true;
+}
+
 bool RegExpExecutor::MatchFailed(bool isMatched)
 {
     while (true) {
@@ -17,8 +17,10 @@
 #define PANDA_RUNTIME_REGEXP_EXECUTOR_H
 
 #include "runtime/regexp/ecmascript/regexp_parser.h"
+#include "runtime/regexp/ecmascript/regexp_prefilter.h"
 
 namespace ark {
+class RegExpDfa;
 
 template <class T>
 struct RegExpMatchResult {
@@ -69,23 +71,52 @@ public:
     PANDA_PUBLIC_API bool Execute(const uint8_t *input, uint32_t lastIndex, uint32_t length, uint8_t *buf,
                                   bool isWideChar = false);
 
+    /**
+     * Optional accelerators built from the same bytecode: the prefilter skips the start positions
+     * that can not begin a match, the DFA rejects the inputs without a match before backtracking.
+     */
+    void SetPrefilter(const RegExpPrefilter *prefilter)
+    {
+        prefilter_ = prefilter;
+    }
+
+    void SetDfa(RegExpDfa *dfa)
+    {
+        dfa_ = dfa;
+    }
+
     bool ExecuteInternal(const DynChunk &byteCode, uint32_t pcEnd);
     inline bool HandleFirstSplit()
     {
-        if (GetCurrentPC() == RegExpParser::OP_START_OFFSET && stateStackLen_ == 0 &&
-            (flags_ & RegExpParser::FLAG_STICKY) == 0) {
+        if (GetCurrentPC() == RegExpParser::OP_START_OFFSET && stateStackLen_ == 0 && isSearch_) {
             if (IsEOF()) {
                 if (MatchFailed()) {
                     return false;
                 }
             } else {
                 AdvanceCurrentPtr();
+                if (!SkipToCandidate()) {
+                    return false;
+                }
                 PushRegExpState(STATE_SPLIT, RegExpParser::OP_START_OFFSET);
             }
         }
         return true;
     }
 
+    inline bool SkipToCandidate()
+    {
+        if (prefilter_ == nullptr || !prefilter_->HasFilter()) {
+            return true;
+        }
+        const uint8_t *candidate = prefilter_->FindCandidate(currentPtr_, inputEnd_, isWideChar_);
+        if (candidate == inputEnd_) {
+            return false;
+        }
+        SetCurrentPtr(candidate);
+        return true;
+    }
+
     inline bool HandleOpAll(uint8_t opCode)
     {
         if (IsEOF()) {
@@ -536,9 +567,14 @@ public:
     static constexpr uint32_t MIN_STACK_SIZE = 8;
 
 private:
+    bool StartSearch();
+
     uint8_t *input_ = nullptr;
     uint8_t *inputEnd_ = nullptr;
     bool isWideChar_ = false;
+    bool isSearch_ = false;
+    const RegExpPrefilter *prefilter_ = nullptr;
+    RegExpDfa *dfa_ = nullptr;
 
     uint32_t currentPc_ = 0;
     const uint8_t *currentPtr_ = nullptr;
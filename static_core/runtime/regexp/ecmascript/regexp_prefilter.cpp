@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/regexp/ecmascript/regexp_prefilter.h"
+#include "runtime/regexp/ecmascript/regexp_opcode.h"
+
+#include <cstring>
+
+namespace ark {
+
+void RegExpPrefilter::Analyze(const uint8_t *byteCode)
+{
+    DynChunk buffer(const_cast<uint8_t *>(byteCode));
+    uint32_t size = buffer.GetU32(0);
+    flags_ = buffer.GetU32(RegExpParser::FLAGS_OFFSET);
+    kind_ = FilterKind::NONE;
+    isAnchored_ = false;
+
+    uint32_t pc = RegExpParser::OP_START_OFFSET;
+    while (pc < size) {
+        uint8_t opCode = buffer.GetU8(pc);
+        switch (opCode) {
+            case RegExpOpCode::OP_LINE_START:
+                isAnchored_ = isAnchored_ || (flags_ & RegExpParser::FLAG_MULTILINE) == 0;
+                [[fallthrough]];
+            // Zero-width operations do not move the match start
+            case RegExpOpCode::OP_SAVE_START:
+            case RegExpOpCode::OP_SAVE_END:
+            case RegExpOpCode::OP_LINE_END:
+            case RegExpOpCode::OP_WORD_BOUNDARY:
+            case RegExpOpCode::OP_NOT_WORD_BOUNDARY:
+                pc += RegExpOpCode::GetRegExpOpCode(opCode)->GetSize();
+                break;
+            case RegExpOpCode::OP_CHAR:
+                AnalyzeChars(buffer, pc);
+                return;
+            case RegExpOpCode::OP_RANGE:
+            case RegExpOpCode::OP_RANGE32:
+                AnalyzeRange(buffer, pc, opCode == RegExpOpCode::OP_RANGE32);
+                return;
+            default:
+                return;
+        }
+    }
+}
+
+void RegExpPrefilter::AnalyzeChars(const DynChunk &byteCode, uint32_t pc)
+{
+    if ((flags_ & RegExpParser::FLAG_IGNORECASE) != 0) {
+        // Input characters are canonicalized before the comparison, so only the first one is filtered
+        AddCharToSet(byteCode.GetU16(pc + 1));
+        kind_ = FilterKind::CHAR_SET;
+        return;
+    }
+    bool isUtf16 = (flags_ & RegExpParser::FLAG_UTF16) != 0;
+    if (isUtf16 && U16_IS_SURROGATE(byteCode.GetU16(pc + 1))) {
+        // A lone surrogate unit may be a half of a pair, which is not a valid start position
+        return;
+    }
+    uint32_t size = byteCode.GetU32(0);
+    prefixLength_ = 0;
+    while (pc < size && prefixLength_ < MAX_PREFIX_LENGTH) {
+        uint8_t opCode = byteCode.GetU8(pc);
+        if (opCode == RegExpOpCode::OP_CHAR) {
+            prefix_[prefixLength_++] = byteCode.GetU16(pc + 1);
+        } else if (opCode != RegExpOpCode::OP_SAVE_START && opCode != RegExpOpCode::OP_SAVE_END) {
+            break;
+        }
+        pc += RegExpOpCode::GetRegExpOpCode(opCode)->GetSize();
+    }
+    kind_ = FilterKind::PREFIX;
+}
+
+void RegExpPrefilter::AnalyzeRange(const DynChunk &byteCode, uint32_t pc, bool isRange32)
+{
+    uint32_t rangeCount = byteCode.GetU16(pc + 1);
+    uint32_t rangeSize = isRange32 ? RegExpOpCode::OP_SIZE_EIGHT : RegExpOpCode::OP_SIZE_FOUR;
+    uint32_t halfSize = rangeSize / 2U;
+    bool ignoreCase = (flags_ & RegExpParser::FLAG_IGNORECASE) != 0;
+    bool isUtf16 = (flags_ & RegExpParser::FLAG_UTF16) != 0;
+    for (uint32_t i = 0; i < rangeCount; i++) {
+        uint32_t offset = pc + RegExpOpCode::OP_SIZE_THREE + i * rangeSize;
+        uint32_t low = isRange32 ? byteCode.GetU32(offset) : byteCode.GetU16(offset);
+        uint32_t high = isRange32 ? byteCode.GetU32(offset + halfSize) : byteCode.GetU16(offset + halfSize);
+        for (uint32_t c = 0; c < CHAR_TABLE_SIZE; c++) {
+            auto canonical = static_cast<uint32_t>(ignoreCase ? RegExpParser::Canonicalize(c, isUtf16) : c);
+            charSet_[c] = charSet_[c] || (canonical >= low && canonical <= high);
+        }
+        acceptsWideChars_ = acceptsWideChars_ || high >= CHAR_TABLE_SIZE;
+    }
+    // Unicode case folding maps some wide characters to latin ones
+    acceptsWideChars_ = acceptsWideChars_ || (ignoreCase && isUtf16);
+    kind_ = FilterKind::CHAR_SET;
+}
+
+void RegExpPrefilter::AddCharToSet(uint32_t expected)
+{
+    bool isUtf16 = (flags_ & RegExpParser::FLAG_UTF16) != 0;
+    for (uint32_t c = 0; c < CHAR_TABLE_SIZE; c++) {
+        charSet_[c] = static_cast<uint32_t>(RegExpParser::Canonicalize(c, isUtf16)) == expected;
+    }
+    acceptsWideChars_ = expected >= CHAR_TABLE_SIZE || isUtf16;
+}
+
+const uint8_t *RegExpPrefilter::FindCandidate(const uint8_t *ptr, const uint8_t *end, bool isWideChar) const
+{
+    switch (kind_) {
+        case FilterKind::PREFIX:
+            return isWideChar ? FindWidePrefix(ptr, end) : FindPrefix(ptr, end);
+        case FilterKind::CHAR_SET:
+            return isWideChar ? FindInCharSet<uint16_t>(ptr, end) : FindInCharSet<uint8_t>(ptr, end);
+        default:
+            return ptr;
+    }
+}
+
+const uint8_t *RegExpPrefilter::FindPrefix(const uint8_t *ptr, const uint8_t *end) const
+{
+    if (prefix_[0] >= CHAR_TABLE_SIZE) {
+        return end;
+    }
+    auto first = static_cast<uint8_t>(prefix_[0]);
+    while (ptr < end) {
+        auto *found = static_cast<const uint8_t *>(memchr(ptr, first, end - ptr));
+        if (found == nullptr || static_cast<size_t>(end - found) < prefixLength_) {
+            return end;
+        }
+        uint32_t i = 1;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        while (i < prefixLength_ && found[i] == prefix_[i]) {
+            i++;
+        }
+        if (i == prefixLength_) {
+            return found;
+        }
+        ptr = found + 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    return end;
+}
+
+const uint8_t *RegExpPrefilter::FindWidePrefix(const uint8_t *ptr, const uint8_t *end) const
+{
+    auto *chars = reinterpret_cast<const uint16_t *>(ptr);
+    auto *charsEnd = reinterpret_cast<const uint16_t *>(end);
+    uint16_t first = prefix_[0];
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (; static_cast<size_t>(charsEnd - chars) >= prefixLength_; chars++) {
+        if (*chars != first) {
+            continue;
+        }
+        uint32_t i = 1;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        while (i < prefixLength_ && chars[i] == prefix_[i]) {
+            i++;
+        }
+        if (i == prefixLength_) {
+            return reinterpret_cast<const uint8_t *>(chars);
+        }
+    }
+    return end;
+}
+
+template <class CharType>
+const uint8_t *RegExpPrefilter::FindInCharSet(const uint8_t *ptr, const uint8_t *end) const
+{
+    auto *chars = reinterpret_cast<const CharType *>(ptr);
+    auto *charsEnd = reinterpret_cast<const CharType *>(end);
+    bool isUtf16 = (flags_ & RegExpParser::FLAG_UTF16) != 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (; chars < charsEnd; chars++) {
+        uint32_t c = *chars;
+        if (c < CHAR_TABLE_SIZE ? !charSet_[c] : !acceptsWideChars_) {
+            continue;
+        }
+        // Never stop in the middle of a surrogate pair
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        if (isUtf16 && U16_IS_TRAIL(c) && chars > reinterpret_cast<const CharType *>(ptr) && U16_IS_LEAD(chars[-1])) {
+            continue;
+        }
+        return reinterpret_cast<const uint8_t *>(chars);
+    }
+    return end;
+}
+
+}  // namespace ark
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_REGEXP_PREFILTER_H
+#define PANDA_RUNTIME_REGEXP_PREFILTER_H
+
+#include <array>
+#include <cstdint>
+#include "runtime/regexp/ecmascript/regexp_parser.h"
+
+namespace ark {
+
+/**
+ * Start position filter derived from the bytecode of a compiled pattern.
+ * Every match has to begin with the same leading atom, so the search loop of the executor may skip
+ * the positions where this atom can not match: a literal prefix is located with memchr, a single
+ * character class is checked with a lookup table. Patterns starting with a non-multiline '^' can only
+ * match at the beginning of the input.
+ */
+class RegExpPrefilter {
+public:
+    static constexpr size_t MAX_PREFIX_LENGTH = 16;
+    static constexpr size_t CHAR_TABLE_SIZE = 256;
+
+    explicit RegExpPrefilter() = default;
+    ~RegExpPrefilter() = default;
+
+    DEFAULT_COPY_SEMANTIC(RegExpPrefilter);
+    DEFAULT_MOVE_SEMANTIC(RegExpPrefilter);
+
+    PANDA_PUBLIC_API void Analyze(const uint8_t *byteCode);
+
+    bool IsAnchored() const
+    {
+        return isAnchored_;
+    }
+
+    bool HasFilter() const
+    {
+        return kind_ != FilterKind::NONE;
+    }
+
+    /**
+     * Returns the first position in [ptr, end) where a match may begin, or end when there is none.
+     * A position equal to end is never rejected since the filter only inspects characters.
+     */
+    PANDA_PUBLIC_API const uint8_t *FindCandidate(const uint8_t *ptr, const uint8_t *end, bool isWideChar) const;
+
+private:
+    enum class FilterKind : uint8_t { NONE, PREFIX, CHAR_SET };
+
+    void AnalyzeChars(const DynChunk &byteCode, uint32_t pc);
+    void AnalyzeRange(const DynChunk &byteCode, uint32_t pc, bool isRange32);
+    void AddCharToSet(uint32_t expected);
+
+    const uint8_t *FindPrefix(const uint8_t *ptr, const uint8_t *end) const;
+    const uint8_t *FindWidePrefix(const uint8_t *ptr, const uint8_t *end) const;
+    template <class CharType>
+    const uint8_t *FindInCharSet(const uint8_t *ptr, const uint8_t *end) const;
+
+    FilterKind kind_ = FilterKind::NONE;
+    bool isAnchored_ = false;
+    bool acceptsWideChars_ = false;
+    uint32_t flags_ = 0;
+    uint32_t prefixLength_ = 0;
+    std::array<uint16_t, MAX_PREFIX_LENGTH> prefix_ {};
+    std::array<bool, CHAR_TABLE_SIZE> charSet_ {};
+};
+}  // namespace ark
+#endif  // PANDA_RUNTIME_REGEXP_PREFILTER_H
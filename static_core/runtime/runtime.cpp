@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -56,6 +56,7 @@
 #include "runtime/include/thread.h"
 #include "runtime/include/thread_scopes.h"
 #include "runtime/include/tooling/debug_inf.h"
+#include "runtime/jit/profiling_saver.h"
 #include "runtime/handle_scope.h"
 #include "runtime/handle_scope-inl.h"
 #include "mem/refstorage/reference_storage.h"
@@ -67,6 +68,7 @@
 #include "runtime/mem/gc/gc-hung/gc_hung.h"
 #include "runtime/include/panda_vm.h"
 #include "runtime/profilesaver/profile_saver.h"
+#include "runtime/startup_snapshot.h"
 #include "runtime/tooling/debugger.h"
 #include "runtime/tooling/memory_allocation_dumper.h"
 #include "runtime/include/file_manager.h"
@@ -303,6 +305,8 @@ inline bool CreateMemorySpaces(const RuntimeOptions &options)
                                options.GetCompilerMemorySizeLimit(), options.GetCodeCacheSizeLimit(),
                                options.GetFramesMemorySizeLimit(), options.GetCoroutinesStackMemLimit(),
                                initialObjectSize);
+    mem::MemConfig::InitializePagesPolicy(options.IsHeapUseHugePages(), options.IsHeapPretouch(),
+                                          options.IsHeapReleasePagesLazily());
     PoolManager::Initialize();
     return true;
 }
@@ -430,6 +434,14 @@ bool Runtime::Destroy()
 
     instance_->GetPandaVM()->SaveProfileInfo();
 
+    if (instance_->GetOptions().WasSetProfileOutput()) {
+        ProfilingSaver::Save(instance_->GetOptions().GetProfileOutput(), instance_->GetClassLinker());
+    }
+
+    if (instance_->GetOptions().IsSnapshotSerializeEnabled()) {
+        StartupSnapshot::Serialize(instance_, instance_->GetOptions().GetSnapshotFile());
+    }
+
     instance_->GetNotificationManager()->VmDeathEvent();
 
     // Stop compiler first to make sure compile memleak doesn't occur
@@ -482,7 +494,8 @@ void Runtime::InitializeVerifierRuntime()
     auto mode = options_.GetVerificationMode();
     if (IsEnabled(mode)) {
         std::string const &cacheFile = options_.GetVerificationCacheFile();
-        verifierService_ = ark::verifier::CreateService(verifierConfig_, internalAllocator_, classLinker_, cacheFile);
+        verifierService_ = ark::verifier::CreateService(verifierConfig_, internalAllocator_, classLinker_, cacheFile,
+                                                        options_.IsVerificationUpdateCache());
     }
 }
 
@@ -720,6 +733,9 @@ bool Runtime::CreatePandaVM(std::string_view runtimeType)
         LOG(ERROR, RUNTIME) << "Failed to load boot panda files";
         return false;
     }
+    if (options_.ShouldLoadBootPandaFiles() && options_.IsBootClassIndexEnabled()) {
+        classLinker_->BuildBootClassIndex(options_.GetBootClassIndexFile());
+    }
 
     auto aotBootCtx = classLinker_->GetClassContextForAot(options_.IsAotVerifyAbsPath());
     if (options_.GetPandaFiles().empty() && !options_.IsStartAsZygote()) {
@@ -912,6 +928,10 @@ bool Runtime::Initialize()
         return false;
     }
 
+    if (options_.IsSnapshotDeserializeEnabled() && options_.ShouldLoadBootPandaFiles()) {
+        StartupSnapshot::Deserialize(this, options_.GetSnapshotFile());
+    }
+
     if (IsDebugMode()) {
         pandaVm_->LoadDebuggerAgent();
     }
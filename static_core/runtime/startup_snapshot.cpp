@@ -0,0 +1,188 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/startup_snapshot.h"
+
+#include "libpandabase/os/file.h"
+#include "libpandabase/os/filesystem.h"
+#include "libpandabase/os/mem.h"
+#include "libpandabase/utils/logger.h"
+#include "libpandabase/utils/word_reader.h"
+#include "runtime/boot_files_header.h"
+#include "runtime/include/class.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/coretypes/string.h"
+#include "runtime/include/managed_thread.h"
+#include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/panda_vm.h"
+#include "runtime/include/runtime.h"
+#include "runtime/include/thread_scopes.h"
+#include "runtime/string_table.h"
+
+namespace ark {
+
+/*
+ * Layout of the snapshot, all the values are 32-bit words and the data is padded to the word size:
+ *   magic, version, boot files (see boot_files_header.h),
+ *   number of strings, {boot file index, source language, string offset, length, compressed, hash code, data}
+ *   for every string.
+ */
+
+namespace {
+
+struct StringEntry {
+    uint32_t fileIndex;
+    panda_file::File::EntityId id;
+    coretypes::String *string;
+};
+
+size_t LoadStrings(WordReader *reader, Runtime *runtime, const PandaVector<const panda_file::File *> &bootFiles)
+{
+    auto *classLinker = runtime->GetClassLinker();
+    auto *vm = runtime->GetPandaVM();
+    auto *stringTable = vm->GetStringTable();
+    uint32_t count = 0;
+    if (!reader->Read(&count)) {
+        return 0;
+    }
+    size_t loaded = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t fileIndex = 0;
+        uint32_t lang = 0;
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        uint32_t compressed = 0;
+        uint32_t hashcode = 0;
+        if (!reader->Read(&fileIndex) || !reader->Read(&lang) || !reader->Read(&offset) || !reader->Read(&length) ||
+            !reader->Read(&compressed) || !reader->Read(&hashcode)) {
+            break;
+        }
+        const uint8_t *data = reader->ReadData(compressed != 0 ? length : length * sizeof(uint16_t));
+        if (data == nullptr) {
+            break;
+        }
+        if (fileIndex >= bootFiles.size() || lang >= panda_file::LANG_COUNT ||
+            !classLinker->HasExtension(static_cast<panda_file::SourceLang>(lang))) {
+            continue;
+        }
+        const auto &pf = *bootFiles[fileIndex];
+        panda_file::File::EntityId id(offset);
+        if (stringTable->GetInternalStringFast(pf, id) != nullptr) {
+            continue;
+        }
+        auto ctx = runtime->GetLanguageContext(static_cast<panda_file::SourceLang>(lang));
+        auto *string = coretypes::String::CreateFromStringData(data, length, compressed != 0, hashcode, ctx, vm, false);
+        if (string == nullptr) {
+            break;
+        }
+        stringTable->AddInternalString(pf, id, string, ctx);
+        ++loaded;
+    }
+    return loaded;
+}
+
+}  // namespace
+
+/* static */
+bool StartupSnapshot::Serialize(Runtime *runtime, const std::string &fileName)
+{
+    auto *thread = ManagedThread::GetCurrent();
+    if (thread == nullptr) {
+        return false;
+    }
+    // The strings must not be moved while their contents are written
+    ScopedManagedCodeThread scope(thread);
+    const auto &bootFiles = runtime->GetClassLinker()->GetBootPandaFiles();
+
+    PandaVector<uint8_t> data;
+    WriteWord(&data, MAGIC);
+    WriteWord(&data, VERSION);
+    WriteBootFiles(&data, bootFiles);
+
+    PandaVector<StringEntry> strings;
+    for (uint32_t i = 0; i < bootFiles.size(); ++i) {
+        runtime->GetPandaVM()->GetStringTable()->VisitInternalStrings(
+            *bootFiles[i], [i, &strings](panda_file::File::EntityId id, coretypes::String *string) {
+                strings.push_back({i, id, string});
+            });
+    }
+    WriteWord(&data, static_cast<uint32_t>(strings.size()));
+    for (const auto &entry : strings) {
+        auto *string = entry.string;
+        bool compressed = string->IsMUtf8();
+        WriteWord(&data, entry.fileIndex);
+        WriteWord(&data, static_cast<uint32_t>(string->ClassAddr<Class>()->GetSourceLang()));
+        WriteWord(&data, entry.id.GetOffset());
+        WriteWord(&data, string->GetLength());
+        WriteWord(&data, compressed ? 1U : 0U);
+        WriteWord(&data, string->GetHashcode());
+        if (compressed) {
+            WritePaddedData(&data, string->GetDataMUtf8(), string->GetLength());
+        } else {
+            WritePaddedData(&data, reinterpret_cast<const uint8_t *>(string->GetDataUtf16()),
+                            string->GetLength() * sizeof(uint16_t));
+        }
+    }
+
+    // The snapshot is written aside and renamed, so the processes which have mapped the old one are not affected
+    bool written = os::WriteFileAtomically(
+        fileName, [&data](const os::file::File &file) { return file.WriteAll(data.data(), data.size()); });
+    if (!written) {
+        LOG(ERROR, RUNTIME) << "Cannot write startup snapshot file '" << fileName << "'";
+        return false;
+    }
+    LOG(INFO, RUNTIME) << "Startup snapshot '" << fileName << "': " << strings.size() << " strings";
+    return true;
+}
+
+/* static */
+bool StartupSnapshot::Deserialize(Runtime *runtime, const std::string &fileName)
+{
+    auto *thread = ManagedThread::GetCurrent();
+    if (thread == nullptr) {
+        return false;
+    }
+    auto file = os::file::Open(fileName, os::file::Mode::READONLY);
+    if (!file.IsValid()) {
+        LOG(DEBUG, RUNTIME) << "No startup snapshot file '" << fileName << "'";
+        return false;
+    }
+    os::file::FileHolder holder(file);
+    auto size = file.GetFileSize();
+    if (!size.HasValue() || size.Value() == 0) {
+        return false;
+    }
+    auto mapping = os::mem::MapFile(file, os::mem::MMAP_PROT_READ, os::mem::MMAP_FLAG_PRIVATE, size.Value());
+    if (mapping.Get() == nullptr) {
+        LOG(ERROR, RUNTIME) << "Cannot map startup snapshot file '" << fileName << "'";
+        return false;
+    }
+
+    WordReader reader(reinterpret_cast<const uint8_t *>(mapping.Get()), size.Value());
+    const auto &bootFiles = runtime->GetClassLinker()->GetBootPandaFiles();
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    if (!reader.Read(&magic) || magic != MAGIC || !reader.Read(&version) || version != VERSION ||
+        !CheckBootFiles(&reader, bootFiles)) {
+        LOG(INFO, RUNTIME) << "Startup snapshot '" << fileName << "' doesn't match the boot panda files";
+        return false;
+    }
+    ScopedManagedCodeThread scope(thread);
+    size_t strings = LoadStrings(&reader, runtime, bootFiles);
+    LOG(INFO, RUNTIME) << "Loaded startup snapshot '" << fileName << "': " << strings << " strings";
+    return true;
+}
+
+}  // namespace ark
@@ -0,0 +1,56 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PANDA_RUNTIME_STARTUP_SNAPSHOT_H
+#define PANDA_RUNTIME_STARTUP_SNAPSHOT_H
+
+#include <string>
+
+#include "libpandabase/macros.h"
+
+namespace ark {
+
+class Runtime;
+
+/**
+ * Startup snapshot of the boot panda files: the strings interned from the boot files by a run of the runtime with
+ * their contents and hash codes. The strings are referenced by the indexes of the boot files and the offsets in
+ * them, so the snapshot is relocatable. It is valid only for the same boot files, which are identified by their
+ * names and checksums.
+ *
+ * On startup the snapshot is memory-mapped and its strings are copied to the non-movable space and added to the
+ * internal string table without the decoding of MUTF-8 and the computing of the hash codes.
+ *
+ * The boot classes are not in the snapshot: their linked state holds native pointers and would be loaded by the
+ * same class linking as on a cold start.
+ */
+class StartupSnapshot {
+public:
+    PANDA_PUBLIC_API static bool Serialize(Runtime *runtime, const std::string &fileName);
+    PANDA_PUBLIC_API static bool Deserialize(Runtime *runtime, const std::string &fileName);
+
+    static constexpr uint32_t MAGIC = 0x50414e53U;  // "SNAP"
+    static constexpr uint32_t VERSION = 2U;
+
+private:
+    NO_COPY_SEMANTIC(StartupSnapshot);
+    NO_MOVE_SEMANTIC(StartupSnapshot);
+    StartupSnapshot() = default;
+    ~StartupSnapshot() = default;
+};
+
+}  // namespace ark
+
+#endif  // PANDA_RUNTIME_STARTUP_SNAPSHOT_H
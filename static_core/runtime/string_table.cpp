@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -83,58 +83,115 @@ size_t StringTable::Size()
 
 void StringTable::Table::VisitStrings(const StringVisitor &visitor)
 {
-    os::memory::ReadLockHolder holder(tableLock_);
-    for (auto entry : table_) {
-        visitor(entry.second);
+    os::memory::LockHolder holder(tableLock_);
+    ForEachString(visitor);
+}
+
+template <class Equal>
+coretypes::String *StringTable::Table::Find(uint32_t hash, const Equal &equal) const
+{
+    // Atomic with acquire order reason: the buckets are published after their content
+    const Buckets *buckets = buckets_.load(std::memory_order_acquire);
+    if (buckets == nullptr) {
+        return nullptr;
+    }
+    size_t mask = buckets->Mask();
+    // The load factor is at most 1/2, so the probing always meets an empty bucket
+    for (size_t i = hash & mask;; i = (i + 1U) & mask) {
+        // Atomic with acquire order reason: the string is published after its hash
+        auto *string = buckets->strings[i].load(std::memory_order_acquire);
+        if (string == nullptr) {
+            return nullptr;
+        }
+        // Atomic with relaxed order reason: ordered by the acquire load of the string
+        if (buckets->hashes[i].load(std::memory_order_relaxed) == hash && equal(string)) {
+            return string;
+        }
     }
 }
 
+/* static */
+void StringTable::Table::Place(Buckets *buckets, coretypes::String *string, uint32_t hash)
+{
+    size_t mask = buckets->Mask();
+    size_t i = hash & mask;
+    // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+    while (buckets->strings[i].load(std::memory_order_relaxed) != nullptr) {
+        i = (i + 1U) & mask;
+    }
+    // Atomic with relaxed order reason: published by the release store of the string
+    buckets->hashes[i].store(hash, std::memory_order_relaxed);
+    // Atomic with release order reason: the hash and the string data must be visible to the readers
+    buckets->strings[i].store(string, std::memory_order_release);
+}
+
+void StringTable::Table::Grow()
+{
+    size_t capacity = currentBuckets_ == nullptr ? INITIAL_CAPACITY : currentBuckets_->strings.size() * 2U;
+    auto buckets = MakePandaUnique<Buckets>(capacity);
+    if (currentBuckets_ != nullptr) {
+        ForEachString([this, &buckets](coretypes::String *string) {
+            // The hash of an interned string is always computed
+            Place(buckets.get(), string, string->GetHashcode());
+        });
+        // The readers may still use the old buckets
+        retiredBuckets_.push_back(std::move(currentBuckets_));
+    }
+    // Atomic with release order reason: the content of the buckets must be visible to the readers
+    buckets_.store(buckets.get(), std::memory_order_release);
+    currentBuckets_ = std::move(buckets);
+}
+
+void StringTable::Table::Insert(coretypes::String *string, uint32_t hash)
+{
+    if (currentBuckets_ == nullptr || (size_ + 1U) * 2U > currentBuckets_->strings.size()) {
+        Grow();
+    }
+    Place(currentBuckets_.get(), string, hash);
+    ++size_;
+}
+
+void StringTable::Table::Clear()
+{
+    if (currentBuckets_ != nullptr) {
+        for (auto &string : currentBuckets_->strings) {
+            // Atomic with relaxed order reason: the table is cleared when there are no readers
+            string.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    size_ = 0;
+}
+
 coretypes::String *StringTable::Table::GetString(const uint8_t *utf8Data, uint32_t utf16Length, bool canBeCompressed,
                                                  [[maybe_unused]] const LanguageContext &ctx)
 {
     uint32_t hashCode = coretypes::String::ComputeHashcodeMutf8(utf8Data, utf16Length, canBeCompressed);
-    os::memory::ReadLockHolder holder(tableLock_);
-    for (auto it = table_.find(hashCode); it != table_.end(); it++) {
-        auto foundString = it->second;
-        if (coretypes::String::StringsAreEqualMUtf8(foundString, utf8Data, utf16Length, canBeCompressed)) {
-            return foundString;
-        }
-    }
-    return nullptr;
+    return Find(hashCode, [utf8Data, utf16Length, canBeCompressed](coretypes::String *foundString) {
+        return coretypes::String::StringsAreEqualMUtf8(foundString, utf8Data, utf16Length, canBeCompressed);
+    });
 }
 
 coretypes::String *StringTable::Table::GetString(const uint16_t *utf16Data, uint32_t utf16Length,
                                                  [[maybe_unused]] const LanguageContext &ctx)
 {
     uint32_t hashCode = coretypes::String::ComputeHashcodeUtf16(const_cast<uint16_t *>(utf16Data), utf16Length);
-    os::memory::ReadLockHolder holder(tableLock_);
-    for (auto it = table_.find(hashCode); it != table_.end(); it++) {
-        auto foundString = it->second;
-        if (coretypes::String::StringsAreEqualUtf16(foundString, utf16Data, utf16Length)) {
-            return foundString;
-        }
-    }
-    return nullptr;
+    return Find(hashCode, [utf16Data, utf16Length](coretypes::String *foundString) {
+        return coretypes::String::StringsAreEqualUtf16(foundString, utf16Data, utf16Length);
+    });
 }
 
 coretypes::String *StringTable::Table::GetString(coretypes::String *string, [[maybe_unused]] const LanguageContext &ctx)
 {
     ASSERT(string != nullptr);
-    os::memory::ReadLockHolder holder(tableLock_);
-    auto hash = string->GetHashcode();
-    for (auto it = table_.find(hash); it != table_.end(); it++) {
-        auto foundString = it->second;
-        if (coretypes::String::StringsAreEqual(foundString, string)) {
-            return foundString;
-        }
-    }
-    return nullptr;
+    return Find(string->GetHashcode(), [string](coretypes::String *foundString) {
+        return coretypes::String::StringsAreEqual(foundString, string);
+    });
 }
 
 void StringTable::Table::ForceInternString(coretypes::String *string, [[maybe_unused]] const LanguageContext &ctx)
 {
-    os::memory::WriteLockHolder holder(tableLock_);
-    table_.insert(std::pair<uint32_t, coretypes::String *>(string->GetHashcode(), string));
+    os::memory::LockHolder holder(tableLock_);
+    Insert(string, string->GetHashcode());
 }
 
 coretypes::String *StringTable::Table::InternString(coretypes::String *string,
@@ -142,15 +199,15 @@ coretypes::String *StringTable::Table::InternString(coretypes::String *string,
 {
     ASSERT(string != nullptr);
     uint32_t hashCode = string->GetHashcode();
-    os::memory::WriteLockHolder holder(tableLock_);
+    os::memory::LockHolder holder(tableLock_);
     // Check string is not present before actually creating and inserting
-    for (auto it = table_.find(hashCode); it != table_.end(); it++) {
-        auto foundString = it->second;
-        if (coretypes::String::StringsAreEqual(foundString, string)) {
-            return foundString;
-        }
+    auto *foundString = Find(hashCode, [string](coretypes::String *candidate) {
+        return coretypes::String::StringsAreEqual(candidate, string);
+    });
+    if (foundString != nullptr) {
+        return foundString;
     }
-    table_.insert(std::pair<uint32_t, coretypes::String *>(hashCode, string));
+    Insert(string, hashCode);
     return string;
 }
 
@@ -218,19 +275,22 @@ coretypes::String *StringTable::Table::GetOrInternString(coretypes::String *stri
 
 bool StringTable::Table::UpdateMoved()
 {
-    os::memory::WriteLockHolder holder(tableLock_);
+    os::memory::LockHolder holder(tableLock_);
     LOG(DEBUG, GC) << "=== StringTable Update moved. BEGIN ===";
-    LOG(DEBUG, GC) << "Iterate over: " << table_.size() << " elements in string table";
+    LOG(DEBUG, GC) << "Iterate over: " << size_ << " elements in string table";
     bool updated = false;
-    for (auto it = table_.begin(), end = table_.end(); it != end;) {
-        auto *object = it->second;
-        if (object->IsForwarded()) {
-            ObjectHeader *fwdString = ark::mem::GetForwardAddress(object);
-            it->second = static_cast<coretypes::String *>(fwdString);
-            LOG(DEBUG, GC) << "StringTable: forward " << std::hex << object << " -> " << fwdString;
-            updated = true;
+    if (currentBuckets_ != nullptr) {
+        for (auto &string : currentBuckets_->strings) {
+            // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+            auto *object = string.load(std::memory_order_relaxed);
+            if (object != nullptr && object->IsForwarded()) {
+                ObjectHeader *fwdString = ark::mem::GetForwardAddress(object);
+                // Atomic with release order reason: the readers may access the moved string
+                string.store(static_cast<coretypes::String *>(fwdString), std::memory_order_release);
+                LOG(DEBUG, GC) << "StringTable: forward " << std::hex << object << " -> " << fwdString;
+                updated = true;
+            }
         }
-        ++it;
     }
     LOG(DEBUG, GC) << "=== StringTable Update moved. END ===";
     return updated;
@@ -239,33 +299,55 @@ bool StringTable::Table::UpdateMoved()
 // NOTE(alovkov): make parallel
 void StringTable::Table::Sweep(const GCObjectVisitor &gcObjectVisitor)
 {
-    os::memory::WriteLockHolder holder(tableLock_);
+    os::memory::LockHolder holder(tableLock_);
     LOG(DEBUG, GC) << "=== StringTable Sweep. BEGIN ===";
-    LOG(DEBUG, GC) << "StringTable iterate over: " << table_.size() << " elements in string table";
-    for (auto it = table_.begin(), end = table_.end(); it != end;) {
-        auto *object = it->second;
+    LOG(DEBUG, GC) << "StringTable iterate over: " << size_ << " elements in string table";
+    // The mutators are suspended, so nobody uses the outgrown buckets and the table may be rehashed in place
+    retiredBuckets_.clear();
+    if (currentBuckets_ == nullptr) {
+        return;
+    }
+    PandaVector<std::pair<coretypes::String *, uint32_t>> alive;
+    bool removed = false;
+    for (size_t i = 0; i < currentBuckets_->strings.size(); ++i) {
+        // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+        auto *object = currentBuckets_->strings[i].load(std::memory_order_relaxed);
+        if (object == nullptr) {
+            continue;
+        }
+        // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+        auto hash = currentBuckets_->hashes[i].load(std::memory_order_relaxed);
         if (object->IsForwarded()) {
             ASSERT(gcObjectVisitor(object) != ObjectStatus::DEAD_OBJECT);
-            ObjectHeader *fwdString = ark::mem::GetForwardAddress(object);
-            it->second = static_cast<coretypes::String *>(fwdString);
-            ++it;
+            auto *fwdString = static_cast<coretypes::String *>(ark::mem::GetForwardAddress(object));
+            // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+            currentBuckets_->strings[i].store(fwdString, std::memory_order_relaxed);
+            alive.emplace_back(fwdString, hash);
             LOG(DEBUG, GC) << "StringTable: forward " << std::hex << object << " -> " << fwdString;
         } else if (gcObjectVisitor(object) == ObjectStatus::DEAD_OBJECT) {
             LOG(DEBUG, GC) << "StringTable: delete string " << std::hex << object
                            << ", val = " << ConvertToString(object);
-            table_.erase(it++);
+            removed = true;
         } else {
-            ++it;
+            alive.emplace_back(object, hash);
+        }
+    }
+    if (removed) {
+        // Linear probing can't leave holes in the probe sequences, so the live strings are placed anew
+        Clear();
+        for (auto [string, hash] : alive) {
+            Place(currentBuckets_.get(), string, hash);
         }
+        size_ = alive.size();
     }
-    LOG(DEBUG, GC) << "StringTable size after sweep = " << table_.size();
+    LOG(DEBUG, GC) << "StringTable size after sweep = " << size_;
     LOG(DEBUG, GC) << "=== StringTable Sweep. END ===";
 }
 
 size_t StringTable::Table::Size()
 {
-    os::memory::ReadLockHolder holder(tableLock_);
-    return table_.size();
+    os::memory::LockHolder holder(tableLock_);
+    return size_;
 }
 
 coretypes::String *StringTable::InternalTable::GetOrInternString(const uint8_t *mutf8Data, uint32_t utf16Length,
@@ -327,31 +409,41 @@ coretypes::String *StringTable::InternalTable::GetOrInternString(const panda_fil
     }
 
     result = InternStringNonMovable(result, ctx);
+    CacheFileString(pf, id, result);
+    return result;
+}
 
-    // Update cache.
-    os::memory::WriteLockHolder lock(mapsLock_);
-    auto it = maps_.find(&pf);
-    if (it != maps_.end()) {
-        (it->second)[id] = result;
-    } else {
-        PandaUnorderedMap<panda_file::File::EntityId, coretypes::String *, EntityIdEqual> map;
-        map[id] = result;
-        maps_[&pf] = std::move(map);
-    }
+coretypes::String *StringTable::InternalTable::AddString(const panda_file::File &pf, panda_file::File::EntityId id,
+                                                         coretypes::String *string, const LanguageContext &ctx)
+{
+    auto *result = InternStringNonMovable(string, ctx);
+    CacheFileString(pf, id, result);
     return result;
 }
 
-coretypes::String *StringTable::InternalTable::GetStringFast(const panda_file::File &pf, panda_file::File::EntityId id)
+void StringTable::InternalTable::CacheFileString(const panda_file::File &pf, panda_file::File::EntityId id,
+                                                 coretypes::String *string)
 {
-    os::memory::ReadLockHolder lock(mapsLock_);
-    auto it = maps_.find(&pf);
-    if (it != maps_.end()) {
-        auto idIt = it->second.find(id);
-        if (idIt != it->second.end()) {
-            return idIt->second;
-        }
+    os::memory::LockHolder lock(mapsLock_);
+    auto *strings = files_.Get(&pf);
+    if (strings == nullptr) {
+        fileStrings_.push_back(MakePandaUnique<FileStrings>());
+        strings = fileStrings_.back().get();
+        files_.Insert(&pf, strings);
+    }
+    if (strings->Get(id.GetOffset()) == nullptr) {
+        strings->Insert(id.GetOffset(), string);
+    }
+}
+
+void StringTable::InternalTable::VisitFileStrings(const panda_file::File &pf, const FileStringVisitor &visitor)
+{
+    auto *strings = files_.Get(&pf);
+    if (strings != nullptr) {
+        strings->ForEach([&visitor](uint32_t offset, coretypes::String *string) {
+            visitor(panda_file::File::EntityId(offset), string);
+        });
     }
-    return nullptr;
 }
 
 void StringTable::InternalTable::VisitRoots(const StringVisitor &visitor, mem::VisitGCRootFlags flags)
@@ -363,20 +455,18 @@ void StringTable::InternalTable::VisitRoots(const StringVisitor &visitor, mem::V
                              mem::VisitGCRootFlags::END_RECORDING_NEW_ROOT)) <= 1);
     // need to set flags before we iterate, because concurrent allocation should be in proper table
     if ((flags & mem::VisitGCRootFlags::START_RECORDING_NEW_ROOT) != 0) {
-        os::memory::WriteLockHolder holder(tableLock_);
+        os::memory::LockHolder holder(tableLock_);
         recordNewString_ = true;
     } else if ((flags & mem::VisitGCRootFlags::END_RECORDING_NEW_ROOT) != 0) {
-        os::memory::WriteLockHolder holder(tableLock_);
+        os::memory::LockHolder holder(tableLock_);
         recordNewString_ = false;
     }
 
     if ((flags & mem::VisitGCRootFlags::ACCESS_ROOT_ALL) != 0) {
-        os::memory::ReadLockHolder lock(tableLock_);
-        for (const auto &v : table_) {
-            visitor(v.second);
-        }
+        os::memory::LockHolder lock(tableLock_);
+        ForEachString(visitor);
     } else if ((flags & mem::VisitGCRootFlags::ACCESS_ROOT_ONLY_NEW) != 0) {
-        os::memory::ReadLockHolder lock(tableLock_);
+        os::memory::LockHolder lock(tableLock_);
         for (const auto str : newStringTable_) {
             visitor(str);
         }
@@ -384,7 +474,7 @@ void StringTable::InternalTable::VisitRoots(const StringVisitor &visitor, mem::V
         LOG(FATAL, RUNTIME) << "Unknown VisitGCRootFlags: " << static_cast<uint32_t>(flags);
     }
     if ((flags & mem::VisitGCRootFlags::END_RECORDING_NEW_ROOT) != 0) {
-        os::memory::WriteLockHolder holder(tableLock_);
+        os::memory::LockHolder holder(tableLock_);
         newStringTable_.clear();
     }
 }
@@ -393,7 +483,7 @@ coretypes::String *StringTable::InternalTable::InternStringNonMovable(coretypes:
                                                                       const LanguageContext &ctx)
 {
     auto *result = InternString(string, ctx);
-    os::memory::WriteLockHolder holder(tableLock_);
+    os::memory::LockHolder holder(tableLock_);
     if (recordNewString_) {
         newStringTable_.push_back(result);
     }
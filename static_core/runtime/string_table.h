@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 #ifndef PANDA_RUNTIME_STRING_TABLE_H_
 #define PANDA_RUNTIME_STRING_TABLE_H_
 
+#include <atomic>
 #include <cstdint>
 
 #include "libpandabase/mem/mem.h"
@@ -22,6 +23,7 @@
 #include "runtime/include/coretypes/string.h"
 #include "runtime/include/language_context.h"
 #include "runtime/include/mem/panda_containers.h"
+#include "runtime/include/mem/panda_smart_pointers.h"
 
 namespace ark {
 
@@ -49,7 +51,21 @@ public:
         return internalTable_.GetStringFast(pf, id);
     }
 
+    /// Interns the string as the resolved string id of the panda file, e.g. when it is loaded from a startup snapshot
+    coretypes::String *AddInternalString(const panda_file::File &pf, panda_file::File::EntityId id,
+                                         coretypes::String *string, const LanguageContext &ctx)
+    {
+        return internalTable_.AddString(pf, id, string, ctx);
+    }
+
     using StringVisitor = std::function<void(ObjectHeader *)>;
+    using FileStringVisitor = std::function<void(panda_file::File::EntityId, coretypes::String *)>;
+
+    /// Visits the resolved string ids of the panda file
+    void VisitInternalStrings(const panda_file::File &pf, const FileStringVisitor &visitor)
+    {
+        internalTable_.VisitFileStrings(pf, visitor);
+    }
 
     void VisitRoots(const StringVisitor &visitor, mem::VisitGCRootFlags flags = mem::VisitGCRootFlags::ACCESS_ROOT_ALL)
     {
@@ -68,9 +84,15 @@ public:
     size_t Size();
 
 protected:
+    /**
+     * Open addressing hash set of the strings with linear probing. Lookups don't take any lock: they read the current
+     * buckets and the string pointers with acquire loads. Inserts, sweeping and updating of the moved strings are
+     * serialized by tableLock_. The buckets are replaced by an insert only when they grow, the outgrown ones are
+     * released by Sweep, which is called by GC while the mutators (the only readers of the table) are suspended.
+     */
     class PANDA_PUBLIC_API Table {
     public:
-        explicit Table(mem::InternalAllocatorPtr allocator) : table_(allocator->Adapter()) {}
+        explicit Table(mem::InternalAllocatorPtr allocator) : retiredBuckets_(allocator->Adapter()) {}
         Table() = default;
         virtual ~Table() = default;
 
@@ -98,23 +120,197 @@ protected:
         void ForceInternString(coretypes::String *string, const LanguageContext &ctx);
 
     protected:
-        // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
-        PandaUnorderedMultiMap<uint32_t, coretypes::String *> table_ GUARDED_BY(tableLock_) {};
-        os::memory::RWLock tableLock_;  // NOLINT(misc-non-private-member-variables-in-classes)
+        struct Buckets {
+            explicit Buckets(size_t capacity) : hashes(capacity), strings(capacity) {}
+
+            size_t Mask() const
+            {
+                return strings.size() - 1U;
+            }
+
+            // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+            // The hash is stored before the string is published, so a reader which sees the string sees its hash
+            PandaVector<std::atomic<uint32_t>> hashes;
+            PandaVector<std::atomic<coretypes::String *>> strings;
+            // NOLINTEND(misc-non-private-member-variables-in-classes)
+        };
+
+        template <class Equal>
+        coretypes::String *Find(uint32_t hash, const Equal &equal) const;
+        void Insert(coretypes::String *string, uint32_t hash) REQUIRES(tableLock_);
+        void Clear() REQUIRES(tableLock_);
+
+        template <class Visitor>
+        void ForEachString(const Visitor &visitor) const REQUIRES(tableLock_)
+        {
+            if (currentBuckets_ == nullptr) {
+                return;
+            }
+            for (auto &str : currentBuckets_->strings) {
+                // Atomic with relaxed order reason: the buckets are changed only under tableLock_
+                auto *string = str.load(std::memory_order_relaxed);
+                if (string != nullptr) {
+                    visitor(string);
+                }
+            }
+        }
+
+        os::memory::Mutex tableLock_;  // NOLINT(misc-non-private-member-variables-in-classes)
 
     private:
         NO_COPY_SEMANTIC(Table);
         NO_MOVE_SEMANTIC(Table);
 
+        static constexpr size_t INITIAL_CAPACITY = 64;
+
+        void Grow() REQUIRES(tableLock_);
+        static void Place(Buckets *buckets, coretypes::String *string, uint32_t hash);
+
+        std::atomic<Buckets *> buckets_ {nullptr};
+        PandaUniquePtr<Buckets> currentBuckets_ GUARDED_BY(tableLock_);
+        PandaVector<PandaUniquePtr<Buckets>> retiredBuckets_ GUARDED_BY(tableLock_);
+        size_t size_ GUARDED_BY(tableLock_) {0};
+
         // Required to clear intern string in test
         friend class mem::test::MultithreadedInternStringTableTest;
     };
 
+    /**
+     * Open addressing map which is only appended under a lock of the owner and is read without locks. A key is
+     * published by the release store of its value, values are never changed after that. The buckets outgrown by
+     * an insert are kept until the map is destroyed, their total size is less than the size of the current ones.
+     */
+    template <class Key, class Value>
+    class AppendOnlyMap {
+    public:
+        AppendOnlyMap() = default;
+        ~AppendOnlyMap() = default;
+
+        Value Get(Key key) const
+        {
+            // Atomic with acquire order reason: the buckets are published after their content
+            const Buckets *buckets = buckets_.load(std::memory_order_acquire);
+            if (buckets == nullptr) {
+                return nullptr;
+            }
+            size_t mask = buckets->values.size() - 1U;
+            for (size_t i = Hash(key) & mask;; i = (i + 1U) & mask) {
+                // Atomic with acquire order reason: the value is published after its key
+                Value value = buckets->values[i].load(std::memory_order_acquire);
+                if (value == nullptr) {
+                    return nullptr;
+                }
+                // Atomic with relaxed order reason: ordered by the acquire load of the value
+                if (buckets->keys[i].load(std::memory_order_relaxed) == key) {
+                    return value;
+                }
+            }
+        }
+
+        /// The key must be absent, the caller serializes the inserts
+        void Insert(Key key, Value value)
+        {
+            ASSERT(value != nullptr);
+            if (current_ == nullptr || (size_ + 1U) * 2U > current_->values.size()) {
+                Grow();
+            }
+            Place(current_.get(), key, value);
+            ++size_;
+        }
+
+        /// Visits the keys and the values inserted before the call
+        template <class Visitor>
+        void ForEach(const Visitor &visitor) const
+        {
+            // Atomic with acquire order reason: the buckets are published after their content
+            const Buckets *buckets = buckets_.load(std::memory_order_acquire);
+            if (buckets == nullptr) {
+                return;
+            }
+            for (size_t i = 0; i < buckets->values.size(); ++i) {
+                // Atomic with acquire order reason: the value is published after its key
+                Value value = buckets->values[i].load(std::memory_order_acquire);
+                if (value != nullptr) {
+                    // Atomic with relaxed order reason: ordered by the acquire load of the value
+                    visitor(buckets->keys[i].load(std::memory_order_relaxed), value);
+                }
+            }
+        }
+
+        NO_COPY_SEMANTIC(AppendOnlyMap);
+        NO_MOVE_SEMANTIC(AppendOnlyMap);
+
+    private:
+        static constexpr size_t INITIAL_CAPACITY = 64;
+
+        struct Buckets {
+            explicit Buckets(size_t capacity) : keys(capacity), values(capacity) {}
+
+            // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
+            PandaVector<std::atomic<Key>> keys;
+            PandaVector<std::atomic<Value>> values;
+            // NOLINTEND(misc-non-private-member-variables-in-classes)
+        };
+
+        static size_t Hash(Key key)
+        {
+            uint64_t bits;
+            if constexpr (std::is_pointer_v<Key>) {
+                bits = reinterpret_cast<uintptr_t>(key);
+            } else {
+                bits = key;
+            }
+            // Fibonacci hashing, the aligned pointers and offsets have zero low bits
+            constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+            constexpr uint64_t SHIFT = 32U;
+            return static_cast<size_t>((bits * MULTIPLIER) >> SHIFT);
+        }
+
+        static void Place(Buckets *buckets, Key key, Value value)
+        {
+            size_t mask = buckets->values.size() - 1U;
+            size_t i = Hash(key) & mask;
+            // Atomic with relaxed order reason: the buckets are changed only by the owner of the lock
+            while (buckets->values[i].load(std::memory_order_relaxed) != nullptr) {
+                i = (i + 1U) & mask;
+            }
+            // Atomic with relaxed order reason: published by the release store of the value
+            buckets->keys[i].store(key, std::memory_order_relaxed);
+            // Atomic with release order reason: the key must be visible to the readers of the value
+            buckets->values[i].store(value, std::memory_order_release);
+        }
+
+        void Grow()
+        {
+            size_t capacity = current_ == nullptr ? INITIAL_CAPACITY : current_->values.size() * 2U;
+            auto buckets = MakePandaUnique<Buckets>(capacity);
+            if (current_ != nullptr) {
+                for (size_t i = 0; i < current_->values.size(); ++i) {
+                    // Atomic with relaxed order reason: the buckets are changed only by the owner of the lock
+                    Value value = current_->values[i].load(std::memory_order_relaxed);
+                    if (value != nullptr) {
+                        // Atomic with relaxed order reason: the buckets are changed only by the owner of the lock
+                        Place(buckets.get(), current_->keys[i].load(std::memory_order_relaxed), value);
+                    }
+                }
+                retired_.push_back(std::move(current_));
+            }
+            // Atomic with release order reason: the content of the buckets must be visible to the readers
+            buckets_.store(buckets.get(), std::memory_order_release);
+            current_ = std::move(buckets);
+        }
+
+        std::atomic<Buckets *> buckets_ {nullptr};
+        PandaUniquePtr<Buckets> current_;
+        PandaVector<PandaUniquePtr<Buckets>> retired_;
+        size_t size_ {0};
+    };
+
     class PANDA_PUBLIC_API InternalTable : public Table {
     public:
         InternalTable() = default;
         explicit InternalTable(mem::InternalAllocatorPtr allocator)
-            : Table(allocator), newStringTable_(allocator->Adapter())
+            : Table(allocator), newStringTable_(allocator->Adapter()), fileStrings_(allocator->Adapter())
         {
         }
         ~InternalTable() override = default;
@@ -132,7 +328,16 @@ protected:
         coretypes::String *GetOrInternString(const panda_file::File &pf, panda_file::File::EntityId id,
                                              const LanguageContext &ctx);
 
-        coretypes::String *GetStringFast(const panda_file::File &pf, panda_file::File::EntityId id);
+        coretypes::String *GetStringFast(const panda_file::File &pf, panda_file::File::EntityId id)
+        {
+            auto *strings = files_.Get(&pf);
+            return strings != nullptr ? strings->Get(id.GetOffset()) : nullptr;
+        }
+
+        coretypes::String *AddString(const panda_file::File &pf, panda_file::File::EntityId id,
+                                     coretypes::String *string, const LanguageContext &ctx);
+
+        void VisitFileStrings(const panda_file::File &pf, const FileStringVisitor &visitor);
 
         void VisitRoots(const StringVisitor &visitor,
                         mem::VisitGCRootFlags flags = mem::VisitGCRootFlags::ACCESS_ROOT_ALL);
@@ -141,20 +346,17 @@ protected:
         coretypes::String *InternStringNonMovable(coretypes::String *string, const LanguageContext &ctx);
 
     private:
-        bool recordNewString_ {false};
+        void CacheFileString(const panda_file::File &pf, panda_file::File::EntityId id, coretypes::String *string);
+
+        // Resolved strings of a panda file by the offsets of their entity ids
+        using FileStrings = AppendOnlyMap<uint32_t, coretypes::String *>;
+
+        bool recordNewString_ GUARDED_BY(tableLock_) {false};
         PandaVector<coretypes::String *> newStringTable_ GUARDED_BY(tableLock_) {};
-        class EntityIdEqual {
-        public:
-            uint32_t operator()(const panda_file::File::EntityId &id) const
-            {
-                return id.GetOffset();
-            }
-        };
-        PandaUnorderedMap<const panda_file::File *,
-                          PandaUnorderedMap<panda_file::File::EntityId, coretypes::String *, EntityIdEqual>>
-            maps_ GUARDED_BY(mapsLock_);
+        AppendOnlyMap<const panda_file::File *, FileStrings *> files_;
+        PandaVector<PandaUniquePtr<FileStrings>> fileStrings_ GUARDED_BY(mapsLock_);
 
-        os::memory::RWLock mapsLock_;
+        os::memory::Mutex mapsLock_;
 
         NO_COPY_SEMANTIC(InternalTable);
         NO_MOVE_SEMANTIC(InternalTable);
@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+
+#include <gtest/gtest.h>
+
+#include "intrinsics.h"
+#include "runtime/include/class-inl.h"
+#include "runtime/include/coretypes/array.h"
+#include "runtime/include/runtime.h"
+
+namespace ark::intrinsics::test {
+
+// The ranges start and end at any element, so the vectorized loops run their scalar prologues and epilogues
+class ArrayIntrinsicsTest : public testing::Test {
+public:
+    ArrayIntrinsicsTest()
+    {
+        options_.SetShouldLoadBootPandaFiles(false);
+        options_.SetShouldInitializeIntrinsics(false);
+        // The arrays must not move while the intrinsics use them
+        options_.SetGcType("epsilon");
+        Runtime::Create(options_);
+        thread_ = ark::MTManagedThread::GetCurrent();
+        thread_->ManagedCodeBegin();
+    }
+
+    ~ArrayIntrinsicsTest() override
+    {
+        thread_->ManagedCodeEnd();
+        Runtime::Destroy();
+    }
+
+    NO_COPY_SEMANTIC(ArrayIntrinsicsTest);
+    NO_MOVE_SEMANTIC(ArrayIntrinsicsTest);
+
+protected:
+    static constexpr uint32_t LENGTH = 67;
+    static constexpr uint32_t MAX_SHIFT = 9;
+
+    template <typename T>
+    static coretypes::Array *CreateArray(ClassRoot classRoot)
+    {
+        LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+        auto *klass = Runtime::GetCurrent()->GetClassLinker()->GetExtension(ctx)->GetClassRoot(classRoot);
+        auto *array = coretypes::Array::Create(klass, LENGTH);
+        for (uint32_t i = 0; i < LENGTH; ++i) {
+            // Large values make the integer operations wrap
+            // NOLINTNEXTLINE(readability-magic-numbers)
+            array->Set<T>(i, static_cast<T>((i + 1U) * static_cast<T>(0x9e3779b97f4a7c15ULL)));
+        }
+        return array;
+    }
+
+    template <typename T, typename Intrinsic, typename BinaryOp>
+    static void CheckReduce(ClassRoot classRoot, Intrinsic intrinsic, BinaryOp op)
+    {
+        coretypes::Array *array = CreateArray<T>(classRoot);
+        for (uint32_t begin = 0; begin < MAX_SHIFT; ++begin) {
+            for (uint32_t end = LENGTH - MAX_SHIFT; end <= LENGTH; ++end) {
+                T expected = 1;
+                for (uint32_t i = begin; i < end; ++i) {
+                    expected = op(expected, array->Get<T>(i));
+                }
+                ASSERT_EQ(intrinsic(array, 1, begin, end), expected) << "[" << begin << ", " << end << ")";
+            }
+        }
+    }
+
+    template <typename T, typename Intrinsic, typename BinaryOp>
+    static void CheckMap(ClassRoot classRoot, Intrinsic intrinsic, BinaryOp op)
+    {
+        constexpr T SCALAR = 3;
+        coretypes::Array *src = CreateArray<T>(classRoot);
+        for (uint32_t begin = 0; begin < MAX_SHIFT; ++begin) {
+            for (uint32_t end = LENGTH - MAX_SHIFT; end <= LENGTH; ++end) {
+                coretypes::Array *dst = CreateArray<T>(classRoot);
+                intrinsic(dst, src, SCALAR, begin, end);
+                for (uint32_t i = 0; i < LENGTH; ++i) {
+                    // The elements out of the range stay as they were
+                    T expected = (i >= begin && i < end) ? op(src->Get<T>(i), SCALAR) : src->Get<T>(i);
+                    ASSERT_EQ(dst->Get<T>(i), expected) << i << " in [" << begin << ", " << end << ")";
+                }
+            }
+        }
+    }
+
+private:
+    ark::MTManagedThread *thread_;
+    RuntimeOptions options_;
+};
+
+TEST_F(ArrayIntrinsicsTest, Reduce)
+{
+    CheckReduce<uint32_t>(ClassRoot::ARRAY_I32, ArraySum32, std::plus<uint32_t>());
+    CheckReduce<uint64_t>(ClassRoot::ARRAY_I64, ArraySum64, std::plus<uint64_t>());
+    CheckReduce<uint32_t>(ClassRoot::ARRAY_I32, ArrayXor32, std::bit_xor<uint32_t>());
+    CheckReduce<uint64_t>(ClassRoot::ARRAY_I64, ArrayXor64, std::bit_xor<uint64_t>());
+}
+
+TEST_F(ArrayIntrinsicsTest, Map)
+{
+    CheckMap<uint32_t>(ClassRoot::ARRAY_I32, ArrayAddScalar32, std::plus<uint32_t>());
+    CheckMap<uint32_t>(ClassRoot::ARRAY_I32, ArrayMulScalar32, std::multiplies<uint32_t>());
+    CheckMap<double>(ClassRoot::ARRAY_F64, ArrayAddScalarf64, std::plus<double>());
+    CheckMap<double>(ClassRoot::ARRAY_F64, ArrayMulScalarf64, std::multiplies<double>());
+}
+
+}  // namespace ark::intrinsics::test
@@ -21,6 +21,7 @@
 #include "assembly-parser.h"
 #include "runtime/compiler_queue_aged_counter_priority.h"
 #include "runtime/compiler_queue_counter_priority.h"
+#include "runtime/compiler_queue_heap_counter_priority.h"
 #include "runtime/include/class-inl.h"
 #include "runtime/include/method.h"
 #include "runtime/include/runtime.h"
@@ -539,6 +540,174 @@ TEST_F(CompilerQueueTest, AgedDeathCounter)
     ASSERT_EQ(method, nullptr);
 }
 
+// Testing of HeapCounterQueue
+
+TEST_F(CompilerQueueTest, HeapAddGet)
+{
+    Class *klass = TestClassPrepare();
+
+    Method *mainMethod = klass->GetDirectMethod(utf::CStringAsMutf8("main"));
+    ASSERT_NE(mainMethod, nullptr);
+
+    Method *fMethod = klass->GetDirectMethod(utf::CStringAsMutf8("f"));
+    ASSERT_NE(fMethod, nullptr);
+
+    Method *gMethod = klass->GetDirectMethod(utf::CStringAsMutf8("g"));
+    ASSERT_NE(gMethod, nullptr);
+
+    // Manual range
+    mainMethod->SetHotnessCounter(3U);
+    fMethod->SetHotnessCounter(2U);
+    gMethod->SetHotnessCounter(1U);
+
+    RuntimeOptions options;
+    CompilerHeapCounterQueue queue(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                   options.GetCompilerQueueMaxLength(), options.GetCompilerTaskLifeSpan());
+    queue.AddTask(CompilerTask {mainMethod, false});
+    queue.AddTask(CompilerTask {fMethod, false});
+    queue.AddTask(CompilerTask {gMethod, false});
+
+    GetAndCheckMethodsIfExists(&queue, gMethod, fMethod, mainMethod);
+}
+
+TEST_F(CompilerQueueTest, HeapEqualCounters)
+{
+    Class *klass = TestClassPrepare();
+
+    Method *mainMethod = klass->GetDirectMethod(utf::CStringAsMutf8("main"));
+    ASSERT_NE(mainMethod, nullptr);
+
+    Method *fMethod = klass->GetDirectMethod(utf::CStringAsMutf8("f"));
+    ASSERT_NE(fMethod, nullptr);
+
+    Method *gMethod = klass->GetDirectMethod(utf::CStringAsMutf8("g"));
+    ASSERT_NE(gMethod, nullptr);
+
+    mainMethod->SetHotnessCounter(3U);
+    fMethod->SetHotnessCounter(3U);
+    gMethod->SetHotnessCounter(3U);
+
+    RuntimeOptions options;
+    CompilerHeapCounterQueue queue(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                   options.GetCompilerQueueMaxLength(), options.GetCompilerTaskLifeSpan());
+
+    // Tasks with equal counters are extracted in the insertion order
+    queue.AddTask(CompilerTask {gMethod, false});
+    queue.AddTask(CompilerTask {mainMethod, false});
+    queue.AddTask(CompilerTask {fMethod, false});
+
+    GetAndCheckMethodsIfExists(&queue, gMethod, mainMethod, fMethod);
+}
+
+TEST_F(CompilerQueueTest, HeapExpire)
+{
+    auto klass = TestClassPrepare();
+
+    Method *mainMethod = klass->GetDirectMethod(utf::CStringAsMutf8("main"));
+    ASSERT_NE(mainMethod, nullptr);
+
+    Method *fMethod = klass->GetDirectMethod(utf::CStringAsMutf8("f"));
+    ASSERT_NE(fMethod, nullptr);
+
+    Method *gMethod = klass->GetDirectMethod(utf::CStringAsMutf8("g"));
+    ASSERT_NE(gMethod, nullptr);
+
+    RuntimeOptions options;
+    constexpr int COMPILER_TASK_LIFE_SPAN1 = 500;
+    CompilerHeapCounterQueue queue(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                   options.GetCompilerQueueMaxLength(), COMPILER_TASK_LIFE_SPAN1);
+    queue.AddTask(CompilerTask {mainMethod, false});
+    queue.AddTask(CompilerTask {fMethod, false});
+    queue.AddTask(CompilerTask {gMethod, false});
+
+    WaitForExpire(1000U);
+
+    // All tasks should expire after sleep
+    auto method = queue.GetTask().GetMethod();
+    ASSERT_EQ(method, nullptr);
+
+    constexpr int COMPILER_TASK_LIFE_SPAN2 = 0;
+    CompilerHeapCounterQueue queue2(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                    options.GetCompilerQueueMaxLength(), COMPILER_TASK_LIFE_SPAN2);
+    queue2.AddTask(CompilerTask {mainMethod, false});
+    queue2.AddTask(CompilerTask {fMethod, false});
+    queue2.AddTask(CompilerTask {gMethod, false});
+
+    // All tasks should expire without sleep
+    method = queue2.GetTask().GetMethod();
+    ASSERT_EQ(method, nullptr);
+}
+
+TEST_F(CompilerQueueTest, HeapReorder)
+{
+    auto klass = TestClassPrepare();
+
+    Method *mainMethod = klass->GetDirectMethod(utf::CStringAsMutf8("main"));
+    ASSERT_NE(mainMethod, nullptr);
+
+    Method *fMethod = klass->GetDirectMethod(utf::CStringAsMutf8("f"));
+    ASSERT_NE(fMethod, nullptr);
+
+    Method *gMethod = klass->GetDirectMethod(utf::CStringAsMutf8("g"));
+    ASSERT_NE(gMethod, nullptr);
+
+    mainMethod->SetHotnessCounter(3U);
+    fMethod->SetHotnessCounter(2U);
+    gMethod->SetHotnessCounter(1U);
+
+    RuntimeOptions options;
+    CompilerHeapCounterQueue queue(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                   options.GetCompilerQueueMaxLength(), options.GetCompilerTaskLifeSpan());
+
+    queue.AddTask(CompilerTask {gMethod, false});
+    queue.AddTask(CompilerTask {fMethod, false});
+    queue.AddTask(CompilerTask {mainMethod, false});
+
+    // Change the order, the queue is small enough to refresh all the counters at once
+    mainMethod->SetHotnessCounter(-6U);
+    fMethod->SetHotnessCounter(-5U);
+    gMethod->SetHotnessCounter(-4U);
+
+    GetAndCheckMethodsIfExists(&queue, mainMethod, fMethod, gMethod);
+}
+
+TEST_F(CompilerQueueTest, HeapMaxLimit)
+{
+    auto klass = TestClassPrepare();
+
+    Method *mainMethod = klass->GetDirectMethod(utf::CStringAsMutf8("main"));
+    ASSERT_NE(mainMethod, nullptr);
+
+    Method *fMethod = klass->GetDirectMethod(utf::CStringAsMutf8("f"));
+    ASSERT_NE(fMethod, nullptr);
+
+    Method *gMethod = klass->GetDirectMethod(utf::CStringAsMutf8("g"));
+    ASSERT_NE(gMethod, nullptr);
+
+    mainMethod->SetHotnessCounter(1U);
+    fMethod->SetHotnessCounter(2U);
+    gMethod->SetHotnessCounter(3U);
+
+    RuntimeOptions options;
+    constexpr int COMPILER_QUEUE_MAX_LENGTH = 100;
+    CompilerHeapCounterQueue queue(thread_->GetVM()->GetHeapManager()->GetInternalAllocator(),
+                                   COMPILER_QUEUE_MAX_LENGTH, options.GetCompilerTaskLifeSpan());
+
+    for (size_t i = 0; i < 40U; i++) {
+        queue.AddTask(CompilerTask {mainMethod, false});
+        queue.AddTask(CompilerTask {fMethod, false});
+        queue.AddTask(CompilerTask {gMethod, false});
+    }
+
+    // 100 as Max_Limit
+    for (size_t i = 0; i < 100U; i++) {
+        queue.GetTask();
+    }
+
+    auto method = queue.GetTask().GetMethod();
+    ASSERT_EQ(method, nullptr);
+}
+
 // NOLINTEND(readability-magic-numbers)
 
 }  // namespace ark::test
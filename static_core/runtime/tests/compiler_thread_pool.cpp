@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
 #include <vector>
 
 #include "assembly-parser.h"
@@ -28,9 +29,10 @@ namespace ark::test {
 class CompilerThreadPoolTest : public testing::Test {
 public:
     static const size_t METHOD_COUNT = 32;
-    CompilerThreadPoolTest()
+    CompilerThreadPoolTest() : CompilerThreadPoolTest(RuntimeOptions()) {}
+
+    explicit CompilerThreadPoolTest(RuntimeOptions options)
     {
-        RuntimeOptions options;
         options.SetShouldLoadBootPandaFiles(false);
         options.SetShouldInitializeIntrinsics(false);
         Runtime::Create(options);
@@ -58,6 +60,21 @@ private:
     ark::MTManagedThread *thread_;
 };
 
+// A single compiler thread with a single queue slot, so hot methods coming in a row overflow the queue
+class CompilerQueueOverflowTest : public CompilerThreadPoolTest {
+public:
+    CompilerQueueOverflowTest() : CompilerThreadPoolTest(GetOptions()) {}
+
+private:
+    static RuntimeOptions GetOptions()
+    {
+        RuntimeOptions options;
+        options.SetCompilerThreadsCount(1);
+        options.SetCompilerQueueMaxLength(1);
+        return options;
+    }
+};
+
 Method *GetMethod(Class *klass, size_t num)
 {
     PandaStringStream ss;
@@ -66,14 +83,19 @@ Method *GetMethod(Class *klass, size_t num)
     return method;
 }
 
-Class *GetClass()
+Class *GetClass(const std::string &record = "_GLOBAL")
 {
     pandasm::Parser p;
 
     PandaStringStream ss;
 
+    std::string prefix;
+    if (record != "_GLOBAL") {
+        ss << ".record " << record << " {}" << std::endl;
+        prefix = record + ".";
+    }
     for (size_t i = 0; i < CompilerThreadPoolTest::METHOD_COUNT; i++) {
-        ss << ".function void f" << i << "() {" << std::endl;
+        ss << ".function void " << prefix << "f" << i << "() {" << std::endl;
         ss << "    return.void" << std::endl;
         ss << "}" << std::endl;
     }
@@ -89,26 +111,11 @@ Class *GetClass()
     PandaString descriptor;
 
     return classLinker->GetExtension(panda_file::SourceLang::PANDA_ASSEMBLY)
-        ->GetClass(ClassHelper::GetDescriptor(utf::CStringAsMutf8("_GLOBAL"), &descriptor));
+        ->GetClass(ClassHelper::GetDescriptor(utf::CStringAsMutf8(record.c_str()), &descriptor));
 }
 
-void CompileMethods(int initialNumberOfThreads, size_t scaledNumberOfThreads)
+void WaitCompiled(Compiler *compiler, Class *klass)
 {
-    auto *klass = GetClass();
-    ASSERT_NE(klass, nullptr);
-
-    auto *compiler = static_cast<Compiler *>(PandaVM::GetCurrent()->GetCompiler());
-
-    compiler->ScaleThreadPool(initialNumberOfThreads);
-
-    for (size_t i = 0; i < CompilerThreadPoolTest::METHOD_COUNT; i++) {
-        Method *method = GetMethod(klass, i);
-        ASSERT_NE(method, nullptr);
-        compiler->CompileMethod(method, i, false, TaggedValue::Hole());
-    }
-
-    compiler->ScaleThreadPool(scaledNumberOfThreads);
-
     for (;;) {
         bool isCompleted = true;
         for (size_t i = 0; i < CompilerThreadPoolTest::METHOD_COUNT; i++) {
@@ -127,6 +134,26 @@ void CompileMethods(int initialNumberOfThreads, size_t scaledNumberOfThreads)
     }
 }
 
+void CompileMethods(int initialNumberOfThreads, size_t scaledNumberOfThreads)
+{
+    auto *klass = GetClass();
+    ASSERT_NE(klass, nullptr);
+
+    auto *compiler = static_cast<Compiler *>(PandaVM::GetCurrent()->GetCompiler());
+
+    compiler->ScaleThreadPool(initialNumberOfThreads);
+
+    for (size_t i = 0; i < CompilerThreadPoolTest::METHOD_COUNT; i++) {
+        Method *method = GetMethod(klass, i);
+        ASSERT_NE(method, nullptr);
+        compiler->CompileMethod(method, i, false, TaggedValue::Hole());
+    }
+
+    compiler->ScaleThreadPool(scaledNumberOfThreads);
+
+    WaitCompiled(compiler, klass);
+}
+
 TEST_F(CompilerThreadPoolTest, SeveralThreads)
 {
     constexpr size_t NUMBER_OF_THREADS = 8;
@@ -147,4 +174,29 @@ TEST_F(CompilerThreadPoolTest, IncreaseThreads)
     CompileMethods(NUMBER_OF_THREADS, NUMBER_OF_THREADS_SCALED);
 }
 
+TEST_F(CompilerQueueOverflowTest, RejectedMethodBecomesHotAgain)
+{
+    auto *compiler = static_cast<Compiler *>(PandaVM::GetCurrent()->GetCompiler());
+    // The worker may drain the queue faster than the methods come, so try several times
+    constexpr size_t MAX_ROUNDS = 8;
+    size_t rejected = 0;
+    for (size_t round = 0; round < MAX_ROUNDS && rejected == 0; round++) {
+        auto *klass = GetClass("Overflow" + std::to_string(round));
+        ASSERT_NE(klass, nullptr);
+        for (size_t i = 0; i < CompilerThreadPoolTest::METHOD_COUNT; i++) {
+            Method *method = GetMethod(klass, i);
+            method->SetHotnessCounter(0);
+            compiler->CompileMethod(method, i, false, TaggedValue::Hole());
+            // Only the rejection leaves a method in NOT_COMPILED, the accepted ones are WAITING or further
+            if (method->GetCompilationStatus() == Method::NOT_COMPILED) {
+                EXPECT_EQ(method->GetHotnessCounter(), Method::GetInitialHotnessCounter());
+                rejected++;
+            }
+        }
+        // The rejected methods get compiled when they become hot again
+        WaitCompiled(compiler, klass);
+    }
+    EXPECT_NE(rejected, 0U);
+}
+
 }  // namespace ark::test
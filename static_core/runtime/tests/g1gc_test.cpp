@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <array>
+#include <unordered_set>
 
 #include "runtime/include/object_header.h"
 #include "runtime/mem/tlab.h"
@@ -776,6 +777,76 @@ TEST_F(G1GCTest, TestHandlePendingCards)
     }
 }
 
+class G1GCParallelRefinementTest : public G1GCTest {
+public:
+    G1GCParallelRefinementTest() : G1GCTest(CreateOptions()) {}
+
+    static RuntimeOptions CreateOptions()
+    {
+        RuntimeOptions options = CreateDefaultOptions();
+        options.SetGcWorkersCount(GC_WORKERS_COUNT);
+        options.SetGcParallelRefUpdatingEnabled(true);
+        // All the dirty cards are processed in the pause
+        options.SetG1EnableConcurrentUpdateRemset(false);
+        options.SetG1MinParallelCardsToProcess(1U);
+        return options;
+    }
+
+    void ProcessManyDirtyCards(size_t arraysNum);
+
+private:
+    static constexpr size_t GC_WORKERS_COUNT = 3;
+};
+
+// Barrier-heavy workload: every card of the tenured arrays refers to a young string
+void G1GCParallelRefinementTest::ProcessManyDirtyCards(size_t arraysNum)
+{
+    auto thread = MTManagedThread::GetCurrent();
+    auto runtime = Runtime::GetCurrent();
+    auto ctx = runtime->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+    auto arrayClass = runtime->GetClassLinker()->GetExtension(ctx)->GetClassRoot(ClassRoot::ARRAY_STRING);
+    auto gc = static_cast<G1GC<PandaAssemblyLanguageConfig> *>(runtime->GetPandaVM()->GetGC());
+    size_t elemSize = arrayClass->GetComponentSize();
+    // NOLINTNEXTLINE(clang-analyzer-core.DivideZero)
+    size_t arrayLength = DEFAULT_REGION_SIZE / 2 / elemSize;
+    size_t elementsPerCard = CardTable::GetCardSize() / elemSize;
+    ScopedManagedCodeThread s(thread);
+    HandleScope<ObjectHeader *> scope(thread);
+
+    std::vector<VMHandle<coretypes::Array>> arrays;
+    for (size_t i = 0; i < arraysNum; i++) {
+        arrays.emplace_back(thread, ObjectAllocator::AllocArray(arrayLength, ClassRoot::ARRAY_STRING, false));
+    }
+    {
+        ScopedNativeCodeThread sn(thread);
+        GCTask task(GCTaskCause::YOUNG_GC_CAUSE);
+        task.Run(*gc);
+    }
+
+    VMHandle<coretypes::String> str(thread, ObjectAllocator::AllocString(1));
+    for (auto &array : arrays) {
+        ASSERT_TRUE(ObjectToRegion(array.GetPtr())->HasFlag(IS_OLD));
+        for (size_t i = 0; i < arrayLength; i += elementsPerCard) {
+            array->Set(i, str.GetPtr());
+        }
+    }
+
+    ProcessDirtyCards(gc);
+
+    std::unordered_set<ObjectHeader *> objects;
+    ObjectToRegion(str.GetPtr())->GetRemSet()->IterateOverObjects([&objects](ObjectHeader *obj) {
+        objects.insert(obj);
+    });
+    for (auto &array : arrays) {
+        ASSERT_NE(objects.count(array.GetPtr()), 0U);
+    }
+}
+
+TEST_F(G1GCParallelRefinementTest, ProcessManyDirtyCards)
+{
+    ProcessManyDirtyCards(4U);
+}
+
 class G1GCPromotionTest : public G1GCTest {
 public:
     G1GCPromotionTest() : G1GCTest(CreateOptions()) {}
@@ -25,6 +25,7 @@
 #include "libpandafile/file_items.h"
 #include "libpandafile/value.h"
 #include "runtime/bridge/bridge.h"
+#include "runtime/hotreload/hotreload.h"
 #include "runtime/include/class_linker.h"
 #include "runtime/include/compiler_interface.h"
 #include "runtime/include/mem/allocator.h"
@@ -56,7 +57,9 @@ using DynObject = ark::coretypes::DynObject;
 
 class InterpreterTest : public testing::Test {
 public:
-    InterpreterTest()
+    InterpreterTest() : InterpreterTest(true) {}
+
+    explicit InterpreterTest(bool enableJit)
     {
         RuntimeOptions options;
         options.SetShouldLoadBootPandaFiles(false);
@@ -64,6 +67,7 @@ public:
         options.SetRunGcInPlace(true);
         options.SetVerifyCallStack(false);
         options.SetGcType("epsilon");
+        options.SetCompilerEnableJit(enableJit);
         Runtime::Create(options);
         thread_ = ark::MTManagedThread::GetCurrent();
         thread_->ManagedCodeBegin();
@@ -2545,6 +2549,133 @@ TEST_F(InterpreterTest, TestVirtualCalls)
     }
 }
 
+/// Hot reload of no classes, which only clears the caches of the threads
+class TestHotreload final : public hotreload::ArkHotreloadBase {
+public:
+    explicit TestHotreload(ManagedThread *thread) : ArkHotreloadBase(thread, panda_file::SourceLang::PANDA_ASSEMBLY)
+    {
+    }
+    ~TestHotreload() override = default;
+
+    NO_COPY_SEMANTIC(TestHotreload);
+    NO_MOVE_SEMANTIC(TestHotreload);
+
+protected:
+    hotreload::Error LangSpecificValidateClasses() override
+    {
+        return hotreload::Error::NONE;
+    }
+
+    void LangSpecificHotreloadPart() override {}
+};
+
+// Hot reload is not supported with JIT
+class InterpreterNoJitTest : public InterpreterTest {
+public:
+    InterpreterNoJitTest() : InterpreterTest(false) {}
+    ~InterpreterNoJitTest() override = default;
+
+    NO_COPY_SEMANTIC(InterpreterNoJitTest);
+    NO_MOVE_SEMANTIC(InterpreterNoJitTest);
+};
+
+extern "C" Method *ResolveVirtualMethod(const Method *callee, Frame *frame, ObjectPointerType objPtr,
+                                        const uint8_t *pc, Method *caller);
+
+TEST_F(InterpreterNoJitTest, VirtualCallCache)
+{
+    auto emitter = BytecodeEmitter {};
+    emitter.CallVirtShort(0, 1, RuntimeInterface::METHOD_ID.AsIndex());
+    emitter.Return();
+    std::vector<uint8_t> bytecode;
+    ASSERT_EQ(emitter.Build(&bytecode), BytecodeEmitter::ErrorCode::SUCCESS);
+
+    auto f = CreateFrame(16U, nullptr, nullptr);
+    auto cls = CreateClass(panda_file::SourceLang::PANDA_ASSEMBLY);
+    auto methodData = CreateMethod(cls, f.get(), bytecode);
+    auto *caller = methodData.first.get();
+
+    auto source = R"(
+        .record A {}
+        .record B <extends=A> {}
+        .record C <extends=A> {}
+
+        .function i32 A.foo(A a0, i32 a1) {
+            lda a1
+            addi 1
+            return
+        }
+
+        .function i32 B.foo(B a0, i32 a1) {
+            lda a1
+            addi 2
+            return
+        }
+
+        .function i32 C.foo(C a0, i32 a1) {
+            lda a1
+            addi 3
+            return
+        }
+    )";
+
+    bool failed = false;
+    auto classLinker = AddProgramToClassLinker(source, failed);
+    ASSERT_FALSE(failed);
+
+    auto *ext = classLinker->GetExtension(panda_file::SourceLang::PANDA_ASSEMBLY);
+    auto *classA = ext->GetClass(GetClassDescriptor("A"));
+    auto *classB = ext->GetClass(GetClassDescriptor("B"));
+    auto *classC = ext->GetClass(GetClassDescriptor("C"));
+    auto *callee = classA->GetMethods().data();
+    auto *targetB = classB->GetMethods().data();
+    auto *targetC = classC->GetMethods().data();
+
+    auto *thread = ManagedThread::GetCurrent();
+    const uint8_t *pc = bytecode.data();
+    // The same call site is executed with the receivers of different classes
+    auto call = [&](Class *receiverClass) {
+        InitializeFrame(f.get());
+        f->SetMethod(caller);
+        auto frameHandler = StaticFrameHandler(f.get());
+        frameHandler.GetVReg(0).SetReference(AllocObject(receiverClass));
+        frameHandler.GetVReg(1).Set(1);
+        RuntimeInterface::SetupResolvedMethod(callee);
+        Execute(thread, pc, f.get());
+        RuntimeInterface::SetupResolvedMethod(nullptr);
+        return f->GetAccAsVReg().Get();
+    };
+
+    auto *cache = thread->GetVirtualCallCache();
+    ASSERT_EQ(call(classB), 3L);
+    ASSERT_EQ(cache->Get(pc, caller, classB), targetB);
+    ASSERT_EQ(call(classC), 4L);
+    ASSERT_EQ(cache->Get(pc, caller, classC), targetC);
+
+    // The call takes the target from the cache, so a planted entry is called instead of the override
+    cache->Set(pc, caller, classB, callee);
+    ASSERT_EQ(call(classB), 2L);
+    auto *obj = AllocObject(classB);
+    ASSERT_EQ(ResolveVirtualMethod(callee, f.get(), ToObjPtr(obj), pc, caller), callee);
+
+    // Hot reload may change the methods, so it drops the cached targets
+    thread->ManagedCodeEnd();
+    {
+        TestHotreload hotreload(thread);
+        thread->ManagedCodeBegin();
+        EXPECT_EQ(hotreload.ProcessHotreload(), hotreload::Error::NONE);
+        thread->ManagedCodeEnd();
+    }
+    thread->ManagedCodeBegin();
+    ASSERT_EQ(cache->Get(pc, caller, classB), nullptr);
+    ASSERT_EQ(cache->Get(pc, caller, classC), nullptr);
+
+    // The entrypoint of the irtoc and LLVM interpreters fills the cache the same way
+    ASSERT_EQ(ResolveVirtualMethod(callee, f.get(), ToObjPtr(obj), pc, caller), targetB);
+    ASSERT_EQ(cache->Get(pc, caller, classB), targetB);
+    ASSERT_EQ(call(classB), 3L);
+}
+
 TEST_F(InterpreterTest, TestVirtualCallsExceptions)
 {
     auto testNullReferenceException = [](BytecodeEmitter &emitter) {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "runtime/include/runtime.h"
 #include "runtime/handle_base-inl.h"
+#include "runtime/monitor_pool.h"
 
 namespace ark::concurrency::test {
 
@@ -275,4 +276,40 @@ TEST_F(MonitorTest, MonitorTestLightLockOverflow)
     ASSERT_FALSE(Monitor::HoldsLock(header));
 }
 
+TEST_F(MonitorTest, MonitorPoolShardsTest)
+{
+    LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+    Class *cls = Runtime::GetCurrent()->GetClassLinker()->GetExtension(ctx)->GetClassRoot(ClassRoot::OBJECT);
+    auto *monitorPool = thread_->GetMonitorPool();
+    constexpr size_t OBJECTS_COUNT = MonitorPool::SHARD_COUNT * 3U;
+    PandaVector<ObjectHeader *> headers;
+    PandaSet<Monitor::MonitorId> ids;
+    for (size_t i = 0; i < OBJECTS_COUNT; i++) {
+        auto header = ObjectHeader::Create(cls);
+        ASSERT_TRUE(Monitor::Inflate(header, thread_));
+        Monitor *monitor = Monitor::GetMonitorFromObject(header);
+        ASSERT_NE(monitor, nullptr);
+        ASSERT_EQ(monitorPool->LookupMonitor(monitor->GetId()), monitor);
+        ids.insert(monitor->GetId());
+        headers.push_back(header);
+    }
+    // Every inflated object has its own monitor, wherever the shard is
+    ASSERT_EQ(ids.size(), OBJECTS_COUNT);
+    ASSERT_EQ(monitorPool->GetEnteredMonitorsIds(thread_), ids);
+    size_t enumerated = 0;
+    monitorPool->EnumerateMonitors([&enumerated, &ids](Monitor *monitor) {
+        enumerated += ids.count(monitor->GetId());
+        return true;
+    });
+    ASSERT_EQ(enumerated, OBJECTS_COUNT);
+    for (auto *header : headers) {
+        Monitor::MonitorExit(header);
+        ASSERT_TRUE(Monitor::Deflate(header));
+        ASSERT_TRUE(header->AtomicGetMark().GetState() == MarkWord::STATE_UNLOCKED);
+    }
+    for (auto id : ids) {
+        ASSERT_EQ(monitorPool->LookupMonitor(id), nullptr);
+    }
+}
+
 }  // namespace ark::concurrency::test
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -28,12 +28,17 @@
 #include <random>
 #include <climits>
 #include <functional>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace ark::mem::test {
 
 static constexpr uint32_t TEST_THREADS = 8;
 static constexpr uint32_t TEST_ITERS = 1000;
 static constexpr uint32_t TEST_ARRAY_SIZE = TEST_THREADS * 1000;
+static constexpr uint32_t LOOKUP_STRINGS = 4096;
+static constexpr uint32_t TEST_LOOKUPS = 10000;
 
 class MultithreadedInternStringTableTest : public testing::Test {
 public:
@@ -81,6 +86,14 @@ public:
         return table_;
     }
 
+    /// Looks the string up without interning it
+    coretypes::String *FindString(const std::string &str)
+    {
+        LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+        auto *data = reinterpret_cast<const uint8_t *>(str.c_str());
+        return table_->table_.GetString(data, str.size(), true, ctx);
+    }
+
     void PreCheck()
     {
         std::unique_lock<std::mutex> lk(preLock_);
@@ -116,12 +129,12 @@ public:
             string_ = nullptr;
 
             {
-                os::memory::WriteLockHolder holder(table_->table_.tableLock_);
-                table_->table_.table_.clear();
+                os::memory::LockHolder holder(table_->table_.tableLock_);
+                table_->table_.Clear();
             }
             {
-                os::memory::WriteLockHolder holder(table_->internalTable_.tableLock_);
-                table_->internalTable_.table_.clear();
+                os::memory::LockHolder holder(table_->internalTable_.tableLock_);
+                table_->internalTable_.Clear();
             }
 
             postCv_.notify_all();
@@ -227,4 +240,86 @@ TEST_F(MultithreadedInternStringTableTest, CheckInternReturnsSameString)
         threads[i].join();
     }
 }
+
+void TestConcurrentLookup(const std::vector<std::string> &strings, const std::vector<coretypes::String *> &interned,
+                          uint32_t seed, uint32_t lookups, MultithreadedInternStringTableTest *test)
+{
+    auto *thisThread =
+        ark::MTManagedThread::Create(ark::Runtime::GetCurrent(), ark::Runtime::GetCurrent()->GetPandaVM());
+    thisThread->ManagedCodeBegin();
+    LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+    auto *table = test->GetTable();
+    uint32_t index = seed;
+    for (uint32_t i = 0; i < lookups; i++) {
+        // NOLINTNEXTLINE(readability-magic-numbers)
+        index = (index * 1103515245U + 12345U) % LOOKUP_STRINGS;
+        const auto &str = strings[index];
+        auto *found = table->GetOrInternString(reinterpret_cast<const uint8_t *>(str.c_str()), str.size(), ctx);
+        ASSERT_EQ(found, interned[index]);
+    }
+    thisThread->ManagedCodeEnd();
+    thisThread->Destroy();
+}
+
+void InternLookupStrings(std::vector<std::string> &strings, std::vector<coretypes::String *> &interned,
+                        MultithreadedInternStringTableTest *test)
+{
+    LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+    for (uint32_t i = 0; i < LOOKUP_STRINGS; i++) {
+        strings.push_back("string_literal_" + std::to_string(i));
+        const auto &str = strings.back();
+        auto *data = reinterpret_cast<const uint8_t *>(str.c_str());
+        interned.push_back(test->GetTable()->GetOrInternString(data, str.size(), ctx));
+    }
+}
+
+// Concurrent lookups of the interned strings find the same objects and never add new ones
+TEST_F(MultithreadedInternStringTableTest, ConcurrentLookup)
+{
+    std::vector<std::string> strings;
+    std::vector<coretypes::String *> interned;
+    InternLookupStrings(strings, interned, this);
+    ASSERT_EQ(GetTable()->Size(), LOOKUP_STRINGS);
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < TEST_THREADS; i++) {
+        threads.emplace_back(TestConcurrentLookup, std::cref(strings), std::cref(interned), i, TEST_LOOKUPS, this);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(GetTable()->Size(), LOOKUP_STRINGS);
+}
+
+// The table has grown several times, Sweep removes the dead strings and rehashes the live ones in place
+TEST_F(MultithreadedInternStringTableTest, SweepAfterGrow)
+{
+    std::vector<std::string> strings;
+    std::vector<coretypes::String *> interned;
+    InternLookupStrings(strings, interned, this);
+
+    std::unordered_set<ObjectHeader *> dead;
+    for (uint32_t i = 0; i < LOOKUP_STRINGS; i += 3U) {
+        dead.insert(interned[i]);
+    }
+    GetTable()->Sweep([&dead](ObjectHeader *object) {
+        return dead.count(object) != 0 ? ObjectStatus::DEAD_OBJECT : ObjectStatus::ALIVE_OBJECT;
+    });
+    ASSERT_EQ(GetTable()->Size(), LOOKUP_STRINGS - dead.size());
+    for (uint32_t i = 0; i < LOOKUP_STRINGS; i++) {
+        ASSERT_EQ(FindString(strings[i]), i % 3U == 0 ? nullptr : interned[i]) << strings[i];
+    }
+
+    // The live strings stay in the probe sequences of the buckets grown after the sweep
+    LanguageContext ctx = Runtime::GetCurrent()->GetLanguageContext(panda_file::SourceLang::PANDA_ASSEMBLY);
+    for (uint32_t i = 0; i < LOOKUP_STRINGS; i++) {
+        auto str = "string_after_sweep_" + std::to_string(i);
+        GetTable()->GetOrInternString(reinterpret_cast<const uint8_t *>(str.c_str()), str.size(), ctx);
+    }
+    ASSERT_EQ(GetTable()->Size(), 2U * LOOKUP_STRINGS - dead.size());
+    for (uint32_t i = 0; i < LOOKUP_STRINGS; i++) {
+        ASSERT_EQ(FindString(strings[i]), i % 3U == 0 ? nullptr : interned[i]) << strings[i];
+    }
+}
+
 }  // namespace ark::mem::test
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,7 +17,9 @@
 
 #include "runtime/include/runtime.h"
 #include "runtime/regexp/ecmascript/regexp_parser.h"
+#include "runtime/regexp/ecmascript/regexp_dfa.h"
 #include "runtime/regexp/ecmascript/regexp_executor.h"
+#include "runtime/regexp/ecmascript/regexp_prefilter.h"
 
 namespace ark::test {
 
@@ -764,6 +766,112 @@ TEST_F(RegExpTest, RangeSet10)
     rangeResult.Invert(false);
     EXPECT_EQ(rangeResult, rangeExpected);
 }
+
+static PandaVector<uint8_t> Compile(const PandaString &source, uint32_t flags)
+{
+    RegExpParser parser = RegExpParser();
+    parser.Init(const_cast<char *>(reinterpret_cast<const char *>(source.c_str())), source.size(), flags);
+    parser.Parse();
+    EXPECT_FALSE(parser.IsError());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return PandaVector<uint8_t>(parser.GetOriginBuffer(), parser.GetOriginBuffer() + parser.GetOriginBufferSize());
+}
+
+static RegExpDfa::Result DfaSearch(RegExpDfa &dfa, const PandaString &input)
+{
+    auto *chars = reinterpret_cast<const uint8_t *>(input.c_str());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    return dfa.Match(chars, chars, chars + input.size(), false, true);
+}
+
+TEST_F(RegExpTest, DfaMatch)
+{
+    auto byteCode = Compile("a[bc]+d|x*y", 0);
+    RegExpDfa dfa(byteCode.data());
+    ASSERT_TRUE(dfa.IsSupported());
+    EXPECT_EQ(DfaSearch(dfa, "zzabcbd"), RegExpDfa::Result::MATCH);
+    EXPECT_EQ(DfaSearch(dfa, "zzxxy"), RegExpDfa::Result::MATCH);
+    EXPECT_EQ(DfaSearch(dfa, "zzad"), RegExpDfa::Result::NO_MATCH);
+    EXPECT_EQ(DfaSearch(dfa, ""), RegExpDfa::Result::NO_MATCH);
+}
+
+TEST_F(RegExpTest, DfaAssertions)
+{
+    auto byteCode = Compile("^\\bfoo$", RegExpParser::FLAG_MULTILINE);
+    RegExpDfa dfa(byteCode.data());
+    ASSERT_TRUE(dfa.IsSupported());
+    EXPECT_EQ(DfaSearch(dfa, "bar\nfoo\nbaz"), RegExpDfa::Result::MATCH);
+    EXPECT_EQ(DfaSearch(dfa, "bar foo"), RegExpDfa::Result::NO_MATCH);
+}
+
+TEST_F(RegExpTest, DfaUnsupported)
+{
+    auto backReference = Compile("(a)\\1", 0);
+    RegExpDfa dfa1(backReference.data());
+    EXPECT_FALSE(dfa1.IsSupported());
+    EXPECT_EQ(DfaSearch(dfa1, "aa"), RegExpDfa::Result::UNKNOWN);
+
+    auto lookahead = Compile("a(?=b)", 0);
+    RegExpDfa dfa2(lookahead.data());
+    EXPECT_FALSE(dfa2.IsSupported());
+}
+
+TEST_F(RegExpTest, PrefilterPrefix)
+{
+    auto byteCode = Compile("abc\\d", 0);
+    RegExpPrefilter prefilter;
+    prefilter.Analyze(byteCode.data());
+    ASSERT_TRUE(prefilter.HasFilter());
+    EXPECT_FALSE(prefilter.IsAnchored());
+    PandaString input("xxabxabc1");
+    auto *chars = reinterpret_cast<const uint8_t *>(input.c_str());
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const uint8_t *end = chars + input.size();
+    EXPECT_EQ(prefilter.FindCandidate(chars, end, false) - chars, 5);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    EXPECT_EQ(prefilter.FindCandidate(chars + 6, end, false), end);
+}
+
+TEST_F(RegExpTest, PrefilterAnchored)
+{
+    auto anchored = Compile("^a", 0);
+    RegExpPrefilter prefilter1;
+    prefilter1.Analyze(anchored.data());
+    EXPECT_TRUE(prefilter1.IsAnchored());
+
+    auto multiline = Compile("^a", RegExpParser::FLAG_MULTILINE);
+    RegExpPrefilter prefilter2;
+    prefilter2.Analyze(multiline.data());
+    EXPECT_FALSE(prefilter2.IsAnchored());
+}
+
+TEST_F(RegExpTest, ExecuteWithPrefilterAndDfa)
+{
+    auto byteCode = Compile("b(c+)d", 0);
+    RegExpPrefilter prefilter;
+    prefilter.Analyze(byteCode.data());
+    RegExpDfa dfa(byteCode.data());
+    for (const char *str : {"aabccd", "aabcce", "bd", "xbcd"}) {
+        PandaString input(str);
+        auto *chars = reinterpret_cast<const uint8_t *>(input.c_str());
+        RegExpExecutor plain;
+        bool expected = plain.Execute(chars, 0, input.size(), byteCode.data(), false);
+        RegExpExecutor filtered;
+        filtered.SetPrefilter(&prefilter);
+        filtered.SetDfa(&dfa);
+        EXPECT_EQ(filtered.Execute(chars, 0, input.size(), byteCode.data(), false), expected);
+        if (!expected) {
+            continue;
+        }
+        ASSERT_EQ(filtered.GetCaptureCount(), plain.GetCaptureCount());
+        for (uint32_t i = 0; i < plain.GetCaptureCount(); i++) {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            EXPECT_EQ(filtered.GetCaptureResultList()[i].captureStart, plain.GetCaptureResultList()[i].captureStart);
+            EXPECT_EQ(filtered.GetCaptureResultList()[i].captureEnd, plain.GetCaptureResultList()[i].captureEnd);
+            // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+}
 }  // namespace ark::test
 
 // NOLINTEND(readability-magic-numbers)
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -499,6 +499,82 @@ TEST_F(SamplerTest, StreamWriterReaderLotsSamplesTest)
     ASSERT_FALSE(reader.GetNextModule(nullptr));
 }
 
+// Testing reader and writer with the stacks which share the frames in the call tree
+TEST_F(SamplerTest, StreamWriterReaderCallTreeTest)
+{
+    constexpr size_t STACKS_COUNT = 8;
+    const char *streamTestFilename = "stream_writer_reader_call_tree_test.aspt";
+    std::vector<SampleInfo> samplesInput;
+
+    {
+        // Stacks of different depths with the common bottom frames, the stacks of different threads and the
+        // stacks which differ in the order of the frames
+        SampleInfo sample;
+        FullfillFakeSample(&sample);
+        for (size_t i = 0; i < STACKS_COUNT; ++i) {
+            sample.stackInfo.managedStackSize = SampleInfo::StackInfo::MAX_STACK_DEPTH - i;
+            samplesInput.push_back(sample);
+            sample.threadInfo.threadId++;
+            samplesInput.push_back(sample);
+            std::swap(sample.stackInfo.managedStack[0], sample.stackInfo.managedStack[1]);
+            samplesInput.push_back(sample);
+        }
+        sample.stackInfo.managedStackSize = 1;
+        samplesInput.push_back(sample);
+    }
+
+    {
+        StreamWriter writer(streamTestFilename);
+        for (size_t i = 0; i < TEST_CYCLE_THRESHOLD; ++i) {
+            for (const auto &sample : samplesInput) {
+                writer.WriteSample(sample);
+            }
+        }
+    }
+
+    SampleInfo sampleOutput;
+    SampleReader reader(streamTestFilename);
+    for (size_t i = 0; i < TEST_CYCLE_THRESHOLD; ++i) {
+        for (const auto &sample : samplesInput) {
+            ASSERT_TRUE(reader.GetNextSample(&sampleOutput));
+            ASSERT_EQ(sampleOutput, sample);
+        }
+    }
+    ASSERT_FALSE(reader.GetNextSample(&sampleOutput));
+}
+
+// Testing reader and writer with more distinct stacks than the writer caches
+TEST_F(SamplerTest, StreamWriterReaderManyStacksTest)
+{
+    constexpr size_t STACKS_COUNT = 1024;
+    constexpr size_t CYCLES_COUNT = 4;
+    const char *streamTestFilename = "stream_writer_reader_many_stacks_test.aspt";
+    std::vector<SampleInfo> samplesInput(STACKS_COUNT);
+    for (size_t i = 0; i < STACKS_COUNT; ++i) {
+        FullfillFakeSample(&samplesInput[i]);
+        samplesInput[i].stackInfo.managedStack[0] = {i, pfId_};
+    }
+
+    {
+        StreamWriter writer(streamTestFilename);
+        for (size_t i = 0; i < CYCLES_COUNT; ++i) {
+            for (const auto &sample : samplesInput) {
+                writer.WriteSample(sample);
+            }
+        }
+    }
+
+    SampleInfo sampleOutput;
+    SampleReader reader(streamTestFilename);
+    for (size_t i = 0; i < CYCLES_COUNT; ++i) {
+        for (const auto &sample : samplesInput) {
+            ASSERT_TRUE(reader.GetNextSample(&sampleOutput));
+            ASSERT_EQ(sampleOutput, sample);
+        }
+    }
+    ASSERT_FALSE(reader.GetNextSample(&sampleOutput));
+}
+
 // Testing reader and writer by writing and reading from .aspt one module
 TEST_F(SamplerTest, ModuleWriterReaderTest)
 {
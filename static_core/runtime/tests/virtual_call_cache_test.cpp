@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "runtime/interpreter/cache.h"
+
+namespace ark::interpreter::test {
+
+/**
+ * The cache only compares the pointers, so the call sites, the methods and the classes are addresses within
+ * the storage of the test and are never dereferenced.
+ */
+class VirtualCallCacheTest : public testing::Test {
+protected:
+    // Distance between two classes which are mapped to the same slot for the same call site
+    static constexpr size_t SAME_SLOT_DISTANCE = VirtualCallCache::N * 8U;
+    static constexpr size_t STORAGE_SIZE = 4U * SAME_SLOT_DISTANCE;
+    static constexpr size_t METHOD_SIZE = 64U;
+
+    const void *Pc(size_t offset) const
+    {
+        return &storage_[offset];
+    }
+
+    Method *MethodAt(size_t index)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<Method *>(&storage_[index * METHOD_SIZE]);
+    }
+
+    const Class *ClassAt(size_t offset) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const Class *>(&storage_[offset]);
+    }
+
+    VirtualCallCache cache_;  // NOLINT(misc-non-private-member-variables-in-classes)
+
+private:
+    alignas(sizeof(uint64_t)) std::array<uint8_t, STORAGE_SIZE> storage_ {};
+};
+
+TEST_F(VirtualCallCacheTest, Hit)
+{
+    auto *caller = MethodAt(0U);
+    auto *target = MethodAt(1U);
+    auto *pc = Pc(3U);
+    auto *cls = ClassAt(SAME_SLOT_DISTANCE);
+
+    ASSERT_EQ(cache_.Get(pc, caller, cls), nullptr);
+    cache_.Set(pc, caller, cls, target);
+    ASSERT_EQ(cache_.Get(pc, caller, cls), target);
+    // The lookup doesn't change the entry
+    ASSERT_EQ(cache_.Get(pc, caller, cls), target);
+
+    cache_.Clear();
+    ASSERT_EQ(cache_.Get(pc, caller, cls), nullptr);
+}
+
+TEST_F(VirtualCallCacheTest, MissOnOtherReceiverClass)
+{
+    auto *caller = MethodAt(0U);
+    auto *target = MethodAt(1U);
+    auto *pc = Pc(3U);
+    auto *cls = ClassAt(SAME_SLOT_DISTANCE);
+    auto *otherCls = ClassAt(SAME_SLOT_DISTANCE + 8U);
+
+    cache_.Set(pc, caller, cls, target);
+    ASSERT_EQ(cache_.Get(pc, caller, otherCls), nullptr);
+    // Same call site address in another method
+    ASSERT_EQ(cache_.Get(pc, MethodAt(2U), cls), nullptr);
+
+    // A polymorphic call site keeps an entry per receiver
+    auto *otherTarget = MethodAt(3U);
+    cache_.Set(pc, caller, otherCls, otherTarget);
+    ASSERT_EQ(cache_.Get(pc, caller, cls), target);
+    ASSERT_EQ(cache_.Get(pc, caller, otherCls), otherTarget);
+}
+
+TEST_F(VirtualCallCacheTest, EvictionOnSharedSlot)
+{
+    auto *caller = MethodAt(0U);
+    auto *target = MethodAt(1U);
+    auto *otherTarget = MethodAt(2U);
+    auto *pc = Pc(3U);
+    auto *cls = ClassAt(SAME_SLOT_DISTANCE);
+    auto *clsInSameSlot = ClassAt(2U * SAME_SLOT_DISTANCE);
+
+    cache_.Set(pc, caller, cls, target);
+    cache_.Set(pc, caller, clsInSameSlot, otherTarget);
+    ASSERT_EQ(cache_.Get(pc, caller, clsInSameSlot), otherTarget);
+    ASSERT_EQ(cache_.Get(pc, caller, cls), nullptr);
+
+    cache_.Set(pc, caller, cls, target);
+    ASSERT_EQ(cache_.Get(pc, caller, cls), target);
+    ASSERT_EQ(cache_.Get(pc, caller, clsInSameSlot), nullptr);
+}
+
+}  // namespace ark::interpreter::test
@@ -274,10 +274,16 @@ ManagedThread::~ManagedThread()
     internalLocalAllocator_ = nullptr;
     allocator->Delete(stackFrameAllocator_);
     allocator->Delete(ptThreadInfo_.release());
+    allocator->Delete(virtualCallCache_);
 
     ASSERT(threadFrameStates_.empty() && "stack should be empty");
 }
 
+VirtualCallCache *ManagedThread::CreateVirtualCallCache()
+{
+    return GetInternalAllocator(this)->New<VirtualCallCache>();
+}
+
 void ManagedThread::InitBuffers()
 {
     auto allocator = GetInternalAllocator(this);
@@ -931,6 +937,8 @@ void ManagedThread::FreeInternalMemory()
 
     allocator->Delete(ptThreadInfo_.release());
     allocator->Delete(weightedAdaptiveTlabAverage_);
+    allocator->Delete(virtualCallCache_);
+    virtualCallCache_ = nullptr;
 
     taggedHandleScopes_.~PandaVector<HandleScope<coretypes::TaggedType> *>();
     allocator->Delete(taggedHandleStorage_);
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -34,10 +34,13 @@ namespace ark::tooling::sampler {
 /*
  * Example for 64 bit architecture
  *
- *              Thread id   Thread status    Stack Size      Managed stack frame id
- * Sample row |___________|______________|________________|_____________------___________|
- *              32 bits      32 bits          64 bits       (128 * <stack size>) bits
+ *              Thread id   Thread status    Stack id
+ * Sample row |___________|______________|________________|
+ *              32 bits      32 bits          64 bits
  *
+ *                    0xFF..FE    parent id   Managed stack frame id
+ * Call tree node row |__________|__________|______________________|
+ *                     64 bits    64 bits          128 bits
  *
  *              0xFF..FF    pointer   checksum   name size     module path (ASCII str)
  * Module row |__________|__________|__________|___________|_____________------___________|
@@ -63,9 +66,14 @@ inline SampleReader::SampleReader(const char *filename)
         binFile.close();
     }
 
+    callTree_.push_back({StreamWriter::CALL_TREE_ROOT_ID, 0, {}});
     size_t bufferCounter = 0;
     while (bufferCounter < buffer_.size()) {
-        if (ReadUintptrTBitMisaligned(&buffer_[bufferCounter]) == StreamWriter::MODULE_INDICATOR_VALUE) {
+        if (bufferCounter + sizeof(uintptr_t) > buffer_.size()) {
+            break;
+        }
+        uintptr_t indicator = ReadUintptrTBitMisaligned(&buffer_[bufferCounter]);
+        if (indicator == StreamWriter::MODULE_INDICATOR_VALUE) {
             // This entry is panda file
             size_t pfNameSize = ReadUintptrTBitMisaligned(&buffer_[bufferCounter + PANDA_FILE_NAME_SIZE_OFFSET]);
             size_t nextModulePtrOffset = PANDA_FILE_NAME_OFFSET + pfNameSize * sizeof(char);
@@ -80,21 +88,32 @@ inline SampleReader::SampleReader(const char *filename)
             continue;
         }
 
-        // buffer_counter now is entry of a sample, stack size lies after thread_id
-        size_t stackSize = ReadUintptrTBitMisaligned(&buffer_[bufferCounter + SAMPLE_STACK_SIZE_OFFSET]);
-        if (stackSize > SampleInfo::StackInfo::MAX_STACK_DEPTH) {
-            LOG(FATAL, PROFILER) << "ark sampling profiler trace file is invalid, stack_size > MAX_STACK_DEPTH";
-            UNREACHABLE();
+        if (indicator == StreamWriter::CALL_TREE_NODE_INDICATOR_VALUE) {
+            if (bufferCounter + CALL_TREE_NODE_ROW_SIZE > buffer_.size()) {
+                LOG(ERROR, PROFILER) << "ark sampling profiler drop last stacks, because of invalid trace file";
+                return;
+            }
+            if (!ReadCallTreeNode(&buffer_[bufferCounter])) {
+                LOG(FATAL, PROFILER) << "ark sampling profiler trace file is invalid, wrong call tree node";
+                UNREACHABLE();
+            }
+            bufferCounter += CALL_TREE_NODE_ROW_SIZE;
+            continue;
         }
 
-        size_t nextSamplePtrOffset = SAMPLE_STACK_OFFSET + stackSize * sizeof(SampleInfo::ManagedStackFrameId);
-        if (bufferCounter + nextSamplePtrOffset > buffer_.size()) {
+        // buffer_counter now is entry of a sample, stack id lies after thread status
+        if (bufferCounter + SAMPLE_ROW_SIZE > buffer_.size()) {
             LOG(ERROR, PROFILER) << "ark sampling profiler drop last samples, because of invalid trace file";
             return;
         }
+        size_t stackId = ReadUintptrTBitMisaligned(&buffer_[bufferCounter + SAMPLE_STACK_ID_OFFSET]);
+        if (stackId >= callTree_.size()) {
+            LOG(FATAL, PROFILER) << "ark sampling profiler trace file is invalid, sample of unknown stack";
+            UNREACHABLE();
+        }
 
         sampleRowPtrs_.push_back(&buffer_[bufferCounter]);
-        bufferCounter += nextSamplePtrOffset;
+        bufferCounter += SAMPLE_ROW_SIZE;
     }
 
     if (bufferCounter != buffer_.size()) {
@@ -112,17 +131,34 @@ inline bool SampleReader::GetNextSample(SampleInfo *sampleOut)
     sampleOut->threadInfo.threadId = ReadUint32TBitMisaligned(&currentSamplePtr[SAMPLE_THREAD_ID_OFFSET]);
     sampleOut->threadInfo.threadStatus =
         static_cast<SampleInfo::ThreadStatus>(ReadUint32TBitMisaligned(&currentSamplePtr[SAMPLE_THREAD_STATUS_OFFSET]));
-    sampleOut->stackInfo.managedStackSize = ReadUintptrTBitMisaligned(&currentSamplePtr[SAMPLE_STACK_SIZE_OFFSET]);
+    size_t stackId = ReadUintptrTBitMisaligned(&currentSamplePtr[SAMPLE_STACK_ID_OFFSET]);
 
+    // The stack is restored from the top frame to the root of the call tree
+    const CallTreeNode *node = &callTree_[stackId];
+    sampleOut->stackInfo.managedStackSize = node->depth;
     ASSERT(sampleOut->stackInfo.managedStackSize <= SampleInfo::StackInfo::MAX_STACK_DEPTH);
-    auto copySize = sampleOut->stackInfo.managedStackSize * sizeof(SampleInfo::ManagedStackFrameId);
-    [[maybe_unused]] int r =
-        memcpy_s(sampleOut->stackInfo.managedStack.data(), copySize, currentSamplePtr + SAMPLE_STACK_OFFSET, copySize);
-    ASSERT(r == 0);
+    for (size_t i = 0; i < sampleOut->stackInfo.managedStackSize; ++i) {
+        sampleOut->stackInfo.managedStack[i] = node->frame;
+        node = &callTree_[node->parentId];
+    }
     ++sampleRowCounter_;
     return true;
 }
 
+inline bool SampleReader::ReadCallTreeNode(const char *nodeRowPtr)
+{
+    uintptr_t parentId = ReadUintptrTBitMisaligned(&nodeRowPtr[CALL_TREE_NODE_PARENT_OFFSET]);
+    // The parent is written before its children
+    if (parentId >= callTree_.size() || callTree_[parentId].depth >= SampleInfo::StackInfo::MAX_STACK_DEPTH) {
+        return false;
+    }
+    SampleInfo::ManagedStackFrameId frame;
+    frame.fileId = ReadUintptrTBitMisaligned(&nodeRowPtr[CALL_TREE_NODE_FRAME_OFFSET]);
+    frame.pandaFilePtr = ReadUintptrTBitMisaligned(&nodeRowPtr[CALL_TREE_NODE_FRAME_OFFSET + sizeof(uintptr_t)]);
+    callTree_.push_back({parentId, callTree_[parentId].depth + 1, frame});
+    return true;
+}
+
 inline bool SampleReader::GetNextModule(FileInfo *moduleOut)
 {
     if (moduleRowPtrs_.size() <= moduleRowCounter_) {
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -28,8 +28,12 @@ public:
     // clang-format off
     static constexpr size_t SAMPLE_THREAD_ID_OFFSET     = 0 * sizeof(uint32_t);
     static constexpr size_t SAMPLE_THREAD_STATUS_OFFSET = 1 * sizeof(uint32_t);
-    static constexpr size_t SAMPLE_STACK_SIZE_OFFSET    = 2 * sizeof(uint32_t);
-    static constexpr size_t SAMPLE_STACK_OFFSET         = 2 * sizeof(uint32_t) + 1 * sizeof(uintptr_t);
+    static constexpr size_t SAMPLE_STACK_ID_OFFSET      = 2 * sizeof(uint32_t);
+    static constexpr size_t SAMPLE_ROW_SIZE             = 2 * sizeof(uint32_t) + 1 * sizeof(uintptr_t);
+
+    static constexpr size_t CALL_TREE_NODE_PARENT_OFFSET = 1 * sizeof(uintptr_t);
+    static constexpr size_t CALL_TREE_NODE_FRAME_OFFSET  = 2 * sizeof(uintptr_t);
+    static constexpr size_t CALL_TREE_NODE_ROW_SIZE      = 4 * sizeof(uintptr_t);
 
     static constexpr size_t PANDA_FILE_POINTER_OFFSET   = 1 * sizeof(uintptr_t);
     static constexpr size_t PANDA_FILE_CHECKSUM_OFFSET  = 2 * sizeof(uintptr_t);
@@ -46,10 +50,20 @@ public:
     NO_MOVE_SEMANTIC(SampleReader);
 
 private:
+    struct CallTreeNode {
+        uintptr_t parentId;
+        uintptr_t depth;
+        SampleInfo::ManagedStackFrameId frame;
+    };
+
+    inline bool ReadCallTreeNode(const char *nodeRowPtr);
+
     // Using std::vector instead of PandaVector 'cause it should be used in tool without runtime
     std::vector<char> buffer_;
     std::vector<char *> sampleRowPtrs_;
     std::vector<char *> moduleRowPtrs_;
+    // Node with index `i` has id `i`, the first one is the root
+    std::vector<CallTreeNode> callTree_;
     size_t sampleRowCounter_ {0};
     size_t moduleRowCounter_ {0};
 };
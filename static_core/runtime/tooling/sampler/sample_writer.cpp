@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -13,32 +13,94 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <string>
 
+#include "libpandabase/utils/math_helpers.h"
 #include "runtime/tooling/sampler/sample_info.h"
 #include "runtime/tooling/sampler/sample_writer.h"
 
 namespace ark::tooling::sampler {
 
-void StreamWriter::WriteSample(const SampleInfo &sample) const
+void StreamWriter::WriteSample(const SampleInfo &sample)
 {
     ASSERT(writeStreamPtr_ != nullptr);
     ASSERT(sample.stackInfo.managedStackSize <= SampleInfo::StackInfo::MAX_STACK_DEPTH);
 
     static_assert(sizeof(sample.threadInfo.threadId) == sizeof(uint32_t));
     static_assert(sizeof(sample.threadInfo.threadStatus) == sizeof(uint32_t));
-    static_assert(sizeof(sample.stackInfo.managedStackSize) == sizeof(uintptr_t));
-
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&sample.threadInfo.threadId),
-                           sizeof(sample.threadInfo.threadId));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&sample.threadInfo.threadStatus),
-                           sizeof(sample.threadInfo.threadStatus));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&sample.stackInfo.managedStackSize),
-                           sizeof(sample.stackInfo.managedStackSize));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(sample.stackInfo.managedStack.data()),
-                           sample.stackInfo.managedStackSize * sizeof(SampleInfo::ManagedStackFrameId));
+
+    uintptr_t stackId = GetStackId(sample.stackInfo);
+    WriteData(&sample.threadInfo.threadId, sizeof(sample.threadInfo.threadId));
+    WriteData(&sample.threadInfo.threadStatus, sizeof(sample.threadInfo.threadStatus));
+    WriteData(&stackId, sizeof(stackId));
+}
+
+uintptr_t StreamWriter::GetStackId(const SampleInfo::StackInfo &stack)
+{
+    // Unlike the hash of `SampleInfo`, it depends on the order of the frames
+    constexpr size_t HASH_MULTIPLIER = 31U;
+    size_t hash = stack.managedStackSize;
+    for (size_t i = 0; i < stack.managedStackSize; ++i) {
+        const auto &frame = stack.managedStack[i];
+        hash = hash * HASH_MULTIPLIER + (frame.fileId ^ frame.pandaFilePtr);
+    }
+    auto begin = stack.managedStack.begin();
+    auto end = begin + stack.managedStackSize;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    static_assert((STACKS_CACHE_SIZE & (STACKS_CACHE_SIZE - 1)) == 0);
+    // The multiplicative hashing takes the entry from the high bits, which depend on all the frames
+    constexpr uint64_t FIBONACCI_MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+    constexpr uint64_t ENTRY_SHIFT = BITS_PER_UINT64 - helpers::math::GetIntLog2(uint64_t {STACKS_CACHE_SIZE});
+    auto &[cachedId, cachedStack] = stacks_[(uint64_t {hash} * FIBONACCI_MULTIPLIER) >> ENTRY_SHIFT];
+    if (LIKELY(std::equal(begin, end, cachedStack.begin(), cachedStack.end()))) {
+        return cachedId;
+    }
+    // The top frame is the first one, so the tree is built from the bottom of the stack
+    uintptr_t stackId = CALL_TREE_ROOT_ID;
+    for (size_t i = stack.managedStackSize; i > 0; --i) {
+        stackId = GetCallTreeNode(stackId, stack.managedStack[i - 1]);
+    }
+    // The stack replaces the one cached in the same entry
+    cachedId = stackId;
+    cachedStack.assign(begin, end);
+    return stackId;
+}
+
+uintptr_t StreamWriter::GetCallTreeNode(uintptr_t parentId, const SampleInfo::ManagedStackFrameId &frame)
+{
+    static_assert(sizeof(frame.fileId) == sizeof(uintptr_t));
+    static_assert(sizeof(frame.pandaFilePtr) == sizeof(uintptr_t));
+
+    // Ids of the nodes start from 1, after the root
+    auto [it, inserted] = callTree_.try_emplace({parentId, frame}, callTree_.size() + 1);
+    if (inserted) {
+        WriteData(&CALL_TREE_NODE_INDICATOR_VALUE, sizeof(CALL_TREE_NODE_INDICATOR_VALUE));
+        WriteData(&parentId, sizeof(parentId));
+        WriteData(&frame.fileId, sizeof(frame.fileId));
+        WriteData(&frame.pandaFilePtr, sizeof(frame.pandaFilePtr));
+    }
+    return it->second;
+}
+
+void StreamWriter::WriteData(const void *data, size_t size)
+{
+    if (buffer_.size() + size > BUFFER_SIZE) {
+        FlushBuffer();
+        if (size > BUFFER_SIZE) {
+            writeStreamPtr_->write(static_cast<const char *>(data), size);
+            return;
+        }
+    }
+    const auto *bytes = static_cast<const char *>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+}
+
+void StreamWriter::FlushBuffer()
+{
+    writeStreamPtr_->write(buffer_.data(), buffer_.size());
+    buffer_.clear();
 }
 
 void StreamWriter::WriteModule(const FileInfo &moduleInfo)
@@ -54,11 +116,11 @@ void StreamWriter::WriteModule(const FileInfo &moduleInfo)
     }
     size_t strSize = moduleInfo.pathname.length();
 
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&MODULE_INDICATOR_VALUE), sizeof(MODULE_INDICATOR_VALUE));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&moduleInfo.ptr), sizeof(moduleInfo.ptr));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&moduleInfo.checksum), sizeof(moduleInfo.checksum));
-    writeStreamPtr_->write(reinterpret_cast<const char *>(&strSize), sizeof(moduleInfo.pathname.length()));
-    writeStreamPtr_->write(moduleInfo.pathname.data(), moduleInfo.pathname.length() * sizeof(char));
+    WriteData(&MODULE_INDICATOR_VALUE, sizeof(MODULE_INDICATOR_VALUE));
+    WriteData(&moduleInfo.ptr, sizeof(moduleInfo.ptr));
+    WriteData(&moduleInfo.checksum, sizeof(moduleInfo.checksum));
+    WriteData(&strSize, sizeof(moduleInfo.pathname.length()));
+    WriteData(moduleInfo.pathname.data(), moduleInfo.pathname.length() * sizeof(char));
 
     writtenModules_.insert(moduleInfo);
 }
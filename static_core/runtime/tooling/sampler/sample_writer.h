@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -19,12 +19,16 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
 
+#include "libpandabase/mem/mem.h"
 #include "libpandabase/os/thread.h"
 
 #include "runtime/tooling/sampler/sample_info.h"
 
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace ark::tooling::sampler {
 
@@ -38,28 +42,43 @@ namespace ark::tooling::sampler {
  *
  * .aspt - ark sampling profiler trace file, binary format
  *
- * .aspt consists of 2 type information:
+ * .aspt consists of 3 type information:
  *   - module row (panda file and its pointer)
+ *   - call tree node row (managed stack frame and its caller)
  *   - sample row (sample information)
  *
+ * The managed stacks of the samples are interned into a call tree (prefix tree of the stacks from the bottom
+ * frame), so a stack is written once and every sample refers to it by the id of the node of its top frame.
+ * The nodes get the ids 1, 2, ... in the order of their rows, the root node with id 0 stands for the empty stack.
+ * A node row precedes the rows which refer to the node.
+ *
  * module row for 64-bits:
  *   first 8 byte is 0xFFFFFFFF (to recognize that it's not a sample row)
  *   next 8 byte is pointer module
+ *   next 4 byte is checksum of panda file
  *   next 8 byte is size of panda file name
  *   next bytes is panda file name in ASCII symbols
  *
+ * call tree node row for 64-bits:
+ *   first 8 byte is 0xFFFFFFFE (to recognize that it's not a sample row)
+ *   next 8 byte is id of the parent node, the node of the caller frame
+ *   next 16 bytes is stack frame
+ *   one stack frame is file id and panda file ptr
+ *
  * sample row for 64-bits:
  *   first 4 bytes is thread id of thread from sample was obtained
  *   next 4 bytes is thread status of thread from sample was obtained
- *   next 8 bytes is stack size
- *   next bytes is stack frame
- *   one stack frame is panda file ptr and file id
+ *   next 8 bytes is stack id, id of the node of the top frame
  *
  * Example for 64-bit architecture:
  *
- *            Thread id   Thread status    Stack Size      Managed stack frame id
- * Sample row |___________|___________|________________|_____________------___________|
- *              32 bits      32 bits        64 bits       (128 * <stack size>) bits
+ *            Thread id   Thread status    Stack id
+ * Sample row |___________|___________|________________|
+ *              32 bits      32 bits        64 bits
+ *
+ *                   0xFF..FE    parent id   Managed stack frame id
+ * Call tree node row |__________|__________|______________________|
+ *                     64 bits    64 bits          128 bits
  *
  *              0xFF..FF    pointer   checksum   name size     module path (ASCII str)
  * Module row |__________|__________|__________|___________|_____________------___________|
@@ -76,16 +95,19 @@ public:
          */
         writeStreamPtr_ = std::make_unique<std::ofstream>(filename, std::ios::binary);
         ASSERT(writeStreamPtr_ != nullptr);
+        buffer_.reserve(BUFFER_SIZE);
+        stacks_.resize(STACKS_CACHE_SIZE);
     }
 
     ~StreamWriter()
     {
+        FlushBuffer();
         writeStreamPtr_->flush();
         writeStreamPtr_->close();
     };
 
     PANDA_PUBLIC_API void WriteModule(const FileInfo &moduleInfo);
-    PANDA_PUBLIC_API void WriteSample(const SampleInfo &sample) const;
+    PANDA_PUBLIC_API void WriteSample(const SampleInfo &sample);
 
     bool IsModuleWritten(const FileInfo &moduleInfo) const
     {
@@ -96,10 +118,55 @@ public:
     NO_MOVE_SEMANTIC(StreamWriter);
 
     static constexpr uintptr_t MODULE_INDICATOR_VALUE = 0xFFFFFFFF;
+    static constexpr uintptr_t CALL_TREE_NODE_INDICATOR_VALUE = 0xFFFFFFFE;
+    static constexpr uintptr_t CALL_TREE_ROOT_ID = 0;
 
 private:
+    struct CallTreeEdge {
+        uintptr_t parentId {CALL_TREE_ROOT_ID};
+        SampleInfo::ManagedStackFrameId frame;
+
+        bool operator==(const CallTreeEdge &other) const
+        {
+            return parentId == other.parentId && frame == other.frame;
+        }
+    };
+
+    struct CallTreeEdgeHash {
+        size_t operator()(const CallTreeEdge &edge) const
+        {
+            constexpr uint32_t FILE_PTR_SHIFT = 16;
+            constexpr uint32_t PARENT_SHIFT = 32;
+            return std::hash<uintptr_t> {}(edge.frame.fileId ^ (edge.frame.pandaFilePtr << FILE_PTR_SHIFT) ^
+                                           (edge.parentId << PARENT_SHIFT) ^ (edge.parentId >> PARENT_SHIFT));
+        }
+    };
+
+    struct CachedStack {
+        uintptr_t id {CALL_TREE_ROOT_ID};
+        std::vector<SampleInfo::ManagedStackFrameId> frames;
+    };
+
+    // Size of the buffer which collects the rows to write them to the file at once
+    static constexpr size_t BUFFER_SIZE = 1_MB;
+    // Number of the entries in the cache of the stacks, a power of two
+    static constexpr size_t STACKS_CACHE_SIZE = 4096;
+
+    /// Returns the id of the node of the top frame, writes the new nodes of the stack
+    uintptr_t GetStackId(const SampleInfo::StackInfo &stack);
+    /// Returns the id of the node of `frame` called from the node `parentId`, writes the node if it is new
+    uintptr_t GetCallTreeNode(uintptr_t parentId, const SampleInfo::ManagedStackFrameId &frame);
+
+    void WriteData(const void *data, size_t size);
+    void FlushBuffer();
+
     std::unique_ptr<std::ofstream> writeStreamPtr_;
     std::unordered_set<FileInfo> writtenModules_;
+    std::unordered_map<CallTreeEdge, uintptr_t, CallTreeEdgeHash> callTree_;
+    // Direct-mapped cache of the recent stacks by their hash, as a sample walks the whole stack in `callTree_`
+    // otherwise. The memory is bounded by the cache size and the max stack depth however long the profiling is
+    std::vector<CachedStack> stacks_;
+    std::vector<char> buffer_;
 };
 
 }  // namespace ark::tooling::sampler
@@ -1,4 +1,4 @@
-# Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+# Copyright (c) 2021-2024 Huawei Device Co., Ltd.
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
 # You may obtain a copy of the License at
@@ -45,6 +45,7 @@ set(VERIFIER_TESTS_SOURCES
     ${UTIL_TESTS_SOURCES}
     ${ABSINT_TESTS_SOURCES}
     ${JOBS_TESTS_SOURCES}
+    ${CACHE_TESTS_SOURCES}
 )
 
 set(VERIFIER_RAPIDCHECK_TESTS_SOURCES
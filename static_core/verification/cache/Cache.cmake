@@ -1,4 +1,4 @@
-# Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+# Copyright (c) 2021-2024 Huawei Device Co., Ltd.
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
 # You may obtain a copy of the License at
@@ -14,3 +14,7 @@
 set(VERIFIER_CACHE_SOURCES
     ${VERIFICATION_SOURCES_DIR}/cache/results_cache.cpp
 )
+
+set(CACHE_TESTS_SOURCES
+    ${VERIFICATION_SOURCES_DIR}/cache/tests/results_cache_test.cpp
+)
@@ -0,0 +1,158 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _PANDA_VERIFIER_CACHE_CONTENT_HASHER_H__
+#define _PANDA_VERIFIER_CACHE_CONTENT_HASHER_H__
+
+#include "verification/cache/results_cache.h"
+
+#include "libpandabase/globals.h"
+#include "libpandabase/macros.h"
+
+#include <array>
+#include <cstdint>
+
+namespace ark::verifier {
+
+/**
+ * SHA-256, unlike std::hash it gives the same keys for all the runs and platforms, and the keys don't collide even
+ * for the crafted code. The key is the first 128 bits of the digest.
+ */
+class ContentHasher {
+public:
+    using Digest = std::array<uint32_t, 8U>;
+
+    void AddByte(uint8_t byte)
+    {
+        buffer_[bufferSize_++] = byte;
+        ++length_;
+        if (bufferSize_ == BLOCK_SIZE) {
+            Compress();
+            bufferSize_ = 0;
+        }
+    }
+
+    void Add(uint64_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            AddByte(static_cast<uint8_t>(value >> (i * BITS_PER_BYTE)));
+        }
+    }
+
+    void AddString(const uint8_t *mutf8)
+    {
+        // The terminating zero is hashed as well to separate the strings
+        for (; *mutf8 != 0; ++mutf8) {  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            AddByte(*mutf8);
+        }
+        AddByte(0);
+    }
+
+    /// Finishes the hashing, the hasher can't be used after that
+    Digest GetDigest()
+    {
+        uint64_t bitLength = length_ * BITS_PER_BYTE;
+        AddByte(PADDING_START);
+        while (bufferSize_ != BLOCK_SIZE - sizeof(bitLength)) {
+            AddByte(0);
+        }
+        for (size_t i = sizeof(bitLength); i > 0; --i) {
+            AddByte(static_cast<uint8_t>(bitLength >> ((i - 1U) * BITS_PER_BYTE)));
+        }
+        ASSERT(bufferSize_ == 0);
+        return state_;
+    }
+
+    VerificationResultCache::MethodKey GetKey()
+    {
+        auto digest = GetDigest();
+        VerificationResultCache::MethodKey key {};
+        for (size_t i = 0; i < key.size(); ++i) {
+            key[i] = (static_cast<uint64_t>(digest[i * 2U]) << WORD_BITS) | digest[i * 2U + 1U];
+            // 0 marks an empty slot in the cache file
+            if (key[i] == 0) {
+                key[i] = 1U;
+            }
+        }
+        return key;
+    }
+
+private:
+    static uint32_t RotateRight(uint32_t value, uint32_t shift)
+    {
+        return (value >> shift) | (value << (WORD_BITS - shift));
+    }
+
+    // NOLINTBEGIN(readability-magic-numbers)
+    void Compress()
+    {
+        std::array<uint32_t, ROUNDS> w {};
+        for (size_t i = 0; i < BLOCK_SIZE / sizeof(uint32_t); ++i) {
+            w[i] = (static_cast<uint32_t>(buffer_[i * 4U]) << 24U) |
+                   (static_cast<uint32_t>(buffer_[i * 4U + 1U]) << 16U) |
+                   (static_cast<uint32_t>(buffer_[i * 4U + 2U]) << 8U) | buffer_[i * 4U + 3U];
+        }
+        for (size_t i = BLOCK_SIZE / sizeof(uint32_t); i < ROUNDS; ++i) {
+            uint32_t s0 = RotateRight(w[i - 15U], 7U) ^ RotateRight(w[i - 15U], 18U) ^ (w[i - 15U] >> 3U);
+            uint32_t s1 = RotateRight(w[i - 2U], 17U) ^ RotateRight(w[i - 2U], 19U) ^ (w[i - 2U] >> 10U);
+            w[i] = w[i - 16U] + s0 + w[i - 7U] + s1;
+        }
+        auto [a, b, c, d, e, f, g, h] = state_;
+        for (size_t i = 0; i < ROUNDS; ++i) {
+            uint32_t sum1 = RotateRight(e, 6U) ^ RotateRight(e, 11U) ^ RotateRight(e, 25U);
+            uint32_t t1 = h + sum1 + ((e & f) ^ (~e & g)) + ROUND_CONSTANTS[i] + w[i];
+            uint32_t sum0 = RotateRight(a, 2U) ^ RotateRight(a, 13U) ^ RotateRight(a, 22U);
+            uint32_t t2 = sum0 + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        std::array<uint32_t, STATE_WORDS> working {a, b, c, d, e, f, g, h};
+        for (size_t i = 0; i < STATE_WORDS; ++i) {
+            state_[i] += working[i];
+        }
+    }
+
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t ROUNDS = 64;
+    static constexpr size_t STATE_WORDS = 8;
+    static constexpr uint32_t WORD_BITS = 32;
+    static constexpr uint8_t PADDING_START = 0x80;
+    static constexpr std::array<uint32_t, ROUNDS> ROUND_CONSTANTS = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+    Digest state_ {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                              0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    // NOLINTEND(readability-magic-numbers)
+    std::array<uint8_t, BLOCK_SIZE> buffer_ {};
+    size_t bufferSize_ {0};
+    uint64_t length_ {0};
+};
+
+}  // namespace ark::verifier
+
+#endif  // _PANDA_VERIFIER_CACHE_CONTENT_HASHER_H__
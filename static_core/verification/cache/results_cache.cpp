@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,77 +14,484 @@
  */
 
 #include "verification/cache/results_cache.h"
+#include "verification/cache/content_hasher.h"
 #include "verification/util/synchronized.h"
 
+#include "runtime/include/class.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/method.h"
 #include "runtime/include/runtime.h"
 #include "runtime/include/mem/allocator.h"
 #include "runtime/include/mem/panda_containers.h"
 
 #include "libpandabase/os/file.h"
+#include "libpandabase/os/filesystem.h"
+#include "libpandabase/os/mem.h"
+#include "libpandafile/bytecode_instruction-inl.h"
+#include "libpandafile/code_data_accessor-inl.h"
+#include "libpandafile/field_data_accessor-inl.h"
+#include "libpandafile/method_data_accessor-inl.h"
+#include "libpandafile/proto_data_accessor-inl.h"
 #include "utils/logger.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+
 namespace ark::verifier {
 
-struct VerificationResultCache::Impl {
-    std::string filename;
-    Synchronized<PandaUnorderedSet<uint64_t>> verifiedOk;
-    Synchronized<PandaUnorderedSet<uint64_t>> verifiedFail;
+namespace {
+
+/*
+ * The cache file is a header of HEADER_WORDS 64-bit words followed by an open addressing table of the keys of the
+ * successfully verified methods with linear probing. A key takes SLOT_WORDS words, 0 marks an empty slot. The
+ * capacity of the table is a power of 2.
+ */
+constexpr uint64_t CACHE_MAGIC = 0x4548434143524556ULL;  // "VERCACHE"
+// Must be changed when the key computation or the verifier rules are changed
+constexpr uint64_t CACHE_VERSION = 2U;
+constexpr size_t MAGIC_WORD = 0;
+constexpr size_t VERSION_WORD = 1;
+constexpr size_t CAPACITY_WORD = 2;
+constexpr size_t COUNT_WORD = 3;
+constexpr size_t HEADER_WORDS = 4;
+constexpr size_t SLOT_WORDS = 2;
+constexpr size_t INITIAL_CAPACITY = 4096;
+// The results are appended to the file while it is filled less than by 3/4
+constexpr size_t MAX_LOAD_NUM = 3;
+constexpr size_t MAX_LOAD_DEN = 4;
+
+using CacheWord = std::atomic<uint64_t>;
+static_assert(sizeof(CacheWord) == sizeof(uint64_t));
+static_assert(CacheWord::is_always_lock_free);
+
+/// Markers which separate the parts of the hashed content
+enum class HashTag : uint64_t {
+    CLASS,
+    CLASS_END,
+    VISITED_CLASS,
+    UNRESOLVED,
+    METHOD,
+    FIELD,
+    CODE,
+    INSTRUCTION,
+    ID,
+    TRY_BLOCK,
+    CATCH_ALL,
+    TRUNCATED
+};
+
+class SilentErrorHandler : public ClassLinkerErrorHandler {
+public:
+    // The verifier reports the resolution errors itself
+    void OnError([[maybe_unused]] ClassLinker::Error error, [[maybe_unused]] const PandaString &message) override {}
+};
+
+/**
+ * The verification result depends on the referenced entities as they are resolved at runtime, so the key covers the
+ * declarations of the resolved methods and fields and the hierarchies of all the classes the method works with
+ */
+class KeyBuilder {
+public:
+    explicit KeyBuilder(const Method &method)
+        : method_ {method},
+          pf_ {*method.GetPandaFile()},
+          classLinker_ {Runtime::GetCurrent()->GetClassLinker()},
+          context_ {method.GetClass()->GetLoadContext()}
+    {
+    }
+
+    VerificationResultCache::MethodKey Build()
+    {
+        hasher_.Add(static_cast<uint64_t>(method_.GetClass()->GetSourceLang()));
+        HashClassHierarchy(method_.GetClass());
+        hasher_.Add(static_cast<uint64_t>(HashTag::METHOD));
+        hasher_.AddString(method_.GetName().data);
+        hasher_.Add(method_.GetAccessFlags());
+        HashProto(pf_, panda_file::MethodDataAccessor::GetProtoId(pf_, method_.GetFileId()));
+        if (method_.GetCodeId().IsValid()) {
+            HashCode();
+        }
+        return hasher_.GetKey();
+    }
+
+private:
+    /// Subtyping of the class depends on its bases, interfaces and, for arrays, on the component type
+    void HashClassHierarchy(const Class *klass)
+    {
+        hasher_.Add(static_cast<uint64_t>(HashTag::CLASS));
+        hasher_.AddString(klass->GetDescriptor());
+        if (!visited_.insert(klass).second) {
+            hasher_.Add(static_cast<uint64_t>(HashTag::VISITED_CLASS));
+            return;
+        }
+        hasher_.Add(klass->GetAccessFlags());
+        if (klass->IsArrayClass()) {
+            HashClassHierarchy(klass->GetComponentType());
+        }
+        if (klass->GetBase() != nullptr) {
+            HashClassHierarchy(klass->GetBase());
+        }
+        for (const auto *iface : klass->GetInterfaces()) {
+            HashClassHierarchy(iface);
+        }
+        hasher_.Add(static_cast<uint64_t>(HashTag::CLASS_END));
+    }
 
-    template <typename It>
-    Impl(std::string fileName, It dataStart, It dataEnd)
-        : filename {std::move(fileName)}, verifiedOk {dataStart, dataEnd}
+    void HashClass(const panda_file::File &pf, panda_file::File::EntityId classId)
     {
+        // The name keeps the unresolved references distinct
+        hasher_.AddString(pf.GetStringData(classId).data);
+        auto *klass = classLinker_->GetClass(pf, classId, context_, &errorHandler_);
+        if (klass == nullptr) {
+            hasher_.Add(static_cast<uint64_t>(HashTag::UNRESOLVED));
+            return;
+        }
+        HashClassHierarchy(klass);
     }
+
+    void HashProto(const panda_file::File &pf, panda_file::File::EntityId protoId)
+    {
+        panda_file::ProtoDataAccessor pda(pf, protoId);
+        pda.EnumerateTypes([this](panda_file::Type type) { hasher_.Add(type.GetEncoding()); });
+        for (size_t i = 0; i < pda.GetRefNum(); ++i) {
+            HashClass(pf, pda.GetReferenceType(i));
+        }
+    }
+
+    void HashMethodRef(panda_file::File::EntityId methodId)
+    {
+        hasher_.Add(static_cast<uint64_t>(HashTag::METHOD));
+        panda_file::MethodDataAccessor mda(pf_, methodId);
+        hasher_.AddString(pf_.GetStringData(mda.GetClassId()).data);
+        hasher_.AddString(pf_.GetStringData(mda.GetNameId()).data);
+        // The method may be resolved to a declaration in a base class
+        const auto *callee = classLinker_->GetMethod(method_, methodId, &errorHandler_);
+        if (callee == nullptr) {
+            hasher_.Add(static_cast<uint64_t>(HashTag::UNRESOLVED));
+            HashProto(pf_, mda.GetProtoId());
+            return;
+        }
+        HashClassHierarchy(callee->GetClass());
+        hasher_.AddString(callee->GetName().data);
+        hasher_.Add(callee->GetAccessFlags());
+        const auto *calleePf = callee->GetPandaFile();
+        if (calleePf != nullptr) {
+            HashProto(*calleePf, panda_file::MethodDataAccessor::GetProtoId(*calleePf, callee->GetFileId()));
+        }
+    }
+
+    void HashFieldRef(panda_file::File::EntityId fieldId)
+    {
+        hasher_.Add(static_cast<uint64_t>(HashTag::FIELD));
+        panda_file::FieldDataAccessor fda(pf_, fieldId);
+        hasher_.AddString(pf_.GetStringData(fda.GetClassId()).data);
+        hasher_.AddString(pf_.GetStringData(fda.GetNameId()).data);
+        const auto *field = classLinker_->GetField(method_, fieldId, &errorHandler_);
+        if (field == nullptr) {
+            hasher_.Add(static_cast<uint64_t>(HashTag::UNRESOLVED));
+            hasher_.Add(fda.GetType());
+            return;
+        }
+        HashClassHierarchy(field->GetClass());
+        hasher_.Add(field->GetAccessFlags());
+        const auto &fieldPf = *field->GetPandaFile();
+        panda_file::FieldDataAccessor fieldFda(fieldPf, field->GetFileId());
+        auto type = panda_file::Type::GetTypeFromFieldEncoding(fieldFda.GetType());
+        hasher_.Add(type.GetEncoding());
+        if (type.IsReference()) {
+            HashClass(fieldPf, panda_file::File::EntityId(fieldFda.GetType()));
+        }
+    }
+
+    /// The ids of the instruction are replaced by the resolved entities, which don't depend on the file layout
+    void HashInstructionId(const BytecodeInstruction &inst, size_t idx)
+    {
+        using Flags = BytecodeInstruction::Flags;
+        auto id = inst.GetId(idx);
+        hasher_.Add(static_cast<uint64_t>(HashTag::ID));
+        if (inst.HasFlag(Flags::TYPE_ID)) {
+            HashClass(pf_, pf_.ResolveClassIndex(method_.GetFileId(), id.AsIndex()));
+        } else if (inst.HasFlag(Flags::METHOD_ID)) {
+            HashMethodRef(pf_.ResolveMethodIndex(method_.GetFileId(), id.AsIndex()));
+        } else if (inst.HasFlag(Flags::FIELD_ID)) {
+            HashFieldRef(pf_.ResolveFieldIndex(method_.GetFileId(), id.AsIndex()));
+        } else if (inst.HasFlag(Flags::STRING_ID)) {
+            hasher_.AddString(pf_.GetStringData(id.AsFileId()).data);
+        } else {
+            // The literal arrays are identified by their offsets, so such methods hit the cache only for the same file
+            hasher_.Add(id.AsRawValue());
+        }
+    }
+
+    void HashCode()
+    {
+        panda_file::CodeDataAccessor cda(pf_, method_.GetCodeId());
+        hasher_.Add(static_cast<uint64_t>(HashTag::CODE));
+        hasher_.Add(cda.GetNumVregs());
+        hasher_.Add(cda.GetNumArgs());
+        hasher_.Add(cda.GetCodeSize());
+
+        size_t offset = 0;
+        BytecodeInstruction inst(cda.GetInstructions());
+        while (offset < cda.GetCodeSize()) {
+            if (offset + inst.GetSize() > cda.GetCodeSize()) {
+                // Malformed code, the verifier rejects it
+                hasher_.Add(static_cast<uint64_t>(HashTag::TRUNCATED));
+                break;
+            }
+            auto format = inst.GetFormat();
+            hasher_.Add(static_cast<uint64_t>(HashTag::INSTRUCTION));
+            hasher_.Add(static_cast<uint64_t>(inst.GetOpcode()));
+            for (size_t idx = 0; BytecodeInstruction::HasVReg(format, idx); ++idx) {
+                hasher_.Add(inst.GetVReg(idx));
+            }
+            for (size_t idx = 0; BytecodeInstruction::HasImm(format, idx); ++idx) {
+                hasher_.Add(static_cast<uint64_t>(inst.GetImm64(idx)));
+            }
+            for (size_t idx = 0; BytecodeInstruction::HasId(format, idx); ++idx) {
+                HashInstructionId(inst, idx);
+            }
+            offset += inst.GetSize();
+            inst = inst.GetNext();
+        }
+
+        cda.EnumerateTryBlocks([this](panda_file::CodeDataAccessor::TryBlock &tryBlock) {
+            hasher_.Add(static_cast<uint64_t>(HashTag::TRY_BLOCK));
+            hasher_.Add(tryBlock.GetStartPc());
+            hasher_.Add(tryBlock.GetLength());
+            tryBlock.EnumerateCatchBlocks([this](panda_file::CodeDataAccessor::CatchBlock &catchBlock) {
+                auto typeIdx = catchBlock.GetTypeIdx();
+                if (typeIdx == panda_file::INVALID_INDEX) {
+                    hasher_.Add(static_cast<uint64_t>(HashTag::CATCH_ALL));
+                } else {
+                    HashClass(pf_, method_.GetClass()->ResolveClassIndex(typeIdx));
+                }
+                hasher_.Add(catchBlock.GetHandlerPc());
+                hasher_.Add(catchBlock.GetCodeSize());
+                return true;
+            });
+            return true;
+        });
+    }
+
+    const Method &method_;
+    const panda_file::File &pf_;
+    ClassLinker *classLinker_;
+    ClassLinkerContext *context_;
+    SilentErrorHandler errorHandler_;
+    ContentHasher hasher_;
+    PandaUnorderedSet<const Class *> visited_;
 };
 
-VerificationResultCache::Impl *VerificationResultCache::impl_ {nullptr};
+using MethodKey = VerificationResultCache::MethodKey;
 
-bool VerificationResultCache::Enabled()
+struct MethodKeyHash {
+    size_t operator()(const MethodKey &key) const
+    {
+        // The key is a digest already
+        return static_cast<size_t>(key[0]);
+    }
+};
+
+/// A slot is a pair of words, the first one is written first, so a slot with only the first word is being claimed
+CacheWord *GetSlot(CacheWord *slots, size_t index)
 {
-    return impl_ != nullptr;
+    return slots + index * SLOT_WORDS;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
 }
 
-void VerificationResultCache::Initialize(const std::string &filename)
+bool FindKey(CacheWord *slots, size_t capacity, const MethodKey &key)
 {
-    if (Enabled()) {
-        return;
+    size_t mask = capacity - 1U;
+    size_t index = key[0] & mask;
+    for (size_t probes = 0; probes < capacity; ++probes, index = (index + 1U) & mask) {
+        auto *slot = GetSlot(slots, index);
+        // Atomic with relaxed order reason: the key is the data itself, nothing is published with it
+        uint64_t first = slot[0].load(std::memory_order_relaxed);
+        if (first == 0) {
+            return false;
+        }
+        // Atomic with relaxed order reason: the key is the data itself, nothing is published with it
+        if (first == key[0] && slot[1].load(std::memory_order_relaxed) == key[1]) {  // NOLINT(*-pointer-arithmetic)
+            return true;
+        }
+    }
+    return false;
+}
+
+/// The file is written aside and renamed, so the other processes which have mapped the old file are not affected
+bool WriteCacheFile(const std::string &filename, const PandaVector<MethodKey> &keys)
+{
+    size_t capacity = INITIAL_CAPACITY;
+    // Leave room for the appends
+    while (keys.size() * 2U > capacity) {
+        capacity *= 2U;
+    }
+    PandaVector<uint64_t> words(HEADER_WORDS + capacity * SLOT_WORDS, 0);
+    words[MAGIC_WORD] = CACHE_MAGIC;
+    words[VERSION_WORD] = CACHE_VERSION;
+    words[CAPACITY_WORD] = capacity;
+    size_t mask = capacity - 1U;
+    for (const auto &key : keys) {
+        size_t index = key[0] & mask;
+        auto slot = [&words, &index]() { return words.begin() + HEADER_WORDS + index * SLOT_WORDS; };
+        while (slot()[0] != 0 && (slot()[0] != key[0] || slot()[1] != key[1])) {
+            index = (index + 1U) & mask;
+        }
+        if (slot()[0] == 0) {
+            std::copy(key.cbegin(), key.cend(), slot());
+            ++words[COUNT_WORD];
+        }
+    }
+
+    bool written = os::WriteFileAtomically(filename, [&words](const os::file::File &file) {
+        return file.WriteAll(words.data(), words.size() * sizeof(uint64_t));
+    });
+    if (!written) {
+        LOG(INFO, VERIFIER) << "Cannot write to verification cache file '" << filename << "'";
     }
+    return written;
+}
+
+os::mem::BytePtr MapCacheFile(const std::string &filename, bool updateFile)
+{
     using ark::os::file::Mode;
     using ark::os::file::Open;
-    using Data = PandaVector<uint64_t>;
-
-    auto file = Open(filename, Mode::READONLY);
+    os::mem::BytePtr none(nullptr, 0, nullptr);
+    auto file = Open(filename, updateFile ? Mode::READWRITE : Mode::READONLY);
     if (!file.IsValid()) {
-        file = Open(filename, Mode::READWRITECREATE);
+        return none;
     }
-    if (!file.IsValid()) {
-        LOG(INFO, VERIFIER) << "Cannot open verification cache file '" << filename << "'";
-        return;
+    // The mapping stays valid after the file is closed
+    os::file::FileHolder holder(file);
+    auto size = file.GetFileSize();
+    if (!size.HasValue() || *size < HEADER_WORDS * sizeof(uint64_t) || *size % sizeof(uint64_t) != 0) {
+        return none;
+    }
+    // The appends go right to the file if it is updated, otherwise the mapping is only read
+    uint32_t prot = updateFile ? os::mem::MMAP_PROT_READ | os::mem::MMAP_PROT_WRITE : os::mem::MMAP_PROT_READ;
+    uint32_t flags = updateFile ? os::mem::MMAP_FLAG_SHARED : os::mem::MMAP_FLAG_PRIVATE;
+    auto mapping = os::mem::MapFile(file, prot, flags, *size);
+    if (mapping.Get() == nullptr) {
+        return none;
+    }
+    const auto *words = reinterpret_cast<const CacheWord *>(mapping.Get());
+    // Atomic with relaxed order reason: the header is checked before the file is used by the other threads
+    auto word = [words](size_t idx) { return words[idx].load(std::memory_order_relaxed); };  // NOLINT(*-arithmetic)
+    uint64_t capacity = word(CAPACITY_WORD);
+    if (word(MAGIC_WORD) != CACHE_MAGIC || word(VERSION_WORD) != CACHE_VERSION || capacity == 0 ||
+        (capacity & (capacity - 1U)) != 0 || (HEADER_WORDS + capacity * SLOT_WORDS) * sizeof(uint64_t) != *size) {
+        return none;
     }
+    return mapping;
+}
 
-    auto size = file.GetFileSize();
-    if (!size.HasValue()) {
-        LOG(INFO, VERIFIER) << "Cannot get verification cache file size";
-        file.Close();
-        return;
+}  // namespace
+
+struct VerificationResultCache::Impl {
+    std::string filename;
+    bool updateFile;
+    os::mem::BytePtr mapping;
+    size_t capacity;
+    // The successful results which didn't fit into the file
+    Synchronized<PandaUnorderedSet<MethodKey, MethodKeyHash>> verifiedOk;
+    Synchronized<PandaUnorderedSet<MethodKey, MethodKeyHash>> verifiedFail;
+
+    Impl(std::string fileName, bool update, os::mem::BytePtr map)
+        : filename {std::move(fileName)},
+          updateFile {update},
+          mapping {std::move(map)},
+          // Atomic with relaxed order reason: the capacity is never changed
+          capacity {Words()[CAPACITY_WORD].load(std::memory_order_relaxed)}
+    {
     }
 
-    Data data;
+    CacheWord *Words() const
+    {
+        return reinterpret_cast<CacheWord *>(mapping.Get());
+    }
 
-    auto elements = *size / sizeof(Data::value_type);
+    CacheWord *Slots() const
+    {
+        return Words() + HEADER_WORDS;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
 
-    if (elements > 0) {
-        data.resize(elements, 0);
-        if (!file.ReadAll(data.data(), *size)) {
-            LOG(INFO, VERIFIER) << "Cannot read verification cache data";
-            file.Close();
-            return;
+    /**
+     * Returns false if the file has no room for the key. The file may be shared with the other processes, so the
+     * room is reserved by the count first and the slot is claimed by CAS, there are no locks
+     */
+    bool Append(const MethodKey &key)
+    {
+        auto &count = Words()[COUNT_WORD];
+        // Atomic with relaxed order reason: the count only reserves the room, the slots are claimed by CAS
+        uint64_t oldCount = count.fetch_add(1U, std::memory_order_relaxed);
+        if ((oldCount + 1U) * MAX_LOAD_DEN > capacity * MAX_LOAD_NUM) {
+            // Atomic with relaxed order reason: the count only reserves the room, the slots are claimed by CAS
+            count.fetch_sub(1U, std::memory_order_relaxed);
+            return false;
         }
+        size_t mask = capacity - 1U;
+        size_t index = key[0] & mask;
+        for (size_t probes = 0; probes < capacity; ++probes, index = (index + 1U) & mask) {
+            auto *slot = GetSlot(Slots(), index);
+            uint64_t first = 0;
+            // Atomic with relaxed order reason: the key is the data itself, nothing is published with it
+            if (slot[0].compare_exchange_strong(first, key[0], std::memory_order_relaxed)) {
+                // Atomic with relaxed order reason: the key is the data itself, nothing is published with it
+                slot[1].store(key[1], std::memory_order_relaxed);  // NOLINT(cppcoreguidelines-pro-bounds-*)
+                return true;
+            }
+            // Atomic with relaxed order reason: the key is the data itself, nothing is published with it
+            if (first == key[0] && slot[1].load(std::memory_order_relaxed) == key[1]) {  // NOLINT(*-pointer-arithmetic)
+                break;
+            }
+            // The slot is taken by another key or is being claimed, a duplicate of a key being claimed is harmless
+        }
+        // The key is in the file already, or the file has been filled by the other processes
+        // Atomic with relaxed order reason: the count only reserves the room, the slots are claimed by CAS
+        count.fetch_sub(1U, std::memory_order_relaxed);
+        return FindKey(Slots(), capacity, key);
     }
 
-    file.Close();
+    PandaVector<MethodKey> GetFileKeys() const
+    {
+        PandaVector<MethodKey> keys;
+        for (size_t i = 0; i < capacity; ++i) {
+            auto *slot = GetSlot(Slots(), i);
+            // Atomic with relaxed order reason: called when the verification is finished
+            MethodKey key {slot[0].load(std::memory_order_relaxed), slot[1].load(std::memory_order_relaxed)};
+            // A slot which was being claimed when another process exited is skipped
+            if (key[0] != 0 && key[1] != 0) {
+                keys.push_back(key);
+            }
+        }
+        return keys;
+    }
+};
+
+VerificationResultCache::Impl *VerificationResultCache::impl_ {nullptr};
 
-    impl_ = new (mem::AllocatorAdapter<Impl>().allocate(1)) Impl {filename, data.cbegin(), data.cend()};
+bool VerificationResultCache::Enabled()
+{
+    return impl_ != nullptr;
+}
+
+void VerificationResultCache::Initialize(const std::string &filename, bool updateFile)
+{
+    if (Enabled()) {
+        return;
+    }
+    auto mapping = MapCacheFile(filename, updateFile);
+    // There is no file or it has another format, e.g. it was written by another version of the runtime
+    if (mapping.Get() == nullptr && updateFile && WriteCacheFile(filename, {})) {
+        mapping = MapCacheFile(filename, updateFile);
+    }
+    if (mapping.Get() == nullptr) {
+        LOG(INFO, VERIFIER) << "Cannot map verification cache file '" << filename << "'";
+        return;
+    }
+
+    impl_ = new (mem::AllocatorAdapter<Impl>().allocate(1)) Impl {filename, updateFile, std::move(mapping)};
     ASSERT(Enabled());
 }
 
@@ -93,57 +500,45 @@ void VerificationResultCache::Destroy(bool updateFile)
     if (!Enabled()) {
         return;
     }
-    if (updateFile) {
-        PandaVector<uint64_t> data;
-        impl_->verifiedOk.Apply([&data](const auto &set) {
-            data.reserve(set.size());
-            data.insert(data.begin(), set.cbegin(), set.cend());
-        });
-        using ark::os::file::Mode;
-        using ark::os::file::Open;
-        do {
-            auto file = Open(impl_->filename, Mode::READWRITECREATE);
-            if (!file.IsValid()) {
-                LOG(INFO, VERIFIER) << "Cannot open verification cache file '" << impl_->filename << "'";
-                break;
-            }
-            if (!file.ClearData()) {
-                LOG(INFO, VERIFIER) << "Cannot clear verification cache file '" << impl_->filename << "'";
-                file.Close();
-                break;
-            }
-            if (!file.WriteAll(data.data(), data.size() * sizeof(uint64_t))) {
-                LOG(INFO, VERIFIER) << "Cannot write to verification cache file '" << impl_->filename << "'";
-                file.ClearData();
-                file.Close();
-                break;
-            }
-            file.Close();
-        } while (false);
+    if (updateFile && impl_->updateFile) {
+        PandaVector<MethodKey> newKeys;
+        impl_->verifiedOk.Apply(
+            [&newKeys](const auto &set) { newKeys.insert(newKeys.end(), set.cbegin(), set.cend()); });
+        // The file is rebuilt only when it is full, otherwise all the results are already appended to it
+        if (!newKeys.empty()) {
+            auto keys = impl_->GetFileKeys();
+            keys.insert(keys.end(), newKeys.cbegin(), newKeys.cend());
+            WriteCacheFile(impl_->filename, keys);
+        }
     }
     impl_->~Impl();
     mem::AllocatorAdapter<Impl>().deallocate(impl_, 1);
     impl_ = nullptr;
 }
 
-void VerificationResultCache::CacheResult(uint64_t methodId, bool result)
+VerificationResultCache::MethodKey VerificationResultCache::GetMethodKey(const Method &method)
+{
+    return KeyBuilder(method).Build();
+}
+
+void VerificationResultCache::CacheResult(const MethodKey &methodKey, bool result)
 {
     if (Enabled()) {
-        if (result) {
-            impl_->verifiedOk->insert(methodId);
-        } else {
-            impl_->verifiedFail->insert(methodId);
+        if (!result) {
+            impl_->verifiedFail->insert(methodKey);
+        } else if (!impl_->updateFile || !impl_->Append(methodKey)) {
+            impl_->verifiedOk->insert(methodKey);
         }
     }
 }
 
-VerificationResultCache::Status VerificationResultCache::Check(uint64_t methodId)
+VerificationResultCache::Status VerificationResultCache::Check(const MethodKey &methodKey)
 {
     if (Enabled()) {
-        if (impl_->verifiedOk->count(methodId) > 0) {
+        if (FindKey(impl_->Slots(), impl_->capacity, methodKey) || impl_->verifiedOk->count(methodKey) > 0) {
             return Status::OK;
         }
-        if (impl_->verifiedFail->count(methodId) > 0) {
+        if (impl_->verifiedFail->count(methodKey) > 0) {
             return Status::FAILED;
         }
     }
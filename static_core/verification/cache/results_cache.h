@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,17 +16,35 @@
 #ifndef _PANDA_VERIFIER_CACHE_RESULTS_CACHE_H__
 #define _PANDA_VERIFIER_CACHE_RESULTS_CACHE_H__
 
+#include <array>
 #include <string>
 #include <cstdint>
 
+namespace ark {
+class Method;
+}  // namespace ark
+
 namespace ark::verifier {
+/**
+ * The cache of the verification results, keyed by the content hashes of the methods. The successful results are
+ * stored in a file, which is memory-mapped and probed in place. The new results are appended to the mapped file
+ * while there is room in it, the rest are kept in memory and the file is rebuilt with them by Destroy.
+ */
 class VerificationResultCache {
 public:
     enum class Status { OK, FAILED, UNKNOWN };
-    static void Initialize(const std::string &filename);
+    /// The first 128 bits of SHA-256 of the method content, neither of the words is 0
+    using MethodKey = std::array<uint64_t, 2U>;
+    static void Initialize(const std::string &filename, bool updateFile = true);
     static void Destroy(bool updateFile = true);
-    static void CacheResult(uint64_t methodId, bool result);
-    static Status Check(uint64_t methodId);
+    /**
+     * The key doesn't depend on the ids in the panda file: it is a hash of the bytecode with the referenced entities
+     * as they are resolved by the class linker, of the method signature and of the hierarchies of all the classes the
+     * method works with, including its own class
+     */
+    static MethodKey GetMethodKey(const Method &method);
+    static void CacheResult(const MethodKey &methodKey, bool result);
+    static Status Check(const MethodKey &methodKey);
     static bool Enabled();
 
 private:
@@ -0,0 +1,400 @@
+/**
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "verification/cache/results_cache.h"
+#include "verification/cache/content_hasher.h"
+
+#include "assembler/assembly-emitter.h"
+#include "assembler/assembly-parser.h"
+#include "libpandabase/os/file.h"
+#include "runtime/include/class_linker.h"
+#include "runtime/include/class_helper.h"
+#include "runtime/include/runtime.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ark::verifier::test {
+
+using Status = VerificationResultCache::Status;
+using MethodKey = VerificationResultCache::MethodKey;
+
+// NOLINTBEGIN(readability-magic-numbers)
+
+static constexpr const char *SOURCE = R"(
+    .record R {
+        i32 f <static>
+    }
+
+    .function i32 g(i32 a0) {
+        lda a0
+        return
+    }
+
+    .function i32 foo(i32 a0) {
+        ldstatic R.f
+        add2 a0
+        sta v0
+        call.short g, v0
+        return
+    }
+)";
+
+// Same functions, but the layout of the file is different
+static constexpr const char *SOURCE_WITH_OTHER_LAYOUT = R"(
+    .record Unrelated {
+        i64 x <static>
+    }
+
+    .function void unrelated() {
+        ldstatic.64 Unrelated.x
+        return.void
+    }
+
+    .record R {
+        i32 f <static>
+    }
+
+    .function i32 g(i32 a0) {
+        call.short unrelated
+        lda a0
+        return
+    }
+
+    .function i32 foo(i32 a0) {
+        ldstatic R.f
+        add2 a0
+        sta v0
+        call.short g, v0
+        return
+    }
+)";
+
+static constexpr const char *SOURCE_WITH_OTHER_CODE = R"(
+    .record R {
+        i32 f <static>
+    }
+
+    .function i32 g(i32 a0) {
+        lda a0
+        return
+    }
+
+    .function i32 foo(i32 a0) {
+        ldstatic R.f
+        sub2 a0
+        sta v0
+        call.short g, v0
+        return
+    }
+)";
+
+static constexpr const char *SOURCE_WITH_OTHER_CALLEE = R"(
+    .record R {
+        i32 f <static>
+    }
+
+    .function u32 g(i32 a0) {
+        lda a0
+        return
+    }
+
+    .function i32 foo(i32 a0) {
+        ldstatic R.f
+        add2 a0
+        sta v0
+        call.short g, v0
+        return
+    }
+)";
+
+// Same code, but the referenced class has another hierarchy, so the result of the verification may differ
+static constexpr const char *SOURCE_WITH_OTHER_HIERARCHY = R"(
+    .record Base {}
+
+    .record R <extends=Base> {
+        i32 f <static>
+    }
+
+    .function i32 g(i32 a0) {
+        lda a0
+        return
+    }
+
+    .function i32 foo(i32 a0) {
+        ldstatic R.f
+        add2 a0
+        sta v0
+        call.short g, v0
+        return
+    }
+)";
+
+static constexpr MethodKey KEY1 {1U, 1U};
+static constexpr MethodKey KEY2 {2U, 2U};
+static constexpr MethodKey KEY3 {3U, 3U};
+// Differs from KEY1 only in the second word
+static constexpr MethodKey KEY1_OTHER {1U, 2U};
+
+class VerificationResultCacheTest : public testing::Test {
+public:
+    VerificationResultCacheTest()
+    {
+        std::remove(CACHE_FILE);
+    }
+
+    ~VerificationResultCacheTest() override
+    {
+        std::remove(CACHE_FILE);
+    }
+
+    NO_COPY_SEMANTIC(VerificationResultCacheTest);
+    NO_MOVE_SEMANTIC(VerificationResultCacheTest);
+
+protected:
+    static constexpr const char *CACHE_FILE = "verification_results_cache_test.bin";
+
+    static void CreateRuntime()
+    {
+        RuntimeOptions options;
+        Logger::InitializeDummyLogging();
+        options.SetShouldLoadBootPandaFiles(false);
+        options.SetShouldInitializeIntrinsics(false);
+        options.SetGcType("epsilon");
+        Runtime::Create(options);
+    }
+
+    static MethodKey GetMethodKey(const char *source, const char *name)
+    {
+        CreateRuntime();
+        pandasm::Parser parser;
+        auto res = parser.Parse(source);
+        EXPECT_EQ(parser.ShowError().err, pandasm::Error::ErrorType::ERR_NONE);
+        auto pf = pandasm::AsmEmitter::Emit(res.Value());
+        EXPECT_NE(pf, nullptr);
+        auto *classLinker = Runtime::GetCurrent()->GetClassLinker();
+        classLinker->AddPandaFile(std::move(pf));
+        auto *extension = classLinker->GetExtension(panda_file::SourceLang::PANDA_ASSEMBLY);
+        PandaString descriptor;
+        auto *klass = extension->GetClass(ClassHelper::GetDescriptor(utf::CStringAsMutf8("_GLOBAL"), &descriptor));
+        EXPECT_NE(klass, nullptr);
+        auto *method = klass->GetDirectMethod(utf::CStringAsMutf8(name));
+        EXPECT_NE(method, nullptr);
+        auto key = VerificationResultCache::GetMethodKey(*method);
+        Runtime::Destroy();
+        return key;
+    }
+
+    static std::vector<MethodKey> GetKeys(size_t count, uint64_t seed = 1U)
+    {
+        std::vector<MethodKey> keys;
+        for (uint64_t i = 1; i <= count; ++i) {
+            keys.push_back({i * 0x9E3779B97F4A7C15ULL, seed});
+        }
+        return keys;
+    }
+
+    static size_t GetCacheFileSize()
+    {
+        auto file = os::file::Open(CACHE_FILE, os::file::Mode::READONLY);
+        os::file::FileHolder holder(file);
+        auto size = file.GetFileSize();
+        return size.HasValue() ? size.Value() : 0;
+    }
+};
+
+static ContentHasher::Digest Sha256(const std::string &message)
+{
+    ContentHasher hasher;
+    for (char c : message) {
+        hasher.AddByte(static_cast<uint8_t>(c));
+    }
+    return hasher.GetDigest();
+}
+
+// The known answers of FIPS 180-2, the last message takes two blocks with the padding
+TEST(ContentHasherTest, Sha256KnownAnswers)
+{
+    EXPECT_EQ(Sha256(""), ContentHasher::Digest({0xe3b0c442, 0x98fc1c14, 0x9afbf4c8, 0x996fb924, 0x27ae41e4,
+                                                 0x649b934c, 0xa495991b, 0x7852b855}));
+    EXPECT_EQ(Sha256("abc"), ContentHasher::Digest({0xba7816bf, 0x8f01cfea, 0x414140de, 0x5dae2223, 0xb00361a3,
+                                                    0x96177a9c, 0xb410ff61, 0xf20015ad}));
+    EXPECT_EQ(Sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              ContentHasher::Digest({0x248d6a61, 0xd20638b8, 0xe5c02693, 0x0c3e6039, 0xa33ce459, 0x64ff2167,
+                                     0xf6ecedd4, 0x19db06c1}));
+}
+
+TEST_F(VerificationResultCacheTest, MethodKey)
+{
+    auto key = GetMethodKey(SOURCE, "foo");
+    EXPECT_NE(key[0], 0U);
+    EXPECT_NE(key[1], 0U);
+    EXPECT_EQ(GetMethodKey(SOURCE, "foo"), key);
+    EXPECT_NE(GetMethodKey(SOURCE, "g"), key);
+    EXPECT_EQ(GetMethodKey(SOURCE_WITH_OTHER_LAYOUT, "foo"), key);
+    EXPECT_NE(GetMethodKey(SOURCE_WITH_OTHER_CODE, "foo"), key);
+    EXPECT_NE(GetMethodKey(SOURCE_WITH_OTHER_CALLEE, "foo"), key);
+    EXPECT_NE(GetMethodKey(SOURCE_WITH_OTHER_HIERARCHY, "foo"), key);
+}
+
+TEST_F(VerificationResultCacheTest, Persistence)
+{
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    ASSERT_TRUE(VerificationResultCache::Enabled());
+    VerificationResultCache::CacheResult(KEY1, true);
+    VerificationResultCache::CacheResult(KEY2, false);
+    EXPECT_EQ(VerificationResultCache::Check(KEY1), Status::OK);
+    EXPECT_EQ(VerificationResultCache::Check(KEY2), Status::FAILED);
+    EXPECT_EQ(VerificationResultCache::Check(KEY3), Status::UNKNOWN);
+    EXPECT_EQ(VerificationResultCache::Check(KEY1_OTHER), Status::UNKNOWN);
+    VerificationResultCache::Destroy();
+    ASSERT_FALSE(VerificationResultCache::Enabled());
+
+    VerificationResultCache::Initialize(CACHE_FILE);
+    ASSERT_TRUE(VerificationResultCache::Enabled());
+    EXPECT_EQ(VerificationResultCache::Check(KEY1), Status::OK);
+    // The failures are not stored
+    EXPECT_EQ(VerificationResultCache::Check(KEY2), Status::UNKNOWN);
+    VerificationResultCache::Destroy();
+    Runtime::Destroy();
+}
+
+// The results are in the file before Destroy
+TEST_F(VerificationResultCacheTest, Append)
+{
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    VerificationResultCache::CacheResult(KEY1, true);
+    auto file = os::file::Open(CACHE_FILE, os::file::Mode::READONLY);
+    os::file::FileHolder holder(file);
+    std::vector<uint64_t> words(GetCacheFileSize() / sizeof(uint64_t));
+    ASSERT_TRUE(file.ReadAll(words.data(), words.size() * sizeof(uint64_t)));
+    EXPECT_NE(std::search(words.begin() + 4U, words.end(), KEY1.begin(), KEY1.end()), words.end());
+    VerificationResultCache::Destroy();
+    Runtime::Destroy();
+}
+
+TEST_F(VerificationResultCacheTest, Growth)
+{
+    auto keys = GetKeys(10000U);
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    size_t initialSize = GetCacheFileSize();
+    for (auto key : keys) {
+        VerificationResultCache::CacheResult(key, true);
+    }
+    for (auto key : keys) {
+        ASSERT_EQ(VerificationResultCache::Check(key), Status::OK);
+    }
+    VerificationResultCache::Destroy();
+    EXPECT_GT(GetCacheFileSize(), initialSize);
+
+    VerificationResultCache::Initialize(CACHE_FILE);
+    for (auto key : keys) {
+        ASSERT_EQ(VerificationResultCache::Check(key), Status::OK);
+    }
+    VerificationResultCache::Destroy();
+    Runtime::Destroy();
+}
+
+TEST_F(VerificationResultCacheTest, NoUpdate)
+{
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    VerificationResultCache::CacheResult(KEY1, true);
+    VerificationResultCache::Destroy();
+    size_t size = GetCacheFileSize();
+
+    VerificationResultCache::Initialize(CACHE_FILE, false);
+    ASSERT_TRUE(VerificationResultCache::Enabled());
+    for (auto key : GetKeys(10000U)) {
+        VerificationResultCache::CacheResult(key, true);
+    }
+    EXPECT_EQ(VerificationResultCache::Check(GetKeys(1U)[0]), Status::OK);
+    VerificationResultCache::Destroy();
+    EXPECT_EQ(GetCacheFileSize(), size);
+
+    VerificationResultCache::Initialize(CACHE_FILE);
+    EXPECT_EQ(VerificationResultCache::Check(KEY1), Status::OK);
+    EXPECT_EQ(VerificationResultCache::Check(GetKeys(1U)[0]), Status::UNKNOWN);
+    VerificationResultCache::Destroy();
+    Runtime::Destroy();
+}
+
+// The threads append to the shared file concurrently, every result gets into the file or into the memory
+TEST_F(VerificationResultCacheTest, ConcurrentAppend)
+{
+    constexpr size_t THREADS = 8U;
+    constexpr size_t KEYS_PER_THREAD = 1000U;
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < THREADS; ++i) {
+        // The threads add the same keys as well as their own ones
+        threads.emplace_back([seed = i % 2U + 1U]() {
+            for (const auto &key : GetKeys(KEYS_PER_THREAD, seed)) {
+                VerificationResultCache::CacheResult(key, true);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (uint64_t seed = 1U; seed <= 2U; ++seed) {
+        for (const auto &key : GetKeys(KEYS_PER_THREAD, seed)) {
+            ASSERT_EQ(VerificationResultCache::Check(key), Status::OK);
+        }
+    }
+    VerificationResultCache::Destroy();
+
+    VerificationResultCache::Initialize(CACHE_FILE);
+    for (uint64_t seed = 1U; seed <= 2U; ++seed) {
+        for (const auto &key : GetKeys(KEYS_PER_THREAD, seed)) {
+            ASSERT_EQ(VerificationResultCache::Check(key), Status::OK);
+        }
+    }
+    VerificationResultCache::Destroy();
+    Runtime::Destroy();
+}
+
+// A file of another format, e.g. the plain list of the ids of the verified methods, is replaced by an empty cache
+TEST_F(VerificationResultCacheTest, UnknownFormat)
+{
+    std::vector<uint64_t> ids {1U, 2U, 3U};
+    {
+        auto file = os::file::Open(CACHE_FILE, os::file::Mode::READWRITECREATE);
+        os::file::FileHolder holder(file);
+        ASSERT_TRUE(file.WriteAll(ids.data(), ids.size() * sizeof(uint64_t)));
+    }
+    CreateRuntime();
+    VerificationResultCache::Initialize(CACHE_FILE);
+    ASSERT_TRUE(VerificationResultCache::Enabled());
+    for (auto id : ids) {
+        EXPECT_EQ(VerificationResultCache::Check({id, id}), Status::UNKNOWN);
+    }
+    VerificationResultCache::Destroy();
+    EXPECT_GT(GetCacheFileSize(), ids.size() * sizeof(uint64_t));
+    Runtime::Destroy();
+}
+
+// NOLINTEND(readability-magic-numbers)
+
+}  // namespace ark::verifier::test
@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -55,10 +55,10 @@ bool IsOnlyVerify(Config const *config)
 }
 
 Service *CreateService(Config const *config, ark::mem::InternalAllocatorPtr allocator, ClassLinker *linker,
-                       std::string const &cacheFileName)
+                       std::string const &cacheFileName, bool updateCacheFile)
 {
     if (!cacheFileName.empty()) {
-        VerificationResultCache::Initialize(cacheFileName);
+        VerificationResultCache::Initialize(cacheFileName, updateCacheFile);
     }
     auto res = allocator->New<Service>();
     res->config = config;
@@ -130,7 +130,9 @@ static bool VerifyClass(Class *clazz)
     return true;
 }
 
-static std::optional<Status> CheckBeforeVerification(Service *service, ark::Method *method, VerificationMode mode)
+/// The key of the method in the result cache is computed only once, methodKey keeps it for the caching of the result
+static std::optional<Status> CheckBeforeVerification(Service *service, ark::Method *method, VerificationMode mode,
+                                                     std::optional<VerificationResultCache::MethodKey> &methodKey)
 {
     using VStage = Method::VerificationStage;
     if (method->IsIntrinsic()) {
@@ -164,12 +166,11 @@ static std::optional<Status> CheckBeforeVerification(Service *service, ark::Meth
         return Status::OK;
     }
 
-    auto uniqId = method->GetUniqId();
-    auto methodName = method->GetFullName();
     if (VerificationResultCache::Enabled()) {
-        auto cachedStatus = ToPublic(VerificationResultCache::Check(uniqId));
+        methodKey = VerificationResultCache::GetMethodKey(*method);
+        auto cachedStatus = ToPublic(VerificationResultCache::Check(*methodKey));
         if (cachedStatus != Status::UNKNOWN) {
-            LOG(DEBUG, VERIFIER) << "Verification result of method '" << methodName
+            LOG(DEBUG, VERIFIER) << "Verification result of method '" << method->GetFullName()
                                  << "' was cached: " << (cachedStatus == Status::OK ? "OK" : "FAIL");
             return cachedStatus;
         }
@@ -183,12 +184,12 @@ Status Verify(Service *service, ark::Method *method, VerificationMode mode)
     using VStage = Method::VerificationStage;
     ASSERT(service != nullptr);
 
-    auto status = CheckBeforeVerification(service, method, mode);
+    std::optional<VerificationResultCache::MethodKey> methodKey;
+    auto status = CheckBeforeVerification(service, method, mode, methodKey);
     if (status) {
         return status.value();
     }
 
-    auto uniqId = method->GetUniqId();
     auto methodName = method->GetFullName();
 
     auto lang = method->GetClass()->GetSourceLang();
@@ -216,7 +217,9 @@ Status Verify(Service *service, ark::Method *method, VerificationMode mode)
 
     service->verifierService->ReleaseProcessor(processor);
 
-    VerificationResultCache::CacheResult(uniqId, result);
+    if (methodKey) {
+        VerificationResultCache::CacheResult(*methodKey, result);
+    }
 
     if (result) {
         method->SetVerificationStage(VStage::VERIFIED_OK);
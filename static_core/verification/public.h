@@ -1,5 +1,5 @@
 /**
- * Copyright (c) 2021-2022 Huawei Device Co., Ltd.
+ * Copyright (c) 2021-2024 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -39,7 +39,7 @@ bool IsOnlyVerify(Config const *config);
 using Service = struct Service;
 
 Service *CreateService(Config const *config, ark::mem::InternalAllocatorPtr allocator, ClassLinker *linker,
-                       std::string const &cacheFileName);
+                       std::string const &cacheFileName, bool updateCacheFile = true);
 void DestroyService(Service *service, bool updateCacheFile);
 
 Config const *GetServiceConfig(Service const *service);